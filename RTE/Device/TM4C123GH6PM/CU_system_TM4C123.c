@@ -8,6 +8,7 @@
 	
 	Revision History:
 		July 14, 2014:	version 1.0: convert from TM4C129 to TM4C123	
+		version 1.1: SystemCoreClockUpdate reads the clock from RCC/RCC2
 	
 CU  */
 
@@ -33,6 +34,34 @@ CU  */
  *----------------------------------------------------------------------------*/
 #define __SYSTEM_CLOCK    (16000000ul)
 
+/* CU  the clock sources and the PLL output used by SystemCoreClockUpdate */
+#define __PIOSC_CLOCK     (16000000ul)
+#define __LFIOSC_CLOCK    (30000ul)
+#define __HIB_CLOCK       (32768ul)
+#define __PLL_CLOCK       (400000000ul)
+
+/* CU  RCC and RCC2 fields */
+#define __RCC_XTAL(rcc)        (((rcc) >> 6) & 0x1f)
+#define __RCC_OSCSRC(rcc)      (((rcc) >> 4) & 0x03)
+#define __RCC_BYPASS           (1ul << 11)
+#define __RCC_USESYSDIV        (1ul << 22)
+#define __RCC_SYSDIV(rcc)      (((rcc) >> 23) & 0x0f)
+#define __RCC2_USERCC2         (1ul << 31)
+#define __RCC2_DIV400          (1ul << 30)
+#define __RCC2_OSCSRC2(rcc2)   (((rcc2) >> 4) & 0x07)
+#define __RCC2_BYPASS2         (1ul << 11)
+#define __RCC2_SYSDIV2(rcc2)   (((rcc2) >> 23) & 0x3f)
+#define __RCC2_SYSDIV2LSB      (1ul << 22)
+
+/* CU  crystal frequencies selected by RCC.XTAL, starting at 0x06 */
+static const uint32_t __XTAL_CLOCK[] =
+{
+   4000000ul,  4096000ul,  4915200ul,  5000000ul,  5120000ul,  6000000ul,
+   6144000ul,  7372800ul,  8000000ul,  8192000ul, 10000000ul, 12000000ul,
+  12288000ul, 13560000ul, 14318180ul, 16000000ul, 16384000ul, 18000000ul,
+  20000000ul, 24000000ul, 25000000ul
+};
+
 
 /*----------------------------------------------------------------------------
   Clock Variable definitions
@@ -45,9 +74,57 @@ uint32_t SystemCoreClock = __SYSTEM_CLOCK; /*!< System Clock Frequency (Core Clo
  *----------------------------------------------------------------------------*/
 void SystemCoreClockUpdate (void)            /* Get Core Clock Frequency      */
 {
-  /* TODO: Updates required to fully work with TM4C123 series devices */
-  SystemCoreClock = __SYSTEM_CLOCK;
+  /* CU  OLD: SystemCoreClock = __SYSTEM_CLOCK;
+     The clock is worked out from RCC and RCC2, RCC2 taking over when USERCC2
+     is set, the same way SysCtlClockGet does.  The PLL always runs at
+     400 MHz and is divided by 2 unless DIV400 is set. */
+  uint32_t rcc, rcc2, clock, src, xtal;
+
+  rcc = SYSCTL->RCC;
+  rcc2 = SYSCTL->RCC2;
+
+  src = (rcc2 & __RCC2_USERCC2) ? __RCC2_OSCSRC2(rcc2) : __RCC_OSCSRC(rcc);
+  switch (src) {
+    case 0:                                  /* main oscillator             */
+      xtal = __RCC_XTAL(rcc);
+      clock = ((xtal >= 0x06) && ((xtal - 0x06) < (sizeof(__XTAL_CLOCK) /
+                                                   sizeof(__XTAL_CLOCK[0])))) ?
+              __XTAL_CLOCK[xtal - 0x06] : __SYSTEM_CLOCK;
+      break;
+    case 1:                                  /* precision internal osc.     */
+      clock = __PIOSC_CLOCK;
+      break;
+    case 2:                                  /* precision internal osc. / 4 */
+      clock = __PIOSC_CLOCK / 4;
+      break;
+    case 3:                                  /* low-frequency internal osc. */
+      clock = __LFIOSC_CLOCK;
+      break;
+    default:                                 /* 32.768 kHz hibernate osc.   */
+      clock = __HIB_CLOCK;
+      break;
+  }
+
+  if (rcc2 & __RCC2_USERCC2) {
+    if (!(rcc2 & __RCC2_BYPASS2)) {
+      clock = (rcc2 & __RCC2_DIV400) ? __PLL_CLOCK : (__PLL_CLOCK / 2);
+    }
+    if ((rcc2 & __RCC2_DIV400) && !(rcc2 & __RCC2_BYPASS2)) {
+      clock /= (((__RCC2_SYSDIV2(rcc2) << 1) |
+                 ((rcc2 & __RCC2_SYSDIV2LSB) ? 1 : 0)) + 1);
+    } else {
+      clock /= (__RCC2_SYSDIV2(rcc2) + 1);
+    }
+  } else {
+    if (!(rcc & __RCC_BYPASS)) {
+      clock = __PLL_CLOCK / 2;
+    }
+    if (rcc & __RCC_USESYSDIV) {
+      clock /= (__RCC_SYSDIV(rcc) + 1);
+    }
+  }
 
+  SystemCoreClock = clock;
 }
 
 /**
@@ -71,6 +148,8 @@ void SystemInit (void)
   SCB->CCR |= SCB_CCR_UNALIGN_TRP_Msk;
 #endif
 
-  SystemCoreClock = __SYSTEM_CLOCK;
+  /* CU  OLD: SystemCoreClock = __SYSTEM_CLOCK;
+     The clock is left as reset leaves it; clock.c brings up the PLL. */
+  SystemCoreClockUpdate();
 
 }
@@ -232,6 +232,25 @@ Reset_Handler   PROC
                 EXPORT  Reset_Handler             [WEAK]
                 IMPORT  SystemInit
                 IMPORT  __main
+                IMPORT  |Load$$RW_RAMFUNC$$Base|
+                IMPORT  |Image$$RW_RAMFUNC$$Base|
+                IMPORT  |Image$$RW_RAMFUNC$$Length|
+
+; Copy the SRAM-resident kernels (the .ramfunc section, see Lab5.sct) out of
+; flash first, so that they can be called from SystemInit on.  __main does
+; not know they have been copied and copies them again, which is harmless.
+
+                LDR     R0, =|Load$$RW_RAMFUNC$$Base|
+                LDR     R1, =|Image$$RW_RAMFUNC$$Base|
+                LDR     R2, =|Image$$RW_RAMFUNC$$Length|
+                ADDS    R2, R2, #3
+                LSRS    R2, R2, #2
+                BEQ     RamFuncDone
+RamFuncCopy     LDR     R3, [R0], #4
+                STR     R3, [R1], #4
+                SUBS    R2, R2, #1
+                BNE     RamFuncCopy
+RamFuncDone
                 LDR     R0, =SystemInit
                 BLX     R0
                 LDR     R0, =__main
@@ -30,6 +30,10 @@
 #include "WM8731_Test.h"
 #include <built_in.h>
 #include "__Lib_MmcFat16.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include "ring.h"
+#include "wav_riff.h"
 /**************************************************************************************************
 * MMC Chip Select connection
 **************************************************************************************************/
@@ -41,11 +45,14 @@ sbit MMC_Chip_Select_Direction  at TRISG9_bit;
 **************************************************************************************************/
 char filename[12] = "sound.wav";
 
-struct MyRouundBuffer {
-  char buffer[1024];
-  unsigned int buf_in;
-  unsigned int buf_out;
-} RBuff;
+// Sample ring between the card reader (main loop) and the SPI interrupt.
+// The size must be a power of two.
+uint8_t RBuffData[1024];
+tRing RBuff;
+
+// The start of the file, for the header, and the layout found in it.
+uint8_t WavHeader[512];
+tWavInfo WavInfo;
 
 char ucWM8731_run_test;
 
@@ -110,16 +117,15 @@ void DrawWM8731Scr(){
 **************************************************************************************************/
 void Spi_Output() iv IVT_SPI_1 ilevel 7 ics ICS_SRS {
   char i;
+  uint8_t word[4];
   unsigned long int temp;
 
   if (SPI1TXIF_bit == 1) {            // 32bits were transmited
-    temp = 0;                         // Reset temp
-    for (i = 1; i < 5; i ++){         // Read four bytes from buffer
-      temp = temp << 8;               // And make 32bit data
-      temp = temp | RBuff.buffer[RBuff.buf_out];
-      RBuff.buf_out ++;               // Increment buffer pointer
-      if (RBuff.buf_out == 1023)        // Check if the buffer pointer is at the end of buffer
-        RBuff.buf_out = 0;            // If so reset to first byte in buffer
+    temp = 0;                         // Send silence if the ring runs dry
+    if (RingUsed(&RBuff) >= 4){       // Read four bytes from buffer
+      RingRead(&RBuff, word, 4);
+      for (i = 0; i < 4; i ++)        // And make 32bit data
+        temp = (temp << 8) | word[i];
     }
     
     SPI1BUF = temp;                   // Send temp to SPI1BUF
@@ -159,57 +165,52 @@ void SPI1_Init_FrameMode(){
 /**************************************************************************************************
 * Function GetFileHeader
 * -------------------------------------------------------------------------------------------------
-* Overview: Function reads header from wmv file and displays it on TFT
+* Overview: Function reads header from wav file, walking its chunks, and displays it on TFT
 * Input: Nothing
-* Output: Nothing
+* Output: 1 if the file can be played, 0 if not
 **************************************************************************************************/
-void GetFileHeader(){                 // Read file header according to Canonical Wave File Format
-unsigned long int temp;
+char GetFileHeader(){                 // Find the fmt and data chunks wherever they are
+unsigned long int size, i;
 char TempString[11];
 char TempString1[22];
-char character;
-     
+
   TFT_Set_Font(Verdana12x13_Regular, CL_BLACK, FO_HORIZONTAL);
-  
-  MMC_Fat_Seek(22);  // Set pointer to appropriate position in file
-  
-  Mmc_Fat_Read(&character);             // Display No. of channels info
-  temp = character;
-  Mmc_Fat_Read(&character);
-  temp += character << 8;
-  wordtostr(temp, TempString);
+
+  size = Mmc_Fat_Get_File_Size();     // Read the first sector of the file
+  if (size > sizeof(WavHeader))
+    size = sizeof(WavHeader);
+  MMC_Fat_Seek(0);
+  for (i = 0; i < size; i ++)
+    Mmc_Fat_Read((char *)&WavHeader[i]);
+
+  if (WavRiffParse(WavHeader, size, &WavInfo) != WAV_RIFF_OK){
+    TFT_Write_Text("Not a supported wav file", 50, 120);
+    TFT_Set_Font(TFT_defaultFont, CL_BLACK, FO_HORIZONTAL);
+    return 0;
+  }
+
+  wordtostr(WavInfo.ui32Channels, TempString);  // Display No. of channels info
   TempString1[0] = 0;
   strcat(TempString1, "No. of channels: ");
   strcat(TempString1, TempString);
   TFT_Write_Text(TempString1, 50, 120);
-  
-  Mmc_Fat_Read(&character);             // Display sample rate info
-  temp = character;
-  Mmc_Fat_Read(&character);
-  temp += character << 8;
-  Mmc_Fat_Read(&character);
-  temp += character << 8;
-  Mmc_Fat_Read(&character);
-  temp += character << 8;
-  longwordtostr(temp, TempString);
+
+  longwordtostr(WavInfo.ui32Rate, TempString);  // Display sample rate info
   TempString1[0] = 0;
   strcat(TempString1, "sample rate: ");
   strcat(TempString1, TempString);
   TFT_Write_Text(TempString1, 50, 140);
-  
-  MMC_Fat_Seek(MMC_Fat_Tell() + 6);
-  
-  Mmc_Fat_Read(&character);             // Display bit sample info
-  temp = character;
-  Mmc_Fat_Read(&character);
-  temp += character << 8;
-  wordtostr(temp, TempString);
+
+  wordtostr(WavInfo.ui32Bits, TempString);      // Display bit sample info
   TempString1[0] = 0;
   strcat(TempString1, "bits per sample: ");
   strcat(TempString1, TempString);
   TFT_Write_Text(TempString1, 50, 160);
-  
+
   TFT_Set_Font(TFT_defaultFont, CL_BLACK, FO_HORIZONTAL);
+
+  // The codec is set up for 16-bit words, which are sent as they are
+  return ((WavInfo.ui32Format == WAV_FORMAT_PCM) && (WavInfo.ui32Bits == 16));
 }
 
 /**************************************************************************************************
@@ -223,17 +224,17 @@ char character;
 void WM8731_Play(){
 unsigned long int size;
 char character;
+uint8_t *span;
+unsigned long int i, n;
 
-  size = Mmc_Fat_Get_File_Size();     // Get file size
-  size = size - 44;                   // Header is 44 bytes
-  MMC_Fat_Seek(45);                   // Position pointer on next byte (here starts music)
+  size = WavInfo.ui32DataSize;        // Get sample data size
+  MMC_Fat_Seek(WavInfo.ui32DataOffset);  // Position pointer on the first sample
 
-  RBuff.buf_in = 0;                   // Reset buffer to the start
-  RBuff.buf_out = 0;                  // Reset output buffer pointer to the start
+  RingInit(&RBuff, RBuffData, sizeof(RBuffData));
 
-  while (RBuff.buf_in < 511){         // Load first 512 bytes to the buffer
+  while ((RingUsed(&RBuff) < 512) && (size > 0)){  // Load first 512 bytes to the buffer
     Mmc_Fat_Read(&character);
-    RBuff.buffer[RBuff.buf_in ++] = character;
+    RingWrite(&RBuff, (uint8_t *)&character, 1);
     size --;
   }
   
@@ -242,15 +243,17 @@ char character;
   WM8731_Activate();
 
   while (size > 0){
-    if (RBuff.buf_in != RBuff.buf_out) {
-      Mmc_Fat_Read(&character);       // Load new value to buffer
-      RBuff.buffer[RBuff.buf_in ++] = character;
-      if (RBuff.buf_in == 1023)
-        RBuff.buf_in = 0;
-
-    size --;
-    }
+    n = RingWriteSpanGet(&RBuff, &span);  // Fill the free space in one go
+    if (n > size)
+      n = size;
+    for (i = 0; i < n; i ++)
+      Mmc_Fat_Read((char *)&span[i]);  // Load new values to buffer
+    RingWriteCommit(&RBuff, n);       // And hand them to the interrupt
+    size -= n;
   }
+
+  while (RingUsed(&RBuff) >= 4)       // Let the buffered samples play out
+    ;
   
   // Stop Playing
   WM8731_Deactivate();
@@ -278,14 +281,16 @@ char fileHandle;
     TFT_Write_Text("2. File Assigned", 30, 80);
 
     TFT_Write_Text("3. Get file header:", 30, 100);
-    GetFileHeader();                                   // Read header of wav file
-    
-    TFT_Write_Text("4. Play audio... :)", 30, 180);
-    WM8731_Play();                                     // Play music
-    
-    TFT_Write_Text("5. End.", 30, 200);
+    if (GetFileHeader()) {                             // Read header of wav file
+      TFT_Write_Text("4. Play audio... :)", 30, 180);
+      WM8731_Play();                                   // Play music
+
+      TFT_Write_Text("5. End.", 30, 200);
 
-    *test = 1;
+      *test = 1;
+    }
+    else
+      *test = 2;
   }
   else{
     TFT_Write_Text("2. File Not Found", 30, 80);
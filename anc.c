@@ -0,0 +1,600 @@
+//*****************************************************************************
+//
+// anc.c - Adaptive noise canceller engine.
+//
+// A frame-based LMS canceller modelled on Adaptive_Noise.slx.  The primary
+// input carries the wanted signal plus noise, the reference input carries a
+// correlated copy of the noise, and the output is the LMS error, i.e. the
+// primary with the noise estimate removed.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <string.h>
+#include "dsp_q15.h"
+#include "anc.h"
+#include "perf.h"
+#include "ramfunc.h"
+
+//*****************************************************************************
+//
+//! \addtogroup anc_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The number of history samples kept at the head of the reference delay line.
+//
+//*****************************************************************************
+#define ANC_HISTORY             (ANC_NUM_TAPS - 1)
+
+//*****************************************************************************
+//
+// The right shift that takes a 32-bit codec word to Q15 in ANC_MODE_Q15, and
+// the largest block exponent used in ANC_MODE_BFP.
+//
+//*****************************************************************************
+#define ANC_SHIFT_Q15           16
+
+//*****************************************************************************
+//
+// The placement of the LMS kernel.
+//
+//*****************************************************************************
+#if ANC_KERNEL_IN_RAM
+#define ANC_KERNEL              RAMFUNC
+#else
+#define ANC_KERNEL
+#endif
+
+//*****************************************************************************
+//
+// Rescales the delay line history to a new block exponent.
+//
+// The caller guarantees that the history fits at the new exponent; see
+// ANCBlockShiftGet().
+//
+//*****************************************************************************
+static void
+ANCShiftSet(tANCState *psState, uint32_t ui32Shift)
+{
+    uint32_t ui32Idx;
+    int32_t i32Delta;
+
+    i32Delta = (int32_t)ui32Shift - (int32_t)psState->ui32Shift;
+    if(i32Delta > 0)
+    {
+        for(ui32Idx = 0; ui32Idx < ANC_HISTORY; ui32Idx++)
+        {
+            psState->pi16Ref[ui32Idx] >>= i32Delta;
+        }
+    }
+    else if(i32Delta < 0)
+    {
+        for(ui32Idx = 0; ui32Idx < ANC_HISTORY; ui32Idx++)
+        {
+            psState->pi16Ref[ui32Idx] =
+                DSPSat16((int32_t)psState->pi16Ref[ui32Idx] << -i32Delta);
+        }
+    }
+    psState->ui32Shift = ui32Shift;
+}
+
+//*****************************************************************************
+//
+// Computes the shared block exponent for a frame of codec words.
+//
+// All sample magnitudes of both inputs, plus those of the previous reference
+// frame still held in the delay line, are folded into one word so that a
+// single CLZ gives the number of redundant sign bits of the whole block.  One
+// bit of headroom is kept below Q15 full scale for the LMS error, and the
+// shift is capped at the plain Q15 truncation so that full-scale input
+// behaves exactly as in ANC_MODE_Q15.
+//
+//*****************************************************************************
+static uint32_t
+ANCBlockShiftGet(tANCState *psState, const int32_t *pi32Primary,
+                 const int32_t *pi32Ref)
+{
+    uint32_t ui32Idx, ui32Mag, ui32RefMag;
+    int32_t i32Shift;
+
+    ui32Mag = 0;
+    ui32RefMag = 0;
+    for(ui32Idx = 0; ui32Idx < ANC_FRAME_SIZE; ui32Idx++)
+    {
+        ui32Mag |= (uint32_t)(pi32Primary[ui32Idx] ^
+                              (pi32Primary[ui32Idx] >> 31));
+        ui32RefMag |= (uint32_t)(pi32Ref[ui32Idx] ^ (pi32Ref[ui32Idx] >> 31));
+    }
+
+    //
+    // Fold in the previous reference frame, then remember this one for the
+    // next call.
+    //
+    ui32Mag |= ui32RefMag | psState->ui32PrevMag;
+    psState->ui32PrevMag = ui32RefMag;
+
+    //
+    // The magnitude occupies 32 - clz bits; keep 14 of them (one bit of
+    // headroom plus the sign) in the Q15 word.
+    //
+    i32Shift = 32 - (int32_t)DSPCountLeadingZeros(ui32Mag) - 14;
+    if(i32Shift < 0)
+    {
+        i32Shift = 0;
+    }
+    if(i32Shift > ANC_SHIFT_Q15)
+    {
+        i32Shift = ANC_SHIFT_Q15;
+    }
+    return((uint32_t)i32Shift);
+}
+
+//*****************************************************************************
+//
+// The Q15 LMS kernel.  Filters the reference frame already placed in the
+// delay line, subtracts the estimate from the primary frame and adapts the
+// weights, writing the error frame to pi16Out.  The delay line is advanced
+// for the next frame on return.
+//
+//*****************************************************************************
+static void ANC_KERNEL
+ANCKernel(tANCState *psState, const int16_t *pi16Primary, int16_t *pi16Out)
+{
+    uint32_t ui32N, ui32K, ui32InEnergy, ui32OutEnergy;
+    int64_t i64Acc;
+    int32_t i32MuErr;
+    int16_t i16Err;
+    const int16_t *pi16X;
+
+    ui32InEnergy = 0;
+    ui32OutEnergy = 0;
+    for(ui32N = 0; ui32N < ANC_FRAME_SIZE; ui32N++)
+    {
+        //
+        // pi16X[-k] is x(n - k).
+        //
+        pi16X = &psState->pi16Ref[ui32N + ANC_HISTORY];
+
+        //
+        // Noise estimate y(n) = sum w(k) x(n - k), accumulated in Q30.  Each
+        // product reaches 2^30 with the inputs near full scale, as block
+        // floating point leaves them, so the sum is kept in 64 bits (an
+        // SMLAL per tap).
+        //
+        i64Acc = 0;
+        for(ui32K = 0; ui32K < ANC_NUM_TAPS; ui32K++)
+        {
+            i64Acc += (int32_t)(int16_t)(psState->pi32Weight[ui32K] >> 16) *
+                      pi16X[-(int32_t)ui32K];
+        }
+
+        //
+        // e(n) = d(n) - y(n).  y(n) in Q15 is within ANC_NUM_TAPS times full
+        // scale, so it fits 32 bits.
+        //
+        i16Err = DSPSat16((int32_t)pi16Primary[ui32N] -
+                          (int32_t)(i64Acc >> 15));
+        ui32InEnergy +=
+            ((int32_t)pi16Primary[ui32N] * pi16Primary[ui32N]) >> 8;
+        ui32OutEnergy += ((int32_t)i16Err * i16Err) >> 8;
+        pi16Out[ui32N] = i16Err;
+
+        //
+        // w(k) += mu e(n) x(n - k).  mu e(n) is Q30; the product with the Q15
+        // sample is brought back to the Q31 weight format.
+        //
+        i32MuErr = (int32_t)psState->i16Mu * i16Err;
+        for(ui32K = 0; ui32K < ANC_NUM_TAPS; ui32K++)
+        {
+            psState->pi32Weight[ui32K] =
+                DSPQAdd32(psState->pi32Weight[ui32K],
+                          (int32_t)(((int64_t)i32MuErr *
+                                     pi16X[-(int32_t)ui32K]) >> 14));
+        }
+    }
+
+    //
+    // Track the frame energies with a one-pole smoother, 1/8 per frame.
+    //
+    psState->ui32PrimaryEnergy +=
+        (int32_t)((ui32InEnergy / ANC_FRAME_SIZE) -
+                  psState->ui32PrimaryEnergy) >> 3;
+    psState->ui32ErrorEnergy +=
+        (int32_t)((ui32OutEnergy / ANC_FRAME_SIZE) -
+                  psState->ui32ErrorEnergy) >> 3;
+
+    //
+    // Keep the newest ANC_HISTORY reference samples for the next frame.
+    //
+    memmove(psState->pi16Ref, &psState->pi16Ref[ANC_FRAME_SIZE],
+            ANC_HISTORY * sizeof(int16_t));
+}
+
+//*****************************************************************************
+//
+//! Initializes a canceller instance.
+//!
+//! \param psState is a pointer to the canceller state.
+//! \param ui32Mode is the processing mode, one of \b ANC_MODE_Q15 or
+//! \b ANC_MODE_BFP.
+//!
+//! The weights are set to the initial condition \b ANC_IC and the delay line
+//! is cleared.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ANCInit(tANCState *psState, uint32_t ui32Mode)
+{
+    uint32_t ui32Idx;
+
+    memset(psState, 0, sizeof(tANCState));
+    for(ui32Idx = 0; ui32Idx < ANC_NUM_TAPS; ui32Idx++)
+    {
+        psState->pi32Weight[ui32Idx] = (int32_t)(ANC_IC * 2147483648.0);
+    }
+    psState->i16Mu = Q15(ANC_MU);
+    psState->ui32Mode = ui32Mode;
+    psState->ui32Shift = ANC_SHIFT_Q15;
+}
+
+//*****************************************************************************
+//
+//! Changes the processing mode of a running canceller.
+//!
+//! \param psState is a pointer to the canceller state.
+//! \param ui32Mode is the new mode, one of \b ANC_MODE_Q15 or
+//! \b ANC_MODE_BFP.
+//!
+//! The weights are kept.  When leaving block floating-point mode the delay
+//! line is rescaled back to plain Q15.  When entering it, the first block
+//! exponent is held at plain Q15 since the magnitude of the history is not
+//! known.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ANCModeSet(tANCState *psState, uint32_t ui32Mode)
+{
+    if(ui32Mode == ANC_MODE_Q15)
+    {
+        ANCShiftSet(psState, ANC_SHIFT_Q15);
+    }
+    else if(psState->ui32Mode != ANC_MODE_BFP)
+    {
+        psState->ui32PrevMag = 0xffffffff;
+    }
+    psState->ui32Mode = ui32Mode;
+}
+
+//*****************************************************************************
+//
+//! Clears the reference history of a canceller.
+//!
+//! \param psState is a pointer to the canceller state.
+//!
+//! The delay line is cleared, and with it the magnitude of the previous frame
+//! that the block exponent covers.  The weights, the mode and the energies
+//! are kept, so a canceller that resumes after frames it did not see starts
+//! from its converged solution without filtering reference samples from
+//! before the gap.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ANCReset(tANCState *psState)
+{
+    memset(psState->pi16Ref, 0, sizeof(psState->pi16Ref));
+    psState->ui32PrevMag = 0;
+}
+
+//*****************************************************************************
+//
+//! Processes one frame of Q15 samples.
+//!
+//! \param psState is a pointer to the canceller state.
+//! \param pi16Primary points to \b ANC_FRAME_SIZE primary (signal plus
+//! noise) samples.
+//! \param pi16Ref points to \b ANC_FRAME_SIZE noise reference samples.
+//! \param pi16Out points to the buffer that receives \b ANC_FRAME_SIZE
+//! canceller output samples.  It may alias \e pi16Primary.
+//!
+//! This is the bare Q15 path with no block scaling; the mode setting is
+//! ignored.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ANCProcessFrameQ15(tANCState *psState, const int16_t *pi16Primary,
+                   const int16_t *pi16Ref, int16_t *pi16Out)
+{
+    memcpy(&psState->pi16Ref[ANC_HISTORY], pi16Ref,
+           ANC_FRAME_SIZE * sizeof(int16_t));
+    ANCKernel(psState, pi16Primary, pi16Out);
+}
+
+//*****************************************************************************
+//
+//! Processes one frame of Q15 samples taken from interleaved frames.
+//!
+//! \param psState is a pointer to the canceller state.
+//! \param pi16Primary points to the first primary sample.
+//! \param pi16Ref points to the first noise reference sample.
+//! \param ui32Stride is the distance in samples from one primary or
+//! reference sample to the next, the number of channels of the frames.
+//! \param pi16Out points to the buffer that receives \b ANC_FRAME_SIZE
+//! canceller output samples, one after the other.
+//!
+//! This is ANCProcessFrameQ15() for inputs that are not yet split into
+//! channels.  The reference samples go straight into the delay line and the
+//! primary samples into \e pi16Out, where the kernel works on them in place,
+//! so no other buffer is needed.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ANCProcessFrameQ15Strided(tANCState *psState, const int16_t *pi16Primary,
+                          const int16_t *pi16Ref, uint32_t ui32Stride,
+                          int16_t *pi16Out)
+{
+    uint32_t ui32Idx;
+
+    for(ui32Idx = 0; ui32Idx < ANC_FRAME_SIZE; ui32Idx++)
+    {
+        pi16Out[ui32Idx] = *pi16Primary;
+        psState->pi16Ref[ANC_HISTORY + ui32Idx] = *pi16Ref;
+        pi16Primary += ui32Stride;
+        pi16Ref += ui32Stride;
+    }
+    ANCKernel(psState, pi16Out, pi16Out);
+}
+
+//*****************************************************************************
+//
+//! Processes one frame of 32-bit codec words.
+//!
+//! \param psState is a pointer to the canceller state.
+//! \param pi32Primary points to \b ANC_FRAME_SIZE primary samples, full
+//! scale at 32 bits.
+//! \param pi32Ref points to \b ANC_FRAME_SIZE noise reference samples.
+//! \param pi32Out points to the buffer that receives \b ANC_FRAME_SIZE
+//! output samples.  It may alias \e pi32Primary.
+//!
+//! In \b ANC_MODE_Q15 the words are truncated to their upper 16 bits.  In
+//! \b ANC_MODE_BFP a shared exponent is chosen for the frame so that the
+//! loudest sample sits just below Q15 full scale; the Q15 kernel runs on the
+//! normalized block and the output is scaled back by the same exponent.
+//! Because both inputs share the exponent the weights are unaffected by it.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ANCProcessFrame(tANCState *psState, const int32_t *pi32Primary,
+                const int32_t *pi32Ref, int32_t *pi32Out)
+{
+    int16_t pi16Primary[ANC_FRAME_SIZE];
+    uint32_t ui32Idx, ui32Shift;
+
+    if(psState->ui32Mode == ANC_MODE_BFP)
+    {
+        ANCShiftSet(psState, ANCBlockShiftGet(psState, pi32Primary, pi32Ref));
+    }
+    ui32Shift = psState->ui32Shift;
+
+    for(ui32Idx = 0; ui32Idx < ANC_FRAME_SIZE; ui32Idx++)
+    {
+        pi16Primary[ui32Idx] = (int16_t)(pi32Primary[ui32Idx] >> ui32Shift);
+        psState->pi16Ref[ANC_HISTORY + ui32Idx] =
+            (int16_t)(pi32Ref[ui32Idx] >> ui32Shift);
+    }
+
+    ANCKernel(psState, pi16Primary, pi16Primary);
+
+    for(ui32Idx = 0; ui32Idx < ANC_FRAME_SIZE; ui32Idx++)
+    {
+        pi32Out[ui32Idx] = (int32_t)((uint32_t)(int32_t)pi16Primary[ui32Idx] <<
+                                     ui32Shift);
+    }
+}
+
+//*****************************************************************************
+//
+//! Copies out the adaptive weights.
+//!
+//! \param psState is a pointer to the canceller state.
+//! \param pi32Weight points to the buffer that receives \b ANC_NUM_TAPS
+//! weights in Q31.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ANCWeightsGet(tANCState *psState, int32_t *pi32Weight)
+{
+    memcpy(pi32Weight, psState->pi32Weight, sizeof(psState->pi32Weight));
+}
+
+//*****************************************************************************
+//
+//! Loads a set of adaptive weights, e.g. a previously converged solution.
+//!
+//! \param psState is a pointer to the canceller state.
+//! \param pi32Weight points to \b ANC_NUM_TAPS weights in Q31.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ANCWeightsSet(tANCState *psState, const int32_t *pi32Weight)
+{
+    memcpy(psState->pi32Weight, pi32Weight, sizeof(psState->pi32Weight));
+}
+
+//*****************************************************************************
+//
+//! Sets the sample rate of a canceller, rescaling its weights.
+//!
+//! \param psState is a pointer to the canceller state.
+//! \param ui32Rate is the new sample rate in Hz.
+//!
+//! The weights are an impulse response sampled at the old rate.  They are
+//! resampled to the new rate by linear interpolation and scaled by the rate
+//! ratio, so the filter keeps its frequency response up to the lower of the
+//! two Nyquist frequencies and the canceller carries on from where it was
+//! instead of starting over.  Taps that fall beyond the old response are
+//! zeroed, and weights that no longer fit in Q31 are saturated.
+//!
+//! If the canceller has no rate yet, the rate is recorded and the weights are
+//! left alone.  A rate of zero is ignored.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ANCRateSet(tANCState *psState, uint32_t ui32Rate)
+{
+    int32_t pi32Old[ANC_NUM_TAPS];
+    float fRatio, fPos, fFrac, fWeight;
+    uint32_t ui32Idx, ui32Tap;
+
+    if((ui32Rate == 0) || (ui32Rate == psState->ui32Rate))
+    {
+        return;
+    }
+    if(psState->ui32Rate == 0)
+    {
+        psState->ui32Rate = ui32Rate;
+        return;
+    }
+
+    //
+    // Tap k at the new rate lies at k * fRatio taps of the old response.
+    //
+    fRatio = (float)psState->ui32Rate / (float)ui32Rate;
+    memcpy(pi32Old, psState->pi32Weight, sizeof(pi32Old));
+    for(ui32Idx = 0; ui32Idx < ANC_NUM_TAPS; ui32Idx++)
+    {
+        fPos = (float)ui32Idx * fRatio;
+        ui32Tap = (uint32_t)fPos;
+        fFrac = fPos - (float)ui32Tap;
+        fWeight = 0.0f;
+        if(ui32Tap < ANC_NUM_TAPS)
+        {
+            fWeight = (1.0f - fFrac) * (float)pi32Old[ui32Tap];
+            if((ui32Tap + 1) < ANC_NUM_TAPS)
+            {
+                fWeight += fFrac * (float)pi32Old[ui32Tap + 1];
+            }
+        }
+        fWeight *= fRatio;
+
+        if(fWeight >= 2147483520.0f)
+        {
+            psState->pi32Weight[ui32Idx] = 0x7fffff80;
+        }
+        else if(fWeight <= -2147483648.0f)
+        {
+            psState->pi32Weight[ui32Idx] = (int32_t)0x80000000;
+        }
+        else
+        {
+            psState->pi32Weight[ui32Idx] = (int32_t)fWeight;
+        }
+    }
+    psState->ui32Rate = ui32Rate;
+}
+
+//*****************************************************************************
+//
+// The state of ANCBenchmark() between its steps.
+//
+//*****************************************************************************
+typedef struct
+{
+    tANCState sState;
+    uint32_t ui32Mode;
+    int32_t *pi32Scratch;
+}
+tANCBenchmark;
+
+//*****************************************************************************
+//
+// Starts a fresh canceller on the test signal for one run of ANCBenchmark().
+// The primary input is the reference at half its level.
+//
+//*****************************************************************************
+static void
+ANCBenchmarkSetup(void *pvArg)
+{
+    tANCBenchmark *psBench;
+    uint32_t ui32Idx;
+    int32_t i32Value;
+
+    psBench = (tANCBenchmark *)pvArg;
+    ANCInit(&psBench->sState, psBench->ui32Mode);
+    for(ui32Idx = 0; ui32Idx < ANC_FRAME_SIZE; ui32Idx++)
+    {
+        i32Value = PerfPatternGet(ui32Idx);
+        psBench->pi32Scratch[ui32Idx] = (i32Value * 65536) / 2;
+        psBench->pi32Scratch[ANC_FRAME_SIZE + ui32Idx] = i32Value * 65536;
+    }
+}
+
+//*****************************************************************************
+//
+// Runs the frame timed by ANCBenchmark().
+//
+//*****************************************************************************
+static void
+ANCBenchmarkFrame(void *pvArg)
+{
+    tANCBenchmark *psBench;
+
+    psBench = (tANCBenchmark *)pvArg;
+    ANCProcessFrame(&psBench->sState, psBench->pi32Scratch,
+                    &psBench->pi32Scratch[ANC_FRAME_SIZE],
+                    psBench->pi32Scratch);
+}
+
+//*****************************************************************************
+//
+//! Measures the cost of one canceller frame.
+//!
+//! \param ui32Mode is the processing mode, one of \b ANC_MODE_Q15 or
+//! \b ANC_MODE_BFP.
+//! \param pi32Scratch points to a buffer of 2 \b ANC_FRAME_SIZE words.
+//!
+//! ANCProcessFrame() is timed with PerfBenchmarkRun() on the full-scale test
+//! signal, with a fresh canceller for each run.  Building with
+//! \b ANC_KERNEL_IN_RAM set each way compares the kernel placements.
+//!
+//! \return Returns the cost of one frame.
+//
+//*****************************************************************************
+uint32_t
+ANCBenchmark(uint32_t ui32Mode, int32_t *pi32Scratch)
+{
+    tANCBenchmark sBench;
+
+    sBench.ui32Mode = ui32Mode;
+    sBench.pi32Scratch = pi32Scratch;
+
+    return(PerfBenchmarkRun(ANCBenchmarkSetup, ANCBenchmarkFrame, &sBench));
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
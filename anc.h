@@ -0,0 +1,141 @@
+//*****************************************************************************
+//
+// anc.h - Prototypes and state for the adaptive noise canceller engine.
+//
+//*****************************************************************************
+
+#ifndef __ANC_H__
+#define __ANC_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// Engine dimensions.  The tap count, step size and initial condition follow
+// the LMS block in Adaptive_Noise.slx (L = 20, mu = 0.002, ic = 0.02).
+//
+// The tap count must not exceed the frame size; block floating-point mode
+// relies on the delay line holding no samples older than the previous frame.
+//
+//*****************************************************************************
+#define ANC_FRAME_SIZE          64
+#define ANC_NUM_TAPS            20
+#define ANC_MU                  0.002
+#define ANC_IC                  0.02
+
+//*****************************************************************************
+//
+// Set to 1 to run the LMS kernel from SRAM, or 0 to leave it in flash.  See
+// ramfunc.h.
+//
+//*****************************************************************************
+#ifndef ANC_KERNEL_IN_RAM
+#define ANC_KERNEL_IN_RAM       1
+#endif
+
+//*****************************************************************************
+//
+// Values that can be passed to ANCInit() and ANCModeSet() as the ui32Mode
+// parameter.
+//
+//*****************************************************************************
+#define ANC_MODE_Q15            0x00000000  // Truncate codec words to Q15
+#define ANC_MODE_BFP            0x00000001  // Block floating-point
+
+//*****************************************************************************
+//
+// The state of one canceller instance.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The adaptive weights in Q31.  Only the upper half-word is used by the
+    // filter; the lower half accumulates updates smaller than one Q15 LSB.
+    //
+    int32_t pi32Weight[ANC_NUM_TAPS];
+
+    //
+    // The reference delay line in Q15: ANC_NUM_TAPS - 1 samples of history
+    // followed by the current frame.
+    //
+    int16_t pi16Ref[ANC_NUM_TAPS - 1 + ANC_FRAME_SIZE];
+
+    //
+    // The LMS step size in Q15.
+    //
+    int16_t i16Mu;
+
+    //
+    // The processing mode, one of ANC_MODE_Q15 or ANC_MODE_BFP.
+    //
+    uint32_t ui32Mode;
+
+    //
+    // The number of bits the current frame's codec words are shifted right to
+    // reach Q15.  Fixed at 16 in ANC_MODE_Q15; the shared block exponent in
+    // ANC_MODE_BFP.
+    //
+    uint32_t ui32Shift;
+
+    //
+    // The OR of the sign-folded magnitudes of the previous frame, used so
+    // that the block exponent also covers the history in the delay line.
+    //
+    uint32_t ui32PrevMag;
+
+    //
+    // Smoothed per-frame energies of the primary input and of the output, in
+    // Q15 squared and scaled down by 2^8.  Their ratio is the current
+    // cancellation depth.
+    //
+    uint32_t ui32PrimaryEnergy;
+    uint32_t ui32ErrorEnergy;
+
+    //
+    // The sample rate the weights were adapted at, or 0 if not yet known.
+    //
+    uint32_t ui32Rate;
+}
+tANCState;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern void ANCInit(tANCState *psState, uint32_t ui32Mode);
+extern void ANCModeSet(tANCState *psState, uint32_t ui32Mode);
+extern void ANCReset(tANCState *psState);
+extern void ANCProcessFrameQ15(tANCState *psState, const int16_t *pi16Primary,
+                               const int16_t *pi16Ref, int16_t *pi16Out);
+extern void ANCProcessFrameQ15Strided(tANCState *psState,
+                                      const int16_t *pi16Primary,
+                                      const int16_t *pi16Ref,
+                                      uint32_t ui32Stride, int16_t *pi16Out);
+extern void ANCProcessFrame(tANCState *psState, const int32_t *pi32Primary,
+                            const int32_t *pi32Ref, int32_t *pi32Out);
+extern void ANCWeightsGet(tANCState *psState, int32_t *pi32Weight);
+extern void ANCWeightsSet(tANCState *psState, const int32_t *pi32Weight);
+extern void ANCRateSet(tANCState *psState, uint32_t ui32Rate);
+extern uint32_t ANCBenchmark(uint32_t ui32Mode, int32_t *pi32Scratch);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __ANC_H__
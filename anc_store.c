@@ -0,0 +1,293 @@
+//*****************************************************************************
+//
+// anc_store.c - Persistence of converged canceller weights in EEPROM.
+//
+// A converged weight set is snapshotted periodically into the on-chip EEPROM
+// and loaded back at startup, so the canceller starts from its last solution
+// instead of the model's initial condition and cancels from the first frame.
+//
+// Every record carries a format version, a sequence number and a CRC-16.
+// Records are written to the next slot in a ring of slots, never in place,
+// so an interrupted write leaves the previous record intact and the EEPROM
+// wear is spread over all slots.  At startup the valid record with the
+// highest sequence number wins.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/eeprom.h"
+#include "driverlib/sw_crc.h"
+#include "anc.h"
+#include "anc_store.h"
+
+//*****************************************************************************
+//
+//! \addtogroup anc_store_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The record marker, "ANCW".
+//
+//*****************************************************************************
+#define ANC_STORE_MAGIC         0x57434e41
+
+//*****************************************************************************
+//
+// The seed used for the record CRC.
+//
+//*****************************************************************************
+#define ANC_STORE_CRC_SEED      0xffff
+
+//*****************************************************************************
+//
+// The EEPROM image of one snapshot.  All fields are whole words since the
+// EEPROM is accessed a word at a time.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t ui32Magic;
+    uint32_t ui32Version;
+    uint32_t ui32Sequence;
+    uint32_t ui32NumTaps;
+    uint32_t ui32Rate;
+    int32_t pi32Weight[ANC_NUM_TAPS];
+
+    //
+    // CRC-16 over all preceding fields, in the lower half-word.
+    //
+    uint32_t ui32Crc;
+}
+tANCStoreRecord;
+
+//*****************************************************************************
+//
+// A record must fit in its slot.
+//
+//*****************************************************************************
+typedef char
+    ANCStoreRecordFits[(sizeof(tANCStoreRecord) <=
+                        (ANC_STORE_SLOT_BLOCKS * 64)) ? 1 : -1];
+
+//*****************************************************************************
+//
+// Returns the EEPROM byte address of a slot.
+//
+//*****************************************************************************
+#define ANC_STORE_SLOT_ADDR(ui32Slot)                                         \
+        EEPROMAddrFromBlock(ANC_STORE_FIRST_BLOCK +                           \
+                            ((ui32Slot) * ANC_STORE_SLOT_BLOCKS))
+
+//*****************************************************************************
+//
+// Computes the CRC of a record.
+//
+//*****************************************************************************
+static uint16_t
+ANCStoreCrc(const tANCStoreRecord *psRecord)
+{
+    return(Crc16Slice4(ANC_STORE_CRC_SEED, (const uint8_t *)psRecord,
+                       sizeof(tANCStoreRecord) - sizeof(uint32_t)));
+}
+
+//*****************************************************************************
+//
+// Reads a slot and returns true if it holds a valid record of the current
+// format.
+//
+//*****************************************************************************
+static bool
+ANCStoreSlotRead(uint32_t ui32Slot, tANCStoreRecord *psRecord)
+{
+    EEPROMRead((uint32_t *)psRecord, ANC_STORE_SLOT_ADDR(ui32Slot),
+               sizeof(tANCStoreRecord));
+
+    return((psRecord->ui32Magic == ANC_STORE_MAGIC) &&
+           (psRecord->ui32Version == ANC_STORE_VERSION) &&
+           (psRecord->ui32NumTaps == ANC_NUM_TAPS) &&
+           (psRecord->ui32Crc == ANCStoreCrc(psRecord)));
+}
+
+//*****************************************************************************
+//
+//! Initializes the persistence layer and locates the newest record.
+//!
+//! \param psStore is a pointer to the persistence state.
+//!
+//! The EEPROM peripheral must already be enabled with
+//! SysCtlPeripheralEnable().  All slots are scanned once; the newest valid
+//! record is remembered for ANCStoreRestore() and the next snapshot goes to
+//! the slot after it.
+//!
+//! \return Returns \b ANC_STORE_OK, or \b ANC_STORE_ERROR if the EEPROM could
+//! not recover from an interrupted operation.
+//
+//*****************************************************************************
+uint32_t
+ANCStoreInit(tANCStore *psStore)
+{
+    tANCStoreRecord sRecord;
+    uint32_t ui32Slot;
+
+    psStore->ui32Slot = ANC_STORE_NUM_SLOTS;
+    psStore->ui32Sequence = 0;
+    psStore->ui32Frames = 0;
+    psStore->ui32Writes = 0;
+    psStore->ui32Errors = 0;
+
+    if(EEPROMInit() != EEPROM_INIT_OK)
+    {
+        return(ANC_STORE_ERROR);
+    }
+
+    for(ui32Slot = 0; ui32Slot < ANC_STORE_NUM_SLOTS; ui32Slot++)
+    {
+        if(!ANCStoreSlotRead(ui32Slot, &sRecord))
+        {
+            continue;
+        }
+
+        //
+        // Compare sequence numbers modulo 2^32 so that the ring keeps working
+        // across a wrap of the counter.
+        //
+        if((psStore->ui32Slot == ANC_STORE_NUM_SLOTS) ||
+           ((int32_t)(sRecord.ui32Sequence - psStore->ui32Sequence) > 0))
+        {
+            psStore->ui32Slot = ui32Slot;
+            psStore->ui32Sequence = sRecord.ui32Sequence;
+        }
+    }
+
+    return(ANC_STORE_OK);
+}
+
+//*****************************************************************************
+//
+//! Loads the newest stored weights into a canceller.
+//!
+//! \param psStore is a pointer to the persistence state.
+//! \param psState is a pointer to the canceller state, already initialized
+//! with ANCInit().
+//!
+//! Weights saved at another sample rate are rescaled to the canceller's
+//! current rate with ANCRateSet().
+//!
+//! \return Returns \b true if weights were restored, or \b false if no valid
+//! record exists and the canceller keeps its initial condition.
+//
+//*****************************************************************************
+bool
+ANCStoreRestore(tANCStore *psStore, tANCState *psState)
+{
+    tANCStoreRecord sRecord;
+    uint32_t ui32Rate;
+
+    if((psStore->ui32Slot == ANC_STORE_NUM_SLOTS) ||
+       !ANCStoreSlotRead(psStore->ui32Slot, &sRecord))
+    {
+        return(false);
+    }
+
+    ui32Rate = psState->ui32Rate;
+    ANCWeightsSet(psState, sRecord.pi32Weight);
+    psState->ui32Rate = sRecord.ui32Rate;
+    ANCRateSet(psState, ui32Rate);
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Writes a snapshot of the current weights.
+//!
+//! \param psStore is a pointer to the persistence state.
+//! \param psState is a pointer to the canceller state.
+//!
+//! The record goes to the slot after the newest one.  Programming blocks for
+//! several milliseconds, so this must be called from the main loop and never
+//! from the audio interrupt.  The weights may be adapting while they are
+//! copied; each word is read atomically and consecutive frames differ by far
+//! less than the snapshot is worth, so no locking is done.
+//!
+//! \return Returns \b true if the record was written and verified.
+//
+//*****************************************************************************
+bool
+ANCStoreSave(tANCStore *psStore, tANCState *psState)
+{
+    tANCStoreRecord sRecord, sVerify;
+    uint32_t ui32Slot;
+
+    ui32Slot = (psStore->ui32Slot < ANC_STORE_NUM_SLOTS) ?
+               ((psStore->ui32Slot + 1) % ANC_STORE_NUM_SLOTS) : 0;
+
+    sRecord.ui32Magic = ANC_STORE_MAGIC;
+    sRecord.ui32Version = ANC_STORE_VERSION;
+    sRecord.ui32Sequence = psStore->ui32Sequence + 1;
+    sRecord.ui32NumTaps = ANC_NUM_TAPS;
+    sRecord.ui32Rate = psState->ui32Rate;
+    ANCWeightsGet(psState, sRecord.pi32Weight);
+    sRecord.ui32Crc = ANCStoreCrc(&sRecord);
+
+    if((EEPROMProgram((uint32_t *)&sRecord, ANC_STORE_SLOT_ADDR(ui32Slot),
+                      sizeof(tANCStoreRecord)) != 0) ||
+       !ANCStoreSlotRead(ui32Slot, &sVerify) ||
+       (sVerify.ui32Sequence != sRecord.ui32Sequence))
+    {
+        //
+        // Leave the newest record where it was; the next attempt retries the
+        // same slot.
+        //
+        psStore->ui32Errors++;
+        return(false);
+    }
+
+    psStore->ui32Slot = ui32Slot;
+    psStore->ui32Sequence = sRecord.ui32Sequence;
+    psStore->ui32Writes++;
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Takes a periodic snapshot once the canceller has converged.
+//!
+//! \param psStore is a pointer to the persistence state.
+//! \param psState is a pointer to the canceller state.
+//!
+//! This function should be called from the main loop once per processed
+//! frame.  Every \b ANC_STORE_INTERVAL frames it saves the weights if the
+//! canceller is achieving at least the cancellation depth set by
+//! \b ANC_STORE_MIN_DEPTH_SHIFT, so a diverged or idle canceller never
+//! overwrites a good solution.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ANCStoreService(tANCStore *psStore, tANCState *psState)
+{
+    if(++psStore->ui32Frames < ANC_STORE_INTERVAL)
+    {
+        return;
+    }
+
+    if((psState->ui32PrimaryEnergy != 0) &&
+       (psState->ui32ErrorEnergy <=
+        (psState->ui32PrimaryEnergy >> ANC_STORE_MIN_DEPTH_SHIFT)))
+    {
+        ANCStoreSave(psStore, psState);
+    }
+    psStore->ui32Frames = 0;
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -0,0 +1,112 @@
+//*****************************************************************************
+//
+// anc_store.h - Prototypes for the canceller weight persistence layer.
+//
+//*****************************************************************************
+
+#ifndef __ANC_STORE_H__
+#define __ANC_STORE_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The EEPROM area used for weight snapshots.  Each slot holds one record and
+// spans ANC_STORE_SLOT_BLOCKS 64-byte EEPROM blocks; slots are written round
+// robin so that wear is spread over the whole area.  The default uses the
+// lower half of the 2 KB EEPROM on the TM4C123GH6PM.
+//
+//*****************************************************************************
+#define ANC_STORE_FIRST_BLOCK   0
+#define ANC_STORE_SLOT_BLOCKS   2
+#define ANC_STORE_NUM_SLOTS     8
+
+//*****************************************************************************
+//
+// The snapshot policy.  A snapshot is taken at most once every
+// ANC_STORE_INTERVAL codec frames (about a minute), and only when the
+// output energy is at least ANC_STORE_MIN_DEPTH_SHIFT binary orders of
+// magnitude (3 dB each) below the primary energy.
+//
+//*****************************************************************************
+#define ANC_STORE_INTERVAL      7000
+#define ANC_STORE_MIN_DEPTH_SHIFT                                             \
+                                3
+
+//*****************************************************************************
+//
+// The record format version.  Bump this whenever tANCStoreRecord or the
+// meaning of the stored weights changes; records of other versions are
+// ignored at restore.
+//
+//*****************************************************************************
+#define ANC_STORE_VERSION       2
+
+//*****************************************************************************
+//
+// Values returned by ANCStoreInit().
+//
+//*****************************************************************************
+#define ANC_STORE_OK            0
+#define ANC_STORE_ERROR         1
+
+//*****************************************************************************
+//
+// The state of the persistence layer.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The slot holding the newest valid record, or ANC_STORE_NUM_SLOTS if
+    // none was found.
+    //
+    uint32_t ui32Slot;
+
+    //
+    // The sequence number of the newest record.
+    //
+    uint32_t ui32Sequence;
+
+    //
+    // Frames since the last snapshot.
+    //
+    uint32_t ui32Frames;
+
+    //
+    // The number of snapshots written and the number of failed writes.
+    //
+    uint32_t ui32Writes;
+    uint32_t ui32Errors;
+}
+tANCStore;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern uint32_t ANCStoreInit(tANCStore *psStore);
+extern bool ANCStoreRestore(tANCStore *psStore, tANCState *psState);
+extern bool ANCStoreSave(tANCStore *psStore, tANCState *psState);
+extern void ANCStoreService(tANCStore *psStore, tANCState *psState);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __ANC_STORE_H__
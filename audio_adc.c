@@ -0,0 +1,411 @@
+//*****************************************************************************
+//
+// audio_adc.c - Reference microphone capture on the on-chip ADC.
+//
+// Timer 2A runs periodically at the codec rate and triggers ADC0 sample
+// sequencer 0 on every timeout.  The sequencer has a single step on AIN0
+// (PE3), and the ADC averages AUDIO_ADC_OVERSAMPLE conversions in hardware
+// into each sample.  The uDMA moves every sample from the sequencer FIFO
+// into a frame buffer in ping-pong mode, so the CPU does nothing per sample.
+// The primary and alternate control structures take turns over
+// AUDIO_ADC_NUM_BUFFERS frame buffers: whenever one finishes a frame the ADC
+// interrupt arms it for the frame after next.
+//
+// The ADC frames have the codec frame length and start with the codec
+// stream, but the timer runs from the system clock and the codec from its
+// own crystal.  AudioADCFrameGet() therefore pairs each codec frame with
+// the ADC frame that completed at about the same time, and holds that
+// pairing as the two clocks drift, slipping a frame whenever the ADC frame
+// it needs is not complete yet or has already been overwritten.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_adc.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/adc.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#include "driverlib/udma.h"
+#include "anc.h"
+#include "audio_in.h"
+#include "audio_ssi.h"
+#include "audio_adc.h"
+#include "clock.h"
+#include "dma.h"
+
+//*****************************************************************************
+//
+//! \addtogroup audio_adc_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// A frame must fit in one uDMA transfer, the ADC must keep up with the
+// averaging at the highest codec rate, and at least one complete frame must
+// be kept besides the two the uDMA is working on.
+//
+//*****************************************************************************
+typedef char
+    AudioADCFrameFits[(AUDIO_FRAME_SIZE <= 1024) ? 1 : -1];
+typedef char
+    AudioADCRateFits[((AUDIO_MAX_RATE * AUDIO_ADC_OVERSAMPLE) <= 1000000) ?
+                     1 : -1];
+typedef char
+    AudioADCRingFits[(AUDIO_ADC_NUM_BUFFERS >= 3) ? 1 : -1];
+
+//*****************************************************************************
+//
+// The number of complete frames kept.
+//
+//*****************************************************************************
+#define AUDIO_ADC_HISTORY       (AUDIO_ADC_NUM_BUFFERS - 2)
+
+//*****************************************************************************
+//
+// The uDMA buffers.
+//
+//*****************************************************************************
+static uint16_t g_ppui16AudioADC[AUDIO_ADC_NUM_BUFFERS][AUDIO_FRAME_SIZE];
+
+//*****************************************************************************
+//
+// The number of frames completed, the buffer holding the newest of them, and
+// the number of times the uDMA channel stopped for lack of an armed buffer.
+//
+//*****************************************************************************
+static volatile uint32_t g_ui32AudioADCFrames;
+static volatile uint32_t g_ui32AudioADCNewest;
+static volatile uint32_t g_ui32AudioADCOverruns;
+
+//*****************************************************************************
+//
+// The pairing of codec frames with ADC frames: the ADC frame count minus the
+// codec frame count, whether it has been set, and the number of slips.
+//
+//*****************************************************************************
+static uint32_t g_ui32AudioADCOffset;
+static bool g_bAudioADCAligned;
+static uint32_t g_ui32AudioADCSlips;
+
+//*****************************************************************************
+//
+// The sample rate.
+//
+//*****************************************************************************
+static uint32_t g_ui32AudioADCRate;
+
+//*****************************************************************************
+//
+// Sets the timer period for the sample rate, rounded to the nearest cycle of
+// the system clock ui32Clock.
+//
+//*****************************************************************************
+static void
+AudioADCClockSet(uint32_t ui32Clock)
+{
+    TimerLoadSet(TIMER2_BASE, TIMER_A,
+                 ((ui32Clock + (g_ui32AudioADCRate / 2)) /
+                  g_ui32AudioADCRate) - 1);
+}
+
+//*****************************************************************************
+//
+// Arms one control structure for buffer ui32Buf.
+//
+//*****************************************************************************
+static void
+AudioADCArm(uint32_t ui32Select, uint32_t ui32Buf)
+{
+    uDMAChannelTransferSet(UDMA_CHANNEL_ADC0 | ui32Select, UDMA_MODE_PINGPONG,
+                           (void *)(ADC0_BASE + ADC_O_SSFIFO0),
+                           g_ppui16AudioADC[ui32Buf], AUDIO_FRAME_SIZE);
+}
+
+//*****************************************************************************
+//
+//! Initializes the reference capture driver.
+//!
+//! \param ui32Rate is the codec sample rate in Hz.
+//!
+//! ADC0 and Timer 2A are set up to sample AIN0 on PE3 at \e ui32Rate, and the
+//! uDMA channel is armed; capture starts with AudioADCStart().  The ADC runs
+//! from the precision internal oscillator, so its conversion rate does not
+//! depend on the system clock.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+AudioADCInit(uint32_t ui32Rate)
+{
+    g_ui32AudioADCFrames = 0;
+    g_ui32AudioADCNewest = AUDIO_ADC_NUM_BUFFERS - 1;
+    g_ui32AudioADCOverruns = 0;
+    g_bAudioADCAligned = false;
+    g_ui32AudioADCSlips = 0;
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER2);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOE);
+    while(!SysCtlPeripheralReady(SYSCTL_PERIPH_ADC0) ||
+          !SysCtlPeripheralReady(SYSCTL_PERIPH_TIMER2) ||
+          !SysCtlPeripheralReady(SYSCTL_PERIPH_GPIOE))
+    {
+    }
+
+    GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_3);
+
+    //
+    // One averaged sample per timer trigger.  The interrupt enable on the
+    // step is what raises the uDMA request; the sequencer interrupt itself
+    // stays masked, and only the uDMA completion reaches the NVIC.
+    //
+    ADCClockConfigSet(ADC0_BASE, ADC_CLOCK_SRC_PIOSC | ADC_CLOCK_RATE_FULL,
+                      1);
+    ADCHardwareOversampleConfigure(ADC0_BASE, AUDIO_ADC_OVERSAMPLE);
+    ADCSequenceConfigure(ADC0_BASE, 0, ADC_TRIGGER_TIMER, 0);
+    ADCSequenceStepConfigure(ADC0_BASE, 0, 0,
+                             ADC_CTL_CH0 | ADC_CTL_IE | ADC_CTL_END);
+    ADCSequenceEnable(ADC0_BASE, 0);
+    ADCSequenceDMAEnable(ADC0_BASE, 0);
+
+    TimerConfigure(TIMER2_BASE, TIMER_CFG_PERIODIC);
+    TimerControlTrigger(TIMER2_BASE, TIMER_A, true);
+    AudioADCRateSet(ui32Rate);
+
+    //
+    // The channel moves the 16-bit samples one at a time, as the sequencer
+    // produces them.
+    //
+    DMAInit();
+    uDMAChannelAssign(UDMA_CH14_ADC0_0);
+    uDMAChannelAttributeDisable(UDMA_CHANNEL_ADC0, UDMA_ATTR_ALL);
+    uDMAChannelControlSet(UDMA_CHANNEL_ADC0 | UDMA_PRI_SELECT,
+                          UDMA_SIZE_16 | UDMA_SRC_INC_NONE |
+                          UDMA_DST_INC_16 | UDMA_ARB_1);
+    uDMAChannelControlSet(UDMA_CHANNEL_ADC0 | UDMA_ALT_SELECT,
+                          UDMA_SIZE_16 | UDMA_SRC_INC_NONE |
+                          UDMA_DST_INC_16 | UDMA_ARB_1);
+    AudioADCArm(UDMA_PRI_SELECT, 0);
+    AudioADCArm(UDMA_ALT_SELECT, 1);
+
+    ClockHookRegister(AudioADCClockSet);
+}
+
+//*****************************************************************************
+//
+//! Starts capturing.
+//!
+//! This should be called together with AudioSSIStart(), so that the ADC
+//! frames start with the codec frames.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+AudioADCStart(void)
+{
+    uDMAChannelEnable(UDMA_CHANNEL_ADC0);
+    IntEnable(INT_ADC0SS0);
+    TimerEnable(TIMER2_BASE, TIMER_A);
+}
+
+//*****************************************************************************
+//
+//! Stops capturing.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+AudioADCStop(void)
+{
+    TimerDisable(TIMER2_BASE, TIMER_A);
+    IntDisable(INT_ADC0SS0);
+    uDMAChannelDisable(UDMA_CHANNEL_ADC0);
+}
+
+//*****************************************************************************
+//
+//! Changes the sample rate.
+//!
+//! \param ui32Rate is the new codec sample rate in Hz.
+//!
+//! The timer period is rounded to the nearest system clock cycle, and
+//! capture carries on without a break.  The codec stops for a rate switch,
+//! so the pairing of codec and ADC frames is set again from the next
+//! codec frame.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+AudioADCRateSet(uint32_t ui32Rate)
+{
+    g_ui32AudioADCRate = ui32Rate;
+    AudioADCClockSet(SysCtlClockGet());
+    g_bAudioADCAligned = false;
+}
+
+//*****************************************************************************
+//
+//! Returns the ADC frame captured with a codec frame.
+//!
+//! \param ui32Frame is the number of the codec frame, counted from the
+//! first one, as returned by AudioSSIFrameCountGet() before it is
+//! processed.
+//!
+//! The first call pairs \e ui32Frame with the newest complete ADC frame, and
+//! later calls keep that pairing.  When the two clocks have drifted so far
+//! that the paired ADC frame is not complete yet, the newest complete frame
+//! is returned instead; when it has already been overwritten, the oldest one
+//! kept.  Either way the pairing moves by the difference and the slip is
+//! counted.  The samples are the raw ADC readings, \b AUDIO_ADC_MIDSCALE
+//! being zero.
+//!
+//! \return Returns a pointer to \b AUDIO_FRAME_SIZE samples, valid for one
+//! frame, or 0 if no ADC frame has completed yet.
+//
+//*****************************************************************************
+const uint16_t *
+AudioADCFrameGet(uint32_t ui32Frame)
+{
+    uint32_t ui32Done, ui32Newest, ui32Want, ui32Age;
+    bool bIntsOff;
+
+    //
+    // Take the frame count and the newest buffer together.
+    //
+    bIntsOff = IntMasterDisable();
+    ui32Done = g_ui32AudioADCFrames;
+    ui32Newest = g_ui32AudioADCNewest;
+    if(!bIntsOff)
+    {
+        IntMasterEnable();
+    }
+
+    if(ui32Done == 0)
+    {
+        return(0);
+    }
+
+    if(!g_bAudioADCAligned)
+    {
+        g_ui32AudioADCOffset = ui32Done - 1 - ui32Frame;
+        g_bAudioADCAligned = true;
+    }
+
+    //
+    // The age of the paired frame, 0 being the newest complete one.
+    //
+    ui32Want = ui32Frame + g_ui32AudioADCOffset;
+    ui32Age = ui32Done - 1 - ui32Want;
+    if(((int32_t)ui32Age < 0) || (ui32Age >= AUDIO_ADC_HISTORY))
+    {
+        ui32Age = ((int32_t)ui32Age < 0) ? 0 : (AUDIO_ADC_HISTORY - 1);
+        g_ui32AudioADCOffset = ui32Done - 1 - ui32Age - ui32Frame;
+        g_ui32AudioADCSlips++;
+    }
+
+    return(g_ppui16AudioADC[(ui32Newest + AUDIO_ADC_NUM_BUFFERS - ui32Age) %
+                            AUDIO_ADC_NUM_BUFFERS]);
+}
+
+//*****************************************************************************
+//
+//! Returns the number of ADC frames completed since AudioADCInit().
+//!
+//! \return Returns the frame count.
+//
+//*****************************************************************************
+uint32_t
+AudioADCFrameCountGet(void)
+{
+    return(g_ui32AudioADCFrames);
+}
+
+//*****************************************************************************
+//
+//! Returns the number of times the pairing of codec and ADC frames slipped.
+//!
+//! With both clocks within 100 ppm a slip should come no more often than
+//! every 5000 frames or so.
+//!
+//! \return Returns the slip count.
+//
+//*****************************************************************************
+uint32_t
+AudioADCSlipCountGet(void)
+{
+    return(g_ui32AudioADCSlips);
+}
+
+//*****************************************************************************
+//
+//! Returns the number of times capture stopped for lack of an armed buffer.
+//!
+//! This only happens if the ADC interrupt is held off for a whole frame.
+//!
+//! \return Returns the overrun count.
+//
+//*****************************************************************************
+uint32_t
+AudioADCOverrunCountGet(void)
+{
+    return(g_ui32AudioADCOverruns);
+}
+
+//*****************************************************************************
+//
+// The ADC0 sequence 0 interrupt handler, entered when the uDMA completes a
+// frame.  The control structures finish frames alternately, primary first,
+// so the one that finishes frame n is re-armed for frame n + 2.
+//
+//*****************************************************************************
+void
+ADC0SS0_Handler(void)
+{
+    uint32_t ui32Select, ui32Buf;
+
+    ADCIntClear(ADC0_BASE, 0);
+
+    while(1)
+    {
+        ui32Select = (g_ui32AudioADCFrames & 1) ? UDMA_ALT_SELECT :
+                                                  UDMA_PRI_SELECT;
+        if(uDMAChannelModeGet(UDMA_CHANNEL_ADC0 | ui32Select) !=
+           UDMA_MODE_STOP)
+        {
+            break;
+        }
+
+        ui32Buf = (g_ui32AudioADCNewest + 1) % AUDIO_ADC_NUM_BUFFERS;
+        AudioADCArm(ui32Select, (ui32Buf + 2) % AUDIO_ADC_NUM_BUFFERS);
+        g_ui32AudioADCNewest = ui32Buf;
+        g_ui32AudioADCFrames++;
+    }
+
+    //
+    // If both structures finished before the interrupt was taken, the
+    // controller disabled the channel; both are armed again by now.
+    //
+    if(!uDMAChannelIsEnabled(UDMA_CHANNEL_ADC0))
+    {
+        uDMAChannelEnable(UDMA_CHANNEL_ADC0);
+        g_ui32AudioADCOverruns++;
+    }
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
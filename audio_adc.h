@@ -0,0 +1,70 @@
+//*****************************************************************************
+//
+// audio_adc.h - Prototypes for the on-chip ADC reference capture driver.
+//
+//*****************************************************************************
+
+#ifndef __AUDIO_ADC_H__
+#define __AUDIO_ADC_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The number of conversions the ADC averages into each sample.  The ADC
+// converts at up to 1 Msps, which bounds this by the codec rate.
+//
+//*****************************************************************************
+#ifndef AUDIO_ADC_OVERSAMPLE
+#define AUDIO_ADC_OVERSAMPLE    16
+#endif
+
+//*****************************************************************************
+//
+// The number of frame buffers.  The uDMA fills one and has the next armed,
+// so the rest hold the newest complete frames, enough to cover a ring of
+// AUDIO_SSI_NUM_BUFFERS codec frames falling behind.
+//
+//*****************************************************************************
+#define AUDIO_ADC_NUM_BUFFERS   (AUDIO_SSI_NUM_BUFFERS + 1)
+
+//*****************************************************************************
+//
+// The ADC reading of a zero input: the microphone bias sits at mid-scale.
+//
+//*****************************************************************************
+#define AUDIO_ADC_MIDSCALE      2048
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern void AudioADCInit(uint32_t ui32Rate);
+extern void AudioADCStart(void);
+extern void AudioADCStop(void);
+extern void AudioADCRateSet(uint32_t ui32Rate);
+extern const uint16_t *AudioADCFrameGet(uint32_t ui32Frame);
+extern uint32_t AudioADCFrameCountGet(void);
+extern uint32_t AudioADCSlipCountGet(void);
+extern uint32_t AudioADCOverrunCountGet(void);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __AUDIO_ADC_H__
@@ -1,12 +1,867 @@
 #include "CU_TM4C123.h"
 #include <stdbool.h>
-#include "audio_in.h"
+#include <stdint.h>
+#include <string.h>
 #include "driverlib/i2c.h"
 #include "driverlib/ssi.h"
+#include "driverlib/sysctl.h"
+#include "anc.h"
+#include "anc_store.h"
+#include "audio_in.h"
+#include "audio_adc.h"
+#include "audio_ssi.h"
+#include "biquad.h"
+#include "clock.h"
+#include "dma.h"
+#include "dsp_q15.h"
+#include "fft.h"
+#include "goertzel.h"
+#include "multirate.h"
+#include "nco.h"
+#include "perf.h"
+#include "resample.h"
+#include "ring.h"
+#include "specsub.h"
+#include "telemetry.h"
+#include "telemetry_uart.h"
+#include "wav_riff.h"
+#include "wav_play.h"
+#include "wav_rec.h"
+#include "wm8731.h"
 
-int main(void)
+//*****************************************************************************
+//
+// The codec rates that can be switched to at run time, with the codec's
+// sampling control for each and the input pre-conditioning designed for it:
+// two first-order 20 Hz high-pass stages that remove the line-in DC offset
+// and subsonic rumble before the canceller sees them.  The coefficients are
+// computed by the compiler.
+//
+// The frame geometry and the decimation are the same at every rate, and the
+// decimated frames are converted to the DSP core's rate where the converter
+// can (see AUDIO_DSP_RATE).  The SSI carries 16-bit
+// words, which limits the codec to 16-bit DSP mode frames, and its slave
+// clock limits the rate to AUDIO_MAX_RATE.
+//
+//*****************************************************************************
+#define AUDIO_PRECONDITION_STAGES                                             \
+                                2
+typedef struct
+{
+    uint32_t ui32Rate;
+    uint32_t ui32Sampling;
+    tBiquadCoeffs psPrecondition[AUDIO_PRECONDITION_STAGES];
+}
+tAudioRate;
+#define AUDIO_RATE(ui32Rate, ui32Sampling)                                    \
+        { (ui32Rate), (ui32Sampling),                                         \
+          { BIQUAD_HPF1(20, ui32Rate), BIQUAD_HPF1(20, ui32Rate) } }
+static const tAudioRate g_psAudioRates[] =
+{
+    AUDIO_RATE(8000, WM8731_SAMPLING_8K_USB),
+    AUDIO_RATE(32000, WM8731_SAMPLING_32K_USB),
+    AUDIO_RATE(44100, WM8731_SAMPLING_44K1_USB),
+    AUDIO_RATE(48000, WM8731_SAMPLING_48K_USB)
+};
+#define AUDIO_NUM_RATES         (sizeof(g_psAudioRates) /                     \
+                                 sizeof(g_psAudioRates[0]))
+
+//*****************************************************************************
+//
+// The codec setup: line inputs at 0 dB into the ADC, the DAC alone to the
+// outputs, and the codec mastering 16-bit DSP mode frames at 44.1 kHz from
+// the 12 MHz clock.
+//
+// The order is the datasheet's pop-free power-up sequence.  Everything but
+// the outputs is powered first, then the paths and the interface are set
+// and the interface activated.  The outputs are powered last, once the
+// reference voltage has settled.  The datasheet sets no other minimum times
+// for the control interface, so no other waits are needed.  The settling
+// time depends on the reference decoupling; AUDIO_CODEC_SETTLE_MS keeps the
+// allowance the codec was originally brought up with.
+//
+//*****************************************************************************
+#define AUDIO_CODEC_SETTLE_MS   10
+static const tWM8731Setting g_psCodecSetup[] =
+{
+    { WM8731_REG_RESET, 0 },
+    { WM8731_REG_POWER_DOWN, WM8731_POWER_OUTPUTS },
+    { WM8731_REG_LLINE_IN, WM8731_LINE_IN_0DB },
+    { WM8731_REG_RLINE_IN, WM8731_LINE_IN_0DB },
+    { WM8731_REG_LHPHONE_OUT, WM8731_HPHONE_0DB },
+    { WM8731_REG_RHPHONE_OUT, WM8731_HPHONE_0DB },
+    { WM8731_REG_ANALOG_PATH, WM8731_ANALOG_DACSEL | WM8731_ANALOG_MUTE_MIC },
+    { WM8731_REG_DIGITAL_PATH, 0 },
+    { WM8731_REG_DIGITAL_IF,
+      WM8731_IF_MASTER | WM8731_IF_IWL_16 | WM8731_IF_FORMAT_DSP },
+    { WM8731_REG_SAMPLING, WM8731_SAMPLING_44K1_USB },
+    { WM8731_REG_ACTIVE, WM8731_ACTIVE },
+    { WM8731_WAIT, AUDIO_CODEC_SETTLE_MS },
+    { WM8731_REG_POWER_DOWN, 0 }
+};
+#define AUDIO_CODEC_SETTINGS    (sizeof(g_psCodecSetup) /                     \
+                                 sizeof(g_psCodecSetup[0]))
+
+//*****************************************************************************
+//
+// The tones watched on the primary input to choose the cancellation mode: the
+// 50 Hz and 60 Hz mains families up to the third harmonic.  Blocks of 32
+// canceller frames resolve about 3.9 Hz, enough to keep the two families
+// apart.
+//
+//*****************************************************************************
+static const float g_pfToneFrequency[] =
+{
+    50.0f, 100.0f, 150.0f, 60.0f, 120.0f, 180.0f
+};
+#define AUDIO_TONE_BLOCK        (32 * ANC_FRAME_SIZE)
+
+//*****************************************************************************
+//
+// The canceller, its weight store, the single-microphone suppressor, the
+// canceller's post-filter and the rate change stage around them.
+//
+//*****************************************************************************
+tANCState g_sANC;
+tSpecSub g_sSpecSub;
+tSpecSub g_sPostFilter;
+tANCStore g_sANCStore;
+tMRStage g_sMRStage;
+tBiquadCascade g_sPrecondition;
+tGoertzelBank g_sToneBank;
+
+//*****************************************************************************
+//
+// The frame processor's full-rate working buffers.  Before the stream starts
+// they serve as scratch for the kernel benchmarks.
+//
+//*****************************************************************************
+static int32_t g_pi32AudioPrimary[AUDIO_FRAME_SIZE];
+static int32_t g_pi32AudioRef[AUDIO_FRAME_SIZE];
+
+//*****************************************************************************
+//
+// The conversion between the decimated codec frames and the DSP core's
+// frames, and the DSP core's codec-side rate.
+//
+// The converted inputs collect in g_pi32AudioDSPPrimary and
+// g_pi32AudioDSPRef, and each whole frame there is processed and converted
+// back into g_pi32AudioSRCOut, from which the interpolator takes a frame per
+// codec frame.  While converting, the output starts primed with a frame of
+// silence, which covers the converted inputs held back waiting for a whole
+// frame; the buffers hold the most either reaches with the converter's
+// ratios, 112 and 129 samples.  At equal rates the converters pass the
+// samples through and nothing is held back.
+//
+//*****************************************************************************
+#define AUDIO_SRC_BUFFER        ((2 * ANC_FRAME_SIZE) + 16)
+static tResampler g_sAudioSRCPrimary;
+static tResampler g_sAudioSRCRef;
+static tResampler g_sAudioSRCOut;
+static int32_t g_pi32AudioDSPPrimary[AUDIO_SRC_BUFFER];
+static int32_t g_pi32AudioDSPRef[AUDIO_SRC_BUFFER];
+static uint32_t g_ui32AudioDSPCount;
+static int32_t g_pi32AudioSRCOut[AUDIO_SRC_BUFFER];
+static uint32_t g_ui32AudioSRCOutCount;
+static uint32_t g_ui32AudioDSPRate;
+
+//*****************************************************************************
+//
+// The cost of the DSP kernels, measured at start-up as this build places
+// them (see ramfunc.h): one canceller frame, one of the suppressor's complex
+// transforms and one codec frame of pre-conditioning.  Reading these from
+// builds with each placement gives the comparison.
+//
+//*****************************************************************************
+uint32_t g_ui32AudioANCCycles;
+uint32_t g_ui32AudioFFTCycles;
+uint32_t g_ui32AudioBiquadCycles;
+
+//*****************************************************************************
+//
+// The cost of checksumming 1 KB with each CRC routine, indexed by the
+// TELEMETRY_CRC_* values and measured at start-up.  1024 divided by an
+// entry gives the bytes per cycle.
+//
+//*****************************************************************************
+uint32_t g_pui32AudioCRCCycles[TELEMETRY_NUM_CRCS];
+
+//*****************************************************************************
+//
+// The cost of passing 1 KB through a ring (see ring.h), measured at start-up
+// a byte per call, as the old circular buffer moved it, and in the spans of
+// AUDIO_RING_BENCHMARK_SPAN bytes the telemetry and recording rings move.
+// The ring is AUDIO_RING_BENCHMARK_SIZE bytes of a free frame buffer.
+//
+//*****************************************************************************
+#define AUDIO_RING_BENCHMARK_SIZE                                             \
+                                1024
+#define AUDIO_RING_BENCHMARK_SPAN                                             \
+                                256
+uint32_t g_ui32AudioRingByteCycles;
+uint32_t g_ui32AudioRingSpanCycles;
+
+//*****************************************************************************
+//
+// The self-test sources, after the Simulink model: a 200 Hz signal, and 60 Hz
+// hum with its third harmonic as the noise.  The reference is the hum and
+// the primary input is the signal plus the hum at half amplitude, so a
+// working canceller leaves the 200 Hz tone alone.
+//
+//*****************************************************************************
+tNCO g_sTestSignal;
+tNCO g_sTestNoise;
+
+//*****************************************************************************
+//
+// The recorder the frame processor feeds, if any.  To capture a session for
+// diagnostics, the application starts a recorder on its card with
+// WavRecStart() at the current rate and points this at it; the main loop
+// writes it out and rate switches wait until it is stopped.
+//
+//*****************************************************************************
+tWavRecorder *volatile g_psAudioRecorder;
+
+//*****************************************************************************
+//
+// The player the codec output comes from, if any.  To play a file, such as
+// a test signal or one channel of a recording, the application opens it on
+// its card with WavPlayOpen(), sets the codec rate to the file's and points
+// this at it; the main loop refills it, and the frame processor plays it in
+// place of the canceller's output until it is cleared.
+//
+//*****************************************************************************
+tWavPlayer *volatile g_psAudioPlayer;
+
+//*****************************************************************************
+//
+// The telemetry stream to the host: every AUDIO_TELEMETRY_DECIMATION-th
+// canceller-rate sample of the primary input, the reference and the output
+// from each frame, and the weights and the metrics every
+// AUDIO_TELEMETRY_PERIOD codec frames.  At 44.1 kHz that is about 13 KB/s,
+// well inside the line rate.
+//
+// The frames are queued from the frame processor and from the main loop,
+// which in the SSI's ring mode are the same context, as the queue needs.
+//
+// Set AUDIO_TELEMETRY_LOOPBACK to 1 to loop the stream back inside the UART
+// into g_sTelemetryLoopback, for checking the link on the bench without a
+// host.
+//
+//*****************************************************************************
+#define AUDIO_TELEMETRY_DECIMATION                                            \
+                                4
+#define AUDIO_TELEMETRY_SAMPLES (ANC_FRAME_SIZE / AUDIO_TELEMETRY_DECIMATION)
+#define AUDIO_TELEMETRY_PERIOD  32
+#define AUDIO_TELEMETRY_BUFFER  1024
+#ifndef AUDIO_TELEMETRY_LOOPBACK
+#define AUDIO_TELEMETRY_LOOPBACK                                              \
+                                0
+#endif
+tTelemetry g_sTelemetry;
+static uint8_t g_pui8AudioTelemetry[AUDIO_TELEMETRY_BUFFER];
+static int16_t g_pi16AudioSignals[3 * AUDIO_TELEMETRY_SAMPLES];
+#if AUDIO_TELEMETRY_LOOPBACK
+tTelemetryDecoder g_sTelemetryLoopback;
+
+//*****************************************************************************
+//
+// Takes the frames of the loopback decoder.  Its counters are all the check
+// needs.
+//
+//*****************************************************************************
+static void
+AudioTelemetryCount(void *pvArg, uint32_t ui32Type, uint32_t ui32Sequence,
+                    const uint8_t *pui8Payload, uint32_t ui32Size)
+{
+    (void)pvArg;
+    (void)ui32Type;
+    (void)ui32Sequence;
+    (void)pui8Payload;
+    (void)ui32Size;
+}
+#endif
+
+//*****************************************************************************
+//
+// The active noise reduction mode, one of the AUDIO_MODE_* values.  It may be
+// changed at any time; the switch takes effect at the next frame.
+//
+//*****************************************************************************
+volatile uint32_t g_ui32AudioMode = AUDIO_MODE_ANC;
+
+//*****************************************************************************
+//
+// The mode the last frame was processed in.  The processing that a switch
+// brings back into use starts afresh.
+//
+//*****************************************************************************
+static uint32_t g_ui32AudioModeRan = AUDIO_MODE_ANC;
+
+//*****************************************************************************
+//
+// Enables the Wiener post-filter on the canceller output.  Like the mode, it
+// may be changed at any time.
+//
+//*****************************************************************************
+volatile bool g_bAudioPostFilter = false;
+
+//*****************************************************************************
+//
+// Whether the post-filter ran on the last frame.  It starts afresh when it
+// runs again after frames it did not see.
+//
+//*****************************************************************************
+static bool g_bAudioPostFilterRan;
+
+//*****************************************************************************
+//
+// Replaces both canceller-rate inputs with the self-test sources.
+//
+//*****************************************************************************
+volatile bool g_bAudioSelfTest = false;
+
+//*****************************************************************************
+//
+// Takes the reference from the microphone on the on-chip ADC instead of the
+// codec's right channel.  Like the mode, it may be changed at any time.
+//
+//*****************************************************************************
+volatile bool g_bAudioADCReference = false;
+
+//*****************************************************************************
+//
+// The requested codec rate.  Like the mode, it may be changed at any time;
+// the main loop switches to it with AudioRateSet(), or puts it back if the
+// rate is not supported.
+//
+//*****************************************************************************
+volatile uint32_t g_ui32AudioRate = CODEC_RATE;
+
+//*****************************************************************************
+//
+// The rate the codec and the DSP engine are running at.
+//
+//*****************************************************************************
+static const tAudioRate *g_psAudioRate;
+
+//*****************************************************************************
+//
+// Runs the DSP core on one frame at its rate, in place on pi32Primary.
+//
+//*****************************************************************************
+static void
+AudioDSPFrameProcess(int32_t *pi32Primary, int32_t *pi32Ref, uint32_t ui32Mode)
+{
+    uint32_t ui32Idx;
+    bool bPostFilter;
+
+    if(g_bAudioSelfTest)
+    {
+        NCOGenerate(&g_sTestNoise, pi32Ref, ANC_FRAME_SIZE);
+        NCOGenerate(&g_sTestSignal, pi32Primary, ANC_FRAME_SIZE);
+        for(ui32Idx = 0; ui32Idx < ANC_FRAME_SIZE; ui32Idx++)
+        {
+            pi32Primary[ui32Idx] += pi32Ref[ui32Idx] >> 1;
+        }
+    }
+    GoertzelProcess(&g_sToneBank, pi32Primary, ANC_FRAME_SIZE);
+    for(ui32Idx = 0; ui32Idx < AUDIO_TELEMETRY_SAMPLES; ui32Idx++)
+    {
+        g_pi16AudioSignals[3 * ui32Idx] =
+            (int16_t)(pi32Primary[ui32Idx * AUDIO_TELEMETRY_DECIMATION] >> 16);
+        g_pi16AudioSignals[(3 * ui32Idx) + 1] =
+            ((ui32Mode == AUDIO_MODE_SPECSUB) && !g_bAudioSelfTest) ? 0 :
+            (int16_t)(pi32Ref[ui32Idx * AUDIO_TELEMETRY_DECIMATION] >> 16);
+    }
+    if(ui32Mode == AUDIO_MODE_SPECSUB)
+    {
+        SpecSubProcess(&g_sSpecSub, pi32Primary, pi32Primary);
+    }
+    else
+    {
+        ANCProcessFrame(&g_sANC, pi32Primary, pi32Ref, pi32Primary);
+    }
+
+    //
+    // The post-filter runs on the canceller's output only.
+    //
+    bPostFilter = (g_bAudioPostFilter && (ui32Mode != AUDIO_MODE_SPECSUB));
+    if(bPostFilter)
+    {
+        if(!g_bAudioPostFilterRan)
+        {
+            SpecSubReset(&g_sPostFilter);
+        }
+        SpecSubProcess(&g_sPostFilter, pi32Primary, pi32Primary);
+    }
+    g_bAudioPostFilterRan = bPostFilter;
+    for(ui32Idx = 0; ui32Idx < AUDIO_TELEMETRY_SAMPLES; ui32Idx++)
+    {
+        g_pi16AudioSignals[(3 * ui32Idx) + 2] =
+            (int16_t)(pi32Primary[ui32Idx * AUDIO_TELEMETRY_DECIMATION] >> 16);
+    }
+    TelemetrySend(&g_sTelemetry, TELEMETRY_TYPE_SIGNALS, g_pi16AudioSignals,
+                  sizeof(g_pi16AudioSignals));
+}
+
+//*****************************************************************************
+//
+// Sets up the conversion to the DSP core for a codec rate, restarting the
+// converters, and returns the DSP core's codec-side rate: AUDIO_DSP_RATE if
+// the converter reaches it, or else the codec rate itself.
+//
+//*****************************************************************************
+static uint32_t
+AudioSRCSet(uint32_t ui32Rate)
+{
+    uint32_t ui32DSPRate;
+
+    ui32DSPRate = AUDIO_DSP_RATE;
+    if(!ResampleInit(&g_sAudioSRCPrimary, ui32Rate, ui32DSPRate))
+    {
+        ui32DSPRate = ui32Rate;
+        ResampleInit(&g_sAudioSRCPrimary, ui32Rate, ui32DSPRate);
+    }
+    ResampleInit(&g_sAudioSRCRef, ui32Rate, ui32DSPRate);
+    ResampleInit(&g_sAudioSRCOut, ui32DSPRate, ui32Rate);
+
+    g_ui32AudioDSPCount = 0;
+    g_ui32AudioSRCOutCount = (ui32DSPRate == ui32Rate) ? 0 : ANC_FRAME_SIZE;
+    memset(g_pi32AudioSRCOut, 0, sizeof(g_pi32AudioSRCOut));
+
+    return(ui32DSPRate);
+}
+
+//*****************************************************************************
+//
+// Processes one frame of interleaved codec samples, left channel primary and
+// right channel reference, into a frame of noise-reduced output on both output
+// channels.  pi16In is filtered in place, and its right channel replaced by
+// the ADC reference when that is selected.
+//
+// The decimated frames are converted to the DSP core's rate half a frame at
+// a time, and the core runs on each whole frame this completes, zero, one or
+// two per codec frame.  Its output is converted back and the interpolator
+// takes one frame of it.
+//
+//*****************************************************************************
+void
+AudioFrameProcess(int16_t *pi16In, int16_t *pi16Out)
 {
-	
+    int32_t pi32LowPrimary[ANC_FRAME_SIZE], pi32LowRef[ANC_FRAME_SIZE];
+    const uint16_t *pui16ADC;
+    uint32_t ui32Idx, ui32Mode, ui32Count;
+
+    BiquadCascadeProcess(&g_sPrecondition, pi16In, AUDIO_FRAME_SIZE);
+
+    for(ui32Idx = 0; ui32Idx < AUDIO_FRAME_SIZE; ui32Idx++)
+    {
+        g_pi32AudioPrimary[ui32Idx] = (int32_t)pi16In[2 * ui32Idx] << 16;
+        g_pi32AudioRef[ui32Idx] = (int32_t)pi16In[(2 * ui32Idx) + 1] << 16;
+    }
+
+    //
+    // The ADC reference, if selected, replaces the right channel with the
+    // ADC frame captured alongside this codec frame.  Its 12-bit readings
+    // are scaled to full scale at 32 bits, and written back to the right
+    // channel of pi16In so that the recording holds the reference used.
+    //
+    pui16ADC = g_bAudioADCReference ?
+               AudioADCFrameGet(AudioSSIFrameCountGet()) : 0;
+    if(pui16ADC)
+    {
+        for(ui32Idx = 0; ui32Idx < AUDIO_FRAME_SIZE; ui32Idx++)
+        {
+            g_pi32AudioRef[ui32Idx] = ((int32_t)pui16ADC[ui32Idx] -
+                                       AUDIO_ADC_MIDSCALE) << 20;
+            pi16In[(2 * ui32Idx) + 1] =
+                (int16_t)(g_pi32AudioRef[ui32Idx] >> 16);
+        }
+    }
+
+    //
+    // The suppressor and the post-filter run on the canceller's frames at
+    // the canceller rate.  The suppressor needs no reference, so the
+    // reference decimator idles in that mode and the reference converter,
+    // which must stay in step with the primary's, converts silence.  The
+    // mode is read once per frame.  A switch clears the suppressor, or the
+    // canceller's delay line and the reference decimator's history, so that
+    // the one switched to does not pick up samples from before it idled.
+    //
+    ui32Mode = g_ui32AudioMode;
+    if(ui32Mode != g_ui32AudioModeRan)
+    {
+        if(ui32Mode == AUDIO_MODE_SPECSUB)
+        {
+            SpecSubReset(&g_sSpecSub);
+        }
+        else
+        {
+            ANCReset(&g_sANC);
+            MRDecimatorReset(&g_sMRStage.sRef);
+        }
+        g_ui32AudioModeRan = ui32Mode;
+    }
+    MRStageDecimate(&g_sMRStage, g_pi32AudioPrimary,
+                    (ui32Mode == AUDIO_MODE_SPECSUB) ? 0 : g_pi32AudioRef,
+                    pi32LowPrimary, pi32LowRef);
+    if(ui32Mode == AUDIO_MODE_SPECSUB)
+    {
+        memset(pi32LowRef, 0, sizeof(pi32LowRef));
+    }
+
+    for(ui32Idx = 0; ui32Idx < ANC_FRAME_SIZE; ui32Idx += ANC_FRAME_SIZE / 2)
+    {
+        ui32Count =
+            ResampleProcess(&g_sAudioSRCPrimary, &pi32LowPrimary[ui32Idx],
+                            ANC_FRAME_SIZE / 2,
+                            &g_pi32AudioDSPPrimary[g_ui32AudioDSPCount]);
+        ResampleProcess(&g_sAudioSRCRef, &pi32LowRef[ui32Idx],
+                        ANC_FRAME_SIZE / 2,
+                        &g_pi32AudioDSPRef[g_ui32AudioDSPCount]);
+        g_ui32AudioDSPCount += ui32Count;
+
+        while(g_ui32AudioDSPCount >= ANC_FRAME_SIZE)
+        {
+            AudioDSPFrameProcess(g_pi32AudioDSPPrimary, g_pi32AudioDSPRef,
+                                 ui32Mode);
+            g_ui32AudioSRCOutCount +=
+                ResampleProcess(&g_sAudioSRCOut, g_pi32AudioDSPPrimary,
+                                ANC_FRAME_SIZE,
+                                &g_pi32AudioSRCOut[g_ui32AudioSRCOutCount]);
+
+            g_ui32AudioDSPCount -= ANC_FRAME_SIZE;
+            memmove(g_pi32AudioDSPPrimary,
+                    &g_pi32AudioDSPPrimary[ANC_FRAME_SIZE],
+                    g_ui32AudioDSPCount * sizeof(int32_t));
+            memmove(g_pi32AudioDSPRef, &g_pi32AudioDSPRef[ANC_FRAME_SIZE],
+                    g_ui32AudioDSPCount * sizeof(int32_t));
+        }
+    }
+
+    //
+    // Take a frame of the output.  The priming keeps a frame there; should
+    // it ever run short, the rest of the frame is silence.
+    //
+    if(g_ui32AudioSRCOutCount < ANC_FRAME_SIZE)
+    {
+        memset(&g_pi32AudioSRCOut[g_ui32AudioSRCOutCount], 0,
+               (ANC_FRAME_SIZE - g_ui32AudioSRCOutCount) * sizeof(int32_t));
+        g_ui32AudioSRCOutCount = ANC_FRAME_SIZE;
+    }
+    MRStageInterpolate(&g_sMRStage, g_pi32AudioSRCOut, g_pi32AudioPrimary);
+    g_ui32AudioSRCOutCount -= ANC_FRAME_SIZE;
+    memmove(g_pi32AudioSRCOut, &g_pi32AudioSRCOut[ANC_FRAME_SIZE],
+            g_ui32AudioSRCOutCount * sizeof(int32_t));
+
+    for(ui32Idx = 0; ui32Idx < AUDIO_FRAME_SIZE; ui32Idx++)
+    {
+        pi16Out[2 * ui32Idx] = (int16_t)(g_pi32AudioPrimary[ui32Idx] >> 16);
+        pi16Out[(2 * ui32Idx) + 1] = pi16Out[2 * ui32Idx];
+    }
+
+    //
+    // Record the conditioned primary input, the reference the canceller was
+    // given and the output at the codec rate.  This only copies into the
+    // recorder's buffer; the card is written from the main loop.
+    //
+    if(g_psAudioRecorder)
+    {
+        WavRecFrameWrite(g_psAudioRecorder, &pi16In[0], &pi16In[1],
+                         &pi16Out[0], 2, AUDIO_FRAME_SIZE);
+    }
+
+    //
+    // Play a file in place of the output.  This runs where the frame is
+    // handed to the SSI, so the file's frames go to the codec as they are;
+    // the canceller keeps running and the recording holds its output.
+    //
+    if(g_psAudioPlayer)
+    {
+        WavPlayFrameGet(g_psAudioPlayer, pi16Out, AUDIO_FRAME_SIZE);
+    }
+}
+
+//*****************************************************************************
+//
+// Returns the settings for a codec rate, or 0 if the rate is not supported.
+//
+//*****************************************************************************
+static const tAudioRate *
+AudioRateFind(uint32_t ui32Rate)
+{
+    uint32_t ui32Idx;
+
+    for(ui32Idx = 0; ui32Idx < AUDIO_NUM_RATES; ui32Idx++)
+    {
+        if(g_psAudioRates[ui32Idx].ui32Rate == ui32Rate)
+        {
+            return(&g_psAudioRates[ui32Idx]);
+        }
+    }
+    return(0);
 }
 
+//*****************************************************************************
+//
+// Switches the codec and the DSP engine to a new sample rate without
+// restarting either.  This must be called from the main loop.
+//
+// The interface is deactivated, which stops the codec's clocks at the end of
+// the current word, and the frames already received are processed.  The SSI
+// is then reclocked and its ring resumed where it stopped, the converters
+// to the DSP core are set up for the new rate, and the new sampling control
+// is written before the interface is activated again.  All of this happens
+// before the codec restarts, so in ping-pong mode no frame is processed
+// with a mix of old and new state.
+//
+// Between the rates the converter reaches, the DSP core stays at its own
+// rate and keeps its state; only the converters restart, which costs the
+// converted samples in flight, about a frame.  When the DSP core's rate does
+// change, its rate-dependent state is carried over: the canceller's weights
+// and the suppressors' spectra are resampled, the oscillators keep their
+// phase, and only the tone detectors start a new block.  The pre-
+// conditioning keeps its history at every switch.  The audio stops for the
+// few I2C writes and the received part of one frame, well under a frame in
+// all; PERF_PROBE_RATE_SWITCH records the cycles the codec was stopped.
+//
+// Returns false, leaving everything as it was, if the rate is not supported.
+//
+//*****************************************************************************
+bool
+AudioRateSet(uint32_t ui32Rate)
+{
+    const tAudioRate *psRate;
+    uint32_t ui32Old, ui32New;
+
+    psRate = AudioRateFind(ui32Rate);
+    if(psRate == 0)
+    {
+        return(false);
+    }
+    if(psRate == g_psAudioRate)
+    {
+        return(true);
+    }
+
+    //
+    // Catch up first, so that the drain after the codec stops only has the
+    // frame that was in progress.
+    //
+    AudioSSIService();
+    PerfStart(PERF_PROBE_RATE_SWITCH);
+    WM8731Write(WM8731_REG_ACTIVE, 0);
+    while(WM8731Busy())
+    {
+    }
+    AudioSSIService();
+    AudioSSIRateSet(psRate->ui32Rate);
+    AudioADCRateSet(psRate->ui32Rate);
+
+    ui32Old = g_ui32AudioDSPRate / ANC_DECIMATION;
+    g_ui32AudioDSPRate = AudioSRCSet(psRate->ui32Rate);
+    ui32New = g_ui32AudioDSPRate / ANC_DECIMATION;
+    BiquadCascadeCoeffsSet(&g_sPrecondition, psRate->psPrecondition);
+    if(ui32New != ui32Old)
+    {
+        ANCRateSet(&g_sANC, ui32New);
+        SpecSubRateSet(&g_sSpecSub, ui32Old, ui32New);
+        SpecSubRateSet(&g_sPostFilter, ui32Old, ui32New);
+        NCOSampleRateSet(&g_sTestSignal, ui32New);
+        NCOSampleRateSet(&g_sTestNoise, ui32New);
+        GoertzelInit(&g_sToneBank, g_pfToneFrequency,
+                     sizeof(g_pfToneFrequency) / sizeof(g_pfToneFrequency[0]),
+                     ui32New, AUDIO_TONE_BLOCK);
+    }
+    g_psAudioRate = psRate;
 
+    WM8731Write(WM8731_REG_SAMPLING, psRate->ui32Sampling);
+    WM8731Write(WM8731_REG_ACTIVE, WM8731_ACTIVE);
+    while(WM8731Busy())
+    {
+    }
+    PerfStop(PERF_PROBE_RATE_SWITCH, 1);
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Sends the canceller's weights and the metrics to the host.
+//
+//*****************************************************************************
+static void
+AudioTelemetrySnapshot(uint32_t ui32Frames)
+{
+    uint32_t pui32Metrics[TELEMETRY_NUM_METRICS];
+    int32_t pi32Weight[ANC_NUM_TAPS];
+
+    ANCWeightsGet(&g_sANC, pi32Weight);
+    TelemetrySend(&g_sTelemetry, TELEMETRY_TYPE_WEIGHTS, pi32Weight,
+                  sizeof(pi32Weight));
+
+    pui32Metrics[TELEMETRY_METRIC_FRAMES] = ui32Frames;
+    pui32Metrics[TELEMETRY_METRIC_PRIMARY] = g_sANC.ui32PrimaryEnergy;
+    pui32Metrics[TELEMETRY_METRIC_ERROR] = g_sANC.ui32ErrorEnergy;
+    pui32Metrics[TELEMETRY_METRIC_MODE] = g_ui32AudioMode;
+    pui32Metrics[TELEMETRY_METRIC_RATE] = g_psAudioRate->ui32Rate;
+    pui32Metrics[TELEMETRY_METRIC_ANC_CYCLES] = g_ui32AudioANCCycles;
+    pui32Metrics[TELEMETRY_METRIC_DMA_ERRORS] = DMAErrorCountGet();
+    pui32Metrics[TELEMETRY_METRIC_DROPPED] = g_sTelemetry.ui32Dropped;
+    TelemetrySend(&g_sTelemetry, TELEMETRY_TYPE_METRICS, pui32Metrics,
+                  sizeof(pui32Metrics));
+}
+
+int main(void)
+{
+    uint32_t ui32Frames, ui32CRC, ui32ANCRate;
+    bool bCodecReady;
+
+    //
+    // Run the DSP at the full 80 MHz, then time the bring-up from here to the
+    // first received frame.
+    //
+    ClockProfileSet(CLOCK_PROFILE_DSP);
+    PerfInit();
+    PerfStart(PERF_PROBE_FIRST_FRAME);
+
+    //
+    // Program the codec first.  The settings go out from the I2C and timer
+    // interrupts while everything else is initialized.
+    //
+    WM8731Init();
+    PerfStart(PERF_PROBE_CODEC_INIT);
+    WM8731TableWrite(g_psCodecSetup, AUDIO_CODEC_SETTINGS);
+    bCodecReady = false;
+
+    //
+    // Bring up the canceller and warm-start it from the last converged
+    // weights, if any were saved.
+    //
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_EEPROM0);
+    while(!SysCtlPeripheralReady(SYSCTL_PERIPH_EEPROM0))
+    {
+    }
+    g_psAudioRate = AudioRateFind(CODEC_RATE);
+    g_ui32AudioDSPRate = AudioSRCSet(CODEC_RATE);
+    ui32ANCRate = g_ui32AudioDSPRate / ANC_DECIMATION;
+    ANCInit(&g_sANC, ANC_MODE_BFP);
+    ANCRateSet(&g_sANC, ui32ANCRate);
+    SpecSubInit(&g_sSpecSub, SPECSUB_RULE_SUBTRACT, PERF_PROBE_SPECSUB);
+    SpecSubInit(&g_sPostFilter, SPECSUB_RULE_WIENER, PERF_PROBE_WIENER);
+    MRStageInit(&g_sMRStage, ANC_DECIMATION);
+    GoertzelInit(&g_sToneBank, g_pfToneFrequency,
+                 sizeof(g_pfToneFrequency) / sizeof(g_pfToneFrequency[0]),
+                 ui32ANCRate, AUDIO_TONE_BLOCK);
+    NCOInit(&g_sTestSignal, ui32ANCRate, NCO_INTERPOLATE);
+    NCOFrequencySet(&g_sTestSignal, 200.0f);
+    NCOHarmonicSet(&g_sTestSignal, 0, 1, Q15(0.25));
+    NCOInit(&g_sTestNoise, ui32ANCRate, NCO_INTERPOLATE);
+    NCOFrequencySet(&g_sTestNoise, 60.0f);
+    NCOHarmonicSet(&g_sTestNoise, 0, 1, Q15(0.5));
+    NCOHarmonicSet(&g_sTestNoise, 1, 3, Q15(0.125));
+    BiquadCascadeInit(&g_sPrecondition, g_psAudioRate->psPrecondition,
+                      AUDIO_PRECONDITION_STAGES, 2);
+    if(ANCStoreInit(&g_sANCStore) == ANC_STORE_OK)
+    {
+        ANCStoreRestore(&g_sANCStore, &g_sANC);
+    }
+
+    //
+    // Measure the kernels while the frame buffers are still free.
+    //
+    g_ui32AudioANCCycles = ANCBenchmark(ANC_MODE_BFP, g_pi32AudioPrimary);
+    g_ui32AudioFFTCycles = FFTBenchmark(SPECSUB_FFT_SIZE / 2, false,
+                                        g_pi32AudioPrimary);
+    g_ui32AudioBiquadCycles =
+        BiquadBenchmark(g_psAudioRate->psPrecondition,
+                        AUDIO_PRECONDITION_STAGES, 2,
+                        (int16_t *)g_pi32AudioPrimary, AUDIO_FRAME_SIZE);
+    for(ui32CRC = 0; ui32CRC < TELEMETRY_NUM_CRCS; ui32CRC++)
+    {
+        g_pui32AudioCRCCycles[ui32CRC] =
+            TelemetryCRCBenchmark(ui32CRC, (uint8_t *)g_pi32AudioPrimary,
+                                  sizeof(g_pi32AudioPrimary));
+    }
+    g_ui32AudioRingByteCycles =
+        RingBenchmark((uint8_t *)g_pi32AudioRef, AUDIO_RING_BENCHMARK_SIZE,
+                      (uint8_t *)g_pi32AudioPrimary, 1);
+    g_ui32AudioRingSpanCycles =
+        RingBenchmark((uint8_t *)g_pi32AudioRef, AUDIO_RING_BENCHMARK_SIZE,
+                      (uint8_t *)g_pi32AudioPrimary,
+                      AUDIO_RING_BENCHMARK_SPAN);
+
+    //
+    // Stream the codec through the frame processor.  The uDMA cycles through
+    // a ring of frame buffers on its own, and the main loop processes them
+    // as they fill, followed by the per-frame housekeeping.  A slow snapshot
+    // write only delays the frames behind it in the ring instead of losing
+    // them.  The ADC reference capture starts with the codec stream so that
+    // their frames line up.
+    //
+    TelemetryInit(&g_sTelemetry, g_pui8AudioTelemetry,
+                  sizeof(g_pui8AudioTelemetry));
+#if AUDIO_TELEMETRY_LOOPBACK
+    TelemetryDecoderInit(&g_sTelemetryLoopback, AudioTelemetryCount, 0);
+    TelemetryUARTInit(&g_sTelemetry, TELEMETRY_UART_BAUD,
+                      &g_sTelemetryLoopback);
+#else
+    TelemetryUARTInit(&g_sTelemetry, TELEMETRY_UART_BAUD, 0);
+#endif
+    AudioSSIInit(AudioFrameProcess, AUDIO_SSI_MODE_RING);
+    AudioADCInit(CODEC_RATE);
+    AudioADCStart();
+    AudioSSIStart();
+    ui32Frames = 0;
+
+    while(1)
+    {
+        if(!bCodecReady && !WM8731Busy())
+        {
+            PerfStop(PERF_PROBE_CODEC_INIT, AUDIO_CODEC_SETTINGS);
+            bCodecReady = true;
+        }
+
+        AudioSSIService();
+        while(ui32Frames != AudioSSIFrameCountGet())
+        {
+            if(ui32Frames == 0)
+            {
+                PerfStop(PERF_PROBE_FIRST_FRAME, 1);
+            }
+            ANCStoreService(&g_sANCStore, &g_sANC);
+            ui32Frames++;
+            if((ui32Frames % AUDIO_TELEMETRY_PERIOD) == 0)
+            {
+                AudioTelemetrySnapshot(ui32Frames);
+            }
+        }
+        TelemetryUARTService();
+
+        //
+        // Switch rates between frames, once the codec setup is through.  A
+        // WAV file has one rate, so a recording holds the switch off.
+        //
+        if(bCodecReady && (g_ui32AudioRate != g_psAudioRate->ui32Rate) &&
+           !(g_psAudioRecorder && g_psAudioRecorder->bRecording) &&
+           !AudioRateSet(g_ui32AudioRate))
+        {
+            g_ui32AudioRate = g_psAudioRate->ui32Rate;
+        }
+
+        //
+        // Refill the player and write out the recording last; the card may
+        // keep these busy for a while, and the SSI ring holds the frames
+        // that arrive meanwhile.
+        //
+        if(g_psAudioPlayer)
+        {
+            WavPlayService(g_psAudioPlayer);
+        }
+        if(g_psAudioRecorder)
+        {
+            WavRecService(g_psAudioRecorder);
+        }
+    }
+}
@@ -0,0 +1,72 @@
+//*****************************************************************************
+//
+// audio_in.h - Audio path definitions shared with the drivers.
+//
+//*****************************************************************************
+
+#ifndef __AUDIO_IN_H__
+#define __AUDIO_IN_H__
+
+//*****************************************************************************
+//
+// The codec sample rate at start-up, and the ratio of the codec rate to the
+// rate of the decimated frames.  The rate may be switched at run time with
+// AudioRateSet(); the ratio is the same at every rate.
+//
+//*****************************************************************************
+#define CODEC_RATE              44100
+#define ANC_DECIMATION          6
+
+//*****************************************************************************
+//
+// The codec rate the DSP core is tuned for.  At codec rates the sample-rate
+// converter reaches from here (44.1 kHz and 32 kHz), the decimated frames
+// are converted to AUDIO_DSP_RATE / ANC_DECIMATION, so the canceller, the
+// suppressors and the tone detectors always run at ANC_RATE, 8 kHz, plenty
+// for hum and low-frequency noise.  At other codec rates they run at the
+// codec rate / ANC_DECIMATION.
+//
+//*****************************************************************************
+#define AUDIO_DSP_RATE          48000
+#define ANC_RATE                (AUDIO_DSP_RATE / ANC_DECIMATION)
+
+//*****************************************************************************
+//
+// The highest codec rate AudioRateSet() accepts.
+//
+//*****************************************************************************
+#define AUDIO_MAX_RATE          48000
+
+//*****************************************************************************
+//
+// The number of stereo samples in one codec-rate frame.  One frame yields
+// exactly one canceller frame after decimation.
+//
+//*****************************************************************************
+#define AUDIO_FRAME_SIZE        (ANC_FRAME_SIZE * ANC_DECIMATION)
+
+//*****************************************************************************
+//
+// The noise reduction modes.  AUDIO_MODE_ANC cancels the primary input against
+// the reference on the right channel; AUDIO_MODE_SPECSUB suppresses
+// stationary noise in the primary input alone, for installs with no reference
+// microphone.
+//
+//*****************************************************************************
+#define AUDIO_MODE_ANC          0
+#define AUDIO_MODE_SPECSUB      1
+
+//*****************************************************************************
+//
+// Prototypes.
+//
+//*****************************************************************************
+extern volatile uint32_t g_ui32AudioMode;
+extern volatile bool g_bAudioPostFilter;
+extern volatile bool g_bAudioSelfTest;
+extern volatile uint32_t g_ui32AudioRate;
+extern volatile bool g_bAudioADCReference;
+extern void AudioFrameProcess(int16_t *pi16In, int16_t *pi16Out);
+extern bool AudioRateSet(uint32_t ui32Rate);
+
+#endif // __AUDIO_IN_H__
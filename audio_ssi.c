@@ -0,0 +1,754 @@
+//*****************************************************************************
+//
+// audio_ssi.c - Codec streaming over SSI0 with uDMA transfers.
+//
+// The WM8731 is the bit clock and frame master in DSP mode with 16-bit
+// words, and SSI0 runs as a slave with 16-bit data, so every stereo sample
+// is two SSI words, left then right.  In DSP mode the codec pulses LRC once
+// per stereo sample, before the left word, and sends the right word straight
+// after it.  The SSI frame format is AUDIO_SSI_FRAME_FORMAT, by default
+// Freescale SPI mode 1 (SSI_FRF_MOTO_MODE_1) with LRC on SSInFss: with SPH
+// set, a slave takes back-to-back words for as long as SSInFss stays low,
+// which holds the left and right words of a sample between two LRC pulses,
+// provided the codec sends exactly 32 bit clocks per sample.  The TI
+// synchronous serial format (SSI_FRF_TI) expects SSInFss pulsed before every
+// word, and a slave in that format does not take a word that arrives without
+// a pulse, so the right words would be lost.  Neither format has been
+// checked on hardware; send different left and right signals on the board
+// and check that both arrive at the expected rate.  Nothing else in the
+// driver depends on the framing.
+//
+// In ping-pong mode both directions stream through the uDMA over two frame
+// buffers each.  When the receive side fills a buffer the SSI interrupt
+// hands that buffer, together with the transmit buffer of the same index,
+// straight to the frame handler; nothing is copied.  The transmit buffer was
+// drained at the same time and is sent again one frame later, after the
+// other buffer.  The receive control structure is re-armed for the next pass
+// while the controller works on the other one.  If the handler ever holds
+// off the interrupt for a whole frame both buffers wait, the SSI FIFO fills
+// and the codec's further words are lost.  Streaming then picks up part way
+// through a frame, and if an odd number of words was lost, left and right
+// stay swapped: the driver only sees words, so it cannot tell which is
+// which.  Ring mode keeps the transfers running and does not lose words this
+// way.
+//
+// In ring mode each direction runs a peripheral scatter-gather task list
+// over AUDIO_SSI_NUM_BUFFERS frame buffers, and every buffer has an
+// ownership word.  Around each frame the task list has the controller copy
+// the ownership word aside and take the buffer as it starts on it, and hand
+// the buffer to the DSP when it is done, so buffers change hands without an
+// interrupt and the DSP never sees a buffer that is being transferred.
+// AudioSSIService() processes the frames the DSP owns from the main loop and
+// hands them back; it may fall up to AUDIO_SSI_NUM_BUFFERS - 1 frames behind
+// without losing samples.  The interrupt only restarts each list once per
+// pass and checks the copied ownership words: a receive buffer still owned
+// by the DSP when the controller began to refill it is an overrun, and a
+// transmit buffer still owned by the DSP when the controller began to send
+// it is an underrun.
+//
+// Only driverlib calls touch the hardware, so the driver runs unchanged on a
+// host build against a software model of the SSI and uDMA functions;
+// host/ssimodel.c is one.  The model pulses the frame once per stereo
+// sample as the codec does, so it loses the right words under SSI_FRF_TI,
+// but it cannot stand in for the check on the board.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_ssi.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/ssi.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/udma.h"
+#include "anc.h"
+#include "audio_in.h"
+#include "audio_ssi.h"
+#include "clock.h"
+#include "dma.h"
+
+//*****************************************************************************
+//
+//! \addtogroup audio_ssi_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// A frame must fit in one uDMA transfer, and ping-pong mode uses the first
+// two ring buffers.
+//
+//*****************************************************************************
+typedef char
+    AudioSSIFrameFits[(AUDIO_SSI_FRAME_WORDS <= 1024) ? 1 : -1];
+typedef char
+    AudioSSIRingFits[(AUDIO_SSI_NUM_BUFFERS >= 2) ? 1 : -1];
+
+//*****************************************************************************
+//
+// The nominal bit clock: 32 bits per stereo sample.  In slave mode it only
+// has to be within the range the SSI can follow.
+//
+//*****************************************************************************
+#define AUDIO_SSI_BIT_RATE(ui32Rate)                                          \
+                                ((ui32Rate) * 32)
+
+//*****************************************************************************
+//
+// The owners of a ring buffer, as held in its ownership word.
+//
+//*****************************************************************************
+#define AUDIO_SSI_OWNER_DMA     0
+#define AUDIO_SSI_OWNER_DSP     1
+
+//*****************************************************************************
+//
+// The ring task list holds four tasks per buffer: claim, which copies the
+// ownership word aside; acquire, which hands the buffer to the uDMA; the
+// frame itself; and release, which hands the buffer to the DSP.
+//
+//*****************************************************************************
+#define AUDIO_SSI_NUM_TASKS     (4 * AUDIO_SSI_NUM_BUFFERS)
+
+//*****************************************************************************
+//
+// The uDMA buffers.
+//
+//*****************************************************************************
+static int16_t g_ppi16AudioSSIRx[AUDIO_SSI_NUM_BUFFERS][AUDIO_SSI_FRAME_WORDS];
+static int16_t g_ppi16AudioSSITx[AUDIO_SSI_NUM_BUFFERS][AUDIO_SSI_FRAME_WORDS];
+
+//*****************************************************************************
+//
+// The ring bookkeeping: the ownership word of each buffer, the copy the
+// controller takes as it starts on the buffer, and the task lists.  The
+// controller reads and writes all of these, so they must be in SRAM; that
+// includes g_pui32AudioSSIOwners, the source of the acquire and release
+// tasks.
+//
+//*****************************************************************************
+static volatile uint32_t g_pui32AudioSSIRxOwner[AUDIO_SSI_NUM_BUFFERS];
+static volatile uint32_t g_pui32AudioSSITxOwner[AUDIO_SSI_NUM_BUFFERS];
+static volatile uint32_t g_pui32AudioSSIRxClaim[AUDIO_SSI_NUM_BUFFERS];
+static volatile uint32_t g_pui32AudioSSITxClaim[AUDIO_SSI_NUM_BUFFERS];
+static uint32_t g_pui32AudioSSIOwners[2] =
+{
+    AUDIO_SSI_OWNER_DMA, AUDIO_SSI_OWNER_DSP
+};
+static tDMAControlTable g_psAudioSSIRxTasks[AUDIO_SSI_NUM_TASKS];
+static tDMAControlTable g_psAudioSSITxTasks[AUDIO_SSI_NUM_TASKS];
+
+//*****************************************************************************
+//
+// The codec rate the SSI is set up for, and whether it is streaming.
+//
+//*****************************************************************************
+static uint32_t g_ui32AudioSSIRate;
+static bool g_bAudioSSIRunning;
+
+//*****************************************************************************
+//
+// The streaming mode, the frame handler, the next ring buffer to process,
+// the number of frames handed to the handler, and the number of overruns
+// and underruns.
+//
+//*****************************************************************************
+static uint32_t g_ui32AudioSSIMode;
+static tAudioSSIFrameHandler g_pfnAudioSSIHandler;
+static uint32_t g_ui32AudioSSINext;
+static volatile uint32_t g_ui32AudioSSIFrames;
+static volatile uint32_t g_ui32AudioSSIOverruns;
+static volatile uint32_t g_ui32AudioSSIUnderruns;
+
+//*****************************************************************************
+//
+// Arms one control structure of the receive channel for buffer ui32Buf.
+//
+//*****************************************************************************
+static void
+AudioSSIRxArm(uint32_t ui32Buf)
+{
+    uDMAChannelTransferSet(UDMA_CHANNEL_SSI0RX |
+                           (ui32Buf ? UDMA_ALT_SELECT : UDMA_PRI_SELECT),
+                           UDMA_MODE_PINGPONG,
+                           (void *)(SSI0_BASE + SSI_O_DR),
+                           g_ppi16AudioSSIRx[ui32Buf], AUDIO_SSI_FRAME_WORDS);
+}
+
+//*****************************************************************************
+//
+// Arms one control structure of the transmit channel for buffer ui32Buf.
+//
+//*****************************************************************************
+static void
+AudioSSITxArm(uint32_t ui32Buf)
+{
+    uDMAChannelTransferSet(UDMA_CHANNEL_SSI0TX |
+                           (ui32Buf ? UDMA_ALT_SELECT : UDMA_PRI_SELECT),
+                           UDMA_MODE_PINGPONG, g_ppi16AudioSSITx[ui32Buf],
+                           (void *)(SSI0_BASE + SSI_O_DR),
+                           AUDIO_SSI_FRAME_WORDS);
+}
+
+//*****************************************************************************
+//
+// Fills in one scatter-gather task the way uDMATaskStructEntry() does, for
+// task lists built at run time.  ui32Control holds the item size, the
+// increments and the arbitration size.  Every task waits for the SSI's
+// request; the last one is a basic transfer, so the channel stops and
+// interrupts at the end of the list.
+//
+//*****************************************************************************
+static void
+AudioSSITaskSet(tDMAControlTable *psTask, uint32_t ui32Control,
+                volatile void *pvSrc, volatile void *pvDst,
+                uint32_t ui32Count, bool bLast)
+{
+    uint32_t ui32SrcShift, ui32DstShift;
+
+    ui32SrcShift = (ui32Control & UDMA_SRC_INC_NONE) >> 26;
+    ui32DstShift = (ui32Control & UDMA_DST_INC_NONE) >> 30;
+
+    //
+    // The end addresses are those of the last byte moved; an increment
+    // field of 3 means no increment.
+    //
+    psTask->pvSrcEndAddr =
+        (void *)((uint8_t *)pvSrc +
+                 ((ui32SrcShift == 3) ? 0 :
+                  ((ui32Count << ui32SrcShift) - 1)));
+    psTask->pvDstEndAddr =
+        (void *)((uint8_t *)pvDst +
+                 ((ui32DstShift == 3) ? 0 :
+                  ((ui32Count << ui32DstShift) - 1)));
+    psTask->ui32Control = (ui32Control | ((ui32Count - 1) << 4) |
+                           (bLast ? UDMA_MODE_BASIC :
+                            (UDMA_MODE_PER_SCATTER_GATHER |
+                             UDMA_MODE_ALT_SELECT)));
+    psTask->ui32Spare = 0;
+}
+
+//*****************************************************************************
+//
+// Builds the task lists of both directions, starting each pass at buffer
+// ui32First.
+//
+//*****************************************************************************
+static void
+AudioSSIRingBuild(uint32_t ui32First)
+{
+    tDMAControlTable *psRx, *psTx;
+    uint32_t ui32Pos, ui32Buf;
+    bool bLast;
+
+    psRx = g_psAudioSSIRxTasks;
+    psTx = g_psAudioSSITxTasks;
+
+    for(ui32Pos = 0; ui32Pos < AUDIO_SSI_NUM_BUFFERS; ui32Pos++)
+    {
+        ui32Buf = (ui32First + ui32Pos) % AUDIO_SSI_NUM_BUFFERS;
+        bLast = (ui32Pos == (AUDIO_SSI_NUM_BUFFERS - 1));
+
+        AudioSSITaskSet(psRx++, (UDMA_SIZE_32 | UDMA_SRC_INC_NONE |
+                                 UDMA_DST_INC_NONE | UDMA_ARB_1),
+                        &g_pui32AudioSSIRxOwner[ui32Buf],
+                        &g_pui32AudioSSIRxClaim[ui32Buf], 1, false);
+        AudioSSITaskSet(psRx++, (UDMA_SIZE_32 | UDMA_SRC_INC_NONE |
+                                 UDMA_DST_INC_NONE | UDMA_ARB_1),
+                        &g_pui32AudioSSIOwners[AUDIO_SSI_OWNER_DMA],
+                        &g_pui32AudioSSIRxOwner[ui32Buf], 1, false);
+        AudioSSITaskSet(psRx++, (UDMA_SIZE_16 | UDMA_SRC_INC_NONE |
+                                 UDMA_DST_INC_16 | UDMA_ARB_4),
+                        (void *)(SSI0_BASE + SSI_O_DR),
+                        g_ppi16AudioSSIRx[ui32Buf], AUDIO_SSI_FRAME_WORDS,
+                        false);
+        AudioSSITaskSet(psRx++, (UDMA_SIZE_32 | UDMA_SRC_INC_NONE |
+                                 UDMA_DST_INC_NONE | UDMA_ARB_1),
+                        &g_pui32AudioSSIOwners[AUDIO_SSI_OWNER_DSP],
+                        &g_pui32AudioSSIRxOwner[ui32Buf], 1, bLast);
+
+        AudioSSITaskSet(psTx++, (UDMA_SIZE_32 | UDMA_SRC_INC_NONE |
+                                 UDMA_DST_INC_NONE | UDMA_ARB_1),
+                        &g_pui32AudioSSITxOwner[ui32Buf],
+                        &g_pui32AudioSSITxClaim[ui32Buf], 1, false);
+        AudioSSITaskSet(psTx++, (UDMA_SIZE_32 | UDMA_SRC_INC_NONE |
+                                 UDMA_DST_INC_NONE | UDMA_ARB_1),
+                        &g_pui32AudioSSIOwners[AUDIO_SSI_OWNER_DMA],
+                        &g_pui32AudioSSITxOwner[ui32Buf], 1, false);
+        AudioSSITaskSet(psTx++, (UDMA_SIZE_16 | UDMA_SRC_INC_16 |
+                                 UDMA_DST_INC_NONE | UDMA_ARB_4),
+                        g_ppi16AudioSSITx[ui32Buf],
+                        (void *)(SSI0_BASE + SSI_O_DR),
+                        AUDIO_SSI_FRAME_WORDS, false);
+        AudioSSITaskSet(psTx++, (UDMA_SIZE_32 | UDMA_SRC_INC_NONE |
+                                 UDMA_DST_INC_NONE | UDMA_ARB_1),
+                        &g_pui32AudioSSIOwners[AUDIO_SSI_OWNER_DSP],
+                        &g_pui32AudioSSITxOwner[ui32Buf], 1, bLast);
+    }
+}
+
+//*****************************************************************************
+//
+// Configures SSI0 for frames at ui32Rate and arms both uDMA channels for the
+// first pass, starting at ring buffer ui32First in ring mode.
+//
+//*****************************************************************************
+static void
+AudioSSIConfigure(uint32_t ui32Rate, uint32_t ui32First)
+{
+    g_ui32AudioSSIRate = ui32Rate;
+    SSIConfigSetExpClk(SSI0_BASE, SysCtlClockGet(), AUDIO_SSI_FRAME_FORMAT,
+                       SSI_MODE_SLAVE, AUDIO_SSI_BIT_RATE(ui32Rate), 16);
+
+    //
+    // A transfer stopped part way may have left the channels on their
+    // alternate control structures.
+    //
+    uDMAChannelAttributeDisable(UDMA_CHANNEL_SSI0RX, UDMA_ATTR_ALTSELECT);
+    uDMAChannelAttributeDisable(UDMA_CHANNEL_SSI0TX, UDMA_ATTR_ALTSELECT);
+
+    if(g_ui32AudioSSIMode == AUDIO_SSI_MODE_RING)
+    {
+        //
+        // The lists are set up here only; every pass replays them
+        // unchanged.
+        //
+        AudioSSIRingBuild(ui32First);
+        uDMAChannelScatterGatherSet(UDMA_CHANNEL_SSI0RX, AUDIO_SSI_NUM_TASKS,
+                                    g_psAudioSSIRxTasks, 1);
+        uDMAChannelScatterGatherSet(UDMA_CHANNEL_SSI0TX, AUDIO_SSI_NUM_TASKS,
+                                    g_psAudioSSITxTasks, 1);
+    }
+    else
+    {
+        //
+        // Both channels move 16-bit words between the data register and the
+        // buffers, four at a time to match the FIFO half-full request.
+        //
+        uDMAChannelControlSet(UDMA_CHANNEL_SSI0RX | UDMA_PRI_SELECT,
+                              UDMA_SIZE_16 | UDMA_SRC_INC_NONE |
+                              UDMA_DST_INC_16 | UDMA_ARB_4);
+        uDMAChannelControlSet(UDMA_CHANNEL_SSI0RX | UDMA_ALT_SELECT,
+                              UDMA_SIZE_16 | UDMA_SRC_INC_NONE |
+                              UDMA_DST_INC_16 | UDMA_ARB_4);
+        uDMAChannelControlSet(UDMA_CHANNEL_SSI0TX | UDMA_PRI_SELECT,
+                              UDMA_SIZE_16 | UDMA_SRC_INC_16 |
+                              UDMA_DST_INC_NONE | UDMA_ARB_4);
+        uDMAChannelControlSet(UDMA_CHANNEL_SSI0TX | UDMA_ALT_SELECT,
+                              UDMA_SIZE_16 | UDMA_SRC_INC_16 |
+                              UDMA_DST_INC_NONE | UDMA_ARB_4);
+        AudioSSIRxArm(0);
+        AudioSSIRxArm(1);
+        AudioSSITxArm(0);
+        AudioSSITxArm(1);
+    }
+
+    SSIDMAEnable(SSI0_BASE, SSI_DMA_RX | SSI_DMA_TX);
+}
+
+//*****************************************************************************
+//
+// Follows a change of the system clock.  As a slave the SSI takes its bit
+// clock from the codec, but it is set up for the system clock all the same,
+// and that can only be done with it disabled.  Streaming pauses for the few
+// register writes and picks up again at the next frame sync.
+//
+//*****************************************************************************
+static void
+AudioSSIClockSet(uint32_t ui32Clock)
+{
+    if(g_bAudioSSIRunning)
+    {
+        SSIDisable(SSI0_BASE);
+    }
+    SSIConfigSetExpClk(SSI0_BASE, ui32Clock, AUDIO_SSI_FRAME_FORMAT,
+                       SSI_MODE_SLAVE, AUDIO_SSI_BIT_RATE(g_ui32AudioSSIRate),
+                       16);
+    if(g_bAudioSSIRunning)
+    {
+        SSIEnable(SSI0_BASE);
+    }
+}
+
+//*****************************************************************************
+//
+// Refuses a system clock the SSI cannot follow the codec at.  A slave needs
+// a system clock of at least twelve times its bit clock, and driverlib
+// asserts as much when the SSI is set up, so the check holds whether or not
+// streaming is running.
+//
+//*****************************************************************************
+static bool
+AudioSSIClockCheck(uint32_t ui32Clock)
+{
+    return(AUDIO_SSI_BIT_RATE(g_ui32AudioSSIRate) <= (ui32Clock / 12));
+}
+
+//*****************************************************************************
+//
+//! Initializes the codec streaming driver.
+//!
+//! \param pfnHandler is the function that processes each received frame into
+//! an output frame.
+//! \param ui32Mode is the streaming mode, either \b AUDIO_SSI_MODE_PINGPONG
+//! or \b AUDIO_SSI_MODE_RING.
+//!
+//! SSI0 is set up on PA2 to PA5 for frames at \b CODEC_RATE and both uDMA
+//! channels are armed; streaming starts with AudioSSIStart().  The output
+//! buffers start silent.  From here on ClockProfileSet() refuses a profile
+//! whose clock is too slow for the SSI to follow the codec's bit clock.
+//!
+//! In ping-pong mode \e pfnHandler is called from the SSI interrupt and must
+//! finish within a frame.  In ring mode it is called from
+//! AudioSSIService(), and each output frame goes out
+//! \b AUDIO_SSI_NUM_BUFFERS frames after its input frame came in.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+AudioSSIInit(tAudioSSIFrameHandler pfnHandler, uint32_t ui32Mode)
+{
+    uint32_t ui32Buf, ui32Idx;
+
+    g_ui32AudioSSIMode = ui32Mode;
+    g_pfnAudioSSIHandler = pfnHandler;
+    g_ui32AudioSSINext = 0;
+    g_ui32AudioSSIFrames = 0;
+    g_ui32AudioSSIOverruns = 0;
+    g_ui32AudioSSIUnderruns = 0;
+    for(ui32Buf = 0; ui32Buf < AUDIO_SSI_NUM_BUFFERS; ui32Buf++)
+    {
+        for(ui32Idx = 0; ui32Idx < AUDIO_SSI_FRAME_WORDS; ui32Idx++)
+        {
+            g_ppi16AudioSSITx[ui32Buf][ui32Idx] = 0;
+        }
+        g_pui32AudioSSIRxOwner[ui32Buf] = AUDIO_SSI_OWNER_DMA;
+        g_pui32AudioSSITxOwner[ui32Buf] = AUDIO_SSI_OWNER_DMA;
+    }
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_SSI0);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
+    while(!SysCtlPeripheralReady(SYSCTL_PERIPH_SSI0) ||
+          !SysCtlPeripheralReady(SYSCTL_PERIPH_GPIOA))
+    {
+    }
+
+    GPIOPinConfigure(GPIO_PA2_SSI0CLK);
+    GPIOPinConfigure(GPIO_PA3_SSI0FSS);
+    GPIOPinConfigure(GPIO_PA4_SSI0RX);
+    GPIOPinConfigure(GPIO_PA5_SSI0TX);
+    GPIOPinTypeSSI(GPIO_PORTA_BASE,
+                   GPIO_PIN_2 | GPIO_PIN_3 | GPIO_PIN_4 | GPIO_PIN_5);
+
+    DMAInit();
+    uDMAChannelAssign(UDMA_CH10_SSI0RX);
+    uDMAChannelAssign(UDMA_CH11_SSI0TX);
+    uDMAChannelAttributeDisable(UDMA_CHANNEL_SSI0RX, UDMA_ATTR_ALL);
+    uDMAChannelAttributeDisable(UDMA_CHANNEL_SSI0TX, UDMA_ATTR_ALL);
+
+    AudioSSIConfigure(CODEC_RATE, 0);
+    ClockHookRegister(AudioSSIClockSet);
+    ClockCheckRegister(AudioSSIClockCheck);
+}
+
+//*****************************************************************************
+//
+//! Starts streaming.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+AudioSSIStart(void)
+{
+    uDMAChannelEnable(UDMA_CHANNEL_SSI0RX);
+    uDMAChannelEnable(UDMA_CHANNEL_SSI0TX);
+    IntEnable(INT_SSI0);
+    SSIEnable(SSI0_BASE);
+    g_bAudioSSIRunning = true;
+}
+
+//*****************************************************************************
+//
+//! Stops streaming.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+AudioSSIStop(void)
+{
+    g_bAudioSSIRunning = false;
+    SSIDisable(SSI0_BASE);
+    IntDisable(INT_SSI0);
+    uDMAChannelDisable(UDMA_CHANNEL_SSI0RX);
+    uDMAChannelDisable(UDMA_CHANNEL_SSI0TX);
+}
+
+//*****************************************************************************
+//
+//! Restarts streaming at a new sample rate.
+//!
+//! \param ui32Rate is the new codec sample rate in Hz.
+//!
+//! This is meant to be called while the codec's interface is inactive, so
+//! that no clocks arrive while the SSI is reconfigured.  The SSI is reset,
+//! which drops any part frame left in its FIFOs and so keeps the left and
+//! right words in step, and is set up again for the new bit clock.
+//!
+//! In ring mode, the frames the DSP owns should first be processed with
+//! AudioSSIService(); any left are dropped.  So is the last frame received
+//! before the interface went quiet: the task that hands it to the DSP waits
+//! for a receive request, and none comes before the reset.  The lists are
+//! rebuilt to start at the next buffer in processing order, which is also
+//! the buffer the transfer stopped in, so the processed frames still waiting
+//! in the ring are sent after the restart and the ring carries on where it
+//! left off.
+//! The frame and error counts are kept.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+AudioSSIRateSet(uint32_t ui32Rate)
+{
+    uint32_t ui32Buf;
+
+    AudioSSIStop();
+    SysCtlPeripheralReset(SYSCTL_PERIPH_SSI0);
+    while(!SysCtlPeripheralReady(SYSCTL_PERIPH_SSI0))
+    {
+    }
+    IntPendClear(INT_SSI0);
+
+    for(ui32Buf = 0; ui32Buf < AUDIO_SSI_NUM_BUFFERS; ui32Buf++)
+    {
+        g_pui32AudioSSIRxOwner[ui32Buf] = AUDIO_SSI_OWNER_DMA;
+        g_pui32AudioSSITxOwner[ui32Buf] = AUDIO_SSI_OWNER_DMA;
+    }
+    AudioSSIConfigure(ui32Rate, g_ui32AudioSSINext);
+
+    AudioSSIStart();
+}
+
+//*****************************************************************************
+//
+//! Processes the received frames waiting in the ring.
+//!
+//! In ring mode this should be called from the main loop at least once per
+//! frame on average.  Every receive buffer the DSP owns is passed to the
+//! frame handler, oldest first, together with the transmit buffer of the
+//! same index, and both are then handed back to the uDMA.  It does nothing
+//! in ping-pong mode.
+//!
+//! \return Returns the number of frames processed.
+//
+//*****************************************************************************
+uint32_t
+AudioSSIService(void)
+{
+    uint32_t ui32Buf, ui32Count;
+
+    if(g_ui32AudioSSIMode != AUDIO_SSI_MODE_RING)
+    {
+        return(0);
+    }
+
+    ui32Count = 0;
+    ui32Buf = g_ui32AudioSSINext;
+    while(g_pui32AudioSSIRxOwner[ui32Buf] == AUDIO_SSI_OWNER_DSP)
+    {
+        g_pfnAudioSSIHandler(g_ppi16AudioSSIRx[ui32Buf],
+                             g_ppi16AudioSSITx[ui32Buf]);
+
+        g_pui32AudioSSITxOwner[ui32Buf] = AUDIO_SSI_OWNER_DMA;
+        g_pui32AudioSSIRxOwner[ui32Buf] = AUDIO_SSI_OWNER_DMA;
+        g_ui32AudioSSIFrames++;
+        ui32Count++;
+
+        ui32Buf = (ui32Buf + 1) % AUDIO_SSI_NUM_BUFFERS;
+    }
+    g_ui32AudioSSINext = ui32Buf;
+
+    return(ui32Count);
+}
+
+//*****************************************************************************
+//
+//! Returns the number of frames processed since AudioSSIInit().
+//!
+//! The main loop can poll this to run per-frame housekeeping outside the
+//! interrupt.
+//!
+//! \return Returns the frame count.
+//
+//*****************************************************************************
+uint32_t
+AudioSSIFrameCountGet(void)
+{
+    return(g_ui32AudioSSIFrames);
+}
+
+//*****************************************************************************
+//
+//! Returns the number of receive overruns since AudioSSIInit().
+//!
+//! An overrun is a received frame that was overwritten before it could be
+//! processed.  In ping-pong mode it is counted when the receive channel had
+//! stopped for lack of a free buffer; in ring mode, for every buffer the
+//! controller began to refill while the DSP still owned it.
+//!
+//! \return Returns the overrun count.
+//
+//*****************************************************************************
+uint32_t
+AudioSSIOverrunCountGet(void)
+{
+    return(g_ui32AudioSSIOverruns);
+}
+
+//*****************************************************************************
+//
+//! Returns the number of transmit underruns since AudioSSIInit().
+//!
+//! An underrun is an output frame that was sent before it was written, so
+//! the codec played stale samples for a frame.
+//!
+//! \return Returns the underrun count.
+//
+//*****************************************************************************
+uint32_t
+AudioSSIUnderrunCountGet(void)
+{
+    return(g_ui32AudioSSIUnderruns);
+}
+
+//*****************************************************************************
+//
+// Handles the SSI0 interrupt in ring mode.  A disabled channel has run its
+// whole task list.  The claim copies tell which of its buffers were lost;
+// they are checked before the list restarts and overwrites them.  The SSI
+// FIFO holds eight words, which covers the interrupt latency between passes.
+//
+//*****************************************************************************
+static void
+AudioSSIRingInt(void)
+{
+    uint32_t ui32Buf;
+
+    if(!uDMAChannelIsEnabled(UDMA_CHANNEL_SSI0RX))
+    {
+        for(ui32Buf = 0; ui32Buf < AUDIO_SSI_NUM_BUFFERS; ui32Buf++)
+        {
+            if(g_pui32AudioSSIRxClaim[ui32Buf] == AUDIO_SSI_OWNER_DSP)
+            {
+                g_ui32AudioSSIOverruns++;
+            }
+        }
+
+        uDMAChannelScatterGatherSet(UDMA_CHANNEL_SSI0RX, AUDIO_SSI_NUM_TASKS,
+                                    g_psAudioSSIRxTasks, 1);
+        uDMAChannelEnable(UDMA_CHANNEL_SSI0RX);
+    }
+
+    if(!uDMAChannelIsEnabled(UDMA_CHANNEL_SSI0TX))
+    {
+        for(ui32Buf = 0; ui32Buf < AUDIO_SSI_NUM_BUFFERS; ui32Buf++)
+        {
+            if(g_pui32AudioSSITxClaim[ui32Buf] == AUDIO_SSI_OWNER_DSP)
+            {
+                g_ui32AudioSSIUnderruns++;
+            }
+        }
+
+        uDMAChannelScatterGatherSet(UDMA_CHANNEL_SSI0TX, AUDIO_SSI_NUM_TASKS,
+                                    g_psAudioSSITxTasks, 1);
+        uDMAChannelEnable(UDMA_CHANNEL_SSI0TX);
+    }
+}
+
+//*****************************************************************************
+//
+// Handles the SSI0 interrupt in ping-pong mode.  A control structure reading
+// UDMA_MODE_STOP has finished; the other one is already in use.
+//
+//*****************************************************************************
+static void
+AudioSSIPingPongInt(void)
+{
+    uint32_t ui32Buf;
+
+    for(ui32Buf = 0; ui32Buf < 2; ui32Buf++)
+    {
+        //
+        // A drained transmit buffer goes straight back in the queue.  It is
+        // not read again until the other buffer has been sent, by which time
+        // the matching receive buffer has been processed into it.
+        //
+        if(uDMAChannelModeGet(UDMA_CHANNEL_SSI0TX |
+                              (ui32Buf ? UDMA_ALT_SELECT : UDMA_PRI_SELECT)) ==
+           UDMA_MODE_STOP)
+        {
+            AudioSSITxArm(ui32Buf);
+        }
+
+        if(uDMAChannelModeGet(UDMA_CHANNEL_SSI0RX |
+                              (ui32Buf ? UDMA_ALT_SELECT : UDMA_PRI_SELECT)) ==
+           UDMA_MODE_STOP)
+        {
+            g_pfnAudioSSIHandler(g_ppi16AudioSSIRx[ui32Buf],
+                                 g_ppi16AudioSSITx[ui32Buf]);
+            AudioSSIRxArm(ui32Buf);
+            g_ui32AudioSSIFrames++;
+        }
+    }
+
+    //
+    // If processing ever overran a whole frame both structures stopped and
+    // the controller disabled the channel; pick up where it left off.
+    //
+    if(!uDMAChannelIsEnabled(UDMA_CHANNEL_SSI0RX))
+    {
+        uDMAChannelEnable(UDMA_CHANNEL_SSI0RX);
+        g_ui32AudioSSIOverruns++;
+    }
+    if(!uDMAChannelIsEnabled(UDMA_CHANNEL_SSI0TX))
+    {
+        uDMAChannelEnable(UDMA_CHANNEL_SSI0TX);
+        g_ui32AudioSSIUnderruns++;
+    }
+}
+
+//*****************************************************************************
+//
+// The SSI0 interrupt handler, entered when either uDMA channel completes a
+// buffer in ping-pong mode, or a pass over the ring in ring mode.
+//
+//*****************************************************************************
+void
+SSI0_Handler(void)
+{
+    SSIIntClear(SSI0_BASE, SSIIntStatus(SSI0_BASE, true));
+
+    if(g_ui32AudioSSIMode == AUDIO_SSI_MODE_RING)
+    {
+        AudioSSIRingInt();
+    }
+    else
+    {
+        AudioSSIPingPongInt();
+    }
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -0,0 +1,93 @@
+//*****************************************************************************
+//
+// audio_ssi.h - Prototypes for the SSI and uDMA codec streaming driver.
+//
+//*****************************************************************************
+
+#ifndef __AUDIO_SSI_H__
+#define __AUDIO_SSI_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The number of 16-bit SSI words in one frame: a left and a right word per
+// stereo sample.
+//
+//*****************************************************************************
+#define AUDIO_SSI_FRAME_WORDS   (2 * AUDIO_FRAME_SIZE)
+
+//*****************************************************************************
+//
+// The number of frame buffers per direction in ring mode.  The main loop may
+// fall up to one less than this many frames behind, at the cost of as many
+// frames of delay.
+//
+//*****************************************************************************
+#ifndef AUDIO_SSI_NUM_BUFFERS
+#define AUDIO_SSI_NUM_BUFFERS   4
+#endif
+
+//*****************************************************************************
+//
+// The SSI frame format, one of driverlib's SSI_FRF_* values.  The codec
+// pulses LRC once per stereo sample in DSP mode, and Freescale SPI mode 1
+// takes both words of the sample under that one pulse; see audio_ssi.c.
+//
+//*****************************************************************************
+#ifndef AUDIO_SSI_FRAME_FORMAT
+#define AUDIO_SSI_FRAME_FORMAT  SSI_FRF_MOTO_MODE_1
+#endif
+
+//*****************************************************************************
+//
+// Values that can be passed to AudioSSIInit() as the ui32Mode parameter.
+//
+//*****************************************************************************
+#define AUDIO_SSI_MODE_PINGPONG 0x00000000  // Two buffers, handler in ISR
+#define AUDIO_SSI_MODE_RING     0x00000001  // Scatter-gather buffer ring
+
+//*****************************************************************************
+//
+// The frame handler, called from the SSI interrupt in ping-pong mode and from
+// AudioSSIService() in ring mode.  pi16In holds one frame of interleaved
+// codec samples just received, and pi16Out is the buffer that will be sent
+// for it.  Both are the uDMA buffers themselves.
+//
+//*****************************************************************************
+typedef void (*tAudioSSIFrameHandler)(int16_t *pi16In, int16_t *pi16Out);
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern void AudioSSIInit(tAudioSSIFrameHandler pfnHandler,
+                         uint32_t ui32Mode);
+extern void AudioSSIStart(void);
+extern void AudioSSIStop(void);
+extern void AudioSSIRateSet(uint32_t ui32Rate);
+extern uint32_t AudioSSIService(void);
+extern uint32_t AudioSSIFrameCountGet(void);
+extern uint32_t AudioSSIOverrunCountGet(void);
+extern uint32_t AudioSSIUnderrunCountGet(void);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __AUDIO_SSI_H__
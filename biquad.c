@@ -0,0 +1,273 @@
+//*****************************************************************************
+//
+// biquad.c - Q15 biquad cascade for DC removal and input pre-conditioning.
+//
+// The line inputs of the WM8731 carry a DC offset and subsonic rumble that
+// eat into the canceller's dynamic range and slow its convergence.  This
+// cascade runs directly on the interleaved 16-bit codec stream, in place,
+// before the samples are split into the canceller inputs.
+//
+// Each stage is a direct form I section.  The five products are formed with
+// two dual 16x16 MACs (SMLAD) and one single MAC per sample, with Q15 data
+// and Q14 coefficients.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "dsp_q15.h"
+#include "biquad.h"
+#include "perf.h"
+#include "ramfunc.h"
+
+//*****************************************************************************
+//
+//! \addtogroup biquad_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The placement of the cascade kernel.
+//
+//*****************************************************************************
+#if BIQUAD_KERNEL_IN_RAM
+#define BIQUAD_KERNEL           RAMFUNC
+#else
+#define BIQUAD_KERNEL
+#endif
+
+//*****************************************************************************
+//
+//! Initializes a biquad cascade.
+//!
+//! \param psCascade is a pointer to the cascade state.
+//! \param psCoeffs points to \e ui32NumStages coefficient sets, typically a
+//! const table built with the \b BIQUAD_ macros.
+//! \param ui32NumStages is the number of stages, up to
+//! \b BIQUAD_MAX_STAGES.
+//! \param ui32NumChannels is the number of interleaved channels, up to
+//! \b BIQUAD_MAX_CHANNELS.  Every channel runs the same cascade with its own
+//! history.
+//!
+//! \return Returns \b true on success or \b false if the dimensions are not
+//! supported.
+//
+//*****************************************************************************
+bool
+BiquadCascadeInit(tBiquadCascade *psCascade, const tBiquadCoeffs *psCoeffs,
+                  uint32_t ui32NumStages, uint32_t ui32NumChannels)
+{
+    if((ui32NumStages > BIQUAD_MAX_STAGES) || (ui32NumChannels == 0) ||
+       (ui32NumChannels > BIQUAD_MAX_CHANNELS))
+    {
+        return(false);
+    }
+
+    memset(psCascade, 0, sizeof(tBiquadCascade));
+    psCascade->psCoeffs = psCoeffs;
+    psCascade->ui32NumStages = ui32NumStages;
+    psCascade->ui32NumChannels = ui32NumChannels;
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Changes the coefficients of a running cascade.
+//!
+//! \param psCascade is a pointer to the cascade state.
+//! \param psCoeffs points to the new coefficient sets, one per stage.
+//!
+//! The stage count and the history are kept, so the filter carries on from
+//! its current state, e.g. with a table designed for a new sample rate.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+BiquadCascadeCoeffsSet(tBiquadCascade *psCascade,
+                       const tBiquadCoeffs *psCoeffs)
+{
+    psCascade->psCoeffs = psCoeffs;
+}
+
+//*****************************************************************************
+//
+//! Filters a block of interleaved samples in place.
+//!
+//! \param psCascade is a pointer to the cascade state.
+//! \param pi16Data points to \e ui32Frames frames of interleaved Q15
+//! samples, one per channel per frame.
+//! \param ui32Frames is the number of frames.
+//!
+//! Stages are applied one after the other over the whole block; within a
+//! stage each channel is run over the block with its history held in
+//! registers, stepping through the interleaved data by the channel count.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void BIQUAD_KERNEL
+BiquadCascadeProcess(tBiquadCascade *psCascade, int16_t *pi16Data,
+                     uint32_t ui32Frames)
+{
+    const tBiquadCoeffs *psCoeffs;
+    tBiquadHistory *psHist;
+    uint32_t ui32Stage, ui32Chan, ui32N, ui32Stride;
+    uint32_t ui32B0B1, ui32B2A1;
+    int32_t i32A2, i32Acc, i32Y, i32Rem;
+    int16_t i16X0, i16X1, i16X2, i16Y1, i16Y2;
+    int16_t *pi16Sample;
+
+    ui32Stride = psCascade->ui32NumChannels;
+    for(ui32Stage = 0; ui32Stage < psCascade->ui32NumStages; ui32Stage++)
+    {
+        psCoeffs = &psCascade->psCoeffs[ui32Stage];
+        ui32B0B1 = psCoeffs->ui32B0B1;
+        ui32B2A1 = psCoeffs->ui32B2A1;
+        i32A2 = psCoeffs->i32A2;
+
+        for(ui32Chan = 0; ui32Chan < ui32Stride; ui32Chan++)
+        {
+            psHist = &psCascade->psHistory[ui32Stage][ui32Chan];
+            i16X1 = psHist->i16X1;
+            i16X2 = psHist->i16X2;
+            i16Y1 = psHist->i16Y1;
+            i16Y2 = psHist->i16Y2;
+            i32Rem = psHist->i32Rem;
+
+            pi16Sample = &pi16Data[ui32Chan];
+            for(ui32N = 0; ui32N < ui32Frames; ui32N++)
+            {
+                i16X0 = *pi16Sample;
+
+                //
+                // b0 x(n) + b1 x(n-1), then b2 x(n-2) + a1 y(n-1), then
+                // a2 y(n-2), on top of the previous rounding remainder.
+                //
+                i32Acc = DSPSmlad(ui32B0B1, DSP_PACK16(i16X0, i16X1), i32Rem);
+                i32Acc = DSPSmlad(ui32B2A1, DSP_PACK16(i16X2, i16Y1), i32Acc);
+                i32Acc += i32A2 * i16Y2;
+
+                //
+                // Back to Q15, keeping the bits shifted out for the next
+                // sample unless the output clipped.
+                //
+                i32Y = i32Acc >> 14;
+                if((i32Y > Q15_MAX) || (i32Y < Q15_MIN))
+                {
+                    i32Y = DSPSat16(i32Y);
+                    i32Rem = 0;
+                }
+                else
+                {
+                    i32Rem = i32Acc & 0x3fff;
+                }
+
+                i16X2 = i16X1;
+                i16X1 = i16X0;
+                i16Y2 = i16Y1;
+                i16Y1 = (int16_t)i32Y;
+                *pi16Sample = (int16_t)i32Y;
+                pi16Sample += ui32Stride;
+            }
+
+            psHist->i16X1 = i16X1;
+            psHist->i16X2 = i16X2;
+            psHist->i16Y1 = i16Y1;
+            psHist->i16Y2 = i16Y2;
+            psHist->i32Rem = i32Rem;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// The state of BiquadBenchmark() between its steps.
+//
+//*****************************************************************************
+typedef struct
+{
+    tBiquadCascade sCascade;
+    int16_t *pi16Scratch;
+    uint32_t ui32Frames;
+}
+tBiquadBenchmark;
+
+//*****************************************************************************
+//
+// Loads the test signal for one run of BiquadBenchmark().
+//
+//*****************************************************************************
+static void
+BiquadBenchmarkSetup(void *pvArg)
+{
+    tBiquadBenchmark *psBench;
+
+    psBench = (tBiquadBenchmark *)pvArg;
+    PerfPatternFill16(psBench->pi16Scratch,
+                      (psBench->ui32Frames *
+                       psBench->sCascade.ui32NumChannels));
+}
+
+//*****************************************************************************
+//
+// Runs the block timed by BiquadBenchmark().
+//
+//*****************************************************************************
+static void
+BiquadBenchmarkBlock(void *pvArg)
+{
+    tBiquadBenchmark *psBench;
+
+    psBench = (tBiquadBenchmark *)pvArg;
+    BiquadCascadeProcess(&psBench->sCascade, psBench->pi16Scratch,
+                         psBench->ui32Frames);
+}
+
+//*****************************************************************************
+//
+//! Measures the cost of one block of a cascade.
+//!
+//! \param psCoeffs points to the coefficient sets, as for BiquadCascadeInit().
+//! \param ui32NumStages is the number of stages.
+//! \param ui32NumChannels is the number of interleaved channels.
+//! \param pi16Scratch points to a buffer of \e ui32Frames times
+//! \e ui32NumChannels samples.
+//! \param ui32Frames is the number of sample frames in a block.
+//!
+//! BiquadCascadeProcess() is timed with PerfBenchmarkRun() on the full-scale
+//! test signal.  Building with \b BIQUAD_KERNEL_IN_RAM set each way compares
+//! the kernel placements.
+//!
+//! \return Returns the cost of one block, or 0 if the dimensions are not
+//! supported.
+//
+//*****************************************************************************
+uint32_t
+BiquadBenchmark(const tBiquadCoeffs *psCoeffs, uint32_t ui32NumStages,
+                uint32_t ui32NumChannels, int16_t *pi16Scratch,
+                uint32_t ui32Frames)
+{
+    tBiquadBenchmark sBench;
+
+    if(!BiquadCascadeInit(&sBench.sCascade, psCoeffs, ui32NumStages,
+                          ui32NumChannels))
+    {
+        return(0);
+    }
+    sBench.pi16Scratch = pi16Scratch;
+    sBench.ui32Frames = ui32Frames;
+
+    return(PerfBenchmarkRun(BiquadBenchmarkSetup, BiquadBenchmarkBlock,
+                            &sBench));
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -0,0 +1,183 @@
+//*****************************************************************************
+//
+// biquad.h - Prototypes and coefficient macros for the biquad cascade.
+//
+//*****************************************************************************
+
+#ifndef __BIQUAD_H__
+#define __BIQUAD_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The largest cascade and channel count an instance can hold.
+//
+//*****************************************************************************
+#define BIQUAD_MAX_STAGES       4
+#define BIQUAD_MAX_CHANNELS     2
+
+//*****************************************************************************
+//
+// Set to 1 to run BiquadCascadeProcess() from SRAM, or 0 to leave it in
+// flash.  See ramfunc.h.
+//
+//*****************************************************************************
+#ifndef BIQUAD_KERNEL_IN_RAM
+#define BIQUAD_KERNEL_IN_RAM    1
+#endif
+
+//*****************************************************************************
+//
+// The coefficients of one stage, in Q14 so that |a1| up to 2 fits, packed
+// for the dual 16-bit MAC:
+//
+//     y(n) = b0 x(n) + b1 x(n-1) + b2 x(n-2) + a1 y(n-1) + a2 y(n-2)
+//
+// The feedback coefficients are stored with the sign that makes every term a
+// sum, i.e. negated with respect to the usual transfer-function form.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t ui32B0B1;
+    uint32_t ui32B2A1;
+    int32_t i32A2;
+}
+tBiquadCoeffs;
+
+//*****************************************************************************
+//
+// Builds a tBiquadCoeffs initializer from real-valued coefficients given in
+// transfer-function form (a1 and a2 not negated).  Everything here is a
+// constant expression, so tables built with it are computed by the compiler
+// and placed in flash.
+//
+//*****************************************************************************
+#define BIQUAD_Q14(f)           ((int16_t)((f) * 16384.0 + (((f) < 0) ? -0.5 :\
+                                                            0.5)))
+#define BIQUAD_COEFFS(b0, b1, b2, a1, a2)                                     \
+        {                                                                     \
+            DSP_PACK16(BIQUAD_Q14(b0), BIQUAD_Q14(b1)),                       \
+            DSP_PACK16(BIQUAD_Q14(b2), BIQUAD_Q14(-(a1))),                    \
+            BIQUAD_Q14(-(a2))                                                 \
+        }
+
+//*****************************************************************************
+//
+// The bilinear-transform prewarp K = tan(pi fc / fs), as a series so that it
+// stays a constant expression.  Accurate to better than 1e-6 for corners up
+// to fs / 10.
+//
+//*****************************************************************************
+#define BIQUAD_T(fc, fs)        (3.14159265358979 * (fc) / (fs))
+#define BIQUAD_K(fc, fs)                                                      \
+        (BIQUAD_T(fc, fs) *                                                   \
+         (1.0 + (BIQUAD_T(fc, fs) * BIQUAD_T(fc, fs)) *                       \
+          ((1.0 / 3.0) + (BIQUAD_T(fc, fs) * BIQUAD_T(fc, fs)) *              \
+           ((2.0 / 15.0) + (BIQUAD_T(fc, fs) * BIQUAD_T(fc, fs)) *            \
+            ((17.0 / 315.0) + (BIQUAD_T(fc, fs) * BIQUAD_T(fc, fs)) *         \
+             (62.0 / 2835.0))))))
+
+//*****************************************************************************
+//
+// A first-order high-pass at fc, as a biquad stage.  Its single real pole is
+// quantized directly, so it stays accurate in Q14 even for corners of a few
+// tens of Hz at 48 kHz; cascade two for a second-order DC and rumble filter.
+//
+//*****************************************************************************
+#define BIQUAD_HPF1(fc, fs)                                                   \
+        BIQUAD_COEFFS(1.0 / (1.0 + BIQUAD_K(fc, fs)),                         \
+                      -1.0 / (1.0 + BIQUAD_K(fc, fs)),                        \
+                      0.0,                                                    \
+                      (BIQUAD_K(fc, fs) - 1.0) / (BIQUAD_K(fc, fs) + 1.0),    \
+                      0.0)
+
+//*****************************************************************************
+//
+// A second-order Butterworth high-pass at fc.  The complex pole pair is
+// sensitive to a1 quantization when fc / fs is small; keep fc / fs above
+// about 1 / 300 in Q14 and use BIQUAD_HPF1 stages below that.
+//
+//*****************************************************************************
+#define BIQUAD_HPF2_N(fc, fs)                                                 \
+        (1.0 / (1.0 + (1.41421356237310 * BIQUAD_K(fc, fs)) +                 \
+                (BIQUAD_K(fc, fs) * BIQUAD_K(fc, fs))))
+#define BIQUAD_HPF2(fc, fs)                                                   \
+        BIQUAD_COEFFS(BIQUAD_HPF2_N(fc, fs),                                  \
+                      -2.0 * BIQUAD_HPF2_N(fc, fs),                           \
+                      BIQUAD_HPF2_N(fc, fs),                                  \
+                      2.0 * ((BIQUAD_K(fc, fs) * BIQUAD_K(fc, fs)) - 1.0) *   \
+                      BIQUAD_HPF2_N(fc, fs),                                  \
+                      (1.0 - (1.41421356237310 * BIQUAD_K(fc, fs)) +          \
+                       (BIQUAD_K(fc, fs) * BIQUAD_K(fc, fs))) *               \
+                      BIQUAD_HPF2_N(fc, fs))
+
+//*****************************************************************************
+//
+// The filter history of one stage on one channel.  The remainder of the last
+// output rounding is fed back into the next output (first-order error
+// feedback), which cancels the noise gain of poles close to z = 1.
+//
+//*****************************************************************************
+typedef struct
+{
+    int16_t i16X1;
+    int16_t i16X2;
+    int16_t i16Y1;
+    int16_t i16Y2;
+    int32_t i32Rem;
+}
+tBiquadHistory;
+
+//*****************************************************************************
+//
+// A cascade instance.
+//
+//*****************************************************************************
+typedef struct
+{
+    const tBiquadCoeffs *psCoeffs;
+    uint32_t ui32NumStages;
+    uint32_t ui32NumChannels;
+    tBiquadHistory psHistory[BIQUAD_MAX_STAGES][BIQUAD_MAX_CHANNELS];
+}
+tBiquadCascade;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern bool BiquadCascadeInit(tBiquadCascade *psCascade,
+                              const tBiquadCoeffs *psCoeffs,
+                              uint32_t ui32NumStages,
+                              uint32_t ui32NumChannels);
+extern void BiquadCascadeCoeffsSet(tBiquadCascade *psCascade,
+                                   const tBiquadCoeffs *psCoeffs);
+extern void BiquadCascadeProcess(tBiquadCascade *psCascade, int16_t *pi16Data,
+                                 uint32_t ui32Frames);
+extern uint32_t BiquadBenchmark(const tBiquadCoeffs *psCoeffs,
+                                uint32_t ui32NumStages,
+                                uint32_t ui32NumChannels,
+                                int16_t *pi16Scratch, uint32_t ui32Frames);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __BIQUAD_H__
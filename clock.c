@@ -0,0 +1,187 @@
+//*****************************************************************************
+//
+// clock.c - System clock profiles.
+//
+// Each profile is a SysCtlClockSet() configuration.  Switching profiles
+// updates SystemCoreClock from the clock registers and then calls the hook
+// of every driver that registered one, so that the SSI, I2C and timer
+// dividers follow the new clock without the application having to know
+// which drivers depend on it.  A driver that cannot work at all below some
+// clock registers a check as well, and a profile that any check refuses is
+// not switched to.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "CU_TM4C123.h"
+#include "driverlib/sysctl.h"
+#include "clock.h"
+
+//*****************************************************************************
+//
+//! \addtogroup clock_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The profiles and the system clock each gives.  The DSP profile divides the
+// 400 MHz PLL by 2.5, the highest clock the part supports.  The idle profile
+// runs straight from the 16 MHz crystal and powers the PLL down.  The SSI
+// can only follow a bit clock of up to a twelfth of the system clock, so at
+// 16 MHz the codec must run at 32 kHz or less; the SSI driver's check
+// refuses the idle profile otherwise.
+//
+//*****************************************************************************
+static const uint32_t g_pui32ClockProfiles[CLOCK_NUM_PROFILES] =
+{
+    SYSCTL_SYSDIV_2_5 | SYSCTL_USE_PLL | SYSCTL_XTAL_16MHZ | SYSCTL_OSC_MAIN,
+    SYSCTL_SYSDIV_1 | SYSCTL_USE_OSC | SYSCTL_XTAL_16MHZ | SYSCTL_OSC_MAIN
+};
+static const uint32_t g_pui32ClockRates[CLOCK_NUM_PROFILES] =
+{
+    80000000,
+    16000000
+};
+
+//*****************************************************************************
+//
+// The current profile, CLOCK_NUM_PROFILES until one is set, the hooks and
+// the checks.
+//
+//*****************************************************************************
+static uint32_t g_ui32ClockProfile = CLOCK_NUM_PROFILES;
+static tClockHook g_ppfnClockHooks[CLOCK_MAX_HOOKS];
+static uint32_t g_ui32ClockNumHooks;
+static tClockCheck g_ppfnClockChecks[CLOCK_MAX_CHECKS];
+static uint32_t g_ui32ClockNumChecks;
+
+//*****************************************************************************
+//
+//! Switches the system clock to a profile.
+//!
+//! \param ui32Profile is the profile, one of the \b CLOCK_PROFILE_* values.
+//!
+//! Every registered check is first asked whether its driver can work at the
+//! profile's clock, and the clock is left alone if one cannot.  Otherwise
+//! the clock is switched with SysCtlClockSet(), which waits for the PLL to
+//! lock if the profile uses it, and SystemCoreClock is updated.  The hooks
+//! are then called in the order they were registered.  Peripherals run at
+//! the wrong speed between the switch and their hook, so this is best done
+//! from the main loop with as little traffic as possible in flight.
+//!
+//! This should be called first thing in main() to bring up the DSP
+//! profile.
+//!
+//! \return Returns \b true on success or \b false if the profile does not
+//! exist or a check refused it.
+//
+//*****************************************************************************
+bool
+ClockProfileSet(uint32_t ui32Profile)
+{
+    uint32_t ui32Idx;
+
+    if(ui32Profile >= CLOCK_NUM_PROFILES)
+    {
+        return(false);
+    }
+    if(ui32Profile == g_ui32ClockProfile)
+    {
+        return(true);
+    }
+    for(ui32Idx = 0; ui32Idx < g_ui32ClockNumChecks; ui32Idx++)
+    {
+        if(!g_ppfnClockChecks[ui32Idx](g_pui32ClockRates[ui32Profile]))
+        {
+            return(false);
+        }
+    }
+
+    SysCtlClockSet(g_pui32ClockProfiles[ui32Profile]);
+    SystemCoreClockUpdate();
+    g_ui32ClockProfile = ui32Profile;
+
+    for(ui32Idx = 0; ui32Idx < g_ui32ClockNumHooks; ui32Idx++)
+    {
+        g_ppfnClockHooks[ui32Idx](SystemCoreClock);
+    }
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Returns the current profile.
+//!
+//! \return Returns one of the \b CLOCK_PROFILE_* values, or
+//! \b CLOCK_NUM_PROFILES if no profile has been set and the part still runs
+//! from its reset clock.
+//
+//*****************************************************************************
+uint32_t
+ClockProfileGet(void)
+{
+    return(g_ui32ClockProfile);
+}
+
+//*****************************************************************************
+//
+//! Registers a driver to be told of clock changes.
+//!
+//! \param pfnHook is the function that re-derives the driver's dividers.
+//!
+//! Drivers that program a divider from the system clock call this from
+//! their initialization.
+//!
+//! \return Returns \b true on success or \b false if \b CLOCK_MAX_HOOKS
+//! hooks are already registered.
+//
+//*****************************************************************************
+bool
+ClockHookRegister(tClockHook pfnHook)
+{
+    if(g_ui32ClockNumHooks == CLOCK_MAX_HOOKS)
+    {
+        return(false);
+    }
+
+    g_ppfnClockHooks[g_ui32ClockNumHooks++] = pfnHook;
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Registers a driver that may refuse clock changes.
+//!
+//! \param pfnCheck is the function that tells whether the driver can work at
+//! a given system clock.
+//!
+//! Drivers with a hard lower limit on the system clock, such as an SSI slave
+//! that must follow an external bit clock, call this from their
+//! initialization.
+//!
+//! \return Returns \b true on success or \b false if \b CLOCK_MAX_CHECKS
+//! checks are already registered.
+//
+//*****************************************************************************
+bool
+ClockCheckRegister(tClockCheck pfnCheck)
+{
+    if(g_ui32ClockNumChecks == CLOCK_MAX_CHECKS)
+    {
+        return(false);
+    }
+
+    g_ppfnClockChecks[g_ui32ClockNumChecks++] = pfnCheck;
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
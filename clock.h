@@ -0,0 +1,76 @@
+//*****************************************************************************
+//
+// clock.h - Prototypes for the system clock profiles.
+//
+//*****************************************************************************
+
+#ifndef __CLOCK_H__
+#define __CLOCK_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// Values that can be passed to ClockProfileSet() as the ui32Profile
+// parameter.
+//
+//*****************************************************************************
+#define CLOCK_PROFILE_DSP       0           // 80 MHz from the PLL
+#define CLOCK_PROFILE_IDLE      1           // 16 MHz crystal, PLL off
+#define CLOCK_NUM_PROFILES      2
+
+//*****************************************************************************
+//
+// The number of drivers that can be told of clock changes, and the number
+// that can refuse them.
+//
+//*****************************************************************************
+#define CLOCK_MAX_HOOKS         4
+#define CLOCK_MAX_CHECKS        2
+
+//*****************************************************************************
+//
+// A clock change hook.  It is called with the new system clock in Hz after
+// every profile change, and re-derives the dividers of one driver from it.
+//
+//*****************************************************************************
+typedef void (*tClockHook)(uint32_t ui32Clock);
+
+//*****************************************************************************
+//
+// A clock change check.  It is called with the system clock in Hz that a
+// profile would give before the switch, and returns false if one driver
+// cannot work at that clock in its present state.
+//
+//*****************************************************************************
+typedef bool (*tClockCheck)(uint32_t ui32Clock);
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern bool ClockProfileSet(uint32_t ui32Profile);
+extern uint32_t ClockProfileGet(void);
+extern bool ClockHookRegister(tClockHook pfnHook);
+extern bool ClockCheckRegister(tClockCheck pfnCheck);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __CLOCK_H__
@@ -0,0 +1,114 @@
+//*****************************************************************************
+//
+// dma.c - Shared uDMA controller setup.
+//
+// The uDMA controller has a single channel control table for all channels,
+// so it is owned here and every driver that streams through the uDMA calls
+// DMAInit() before configuring its channels.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_ints.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/udma.h"
+#include "dma.h"
+
+//*****************************************************************************
+//
+//! \addtogroup dma_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The channel control table: a primary and an alternate structure for each
+// of the 32 channels.  The controller requires it to be 1024-byte aligned.
+//
+//*****************************************************************************
+#if defined(ewarm)
+#pragma data_alignment=1024
+static tDMAControlTable g_psDMAControlTable[64];
+#elif defined(ccs)
+#pragma DATA_ALIGN(g_psDMAControlTable, 1024)
+static tDMAControlTable g_psDMAControlTable[64];
+#else
+static tDMAControlTable g_psDMAControlTable[64]
+    __attribute__ ((aligned(1024)));
+#endif
+
+//*****************************************************************************
+//
+// Set once the controller is running, and the number of bus errors seen.
+//
+//*****************************************************************************
+static bool g_bDMAReady = false;
+static volatile uint32_t g_ui32DMAErrors = 0;
+
+//*****************************************************************************
+//
+//! Enables the uDMA controller.
+//!
+//! This may be called by every driver that uses the uDMA; only the first
+//! call has any effect.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+DMAInit(void)
+{
+    if(g_bDMAReady)
+    {
+        return;
+    }
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+    while(!SysCtlPeripheralReady(SYSCTL_PERIPH_UDMA))
+    {
+    }
+    uDMAEnable();
+    uDMAControlBaseSet(g_psDMAControlTable);
+    IntEnable(INT_UDMAERR);
+    g_bDMAReady = true;
+}
+
+//*****************************************************************************
+//
+//! Returns the number of uDMA bus errors since startup.
+//!
+//! \return Returns the error count.
+//
+//*****************************************************************************
+uint32_t
+DMAErrorCountGet(void)
+{
+    return(g_ui32DMAErrors);
+}
+
+//*****************************************************************************
+//
+// The uDMA error interrupt handler.  A bus error stops the failing channel;
+// the owning driver notices the stopped channel and restarts it, so only the
+// error is counted here.
+//
+//*****************************************************************************
+void
+UDMAERR_Handler(void)
+{
+    if(uDMAErrorStatusGet())
+    {
+        uDMAErrorStatusClear();
+        g_ui32DMAErrors++;
+    }
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -0,0 +1,38 @@
+//*****************************************************************************
+//
+// dma.h - Prototypes for the shared uDMA setup.
+//
+//*****************************************************************************
+
+#ifndef __DMA_H__
+#define __DMA_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern void DMAInit(void);
+extern uint32_t DMAErrorCountGet(void);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __DMA_H__
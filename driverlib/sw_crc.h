@@ -65,6 +65,10 @@ extern void Crc16Array3(uint32_t ui32WordLen, const uint32_t *pui32Data,
                         uint16_t *pui16Crc3);
 extern uint32_t Crc32(uint32_t ui32Crc, const uint8_t *pui8Data,
                       uint32_t ui32Count);
+extern uint16_t Crc16Slice4(uint16_t ui16Crc, const uint8_t *pui8Data,
+                            uint32_t ui32Count);
+extern uint32_t Crc32Slice8(uint32_t ui32Crc, const uint8_t *pui8Data,
+                            uint32_t ui32Count);
 
 //*****************************************************************************
 //
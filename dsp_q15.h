@@ -0,0 +1,172 @@
+//*****************************************************************************
+//
+// dsp_q15.h - Fixed-point helpers shared by the audio DSP kernels.
+//
+// The helpers map onto single Cortex-M4 instructions (CLZ, SSAT, SMLAD) when
+// built for the target and fall back to portable C everywhere else, so the
+// kernels produce the same results on the target and on a host build.
+//
+//*****************************************************************************
+
+#ifndef __DSP_Q15_H__
+#define __DSP_Q15_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// Q15 and Q31 full-scale limits.
+//
+//*****************************************************************************
+#define Q15_MAX                 32767
+#define Q15_MIN                 (-32768)
+#define Q31_MAX                 ((int32_t)0x7fffffff)
+#define Q31_MIN                 ((int32_t)0x80000000)
+
+//*****************************************************************************
+//
+// Converts a floating-point constant in [-1, 1) to Q15.  Only intended for
+// compile-time constants.
+//
+//*****************************************************************************
+#define Q15(f)                  ((int16_t)((f) * 32768.0 + (((f) < 0) ? -0.5 :\
+                                                            0.5)))
+
+//*****************************************************************************
+//
+// Selects the target intrinsics.  The ARM compilers provide CLZ and SSAT as
+// built-ins; GCC for the Cortex-M4 advertises the DSP extension through
+// __ARM_FEATURE_DSP.
+//
+//*****************************************************************************
+#if defined(__ARMCC_VERSION) || defined(__ARM_FEATURE_DSP)
+#define DSP_TARGET_M4
+#endif
+
+//*****************************************************************************
+//
+// Counts the leading zero bits of a 32-bit value.  Returns 32 for zero.
+//
+//*****************************************************************************
+static __inline uint32_t
+DSPCountLeadingZeros(uint32_t ui32Value)
+{
+#if defined(__ARMCC_VERSION)
+    return(__clz(ui32Value));
+#elif defined(__GNUC__)
+    return(ui32Value ? (uint32_t)__builtin_clz(ui32Value) : 32);
+#else
+    uint32_t ui32Count;
+
+    if(ui32Value == 0)
+    {
+        return(32);
+    }
+    for(ui32Count = 0; !(ui32Value & 0x80000000); ui32Count++)
+    {
+        ui32Value <<= 1;
+    }
+    return(ui32Count);
+#endif
+}
+
+//*****************************************************************************
+//
+// Saturates a 32-bit value to the Q15 range.
+//
+//*****************************************************************************
+static __inline int16_t
+DSPSat16(int32_t i32Value)
+{
+#if defined(__ARMCC_VERSION)
+    return((int16_t)__ssat(i32Value, 16));
+#else
+    if(i32Value > Q15_MAX)
+    {
+        return(Q15_MAX);
+    }
+    if(i32Value < Q15_MIN)
+    {
+        return(Q15_MIN);
+    }
+    return((int16_t)i32Value);
+#endif
+}
+
+//*****************************************************************************
+//
+// Saturating 32-bit addition.
+//
+//*****************************************************************************
+static __inline int32_t
+DSPQAdd32(int32_t i32A, int32_t i32B)
+{
+#if defined(__ARMCC_VERSION)
+    return(__qadd(i32A, i32B));
+#else
+    int64_t i64Sum;
+
+    i64Sum = (int64_t)i32A + i32B;
+    if(i64Sum > Q31_MAX)
+    {
+        return(Q31_MAX);
+    }
+    if(i64Sum < Q31_MIN)
+    {
+        return(Q31_MIN);
+    }
+    return((int32_t)i64Sum);
+#endif
+}
+
+//*****************************************************************************
+//
+// Dual 16x16 multiply with 32-bit accumulate (SMLAD).  Each argument packs
+// two Q15 values, low half-word first; the two products are summed into the
+// accumulator.
+//
+//*****************************************************************************
+static __inline int32_t
+DSPSmlad(uint32_t ui32X, uint32_t ui32Y, int32_t i32Acc)
+{
+#if defined(__ARMCC_VERSION)
+    return(__smlad(ui32X, ui32Y, i32Acc));
+#elif defined(DSP_TARGET_M4) && defined(__GNUC__)
+    int32_t i32Result;
+
+    __asm__ ("smlad %0, %1, %2, %3"
+             : "=r" (i32Result) : "r" (ui32X), "r" (ui32Y), "r" (i32Acc));
+    return(i32Result);
+#else
+    return(i32Acc + ((int32_t)(int16_t)ui32X * (int16_t)ui32Y) +
+           ((int32_t)(int16_t)(ui32X >> 16) * (int16_t)(ui32Y >> 16)));
+#endif
+}
+
+//*****************************************************************************
+//
+// Packs two Q15 values into one word for DSPSmlad(), low half-word first.
+//
+//*****************************************************************************
+#define DSP_PACK16(i16Lo, i16Hi)                                              \
+        (((uint32_t)(uint16_t)(i16Lo)) | ((uint32_t)(uint16_t)(i16Hi) << 16))
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __DSP_Q15_H__
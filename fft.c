@@ -0,0 +1,1603 @@
+//*****************************************************************************
+//
+// fft.c - Fixed-point FFT library.
+//
+// Complex transforms of 16 to 1024 points in Q15 and Q31, and real
+// transforms of the same lengths built on a complex transform of half the
+// length.
+//
+// The complex transform is decimation in frequency, radix 4, with one final
+// radix-2 stage when the length is an odd power of two.  Each radix-4
+// butterfly stores its outputs in bit-reversed order, so the whole transform
+// ends in plain bit-reversed order and is put right with one table-driven
+// permutation.
+//
+// The twiddle factors and the bit-reversal permutation are const tables in
+// flash, generated offline for FFT_MAX_SIZE.  A transform of length N reads
+// every (FFT_MAX_SIZE / N)th twiddle, and the bit-reversed index of i is the
+// table entry shifted right by log2(FFT_MAX_SIZE / N).
+//
+// The forward transforms scale by 1/4 at each radix-4 stage and 1/2 at the
+// radix-2 stage and return X(k) / N.  No stage can then grow the magnitude
+// of a point, so they cannot overflow as long as every complex sample lies
+// within the unit circle; a sample with both parts near full scale may
+// saturate.  The real transforms, whose complex points pair two real
+// samples, halve the samples first for that reason.  The inverse transforms
+// are unscaled and saturate, so the inverse of a forward transform returns
+// the original samples.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "dsp_q15.h"
+#include "fft.h"
+#include "perf.h"
+#include "ramfunc.h"
+
+//*****************************************************************************
+//
+//! \addtogroup fft_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The placement of the complex transforms, which every other transform runs
+// on.
+//
+//*****************************************************************************
+#if FFT_KERNEL_IN_RAM
+#define FFT_KERNEL              RAMFUNC
+#else
+#define FFT_KERNEL
+#endif
+
+//*****************************************************************************
+//
+// exp(-j 2 pi k / FFT_MAX_SIZE) for k = 0 .. 3 FFT_MAX_SIZE / 4 - 1,
+// interleaved real and imaginary, in Q15.  Three quarters of a turn covers
+// the largest radix-4 twiddle, W^3n for n < N / 4.
+//
+//*****************************************************************************
+static const int16_t g_pi16FFTTwiddleQ15[(3 * FFT_MAX_SIZE) / 2] =
+{
+     32767,      0,  32767,   -201,  32766,   -402,  32762,   -603,
+     32758,   -804,  32753,  -1005,  32746,  -1206,  32738,  -1407,
+     32729,  -1608,  32718,  -1809,  32706,  -2009,  32693,  -2210,
+     32679,  -2411,  32664,  -2611,  32647,  -2811,  32629,  -3012,
+     32610,  -3212,  32590,  -3412,  32568,  -3612,  32546,  -3812,
+     32522,  -4011,  32496,  -4211,  32470,  -4410,  32442,  -4609,
+     32413,  -4808,  32383,  -5007,  32352,  -5205,  32319,  -5404,
+     32286,  -5602,  32251,  -5800,  32214,  -5998,  32177,  -6195,
+     32138,  -6393,  32099,  -6590,  32058,  -6787,  32015,  -6983,
+     31972,  -7180,  31927,  -7376,  31881,  -7571,  31834,  -7767,
+     31786,  -7962,  31737,  -8157,  31686,  -8351,  31634,  -8546,
+     31581,  -8740,  31527,  -8933,  31471,  -9127,  31415,  -9319,
+     31357,  -9512,  31298,  -9704,  31238,  -9896,  31177, -10088,
+     31114, -10279,  31050, -10469,  30986, -10660,  30920, -10850,
+     30853, -11039,  30784, -11228,  30715, -11417,  30644, -11605,
+     30572, -11793,  30499, -11980,  30425, -12167,  30350, -12354,
+     30274, -12540,  30196, -12725,  30118, -12910,  30038, -13095,
+     29957, -13279,  29875, -13463,  29792, -13646,  29707, -13828,
+     29622, -14010,  29535, -14192,  29448, -14373,  29359, -14553,
+     29269, -14733,  29178, -14912,  29086, -15091,  28993, -15269,
+     28899, -15447,  28803, -15624,  28707, -15800,  28610, -15976,
+     28511, -16151,  28411, -16326,  28311, -16500,  28209, -16673,
+     28106, -16846,  28002, -17018,  27897, -17190,  27791, -17361,
+     27684, -17531,  27576, -17700,  27467, -17869,  27357, -18037,
+     27246, -18205,  27133, -18372,  27020, -18538,  26906, -18703,
+     26791, -18868,  26674, -19032,  26557, -19195,  26439, -19358,
+     26320, -19520,  26199, -19681,  26078, -19841,  25956, -20001,
+     25833, -20160,  25708, -20318,  25583, -20475,  25457, -20632,
+     25330, -20788,  25202, -20943,  25073, -21097,  24943, -21251,
+     24812, -21403,  24680, -21555,  24548, -21706,  24414, -21856,
+     24279, -22006,  24144, -22154,  24008, -22302,  23870, -22449,
+     23732, -22595,  23593, -22740,  23453, -22884,  23312, -23028,
+     23170, -23170,  23028, -23312,  22884, -23453,  22740, -23593,
+     22595, -23732,  22449, -23870,  22302, -24008,  22154, -24144,
+     22006, -24279,  21856, -24414,  21706, -24548,  21555, -24680,
+     21403, -24812,  21251, -24943,  21097, -25073,  20943, -25202,
+     20788, -25330,  20632, -25457,  20475, -25583,  20318, -25708,
+     20160, -25833,  20001, -25956,  19841, -26078,  19681, -26199,
+     19520, -26320,  19358, -26439,  19195, -26557,  19032, -26674,
+     18868, -26791,  18703, -26906,  18538, -27020,  18372, -27133,
+     18205, -27246,  18037, -27357,  17869, -27467,  17700, -27576,
+     17531, -27684,  17361, -27791,  17190, -27897,  17018, -28002,
+     16846, -28106,  16673, -28209,  16500, -28311,  16326, -28411,
+     16151, -28511,  15976, -28610,  15800, -28707,  15624, -28803,
+     15447, -28899,  15269, -28993,  15091, -29086,  14912, -29178,
+     14733, -29269,  14553, -29359,  14373, -29448,  14192, -29535,
+     14010, -29622,  13828, -29707,  13646, -29792,  13463, -29875,
+     13279, -29957,  13095, -30038,  12910, -30118,  12725, -30196,
+     12540, -30274,  12354, -30350,  12167, -30425,  11980, -30499,
+     11793, -30572,  11605, -30644,  11417, -30715,  11228, -30784,
+     11039, -30853,  10850, -30920,  10660, -30986,  10469, -31050,
+     10279, -31114,  10088, -31177,   9896, -31238,   9704, -31298,
+      9512, -31357,   9319, -31415,   9127, -31471,   8933, -31527,
+      8740, -31581,   8546, -31634,   8351, -31686,   8157, -31737,
+      7962, -31786,   7767, -31834,   7571, -31881,   7376, -31927,
+      7180, -31972,   6983, -32015,   6787, -32058,   6590, -32099,
+      6393, -32138,   6195, -32177,   5998, -32214,   5800, -32251,
+      5602, -32286,   5404, -32319,   5205, -32352,   5007, -32383,
+      4808, -32413,   4609, -32442,   4410, -32470,   4211, -32496,
+      4011, -32522,   3812, -32546,   3612, -32568,   3412, -32590,
+      3212, -32610,   3012, -32629,   2811, -32647,   2611, -32664,
+      2411, -32679,   2210, -32693,   2009, -32706,   1809, -32718,
+      1608, -32729,   1407, -32738,   1206, -32746,   1005, -32753,
+       804, -32758,    603, -32762,    402, -32766,    201, -32767,
+         0, -32768,   -201, -32767,   -402, -32766,   -603, -32762,
+      -804, -32758,  -1005, -32753,  -1206, -32746,  -1407, -32738,
+     -1608, -32729,  -1809, -32718,  -2009, -32706,  -2210, -32693,
+     -2411, -32679,  -2611, -32664,  -2811, -32647,  -3012, -32629,
+     -3212, -32610,  -3412, -32590,  -3612, -32568,  -3812, -32546,
+     -4011, -32522,  -4211, -32496,  -4410, -32470,  -4609, -32442,
+     -4808, -32413,  -5007, -32383,  -5205, -32352,  -5404, -32319,
+     -5602, -32286,  -5800, -32251,  -5998, -32214,  -6195, -32177,
+     -6393, -32138,  -6590, -32099,  -6787, -32058,  -6983, -32015,
+     -7180, -31972,  -7376, -31927,  -7571, -31881,  -7767, -31834,
+     -7962, -31786,  -8157, -31737,  -8351, -31686,  -8546, -31634,
+     -8740, -31581,  -8933, -31527,  -9127, -31471,  -9319, -31415,
+     -9512, -31357,  -9704, -31298,  -9896, -31238, -10088, -31177,
+    -10279, -31114, -10469, -31050, -10660, -30986, -10850, -30920,
+    -11039, -30853, -11228, -30784, -11417, -30715, -11605, -30644,
+    -11793, -30572, -11980, -30499, -12167, -30425, -12354, -30350,
+    -12540, -30274, -12725, -30196, -12910, -30118, -13095, -30038,
+    -13279, -29957, -13463, -29875, -13646, -29792, -13828, -29707,
+    -14010, -29622, -14192, -29535, -14373, -29448, -14553, -29359,
+    -14733, -29269, -14912, -29178, -15091, -29086, -15269, -28993,
+    -15447, -28899, -15624, -28803, -15800, -28707, -15976, -28610,
+    -16151, -28511, -16326, -28411, -16500, -28311, -16673, -28209,
+    -16846, -28106, -17018, -28002, -17190, -27897, -17361, -27791,
+    -17531, -27684, -17700, -27576, -17869, -27467, -18037, -27357,
+    -18205, -27246, -18372, -27133, -18538, -27020, -18703, -26906,
+    -18868, -26791, -19032, -26674, -19195, -26557, -19358, -26439,
+    -19520, -26320, -19681, -26199, -19841, -26078, -20001, -25956,
+    -20160, -25833, -20318, -25708, -20475, -25583, -20632, -25457,
+    -20788, -25330, -20943, -25202, -21097, -25073, -21251, -24943,
+    -21403, -24812, -21555, -24680, -21706, -24548, -21856, -24414,
+    -22006, -24279, -22154, -24144, -22302, -24008, -22449, -23870,
+    -22595, -23732, -22740, -23593, -22884, -23453, -23028, -23312,
+    -23170, -23170, -23312, -23028, -23453, -22884, -23593, -22740,
+    -23732, -22595, -23870, -22449, -24008, -22302, -24144, -22154,
+    -24279, -22006, -24414, -21856, -24548, -21706, -24680, -21555,
+    -24812, -21403, -24943, -21251, -25073, -21097, -25202, -20943,
+    -25330, -20788, -25457, -20632, -25583, -20475, -25708, -20318,
+    -25833, -20160, -25956, -20001, -26078, -19841, -26199, -19681,
+    -26320, -19520, -26439, -19358, -26557, -19195, -26674, -19032,
+    -26791, -18868, -26906, -18703, -27020, -18538, -27133, -18372,
+    -27246, -18205, -27357, -18037, -27467, -17869, -27576, -17700,
+    -27684, -17531, -27791, -17361, -27897, -17190, -28002, -17018,
+    -28106, -16846, -28209, -16673, -28311, -16500, -28411, -16326,
+    -28511, -16151, -28610, -15976, -28707, -15800, -28803, -15624,
+    -28899, -15447, -28993, -15269, -29086, -15091, -29178, -14912,
+    -29269, -14733, -29359, -14553, -29448, -14373, -29535, -14192,
+    -29622, -14010, -29707, -13828, -29792, -13646, -29875, -13463,
+    -29957, -13279, -30038, -13095, -30118, -12910, -30196, -12725,
+    -30274, -12540, -30350, -12354, -30425, -12167, -30499, -11980,
+    -30572, -11793, -30644, -11605, -30715, -11417, -30784, -11228,
+    -30853, -11039, -30920, -10850, -30986, -10660, -31050, -10469,
+    -31114, -10279, -31177, -10088, -31238,  -9896, -31298,  -9704,
+    -31357,  -9512, -31415,  -9319, -31471,  -9127, -31527,  -8933,
+    -31581,  -8740, -31634,  -8546, -31686,  -8351, -31737,  -8157,
+    -31786,  -7962, -31834,  -7767, -31881,  -7571, -31927,  -7376,
+    -31972,  -7180, -32015,  -6983, -32058,  -6787, -32099,  -6590,
+    -32138,  -6393, -32177,  -6195, -32214,  -5998, -32251,  -5800,
+    -32286,  -5602, -32319,  -5404, -32352,  -5205, -32383,  -5007,
+    -32413,  -4808, -32442,  -4609, -32470,  -4410, -32496,  -4211,
+    -32522,  -4011, -32546,  -3812, -32568,  -3612, -32590,  -3412,
+    -32610,  -3212, -32629,  -3012, -32647,  -2811, -32664,  -2611,
+    -32679,  -2411, -32693,  -2210, -32706,  -2009, -32718,  -1809,
+    -32729,  -1608, -32738,  -1407, -32746,  -1206, -32753,  -1005,
+    -32758,   -804, -32762,   -603, -32766,   -402, -32767,   -201,
+    -32768,      0, -32767,    201, -32766,    402, -32762,    603,
+    -32758,    804, -32753,   1005, -32746,   1206, -32738,   1407,
+    -32729,   1608, -32718,   1809, -32706,   2009, -32693,   2210,
+    -32679,   2411, -32664,   2611, -32647,   2811, -32629,   3012,
+    -32610,   3212, -32590,   3412, -32568,   3612, -32546,   3812,
+    -32522,   4011, -32496,   4211, -32470,   4410, -32442,   4609,
+    -32413,   4808, -32383,   5007, -32352,   5205, -32319,   5404,
+    -32286,   5602, -32251,   5800, -32214,   5998, -32177,   6195,
+    -32138,   6393, -32099,   6590, -32058,   6787, -32015,   6983,
+    -31972,   7180, -31927,   7376, -31881,   7571, -31834,   7767,
+    -31786,   7962, -31737,   8157, -31686,   8351, -31634,   8546,
+    -31581,   8740, -31527,   8933, -31471,   9127, -31415,   9319,
+    -31357,   9512, -31298,   9704, -31238,   9896, -31177,  10088,
+    -31114,  10279, -31050,  10469, -30986,  10660, -30920,  10850,
+    -30853,  11039, -30784,  11228, -30715,  11417, -30644,  11605,
+    -30572,  11793, -30499,  11980, -30425,  12167, -30350,  12354,
+    -30274,  12540, -30196,  12725, -30118,  12910, -30038,  13095,
+    -29957,  13279, -29875,  13463, -29792,  13646, -29707,  13828,
+    -29622,  14010, -29535,  14192, -29448,  14373, -29359,  14553,
+    -29269,  14733, -29178,  14912, -29086,  15091, -28993,  15269,
+    -28899,  15447, -28803,  15624, -28707,  15800, -28610,  15976,
+    -28511,  16151, -28411,  16326, -28311,  16500, -28209,  16673,
+    -28106,  16846, -28002,  17018, -27897,  17190, -27791,  17361,
+    -27684,  17531, -27576,  17700, -27467,  17869, -27357,  18037,
+    -27246,  18205, -27133,  18372, -27020,  18538, -26906,  18703,
+    -26791,  18868, -26674,  19032, -26557,  19195, -26439,  19358,
+    -26320,  19520, -26199,  19681, -26078,  19841, -25956,  20001,
+    -25833,  20160, -25708,  20318, -25583,  20475, -25457,  20632,
+    -25330,  20788, -25202,  20943, -25073,  21097, -24943,  21251,
+    -24812,  21403, -24680,  21555, -24548,  21706, -24414,  21856,
+    -24279,  22006, -24144,  22154, -24008,  22302, -23870,  22449,
+    -23732,  22595, -23593,  22740, -23453,  22884, -23312,  23028,
+    -23170,  23170, -23028,  23312, -22884,  23453, -22740,  23593,
+    -22595,  23732, -22449,  23870, -22302,  24008, -22154,  24144,
+    -22006,  24279, -21856,  24414, -21706,  24548, -21555,  24680,
+    -21403,  24812, -21251,  24943, -21097,  25073, -20943,  25202,
+    -20788,  25330, -20632,  25457, -20475,  25583, -20318,  25708,
+    -20160,  25833, -20001,  25956, -19841,  26078, -19681,  26199,
+    -19520,  26320, -19358,  26439, -19195,  26557, -19032,  26674,
+    -18868,  26791, -18703,  26906, -18538,  27020, -18372,  27133,
+    -18205,  27246, -18037,  27357, -17869,  27467, -17700,  27576,
+    -17531,  27684, -17361,  27791, -17190,  27897, -17018,  28002,
+    -16846,  28106, -16673,  28209, -16500,  28311, -16326,  28411,
+    -16151,  28511, -15976,  28610, -15800,  28707, -15624,  28803,
+    -15447,  28899, -15269,  28993, -15091,  29086, -14912,  29178,
+    -14733,  29269, -14553,  29359, -14373,  29448, -14192,  29535,
+    -14010,  29622, -13828,  29707, -13646,  29792, -13463,  29875,
+    -13279,  29957, -13095,  30038, -12910,  30118, -12725,  30196,
+    -12540,  30274, -12354,  30350, -12167,  30425, -11980,  30499,
+    -11793,  30572, -11605,  30644, -11417,  30715, -11228,  30784,
+    -11039,  30853, -10850,  30920, -10660,  30986, -10469,  31050,
+    -10279,  31114, -10088,  31177,  -9896,  31238,  -9704,  31298,
+     -9512,  31357,  -9319,  31415,  -9127,  31471,  -8933,  31527,
+     -8740,  31581,  -8546,  31634,  -8351,  31686,  -8157,  31737,
+     -7962,  31786,  -7767,  31834,  -7571,  31881,  -7376,  31927,
+     -7180,  31972,  -6983,  32015,  -6787,  32058,  -6590,  32099,
+     -6393,  32138,  -6195,  32177,  -5998,  32214,  -5800,  32251,
+     -5602,  32286,  -5404,  32319,  -5205,  32352,  -5007,  32383,
+     -4808,  32413,  -4609,  32442,  -4410,  32470,  -4211,  32496,
+     -4011,  32522,  -3812,  32546,  -3612,  32568,  -3412,  32590,
+     -3212,  32610,  -3012,  32629,  -2811,  32647,  -2611,  32664,
+     -2411,  32679,  -2210,  32693,  -2009,  32706,  -1809,  32718,
+     -1608,  32729,  -1407,  32738,  -1206,  32746,  -1005,  32753,
+      -804,  32758,   -603,  32762,   -402,  32766,   -201,  32767
+};
+
+//*****************************************************************************
+//
+// The same twiddle factors in Q31.
+//
+//*****************************************************************************
+static const int32_t g_pi32FFTTwiddleQ31[(3 * FFT_MAX_SIZE) / 2] =
+{
+     2147483647,           0,  2147443222,   -13176712,
+     2147321946,   -26352928,  2147119825,   -39528151,
+     2146836866,   -52701887,  2146473080,   -65873638,
+     2146028480,   -79042909,  2145503083,   -92209205,
+     2144896910,  -105372028,  2144209982,  -118530885,
+     2143442326,  -131685278,  2142593971,  -144834714,
+     2141664948,  -157978697,  2140655293,  -171116733,
+     2139565043,  -184248325,  2138394240,  -197372981,
+     2137142927,  -210490206,  2135811153,  -223599506,
+     2134398966,  -236700388,  2132906420,  -249792358,
+     2131333572,  -262874923,  2129680480,  -275947592,
+     2127947206,  -289009871,  2126133817,  -302061269,
+     2124240380,  -315101295,  2122266967,  -328129457,
+     2120213651,  -341145265,  2118080511,  -354148230,
+     2115867626,  -367137861,  2113575080,  -380113669,
+     2111202959,  -393075166,  2108751352,  -406021865,
+     2106220352,  -418953276,  2103610054,  -431868915,
+     2100920556,  -444768294,  2098151960,  -457650927,
+     2095304370,  -470516330,  2092377892,  -483364019,
+     2089372638,  -496193509,  2086288720,  -509004318,
+     2083126254,  -521795963,  2079885360,  -534567963,
+     2076566160,  -547319836,  2073168777,  -560051104,
+     2069693342,  -572761285,  2066139983,  -585449903,
+     2062508835,  -598116479,  2058800036,  -610760536,
+     2055013723,  -623381598,  2051150040,  -635979190,
+     2047209133,  -648552838,  2043191150,  -661102068,
+     2039096241,  -673626408,  2034924562,  -686125387,
+     2030676269,  -698598533,  2026351522,  -711045377,
+     2021950484,  -723465451,  2017473321,  -735858287,
+     2012920201,  -748223418,  2008291295,  -760560380,
+     2003586779,  -772868706,  1998806829,  -785147934,
+     1993951625,  -797397602,  1989021350,  -809617249,
+     1984016189,  -821806413,  1978936331,  -833964638,
+     1973781967,  -846091463,  1968553292,  -858186435,
+     1963250501,  -870249095,  1957873796,  -882278992,
+     1952423377,  -894275671,  1946899451,  -906238681,
+     1941302225,  -918167572,  1935631910,  -930061894,
+     1929888720,  -941921200,  1924072871,  -953745043,
+     1918184581,  -965532978,  1912224073,  -977284562,
+     1906191570,  -988999351,  1900087301, -1000676905,
+     1893911494, -1012316784,  1887664383, -1023918550,
+     1881346202, -1035481766,  1874957189, -1047005996,
+     1868497586, -1058490808,  1861967634, -1069935768,
+     1855367581, -1081340445,  1848697674, -1092704411,
+     1841958164, -1104027237,  1835149306, -1115308496,
+     1828271356, -1126547765,  1821324572, -1137744621,
+     1814309216, -1148898640,  1807225553, -1160009405,
+     1800073849, -1171076495,  1792854372, -1182099496,
+     1785567396, -1193077991,  1778213194, -1204011567,
+     1770792044, -1214899813,  1763304224, -1225742318,
+     1755750017, -1236538675,  1748129707, -1247288478,
+     1740443581, -1257991320,  1732691928, -1268646800,
+     1724875040, -1279254516,  1716993211, -1289814068,
+     1709046739, -1300325060,  1701035922, -1310787095,
+     1692961062, -1321199781,  1684822463, -1331562723,
+     1676620432, -1341875533,  1668355276, -1352137822,
+     1660027308, -1362349204,  1651636841, -1372509294,
+     1643184191, -1382617710,  1634669676, -1392674072,
+     1626093616, -1402678000,  1617456335, -1412629117,
+     1608758157, -1422527051,  1599999411, -1432371426,
+     1591180426, -1442161874,  1582301533, -1451898025,
+     1573363068, -1461579514,  1564365367, -1471205974,
+     1555308768, -1480777044,  1546193612, -1490292364,
+     1537020244, -1499751576,  1527789007, -1509154322,
+     1518500250, -1518500250,  1509154322, -1527789007,
+     1499751576, -1537020244,  1490292364, -1546193612,
+     1480777044, -1555308768,  1471205974, -1564365367,
+     1461579514, -1573363068,  1451898025, -1582301533,
+     1442161874, -1591180426,  1432371426, -1599999411,
+     1422527051, -1608758157,  1412629117, -1617456335,
+     1402678000, -1626093616,  1392674072, -1634669676,
+     1382617710, -1643184191,  1372509294, -1651636841,
+     1362349204, -1660027308,  1352137822, -1668355276,
+     1341875533, -1676620432,  1331562723, -1684822463,
+     1321199781, -1692961062,  1310787095, -1701035922,
+     1300325060, -1709046739,  1289814068, -1716993211,
+     1279254516, -1724875040,  1268646800, -1732691928,
+     1257991320, -1740443581,  1247288478, -1748129707,
+     1236538675, -1755750017,  1225742318, -1763304224,
+     1214899813, -1770792044,  1204011567, -1778213194,
+     1193077991, -1785567396,  1182099496, -1792854372,
+     1171076495, -1800073849,  1160009405, -1807225553,
+     1148898640, -1814309216,  1137744621, -1821324572,
+     1126547765, -1828271356,  1115308496, -1835149306,
+     1104027237, -1841958164,  1092704411, -1848697674,
+     1081340445, -1855367581,  1069935768, -1861967634,
+     1058490808, -1868497586,  1047005996, -1874957189,
+     1035481766, -1881346202,  1023918550, -1887664383,
+     1012316784, -1893911494,  1000676905, -1900087301,
+      988999351, -1906191570,   977284562, -1912224073,
+      965532978, -1918184581,   953745043, -1924072871,
+      941921200, -1929888720,   930061894, -1935631910,
+      918167572, -1941302225,   906238681, -1946899451,
+      894275671, -1952423377,   882278992, -1957873796,
+      870249095, -1963250501,   858186435, -1968553292,
+      846091463, -1973781967,   833964638, -1978936331,
+      821806413, -1984016189,   809617249, -1989021350,
+      797397602, -1993951625,   785147934, -1998806829,
+      772868706, -2003586779,   760560380, -2008291295,
+      748223418, -2012920201,   735858287, -2017473321,
+      723465451, -2021950484,   711045377, -2026351522,
+      698598533, -2030676269,   686125387, -2034924562,
+      673626408, -2039096241,   661102068, -2043191150,
+      648552838, -2047209133,   635979190, -2051150040,
+      623381598, -2055013723,   610760536, -2058800036,
+      598116479, -2062508835,   585449903, -2066139983,
+      572761285, -2069693342,   560051104, -2073168777,
+      547319836, -2076566160,   534567963, -2079885360,
+      521795963, -2083126254,   509004318, -2086288720,
+      496193509, -2089372638,   483364019, -2092377892,
+      470516330, -2095304370,   457650927, -2098151960,
+      444768294, -2100920556,   431868915, -2103610054,
+      418953276, -2106220352,   406021865, -2108751352,
+      393075166, -2111202959,   380113669, -2113575080,
+      367137861, -2115867626,   354148230, -2118080511,
+      341145265, -2120213651,   328129457, -2122266967,
+      315101295, -2124240380,   302061269, -2126133817,
+      289009871, -2127947206,   275947592, -2129680480,
+      262874923, -2131333572,   249792358, -2132906420,
+      236700388, -2134398966,   223599506, -2135811153,
+      210490206, -2137142927,   197372981, -2138394240,
+      184248325, -2139565043,   171116733, -2140655293,
+      157978697, -2141664948,   144834714, -2142593971,
+      131685278, -2143442326,   118530885, -2144209982,
+      105372028, -2144896910,    92209205, -2145503083,
+       79042909, -2146028480,    65873638, -2146473080,
+       52701887, -2146836866,    39528151, -2147119825,
+       26352928, -2147321946,    13176712, -2147443222,
+              0, -2147483647,   -13176712, -2147443222,
+      -26352928, -2147321946,   -39528151, -2147119825,
+      -52701887, -2146836866,   -65873638, -2146473080,
+      -79042909, -2146028480,   -92209205, -2145503083,
+     -105372028, -2144896910,  -118530885, -2144209982,
+     -131685278, -2143442326,  -144834714, -2142593971,
+     -157978697, -2141664948,  -171116733, -2140655293,
+     -184248325, -2139565043,  -197372981, -2138394240,
+     -210490206, -2137142927,  -223599506, -2135811153,
+     -236700388, -2134398966,  -249792358, -2132906420,
+     -262874923, -2131333572,  -275947592, -2129680480,
+     -289009871, -2127947206,  -302061269, -2126133817,
+     -315101295, -2124240380,  -328129457, -2122266967,
+     -341145265, -2120213651,  -354148230, -2118080511,
+     -367137861, -2115867626,  -380113669, -2113575080,
+     -393075166, -2111202959,  -406021865, -2108751352,
+     -418953276, -2106220352,  -431868915, -2103610054,
+     -444768294, -2100920556,  -457650927, -2098151960,
+     -470516330, -2095304370,  -483364019, -2092377892,
+     -496193509, -2089372638,  -509004318, -2086288720,
+     -521795963, -2083126254,  -534567963, -2079885360,
+     -547319836, -2076566160,  -560051104, -2073168777,
+     -572761285, -2069693342,  -585449903, -2066139983,
+     -598116479, -2062508835,  -610760536, -2058800036,
+     -623381598, -2055013723,  -635979190, -2051150040,
+     -648552838, -2047209133,  -661102068, -2043191150,
+     -673626408, -2039096241,  -686125387, -2034924562,
+     -698598533, -2030676269,  -711045377, -2026351522,
+     -723465451, -2021950484,  -735858287, -2017473321,
+     -748223418, -2012920201,  -760560380, -2008291295,
+     -772868706, -2003586779,  -785147934, -1998806829,
+     -797397602, -1993951625,  -809617249, -1989021350,
+     -821806413, -1984016189,  -833964638, -1978936331,
+     -846091463, -1973781967,  -858186435, -1968553292,
+     -870249095, -1963250501,  -882278992, -1957873796,
+     -894275671, -1952423377,  -906238681, -1946899451,
+     -918167572, -1941302225,  -930061894, -1935631910,
+     -941921200, -1929888720,  -953745043, -1924072871,
+     -965532978, -1918184581,  -977284562, -1912224073,
+     -988999351, -1906191570, -1000676905, -1900087301,
+    -1012316784, -1893911494, -1023918550, -1887664383,
+    -1035481766, -1881346202, -1047005996, -1874957189,
+    -1058490808, -1868497586, -1069935768, -1861967634,
+    -1081340445, -1855367581, -1092704411, -1848697674,
+    -1104027237, -1841958164, -1115308496, -1835149306,
+    -1126547765, -1828271356, -1137744621, -1821324572,
+    -1148898640, -1814309216, -1160009405, -1807225553,
+    -1171076495, -1800073849, -1182099496, -1792854372,
+    -1193077991, -1785567396, -1204011567, -1778213194,
+    -1214899813, -1770792044, -1225742318, -1763304224,
+    -1236538675, -1755750017, -1247288478, -1748129707,
+    -1257991320, -1740443581, -1268646800, -1732691928,
+    -1279254516, -1724875040, -1289814068, -1716993211,
+    -1300325060, -1709046739, -1310787095, -1701035922,
+    -1321199781, -1692961062, -1331562723, -1684822463,
+    -1341875533, -1676620432, -1352137822, -1668355276,
+    -1362349204, -1660027308, -1372509294, -1651636841,
+    -1382617710, -1643184191, -1392674072, -1634669676,
+    -1402678000, -1626093616, -1412629117, -1617456335,
+    -1422527051, -1608758157, -1432371426, -1599999411,
+    -1442161874, -1591180426, -1451898025, -1582301533,
+    -1461579514, -1573363068, -1471205974, -1564365367,
+    -1480777044, -1555308768, -1490292364, -1546193612,
+    -1499751576, -1537020244, -1509154322, -1527789007,
+    -1518500250, -1518500250, -1527789007, -1509154322,
+    -1537020244, -1499751576, -1546193612, -1490292364,
+    -1555308768, -1480777044, -1564365367, -1471205974,
+    -1573363068, -1461579514, -1582301533, -1451898025,
+    -1591180426, -1442161874, -1599999411, -1432371426,
+    -1608758157, -1422527051, -1617456335, -1412629117,
+    -1626093616, -1402678000, -1634669676, -1392674072,
+    -1643184191, -1382617710, -1651636841, -1372509294,
+    -1660027308, -1362349204, -1668355276, -1352137822,
+    -1676620432, -1341875533, -1684822463, -1331562723,
+    -1692961062, -1321199781, -1701035922, -1310787095,
+    -1709046739, -1300325060, -1716993211, -1289814068,
+    -1724875040, -1279254516, -1732691928, -1268646800,
+    -1740443581, -1257991320, -1748129707, -1247288478,
+    -1755750017, -1236538675, -1763304224, -1225742318,
+    -1770792044, -1214899813, -1778213194, -1204011567,
+    -1785567396, -1193077991, -1792854372, -1182099496,
+    -1800073849, -1171076495, -1807225553, -1160009405,
+    -1814309216, -1148898640, -1821324572, -1137744621,
+    -1828271356, -1126547765, -1835149306, -1115308496,
+    -1841958164, -1104027237, -1848697674, -1092704411,
+    -1855367581, -1081340445, -1861967634, -1069935768,
+    -1868497586, -1058490808, -1874957189, -1047005996,
+    -1881346202, -1035481766, -1887664383, -1023918550,
+    -1893911494, -1012316784, -1900087301, -1000676905,
+    -1906191570,  -988999351, -1912224073,  -977284562,
+    -1918184581,  -965532978, -1924072871,  -953745043,
+    -1929888720,  -941921200, -1935631910,  -930061894,
+    -1941302225,  -918167572, -1946899451,  -906238681,
+    -1952423377,  -894275671, -1957873796,  -882278992,
+    -1963250501,  -870249095, -1968553292,  -858186435,
+    -1973781967,  -846091463, -1978936331,  -833964638,
+    -1984016189,  -821806413, -1989021350,  -809617249,
+    -1993951625,  -797397602, -1998806829,  -785147934,
+    -2003586779,  -772868706, -2008291295,  -760560380,
+    -2012920201,  -748223418, -2017473321,  -735858287,
+    -2021950484,  -723465451, -2026351522,  -711045377,
+    -2030676269,  -698598533, -2034924562,  -686125387,
+    -2039096241,  -673626408, -2043191150,  -661102068,
+    -2047209133,  -648552838, -2051150040,  -635979190,
+    -2055013723,  -623381598, -2058800036,  -610760536,
+    -2062508835,  -598116479, -2066139983,  -585449903,
+    -2069693342,  -572761285, -2073168777,  -560051104,
+    -2076566160,  -547319836, -2079885360,  -534567963,
+    -2083126254,  -521795963, -2086288720,  -509004318,
+    -2089372638,  -496193509, -2092377892,  -483364019,
+    -2095304370,  -470516330, -2098151960,  -457650927,
+    -2100920556,  -444768294, -2103610054,  -431868915,
+    -2106220352,  -418953276, -2108751352,  -406021865,
+    -2111202959,  -393075166, -2113575080,  -380113669,
+    -2115867626,  -367137861, -2118080511,  -354148230,
+    -2120213651,  -341145265, -2122266967,  -328129457,
+    -2124240380,  -315101295, -2126133817,  -302061269,
+    -2127947206,  -289009871, -2129680480,  -275947592,
+    -2131333572,  -262874923, -2132906420,  -249792358,
+    -2134398966,  -236700388, -2135811153,  -223599506,
+    -2137142927,  -210490206, -2138394240,  -197372981,
+    -2139565043,  -184248325, -2140655293,  -171116733,
+    -2141664948,  -157978697, -2142593971,  -144834714,
+    -2143442326,  -131685278, -2144209982,  -118530885,
+    -2144896910,  -105372028, -2145503083,   -92209205,
+    -2146028480,   -79042909, -2146473080,   -65873638,
+    -2146836866,   -52701887, -2147119825,   -39528151,
+    -2147321946,   -26352928, -2147443222,   -13176712,
+    -2147483647,           0, -2147443222,    13176712,
+    -2147321946,    26352928, -2147119825,    39528151,
+    -2146836866,    52701887, -2146473080,    65873638,
+    -2146028480,    79042909, -2145503083,    92209205,
+    -2144896910,   105372028, -2144209982,   118530885,
+    -2143442326,   131685278, -2142593971,   144834714,
+    -2141664948,   157978697, -2140655293,   171116733,
+    -2139565043,   184248325, -2138394240,   197372981,
+    -2137142927,   210490206, -2135811153,   223599506,
+    -2134398966,   236700388, -2132906420,   249792358,
+    -2131333572,   262874923, -2129680480,   275947592,
+    -2127947206,   289009871, -2126133817,   302061269,
+    -2124240380,   315101295, -2122266967,   328129457,
+    -2120213651,   341145265, -2118080511,   354148230,
+    -2115867626,   367137861, -2113575080,   380113669,
+    -2111202959,   393075166, -2108751352,   406021865,
+    -2106220352,   418953276, -2103610054,   431868915,
+    -2100920556,   444768294, -2098151960,   457650927,
+    -2095304370,   470516330, -2092377892,   483364019,
+    -2089372638,   496193509, -2086288720,   509004318,
+    -2083126254,   521795963, -2079885360,   534567963,
+    -2076566160,   547319836, -2073168777,   560051104,
+    -2069693342,   572761285, -2066139983,   585449903,
+    -2062508835,   598116479, -2058800036,   610760536,
+    -2055013723,   623381598, -2051150040,   635979190,
+    -2047209133,   648552838, -2043191150,   661102068,
+    -2039096241,   673626408, -2034924562,   686125387,
+    -2030676269,   698598533, -2026351522,   711045377,
+    -2021950484,   723465451, -2017473321,   735858287,
+    -2012920201,   748223418, -2008291295,   760560380,
+    -2003586779,   772868706, -1998806829,   785147934,
+    -1993951625,   797397602, -1989021350,   809617249,
+    -1984016189,   821806413, -1978936331,   833964638,
+    -1973781967,   846091463, -1968553292,   858186435,
+    -1963250501,   870249095, -1957873796,   882278992,
+    -1952423377,   894275671, -1946899451,   906238681,
+    -1941302225,   918167572, -1935631910,   930061894,
+    -1929888720,   941921200, -1924072871,   953745043,
+    -1918184581,   965532978, -1912224073,   977284562,
+    -1906191570,   988999351, -1900087301,  1000676905,
+    -1893911494,  1012316784, -1887664383,  1023918550,
+    -1881346202,  1035481766, -1874957189,  1047005996,
+    -1868497586,  1058490808, -1861967634,  1069935768,
+    -1855367581,  1081340445, -1848697674,  1092704411,
+    -1841958164,  1104027237, -1835149306,  1115308496,
+    -1828271356,  1126547765, -1821324572,  1137744621,
+    -1814309216,  1148898640, -1807225553,  1160009405,
+    -1800073849,  1171076495, -1792854372,  1182099496,
+    -1785567396,  1193077991, -1778213194,  1204011567,
+    -1770792044,  1214899813, -1763304224,  1225742318,
+    -1755750017,  1236538675, -1748129707,  1247288478,
+    -1740443581,  1257991320, -1732691928,  1268646800,
+    -1724875040,  1279254516, -1716993211,  1289814068,
+    -1709046739,  1300325060, -1701035922,  1310787095,
+    -1692961062,  1321199781, -1684822463,  1331562723,
+    -1676620432,  1341875533, -1668355276,  1352137822,
+    -1660027308,  1362349204, -1651636841,  1372509294,
+    -1643184191,  1382617710, -1634669676,  1392674072,
+    -1626093616,  1402678000, -1617456335,  1412629117,
+    -1608758157,  1422527051, -1599999411,  1432371426,
+    -1591180426,  1442161874, -1582301533,  1451898025,
+    -1573363068,  1461579514, -1564365367,  1471205974,
+    -1555308768,  1480777044, -1546193612,  1490292364,
+    -1537020244,  1499751576, -1527789007,  1509154322,
+    -1518500250,  1518500250, -1509154322,  1527789007,
+    -1499751576,  1537020244, -1490292364,  1546193612,
+    -1480777044,  1555308768, -1471205974,  1564365367,
+    -1461579514,  1573363068, -1451898025,  1582301533,
+    -1442161874,  1591180426, -1432371426,  1599999411,
+    -1422527051,  1608758157, -1412629117,  1617456335,
+    -1402678000,  1626093616, -1392674072,  1634669676,
+    -1382617710,  1643184191, -1372509294,  1651636841,
+    -1362349204,  1660027308, -1352137822,  1668355276,
+    -1341875533,  1676620432, -1331562723,  1684822463,
+    -1321199781,  1692961062, -1310787095,  1701035922,
+    -1300325060,  1709046739, -1289814068,  1716993211,
+    -1279254516,  1724875040, -1268646800,  1732691928,
+    -1257991320,  1740443581, -1247288478,  1748129707,
+    -1236538675,  1755750017, -1225742318,  1763304224,
+    -1214899813,  1770792044, -1204011567,  1778213194,
+    -1193077991,  1785567396, -1182099496,  1792854372,
+    -1171076495,  1800073849, -1160009405,  1807225553,
+    -1148898640,  1814309216, -1137744621,  1821324572,
+    -1126547765,  1828271356, -1115308496,  1835149306,
+    -1104027237,  1841958164, -1092704411,  1848697674,
+    -1081340445,  1855367581, -1069935768,  1861967634,
+    -1058490808,  1868497586, -1047005996,  1874957189,
+    -1035481766,  1881346202, -1023918550,  1887664383,
+    -1012316784,  1893911494, -1000676905,  1900087301,
+     -988999351,  1906191570,  -977284562,  1912224073,
+     -965532978,  1918184581,  -953745043,  1924072871,
+     -941921200,  1929888720,  -930061894,  1935631910,
+     -918167572,  1941302225,  -906238681,  1946899451,
+     -894275671,  1952423377,  -882278992,  1957873796,
+     -870249095,  1963250501,  -858186435,  1968553292,
+     -846091463,  1973781967,  -833964638,  1978936331,
+     -821806413,  1984016189,  -809617249,  1989021350,
+     -797397602,  1993951625,  -785147934,  1998806829,
+     -772868706,  2003586779,  -760560380,  2008291295,
+     -748223418,  2012920201,  -735858287,  2017473321,
+     -723465451,  2021950484,  -711045377,  2026351522,
+     -698598533,  2030676269,  -686125387,  2034924562,
+     -673626408,  2039096241,  -661102068,  2043191150,
+     -648552838,  2047209133,  -635979190,  2051150040,
+     -623381598,  2055013723,  -610760536,  2058800036,
+     -598116479,  2062508835,  -585449903,  2066139983,
+     -572761285,  2069693342,  -560051104,  2073168777,
+     -547319836,  2076566160,  -534567963,  2079885360,
+     -521795963,  2083126254,  -509004318,  2086288720,
+     -496193509,  2089372638,  -483364019,  2092377892,
+     -470516330,  2095304370,  -457650927,  2098151960,
+     -444768294,  2100920556,  -431868915,  2103610054,
+     -418953276,  2106220352,  -406021865,  2108751352,
+     -393075166,  2111202959,  -380113669,  2113575080,
+     -367137861,  2115867626,  -354148230,  2118080511,
+     -341145265,  2120213651,  -328129457,  2122266967,
+     -315101295,  2124240380,  -302061269,  2126133817,
+     -289009871,  2127947206,  -275947592,  2129680480,
+     -262874923,  2131333572,  -249792358,  2132906420,
+     -236700388,  2134398966,  -223599506,  2135811153,
+     -210490206,  2137142927,  -197372981,  2138394240,
+     -184248325,  2139565043,  -171116733,  2140655293,
+     -157978697,  2141664948,  -144834714,  2142593971,
+     -131685278,  2143442326,  -118530885,  2144209982,
+     -105372028,  2144896910,   -92209205,  2145503083,
+      -79042909,  2146028480,   -65873638,  2146473080,
+      -52701887,  2146836866,   -39528151,  2147119825,
+      -26352928,  2147321946,   -13176712,  2147443222
+};
+
+//*****************************************************************************
+//
+// The bit-reversed value of each index 0 .. FFT_MAX_SIZE - 1 over
+// log2(FFT_MAX_SIZE) bits.
+//
+//*****************************************************************************
+static const uint16_t g_pui16FFTBitRev[FFT_MAX_SIZE] =
+{
+       0,  512,  256,  768,  128,  640,  384,  896,   64,  576,
+     320,  832,  192,  704,  448,  960,   32,  544,  288,  800,
+     160,  672,  416,  928,   96,  608,  352,  864,  224,  736,
+     480,  992,   16,  528,  272,  784,  144,  656,  400,  912,
+      80,  592,  336,  848,  208,  720,  464,  976,   48,  560,
+     304,  816,  176,  688,  432,  944,  112,  624,  368,  880,
+     240,  752,  496, 1008,    8,  520,  264,  776,  136,  648,
+     392,  904,   72,  584,  328,  840,  200,  712,  456,  968,
+      40,  552,  296,  808,  168,  680,  424,  936,  104,  616,
+     360,  872,  232,  744,  488, 1000,   24,  536,  280,  792,
+     152,  664,  408,  920,   88,  600,  344,  856,  216,  728,
+     472,  984,   56,  568,  312,  824,  184,  696,  440,  952,
+     120,  632,  376,  888,  248,  760,  504, 1016,    4,  516,
+     260,  772,  132,  644,  388,  900,   68,  580,  324,  836,
+     196,  708,  452,  964,   36,  548,  292,  804,  164,  676,
+     420,  932,  100,  612,  356,  868,  228,  740,  484,  996,
+      20,  532,  276,  788,  148,  660,  404,  916,   84,  596,
+     340,  852,  212,  724,  468,  980,   52,  564,  308,  820,
+     180,  692,  436,  948,  116,  628,  372,  884,  244,  756,
+     500, 1012,   12,  524,  268,  780,  140,  652,  396,  908,
+      76,  588,  332,  844,  204,  716,  460,  972,   44,  556,
+     300,  812,  172,  684,  428,  940,  108,  620,  364,  876,
+     236,  748,  492, 1004,   28,  540,  284,  796,  156,  668,
+     412,  924,   92,  604,  348,  860,  220,  732,  476,  988,
+      60,  572,  316,  828,  188,  700,  444,  956,  124,  636,
+     380,  892,  252,  764,  508, 1020,    2,  514,  258,  770,
+     130,  642,  386,  898,   66,  578,  322,  834,  194,  706,
+     450,  962,   34,  546,  290,  802,  162,  674,  418,  930,
+      98,  610,  354,  866,  226,  738,  482,  994,   18,  530,
+     274,  786,  146,  658,  402,  914,   82,  594,  338,  850,
+     210,  722,  466,  978,   50,  562,  306,  818,  178,  690,
+     434,  946,  114,  626,  370,  882,  242,  754,  498, 1010,
+      10,  522,  266,  778,  138,  650,  394,  906,   74,  586,
+     330,  842,  202,  714,  458,  970,   42,  554,  298,  810,
+     170,  682,  426,  938,  106,  618,  362,  874,  234,  746,
+     490, 1002,   26,  538,  282,  794,  154,  666,  410,  922,
+      90,  602,  346,  858,  218,  730,  474,  986,   58,  570,
+     314,  826,  186,  698,  442,  954,  122,  634,  378,  890,
+     250,  762,  506, 1018,    6,  518,  262,  774,  134,  646,
+     390,  902,   70,  582,  326,  838,  198,  710,  454,  966,
+      38,  550,  294,  806,  166,  678,  422,  934,  102,  614,
+     358,  870,  230,  742,  486,  998,   22,  534,  278,  790,
+     150,  662,  406,  918,   86,  598,  342,  854,  214,  726,
+     470,  982,   54,  566,  310,  822,  182,  694,  438,  950,
+     118,  630,  374,  886,  246,  758,  502, 1014,   14,  526,
+     270,  782,  142,  654,  398,  910,   78,  590,  334,  846,
+     206,  718,  462,  974,   46,  558,  302,  814,  174,  686,
+     430,  942,  110,  622,  366,  878,  238,  750,  494, 1006,
+      30,  542,  286,  798,  158,  670,  414,  926,   94,  606,
+     350,  862,  222,  734,  478,  990,   62,  574,  318,  830,
+     190,  702,  446,  958,  126,  638,  382,  894,  254,  766,
+     510, 1022,    1,  513,  257,  769,  129,  641,  385,  897,
+      65,  577,  321,  833,  193,  705,  449,  961,   33,  545,
+     289,  801,  161,  673,  417,  929,   97,  609,  353,  865,
+     225,  737,  481,  993,   17,  529,  273,  785,  145,  657,
+     401,  913,   81,  593,  337,  849,  209,  721,  465,  977,
+      49,  561,  305,  817,  177,  689,  433,  945,  113,  625,
+     369,  881,  241,  753,  497, 1009,    9,  521,  265,  777,
+     137,  649,  393,  905,   73,  585,  329,  841,  201,  713,
+     457,  969,   41,  553,  297,  809,  169,  681,  425,  937,
+     105,  617,  361,  873,  233,  745,  489, 1001,   25,  537,
+     281,  793,  153,  665,  409,  921,   89,  601,  345,  857,
+     217,  729,  473,  985,   57,  569,  313,  825,  185,  697,
+     441,  953,  121,  633,  377,  889,  249,  761,  505, 1017,
+       5,  517,  261,  773,  133,  645,  389,  901,   69,  581,
+     325,  837,  197,  709,  453,  965,   37,  549,  293,  805,
+     165,  677,  421,  933,  101,  613,  357,  869,  229,  741,
+     485,  997,   21,  533,  277,  789,  149,  661,  405,  917,
+      85,  597,  341,  853,  213,  725,  469,  981,   53,  565,
+     309,  821,  181,  693,  437,  949,  117,  629,  373,  885,
+     245,  757,  501, 1013,   13,  525,  269,  781,  141,  653,
+     397,  909,   77,  589,  333,  845,  205,  717,  461,  973,
+      45,  557,  301,  813,  173,  685,  429,  941,  109,  621,
+     365,  877,  237,  749,  493, 1005,   29,  541,  285,  797,
+     157,  669,  413,  925,   93,  605,  349,  861,  221,  733,
+     477,  989,   61,  573,  317,  829,  189,  701,  445,  957,
+     125,  637,  381,  893,  253,  765,  509, 1021,    3,  515,
+     259,  771,  131,  643,  387,  899,   67,  579,  323,  835,
+     195,  707,  451,  963,   35,  547,  291,  803,  163,  675,
+     419,  931,   99,  611,  355,  867,  227,  739,  483,  995,
+      19,  531,  275,  787,  147,  659,  403,  915,   83,  595,
+     339,  851,  211,  723,  467,  979,   51,  563,  307,  819,
+     179,  691,  435,  947,  115,  627,  371,  883,  243,  755,
+     499, 1011,   11,  523,  267,  779,  139,  651,  395,  907,
+      75,  587,  331,  843,  203,  715,  459,  971,   43,  555,
+     299,  811,  171,  683,  427,  939,  107,  619,  363,  875,
+     235,  747,  491, 1003,   27,  539,  283,  795,  155,  667,
+     411,  923,   91,  603,  347,  859,  219,  731,  475,  987,
+      59,  571,  315,  827,  187,  699,  443,  955,  123,  635,
+     379,  891,  251,  763,  507, 1019,    7,  519,  263,  775,
+     135,  647,  391,  903,   71,  583,  327,  839,  199,  711,
+     455,  967,   39,  551,  295,  807,  167,  679,  423,  935,
+     103,  615,  359,  871,  231,  743,  487,  999,   23,  535,
+     279,  791,  151,  663,  407,  919,   87,  599,  343,  855,
+     215,  727,  471,  983,   55,  567,  311,  823,  183,  695,
+     439,  951,  119,  631,  375,  887,  247,  759,  503, 1015,
+      15,  527,  271,  783,  143,  655,  399,  911,   79,  591,
+     335,  847,  207,  719,  463,  975,   47,  559,  303,  815,
+     175,  687,  431,  943,  111,  623,  367,  879,  239,  751,
+     495, 1007,   31,  543,  287,  799,  159,  671,  415,  927,
+      95,  607,  351,  863,  223,  735,  479,  991,   63,  575,
+     319,  831,  191,  703,  447,  959,  127,  639,  383,  895,
+     255,  767,  511, 1023
+};
+
+//*****************************************************************************
+//
+// Multiplies two Q15 values, or two Q31 values, with rounding.
+//
+//*****************************************************************************
+#define FFT_MUL(a, b)           ((((int32_t)(a) * (b)) + 0x4000) >> 15)
+#define FFT_MUL31(a, b)         ((((int64_t)(a) * (b)) + 0x40000000) >> 31)
+
+//*****************************************************************************
+//
+// Saturates a 64-bit intermediate to Q31.
+//
+//*****************************************************************************
+static __inline int32_t
+FFTSat32(int64_t i64Value)
+{
+    if(i64Value > Q31_MAX)
+    {
+        return(Q31_MAX);
+    }
+    if(i64Value < Q31_MIN)
+    {
+        return(Q31_MIN);
+    }
+    return((int32_t)i64Value);
+}
+
+//*****************************************************************************
+//
+// Returns the bit-reversal shift for a complex transform of ui32N points, or
+// a value above log2(FFT_MAX_SIZE) if ui32N is not a power of two.
+//
+//*****************************************************************************
+static uint32_t
+FFTRevShift(uint32_t ui32N)
+{
+    uint32_t ui32Shift;
+
+    if((ui32N == 0) || (ui32N & (ui32N - 1)))
+    {
+        return(32);
+    }
+    for(ui32Shift = 0; (ui32N << ui32Shift) < FFT_MAX_SIZE; ui32Shift++)
+    {
+    }
+    return(ui32Shift);
+}
+
+//*****************************************************************************
+//
+// The in-place complex Q15 transform on ui32N interleaved points.
+//
+//*****************************************************************************
+static void FFT_KERNEL
+FFTComplexQ15(int16_t *pi16Data, uint32_t ui32N, uint32_t ui32RevShift,
+              bool bInverse)
+{
+    uint32_t ui32Len, ui32Quarter, ui32Step, ui32I, ui32J, ui32G;
+    int32_t i32W1r, i32W1i, i32W2r, i32W2i, i32W3r, i32W3i;
+    int32_t i32T0r, i32T0i, i32T1r, i32T1i, i32T2r, i32T2i, i32T3r, i32T3i;
+    int32_t i32Yr, i32Yi;
+    int16_t *pi16A, *pi16B, *pi16C, *pi16D;
+    int16_t i16Tmp;
+
+    //
+    // Radix-4 stages.  For input n of a length-L butterfly group:
+    //     T0 = a + c, T1 = a - c, T2 = b + d, T3 = b - d
+    //     X(4r)     <- T0 + T2
+    //     X(4r + 2) <- (T0 - T2) W^2n
+    //     X(4r + 1) <- (T1 -+ j T3) W^n
+    //     X(4r + 3) <- (T1 +- j T3) W^3n
+    // with the upper signs forward and conjugate twiddles inverse.  The
+    // outputs go to quarters 0, 2, 1, 3 of the group: bit-reversed.
+    //
+    for(ui32Len = ui32N; ui32Len >= 4; ui32Len >>= 2)
+    {
+        ui32Quarter = ui32Len >> 2;
+        ui32Step = FFT_MAX_SIZE / ui32Len;
+        for(ui32J = 0; ui32J < ui32Quarter; ui32J++)
+        {
+            i32W1r = g_pi16FFTTwiddleQ15[2 * ui32J * ui32Step];
+            i32W1i = g_pi16FFTTwiddleQ15[(2 * ui32J * ui32Step) + 1];
+            i32W2r = g_pi16FFTTwiddleQ15[4 * ui32J * ui32Step];
+            i32W2i = g_pi16FFTTwiddleQ15[(4 * ui32J * ui32Step) + 1];
+            i32W3r = g_pi16FFTTwiddleQ15[6 * ui32J * ui32Step];
+            i32W3i = g_pi16FFTTwiddleQ15[(6 * ui32J * ui32Step) + 1];
+            if(bInverse)
+            {
+                i32W1i = -i32W1i;
+                i32W2i = -i32W2i;
+                i32W3i = -i32W3i;
+            }
+
+            for(ui32G = 0; ui32G < ui32N; ui32G += ui32Len)
+            {
+                pi16A = &pi16Data[2 * (ui32G + ui32J)];
+                pi16B = pi16A + (2 * ui32Quarter);
+                pi16C = pi16B + (2 * ui32Quarter);
+                pi16D = pi16C + (2 * ui32Quarter);
+
+                i32T0r = pi16A[0] + pi16C[0];
+                i32T0i = pi16A[1] + pi16C[1];
+                i32T1r = pi16A[0] - pi16C[0];
+                i32T1i = pi16A[1] - pi16C[1];
+                i32T2r = pi16B[0] + pi16D[0];
+                i32T2i = pi16B[1] + pi16D[1];
+                i32T3r = pi16B[0] - pi16D[0];
+                i32T3i = pi16B[1] - pi16D[1];
+                if(bInverse)
+                {
+                    i32T3r = -i32T3r;
+                    i32T3i = -i32T3i;
+                }
+
+                //
+                // Scale the butterfly sums by 1/4 going forward, or clamp
+                // them to Q15 going back, before the twiddle multiplies.
+                //
+                if(bInverse)
+                {
+                    pi16A[0] = DSPSat16(i32T0r + i32T2r);
+                    pi16A[1] = DSPSat16(i32T0i + i32T2i);
+                    i32Yr = DSPSat16(i32T0r - i32T2r);
+                    i32Yi = DSPSat16(i32T0i - i32T2i);
+                }
+                else
+                {
+                    pi16A[0] = (int16_t)((i32T0r + i32T2r) >> 2);
+                    pi16A[1] = (int16_t)((i32T0i + i32T2i) >> 2);
+                    i32Yr = (i32T0r - i32T2r) >> 2;
+                    i32Yi = (i32T0i - i32T2i) >> 2;
+                }
+                pi16B[0] = DSPSat16(FFT_MUL(i32Yr, i32W2r) -
+                                    FFT_MUL(i32Yi, i32W2i));
+                pi16B[1] = DSPSat16(FFT_MUL(i32Yr, i32W2i) +
+                                    FFT_MUL(i32Yi, i32W2r));
+
+                if(bInverse)
+                {
+                    i32Yr = DSPSat16(i32T1r + i32T3i);
+                    i32Yi = DSPSat16(i32T1i - i32T3r);
+                }
+                else
+                {
+                    i32Yr = (i32T1r + i32T3i) >> 2;
+                    i32Yi = (i32T1i - i32T3r) >> 2;
+                }
+                i16Tmp = DSPSat16(FFT_MUL(i32Yr, i32W1r) -
+                                  FFT_MUL(i32Yi, i32W1i));
+                i32Yi = DSPSat16(FFT_MUL(i32Yr, i32W1i) +
+                                 FFT_MUL(i32Yi, i32W1r));
+                pi16C[0] = i16Tmp;
+                pi16C[1] = (int16_t)i32Yi;
+
+                if(bInverse)
+                {
+                    i32Yr = DSPSat16(i32T1r - i32T3i);
+                    i32Yi = DSPSat16(i32T1i + i32T3r);
+                }
+                else
+                {
+                    i32Yr = (i32T1r - i32T3i) >> 2;
+                    i32Yi = (i32T1i + i32T3r) >> 2;
+                }
+                pi16D[0] = DSPSat16(FFT_MUL(i32Yr, i32W3r) -
+                                    FFT_MUL(i32Yi, i32W3i));
+                pi16D[1] = DSPSat16(FFT_MUL(i32Yr, i32W3i) +
+                                    FFT_MUL(i32Yi, i32W3r));
+            }
+        }
+    }
+
+    //
+    // The final radix-2 stage for odd powers of two needs no twiddles.
+    //
+    if(ui32Len == 2)
+    {
+        for(ui32G = 0; ui32G < ui32N; ui32G += 2)
+        {
+            pi16A = &pi16Data[2 * ui32G];
+            i32T0r = pi16A[0] + pi16A[2];
+            i32T0i = pi16A[1] + pi16A[3];
+            i32T1r = pi16A[0] - pi16A[2];
+            i32T1i = pi16A[1] - pi16A[3];
+            if(bInverse)
+            {
+                pi16A[0] = DSPSat16(i32T0r);
+                pi16A[1] = DSPSat16(i32T0i);
+                pi16A[2] = DSPSat16(i32T1r);
+                pi16A[3] = DSPSat16(i32T1i);
+            }
+            else
+            {
+                pi16A[0] = (int16_t)(i32T0r >> 1);
+                pi16A[1] = (int16_t)(i32T0i >> 1);
+                pi16A[2] = (int16_t)(i32T1r >> 1);
+                pi16A[3] = (int16_t)(i32T1i >> 1);
+            }
+        }
+    }
+
+    //
+    // Undo the bit-reversed output order.
+    //
+    for(ui32I = 1; ui32I < ui32N; ui32I++)
+    {
+        ui32J = g_pui16FFTBitRev[ui32I] >> ui32RevShift;
+        if(ui32I < ui32J)
+        {
+            i16Tmp = pi16Data[2 * ui32I];
+            pi16Data[2 * ui32I] = pi16Data[2 * ui32J];
+            pi16Data[2 * ui32J] = i16Tmp;
+            i16Tmp = pi16Data[(2 * ui32I) + 1];
+            pi16Data[(2 * ui32I) + 1] = pi16Data[(2 * ui32J) + 1];
+            pi16Data[(2 * ui32J) + 1] = i16Tmp;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// The in-place complex Q31 transform on ui32N interleaved points.  The
+// structure is that of FFTComplexQ15(); going forward the inputs are scaled
+// by 1/4 before the butterfly sums so that those stay within 32 bits, and
+// going back the sums are formed in 64 bits and saturated.
+//
+//*****************************************************************************
+static void FFT_KERNEL
+FFTComplexQ31(int32_t *pi32Data, uint32_t ui32N, uint32_t ui32RevShift,
+              bool bInverse)
+{
+    uint32_t ui32Len, ui32Quarter, ui32Step, ui32I, ui32J, ui32G;
+    int32_t i32W1r, i32W1i, i32W2r, i32W2i, i32W3r, i32W3i;
+    int64_t i64Ar, i64Ai, i64Br, i64Bi, i64Cr, i64Ci, i64Dr, i64Di;
+    int64_t i64T0r, i64T0i, i64T1r, i64T1i, i64T2r, i64T2i, i64T3r, i64T3i;
+    int32_t i32Yr, i32Yi, i32Tmp;
+    int32_t *pi32A, *pi32B, *pi32C, *pi32D;
+
+    for(ui32Len = ui32N; ui32Len >= 4; ui32Len >>= 2)
+    {
+        ui32Quarter = ui32Len >> 2;
+        ui32Step = FFT_MAX_SIZE / ui32Len;
+        for(ui32J = 0; ui32J < ui32Quarter; ui32J++)
+        {
+            i32W1r = g_pi32FFTTwiddleQ31[2 * ui32J * ui32Step];
+            i32W1i = g_pi32FFTTwiddleQ31[(2 * ui32J * ui32Step) + 1];
+            i32W2r = g_pi32FFTTwiddleQ31[4 * ui32J * ui32Step];
+            i32W2i = g_pi32FFTTwiddleQ31[(4 * ui32J * ui32Step) + 1];
+            i32W3r = g_pi32FFTTwiddleQ31[6 * ui32J * ui32Step];
+            i32W3i = g_pi32FFTTwiddleQ31[(6 * ui32J * ui32Step) + 1];
+            if(bInverse)
+            {
+                i32W1i = -i32W1i;
+                i32W2i = -i32W2i;
+                i32W3i = -i32W3i;
+            }
+
+            for(ui32G = 0; ui32G < ui32N; ui32G += ui32Len)
+            {
+                pi32A = &pi32Data[2 * (ui32G + ui32J)];
+                pi32B = pi32A + (2 * ui32Quarter);
+                pi32C = pi32B + (2 * ui32Quarter);
+                pi32D = pi32C + (2 * ui32Quarter);
+
+                if(bInverse)
+                {
+                    i64Ar = pi32A[0];
+                    i64Ai = pi32A[1];
+                    i64Br = pi32B[0];
+                    i64Bi = pi32B[1];
+                    i64Cr = pi32C[0];
+                    i64Ci = pi32C[1];
+                    i64Dr = pi32D[0];
+                    i64Di = pi32D[1];
+                }
+                else
+                {
+                    i64Ar = pi32A[0] >> 2;
+                    i64Ai = pi32A[1] >> 2;
+                    i64Br = pi32B[0] >> 2;
+                    i64Bi = pi32B[1] >> 2;
+                    i64Cr = pi32C[0] >> 2;
+                    i64Ci = pi32C[1] >> 2;
+                    i64Dr = pi32D[0] >> 2;
+                    i64Di = pi32D[1] >> 2;
+                }
+                i64T0r = i64Ar + i64Cr;
+                i64T0i = i64Ai + i64Ci;
+                i64T1r = i64Ar - i64Cr;
+                i64T1i = i64Ai - i64Ci;
+                i64T2r = i64Br + i64Dr;
+                i64T2i = i64Bi + i64Di;
+                i64T3r = i64Br - i64Dr;
+                i64T3i = i64Bi - i64Di;
+                if(bInverse)
+                {
+                    i64T3r = -i64T3r;
+                    i64T3i = -i64T3i;
+                }
+
+                pi32A[0] = FFTSat32(i64T0r + i64T2r);
+                pi32A[1] = FFTSat32(i64T0i + i64T2i);
+
+                i32Yr = FFTSat32(i64T0r - i64T2r);
+                i32Yi = FFTSat32(i64T0i - i64T2i);
+                pi32B[0] = FFTSat32(FFT_MUL31(i32Yr, i32W2r) -
+                                    FFT_MUL31(i32Yi, i32W2i));
+                pi32B[1] = FFTSat32(FFT_MUL31(i32Yr, i32W2i) +
+                                    FFT_MUL31(i32Yi, i32W2r));
+
+                i32Yr = FFTSat32(i64T1r + i64T3i);
+                i32Yi = FFTSat32(i64T1i - i64T3r);
+                i32Tmp = FFTSat32(FFT_MUL31(i32Yr, i32W1r) -
+                                  FFT_MUL31(i32Yi, i32W1i));
+                pi32C[1] = FFTSat32(FFT_MUL31(i32Yr, i32W1i) +
+                                    FFT_MUL31(i32Yi, i32W1r));
+                pi32C[0] = i32Tmp;
+
+                i32Yr = FFTSat32(i64T1r - i64T3i);
+                i32Yi = FFTSat32(i64T1i + i64T3r);
+                pi32D[0] = FFTSat32(FFT_MUL31(i32Yr, i32W3r) -
+                                    FFT_MUL31(i32Yi, i32W3i));
+                pi32D[1] = FFTSat32(FFT_MUL31(i32Yr, i32W3i) +
+                                    FFT_MUL31(i32Yi, i32W3r));
+            }
+        }
+    }
+
+    if(ui32Len == 2)
+    {
+        for(ui32G = 0; ui32G < ui32N; ui32G += 2)
+        {
+            pi32A = &pi32Data[2 * ui32G];
+            if(bInverse)
+            {
+                i64T0r = (int64_t)pi32A[0] + pi32A[2];
+                i64T0i = (int64_t)pi32A[1] + pi32A[3];
+                i64T1r = (int64_t)pi32A[0] - pi32A[2];
+                i64T1i = (int64_t)pi32A[1] - pi32A[3];
+            }
+            else
+            {
+                i64T0r = ((int64_t)pi32A[0] + pi32A[2]) >> 1;
+                i64T0i = ((int64_t)pi32A[1] + pi32A[3]) >> 1;
+                i64T1r = ((int64_t)pi32A[0] - pi32A[2]) >> 1;
+                i64T1i = ((int64_t)pi32A[1] - pi32A[3]) >> 1;
+            }
+            pi32A[0] = FFTSat32(i64T0r);
+            pi32A[1] = FFTSat32(i64T0i);
+            pi32A[2] = FFTSat32(i64T1r);
+            pi32A[3] = FFTSat32(i64T1i);
+        }
+    }
+
+    for(ui32I = 1; ui32I < ui32N; ui32I++)
+    {
+        ui32J = g_pui16FFTBitRev[ui32I] >> ui32RevShift;
+        if(ui32I < ui32J)
+        {
+            i32Tmp = pi32Data[2 * ui32I];
+            pi32Data[2 * ui32I] = pi32Data[2 * ui32J];
+            pi32Data[2 * ui32J] = i32Tmp;
+            i32Tmp = pi32Data[(2 * ui32I) + 1];
+            pi32Data[(2 * ui32I) + 1] = pi32Data[(2 * ui32J) + 1];
+            pi32Data[(2 * ui32J) + 1] = i32Tmp;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+//! Initializes a complex FFT instance.
+//!
+//! \param psFFT is a pointer to the instance.
+//! \param ui32Size is the number of complex points, a power of two from
+//! \b FFT_MIN_SIZE to \b FFT_MAX_SIZE.
+//!
+//! \return Returns \b true on success or \b false if the size is not
+//! supported.
+//
+//*****************************************************************************
+bool
+FFTInit(tFFT *psFFT, uint32_t ui32Size)
+{
+    if((ui32Size < FFT_MIN_SIZE) || (ui32Size > FFT_MAX_SIZE) ||
+       (ui32Size & (ui32Size - 1)))
+    {
+        return(false);
+    }
+
+    psFFT->ui32Size = ui32Size;
+    psFFT->ui32RevShift = FFTRevShift(ui32Size);
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Computes the forward transform of a block of complex Q15 samples.
+//!
+//! \param psFFT is a pointer to an instance initialized with FFTInit().
+//! \param pi16Data points to N complex samples as interleaved real and
+//! imaginary parts, each of magnitude no more than 1.
+//!
+//! The transform is done in place and the result is scaled by 1 / N.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+FFTForwardQ15(tFFT *psFFT, int16_t *pi16Data)
+{
+    FFTComplexQ15(pi16Data, psFFT->ui32Size, psFFT->ui32RevShift, false);
+}
+
+//*****************************************************************************
+//
+//! Computes the inverse transform of a block of complex Q15 bins.
+//!
+//! \param psFFT is a pointer to an instance initialized with FFTInit().
+//! \param pi16Data points to N complex bins as interleaved real and
+//! imaginary parts.
+//!
+//! The transform is done in place and is unscaled; intermediate values
+//! saturate.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+FFTInverseQ15(tFFT *psFFT, int16_t *pi16Data)
+{
+    FFTComplexQ15(pi16Data, psFFT->ui32Size, psFFT->ui32RevShift, true);
+}
+
+//*****************************************************************************
+//
+//! Computes the forward transform of a block of complex Q31 samples.
+//!
+//! \param psFFT is a pointer to an instance initialized with FFTInit().
+//! \param pi32Data points to N complex samples as interleaved real and
+//! imaginary parts, each of magnitude no more than 1.
+//!
+//! The transform is done in place and the result is scaled by 1 / N.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+FFTForwardQ31(tFFT *psFFT, int32_t *pi32Data)
+{
+    FFTComplexQ31(pi32Data, psFFT->ui32Size, psFFT->ui32RevShift, false);
+}
+
+//*****************************************************************************
+//
+//! Computes the inverse transform of a block of complex Q31 bins.
+//!
+//! \param psFFT is a pointer to an instance initialized with FFTInit().
+//! \param pi32Data points to N complex bins as interleaved real and
+//! imaginary parts.
+//!
+//! The transform is done in place and is unscaled; intermediate values
+//! saturate.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+FFTInverseQ31(tFFT *psFFT, int32_t *pi32Data)
+{
+    FFTComplexQ31(pi32Data, psFFT->ui32Size, psFFT->ui32RevShift, true);
+}
+
+//*****************************************************************************
+//
+//! Initializes a real FFT instance.
+//!
+//! \param psFFT is a pointer to the instance.
+//! \param ui32Size is the number of real samples, a power of two from
+//! \b FFT_MIN_SIZE to \b FFT_MAX_SIZE.
+//!
+//! \return Returns \b true on success or \b false if the size is not
+//! supported.
+//
+//*****************************************************************************
+bool
+FFTRealInit(tFFT *psFFT, uint32_t ui32Size)
+{
+    if(!FFTInit(psFFT, ui32Size))
+    {
+        return(false);
+    }
+
+    //
+    // The real transform runs a complex transform of half the length.
+    //
+    psFFT->ui32RevShift = FFTRevShift(ui32Size / 2);
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Computes the forward transform of a block of real Q15 samples.
+//!
+//! \param psFFT is a pointer to an instance initialized with FFTRealInit().
+//! \param pi16Data points to N Q15 samples, in a buffer of N + 2 entries.
+//!
+//! The even and odd samples are halved and transformed together as the real
+//! and imaginary parts of N / 2 complex points, and the two spectra are then
+//! separated.  The halving keeps the complex points within the unit circle,
+//! so that full-scale samples do not saturate.  On return the buffer holds
+//! bins 0 to N / 2 as interleaved real and imaginary parts, scaled by 1 / N.
+//! Bins 0 and N / 2 have a zero imaginary part.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+FFTRealForward(tFFT *psFFT, int16_t *pi16Data)
+{
+    uint32_t ui32K, ui32M, ui32Half, ui32Step;
+    int32_t i32Er, i32Ei, i32Or, i32Oi, i32C, i32S, i32Zr, i32Zi;
+
+    ui32Half = psFFT->ui32Size / 2;
+    ui32Step = 2 * (FFT_MAX_SIZE / psFFT->ui32Size);
+    for(ui32K = 0; ui32K < psFFT->ui32Size; ui32K++)
+    {
+        pi16Data[ui32K] >>= 1;
+    }
+    FFTComplexQ15(pi16Data, ui32Half, psFFT->ui32RevShift, false);
+
+    //
+    // Bins 0 and N / 2 come from the real and imaginary parts of Z(0).
+    //
+    i32Zr = pi16Data[0];
+    i32Zi = pi16Data[1];
+    pi16Data[0] = DSPSat16(i32Zr + i32Zi);
+    pi16Data[1] = 0;
+    pi16Data[2 * ui32Half] = DSPSat16(i32Zr - i32Zi);
+    pi16Data[(2 * ui32Half) + 1] = 0;
+
+    //
+    // Split the remaining bins in pairs k, N / 2 - k:
+    //     E = (Z(k) + Z*(N/2 - k)) / 2,  O = (Z(k) - Z*(N/2 - k)) / 2
+    //     X(k) = E - j W^k O,  X(N/2 - k) = E* - j W^(N/2 - k) (-O*)
+    // where halving the samples has already taken the N/2 scaling of Z to N.
+    //
+    for(ui32K = 1; ui32K <= (ui32Half / 2); ui32K++)
+    {
+        ui32M = ui32Half - ui32K;
+        i32Er = (pi16Data[2 * ui32K] + pi16Data[2 * ui32M]) >> 1;
+        i32Ei = (pi16Data[(2 * ui32K) + 1] - pi16Data[(2 * ui32M) + 1]) >> 1;
+        i32Or = (pi16Data[2 * ui32K] - pi16Data[2 * ui32M]) >> 1;
+        i32Oi = (pi16Data[(2 * ui32K) + 1] + pi16Data[(2 * ui32M) + 1]) >> 1;
+        i32C = g_pi16FFTTwiddleQ15[ui32K * ui32Step];
+        i32S = -g_pi16FFTTwiddleQ15[(ui32K * ui32Step) + 1];
+
+        pi16Data[2 * ui32K] = DSPSat16(i32Er + FFT_MUL(i32C, i32Oi) -
+                                       FFT_MUL(i32S, i32Or));
+        pi16Data[(2 * ui32K) + 1] = DSPSat16(i32Ei - FFT_MUL(i32S, i32Oi) -
+                                             FFT_MUL(i32C, i32Or));
+        pi16Data[2 * ui32M] = DSPSat16(i32Er + FFT_MUL(i32S, i32Or) -
+                                       FFT_MUL(i32C, i32Oi));
+        pi16Data[(2 * ui32M) + 1] = DSPSat16(-i32Ei - FFT_MUL(i32S, i32Oi) -
+                                             FFT_MUL(i32C, i32Or));
+    }
+}
+
+//*****************************************************************************
+//
+//! Computes the inverse transform of a Q15 half spectrum.
+//!
+//! \param psFFT is a pointer to an instance initialized with FFTRealInit().
+//! \param pi16Data points to bins 0 to N / 2 as produced by
+//! FFTRealForward(), N + 2 entries.
+//!
+//! On return the first N entries of the buffer hold the real samples.  The
+//! inverse is unscaled, so it undoes the 1 / N of the forward transform;
+//! intermediate values saturate.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+FFTRealInverse(tFFT *psFFT, int16_t *pi16Data)
+{
+    uint32_t ui32K, ui32M, ui32Half, ui32Step;
+    int32_t i32Er, i32Ei, i32Dr, i32Di, i32C, i32S, i32X0, i32XN;
+
+    ui32Half = psFFT->ui32Size / 2;
+    ui32Step = 2 * (FFT_MAX_SIZE / psFFT->ui32Size);
+
+    //
+    // Rebuild Z(0) from bins 0 and N / 2.
+    //
+    i32X0 = pi16Data[0];
+    i32XN = pi16Data[2 * ui32Half];
+    pi16Data[0] = DSPSat16(i32X0 + i32XN);
+    pi16Data[1] = DSPSat16(i32X0 - i32XN);
+
+    //
+    // Merge the remaining bins in pairs k, N / 2 - k:
+    //     E = X(k) + X*(N/2 - k),  D = X(k) - X*(N/2 - k)
+    //     Z(k) = E + j W^-k D
+    //
+    for(ui32K = 1; ui32K <= (ui32Half / 2); ui32K++)
+    {
+        ui32M = ui32Half - ui32K;
+        i32Er = pi16Data[2 * ui32K] + pi16Data[2 * ui32M];
+        i32Ei = pi16Data[(2 * ui32K) + 1] - pi16Data[(2 * ui32M) + 1];
+        i32Dr = pi16Data[2 * ui32K] - pi16Data[2 * ui32M];
+        i32Di = pi16Data[(2 * ui32K) + 1] + pi16Data[(2 * ui32M) + 1];
+        i32C = g_pi16FFTTwiddleQ15[ui32K * ui32Step];
+        i32S = -g_pi16FFTTwiddleQ15[(ui32K * ui32Step) + 1];
+
+        pi16Data[2 * ui32K] = DSPSat16(i32Er - FFT_MUL(i32S, i32Dr) -
+                                       FFT_MUL(i32C, i32Di));
+        pi16Data[(2 * ui32K) + 1] = DSPSat16(i32Ei + FFT_MUL(i32C, i32Dr) -
+                                             FFT_MUL(i32S, i32Di));
+        pi16Data[2 * ui32M] = DSPSat16(i32Er + FFT_MUL(i32S, i32Dr) +
+                                       FFT_MUL(i32C, i32Di));
+        pi16Data[(2 * ui32M) + 1] = DSPSat16(-i32Ei + FFT_MUL(i32C, i32Dr) -
+                                             FFT_MUL(i32S, i32Di));
+    }
+
+    FFTComplexQ15(pi16Data, ui32Half, psFFT->ui32RevShift, true);
+}
+
+//*****************************************************************************
+//
+//! Computes the forward transform of a block of real Q31 samples.
+//!
+//! \param psFFT is a pointer to an instance initialized with FFTRealInit().
+//! \param pi32Data points to N Q31 samples, in a buffer of N + 2 entries.
+//!
+//! This is the Q31 counterpart of FFTRealForward(), with the same layout and
+//! scaling of the result.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+FFTRealForwardQ31(tFFT *psFFT, int32_t *pi32Data)
+{
+    uint32_t ui32K, ui32M, ui32Half, ui32Step;
+    int32_t i32Er, i32Ei, i32Or, i32Oi, i32C, i32S, i32Zr, i32Zi;
+
+    ui32Half = psFFT->ui32Size / 2;
+    ui32Step = 2 * (FFT_MAX_SIZE / psFFT->ui32Size);
+    for(ui32K = 0; ui32K < psFFT->ui32Size; ui32K++)
+    {
+        pi32Data[ui32K] >>= 1;
+    }
+    FFTComplexQ31(pi32Data, ui32Half, psFFT->ui32RevShift, false);
+
+    i32Zr = pi32Data[0];
+    i32Zi = pi32Data[1];
+    pi32Data[0] = FFTSat32((int64_t)i32Zr + i32Zi);
+    pi32Data[1] = 0;
+    pi32Data[2 * ui32Half] = FFTSat32((int64_t)i32Zr - i32Zi);
+    pi32Data[(2 * ui32Half) + 1] = 0;
+
+    for(ui32K = 1; ui32K <= (ui32Half / 2); ui32K++)
+    {
+        ui32M = ui32Half - ui32K;
+        i32Er = (pi32Data[2 * ui32K] >> 1) + (pi32Data[2 * ui32M] >> 1);
+        i32Ei = (pi32Data[(2 * ui32K) + 1] >> 1) -
+                (pi32Data[(2 * ui32M) + 1] >> 1);
+        i32Or = (pi32Data[2 * ui32K] >> 1) - (pi32Data[2 * ui32M] >> 1);
+        i32Oi = (pi32Data[(2 * ui32K) + 1] >> 1) +
+                (pi32Data[(2 * ui32M) + 1] >> 1);
+        i32C = g_pi32FFTTwiddleQ31[ui32K * ui32Step];
+        i32S = -g_pi32FFTTwiddleQ31[(ui32K * ui32Step) + 1];
+
+        pi32Data[2 * ui32K] = FFTSat32(i32Er + FFT_MUL31(i32C, i32Oi) -
+                                       FFT_MUL31(i32S, i32Or));
+        pi32Data[(2 * ui32K) + 1] = FFTSat32(i32Ei - FFT_MUL31(i32S, i32Oi) -
+                                             FFT_MUL31(i32C, i32Or));
+        pi32Data[2 * ui32M] = FFTSat32(i32Er + FFT_MUL31(i32S, i32Or) -
+                                       FFT_MUL31(i32C, i32Oi));
+        pi32Data[(2 * ui32M) + 1] = FFTSat32(-(int64_t)i32Ei -
+                                             FFT_MUL31(i32S, i32Oi) -
+                                             FFT_MUL31(i32C, i32Or));
+    }
+}
+
+//*****************************************************************************
+//
+//! Computes the inverse transform of a Q31 half spectrum.
+//!
+//! \param psFFT is a pointer to an instance initialized with FFTRealInit().
+//! \param pi32Data points to bins 0 to N / 2 as produced by
+//! FFTRealForwardQ31(), N + 2 entries.
+//!
+//! This is the Q31 counterpart of FFTRealInverse().
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+FFTRealInverseQ31(tFFT *psFFT, int32_t *pi32Data)
+{
+    uint32_t ui32K, ui32M, ui32Half, ui32Step;
+    int32_t i32Er, i32Ei, i32Dr, i32Di, i32C, i32S, i32X0, i32XN;
+
+    ui32Half = psFFT->ui32Size / 2;
+    ui32Step = 2 * (FFT_MAX_SIZE / psFFT->ui32Size);
+
+    i32X0 = pi32Data[0];
+    i32XN = pi32Data[2 * ui32Half];
+    pi32Data[0] = FFTSat32((int64_t)i32X0 + i32XN);
+    pi32Data[1] = FFTSat32((int64_t)i32X0 - i32XN);
+
+    for(ui32K = 1; ui32K <= (ui32Half / 2); ui32K++)
+    {
+        ui32M = ui32Half - ui32K;
+        i32Er = FFTSat32((int64_t)pi32Data[2 * ui32K] + pi32Data[2 * ui32M]);
+        i32Ei = FFTSat32((int64_t)pi32Data[(2 * ui32K) + 1] -
+                         pi32Data[(2 * ui32M) + 1]);
+        i32Dr = FFTSat32((int64_t)pi32Data[2 * ui32K] - pi32Data[2 * ui32M]);
+        i32Di = FFTSat32((int64_t)pi32Data[(2 * ui32K) + 1] +
+                         pi32Data[(2 * ui32M) + 1]);
+        i32C = g_pi32FFTTwiddleQ31[ui32K * ui32Step];
+        i32S = -g_pi32FFTTwiddleQ31[(ui32K * ui32Step) + 1];
+
+        pi32Data[2 * ui32K] = FFTSat32(i32Er - FFT_MUL31(i32S, i32Dr) -
+                                       FFT_MUL31(i32C, i32Di));
+        pi32Data[(2 * ui32K) + 1] = FFTSat32(i32Ei + FFT_MUL31(i32C, i32Dr) -
+                                             FFT_MUL31(i32S, i32Di));
+        pi32Data[2 * ui32M] = FFTSat32(i32Er + FFT_MUL31(i32S, i32Dr) +
+                                       FFT_MUL31(i32C, i32Di));
+        pi32Data[(2 * ui32M) + 1] = FFTSat32(-(int64_t)i32Ei +
+                                             FFT_MUL31(i32C, i32Dr) -
+                                             FFT_MUL31(i32S, i32Di));
+    }
+
+    FFTComplexQ31(pi32Data, ui32Half, psFFT->ui32RevShift, true);
+}
+
+//*****************************************************************************
+//
+// The state of FFTBenchmark() between its steps.
+//
+//*****************************************************************************
+typedef struct
+{
+    tFFT sFFT;
+    bool bQ31;
+    void *pvScratch;
+}
+tFFTBenchmark;
+
+//*****************************************************************************
+//
+// Loads the test signal for one run of FFTBenchmark().
+//
+//*****************************************************************************
+static void
+FFTBenchmarkSetup(void *pvArg)
+{
+    tFFTBenchmark *psBench;
+    uint32_t ui32Idx, ui32Count;
+
+    psBench = (tFFTBenchmark *)pvArg;
+    ui32Count = 2 * psBench->sFFT.ui32Size;
+    if(psBench->bQ31)
+    {
+        for(ui32Idx = 0; ui32Idx < ui32Count; ui32Idx++)
+        {
+            ((int32_t *)psBench->pvScratch)[ui32Idx] =
+                (int32_t)PerfPatternGet(ui32Idx) * 65536;
+        }
+    }
+    else
+    {
+        PerfPatternFill16((int16_t *)psBench->pvScratch, ui32Count);
+    }
+}
+
+//*****************************************************************************
+//
+// Runs the transform timed by FFTBenchmark().
+//
+//*****************************************************************************
+static void
+FFTBenchmarkTransform(void *pvArg)
+{
+    tFFTBenchmark *psBench;
+
+    psBench = (tFFTBenchmark *)pvArg;
+    if(psBench->bQ31)
+    {
+        FFTForwardQ31(&psBench->sFFT, (int32_t *)psBench->pvScratch);
+    }
+    else
+    {
+        FFTForwardQ15(&psBench->sFFT, (int16_t *)psBench->pvScratch);
+    }
+}
+
+//*****************************************************************************
+//
+//! Measures the cost of one complex forward transform.
+//!
+//! \param ui32Size is the number of complex points, as for FFTInit().
+//! \param bQ31 selects FFTForwardQ31() if \b true or FFTForwardQ15() if
+//! \b false.
+//! \param pvScratch points to a buffer of 2 N entries of the sample type.
+//!
+//! The transform is timed with PerfBenchmarkRun() on the full-scale test
+//! signal.
+//!
+//! \return Returns the cost of one transform, or 0 if the size is not
+//! supported.
+//
+//*****************************************************************************
+uint32_t
+FFTBenchmark(uint32_t ui32Size, bool bQ31, void *pvScratch)
+{
+    tFFTBenchmark sBench;
+
+    if(!FFTInit(&sBench.sFFT, ui32Size))
+    {
+        return(0);
+    }
+    sBench.bQ31 = bQ31;
+    sBench.pvScratch = pvScratch;
+
+    return(PerfBenchmarkRun(FFTBenchmarkSetup, FFTBenchmarkTransform,
+                            &sBench));
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
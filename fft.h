@@ -0,0 +1,90 @@
+//*****************************************************************************
+//
+// fft.h - Prototypes for the fixed-point FFT library.
+//
+//*****************************************************************************
+
+#ifndef __FFT_H__
+#define __FFT_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The supported transform lengths, powers of two.  The twiddle and
+// bit-reversal tables in flash are sized for FFT_MAX_SIZE; every smaller size
+// reads them with a stride.
+//
+//*****************************************************************************
+#define FFT_MIN_SIZE            16
+#define FFT_MAX_SIZE            1024
+
+//*****************************************************************************
+//
+// Set to 1 to run the complex transforms from SRAM, or 0 to leave them in
+// flash.  The twiddle and bit-reversal tables stay in flash either way.  See
+// ramfunc.h.
+//
+//*****************************************************************************
+#ifndef FFT_KERNEL_IN_RAM
+#define FFT_KERNEL_IN_RAM       1
+#endif
+
+//*****************************************************************************
+//
+// An FFT instance of one size.  It holds no tables, so an instance costs only
+// a few words of RAM and initializing it computes nothing.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The transform length: the number of complex points for the complex
+    // transforms, or of real samples for the real transforms.
+    //
+    uint32_t ui32Size;
+
+    //
+    // The right shift that turns an entry of the bit-reversal table into the
+    // bit-reversed index for the complex transform length.
+    //
+    uint32_t ui32RevShift;
+}
+tFFT;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern bool FFTInit(tFFT *psFFT, uint32_t ui32Size);
+extern void FFTForwardQ15(tFFT *psFFT, int16_t *pi16Data);
+extern void FFTInverseQ15(tFFT *psFFT, int16_t *pi16Data);
+extern void FFTForwardQ31(tFFT *psFFT, int32_t *pi32Data);
+extern void FFTInverseQ31(tFFT *psFFT, int32_t *pi32Data);
+extern bool FFTRealInit(tFFT *psFFT, uint32_t ui32Size);
+extern void FFTRealForward(tFFT *psFFT, int16_t *pi16Data);
+extern void FFTRealInverse(tFFT *psFFT, int16_t *pi16Data);
+extern void FFTRealForwardQ31(tFFT *psFFT, int32_t *pi32Data);
+extern void FFTRealInverseQ31(tFFT *psFFT, int32_t *pi32Data);
+extern uint32_t FFTBenchmark(uint32_t ui32Size, bool bQ31, void *pvScratch);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __FFT_H__
@@ -0,0 +1,200 @@
+//*****************************************************************************
+//
+// goertzel.c - Goertzel tone detector bank.
+//
+// Measures the power of a handful of known tones (mains hum and its
+// harmonics, fan blade rates) far more cheaply than a full transform.  Each
+// tone is a second-order resonator
+//
+//     s(n) = x(n) + 2 cos(w) s(n - 1) - s(n - 2)
+//
+// costing one multiply-accumulate and one subtraction per sample, run in
+// single precision on the M4F FPU.  At the end of every block the tone power
+// is read from the last two resonator outputs and published; the resonators
+// then restart.
+//
+// Samples may be fed one at a time or in blocks of any length; a detector
+// block may span any number of calls.
+//
+//*****************************************************************************
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "goertzel.h"
+
+//*****************************************************************************
+//
+//! \addtogroup goertzel_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! Initializes a detector bank.
+//!
+//! \param psBank is a pointer to the bank state.
+//! \param pfFrequency points to the target frequencies in Hz.
+//! \param ui32NumTones is the number of target frequencies, at most
+//! \b GOERTZEL_MAX_TONES.
+//! \param ui32SampleRate is the rate of the samples fed to the bank.
+//! \param ui32BlockSize is the number of samples per measurement.  Tones
+//! closer than about \e ui32SampleRate / \e ui32BlockSize cannot be told
+//! apart.
+//!
+//! \return Returns \b true on success or \b false if the parameters are not
+//! supported.
+//
+//*****************************************************************************
+bool
+GoertzelInit(tGoertzelBank *psBank, const float *pfFrequency,
+             uint32_t ui32NumTones, uint32_t ui32SampleRate,
+             uint32_t ui32BlockSize)
+{
+    uint32_t ui32Tone;
+
+    if((ui32NumTones > GOERTZEL_MAX_TONES) || (ui32BlockSize == 0) ||
+       (ui32SampleRate == 0))
+    {
+        return(false);
+    }
+
+    psBank->ui32NumTones = ui32NumTones;
+    psBank->ui32BlockSize = ui32BlockSize;
+    psBank->ui32Count = 0;
+    psBank->sResult.ui32Sequence = 0;
+    psBank->sResult.ui32NumTones = ui32NumTones;
+
+    for(ui32Tone = 0; ui32Tone < ui32NumTones; ui32Tone++)
+    {
+        psBank->pfCoeff[ui32Tone] =
+            2.0f * (float)cos((2.0 * 3.14159265358979 *
+                               pfFrequency[ui32Tone]) / ui32SampleRate);
+        psBank->pfS1[ui32Tone] = 0.0f;
+        psBank->pfS2[ui32Tone] = 0.0f;
+        psBank->sResult.pfPower[ui32Tone] = 0.0f;
+    }
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Feeds samples to a detector bank.
+//!
+//! \param psBank is a pointer to the bank state.
+//! \param pi32In points to the samples, full scale at 32 bits.
+//! \param ui32Count is the number of samples.
+//!
+//! Whenever a block completes, its tone powers replace the previous result.
+//! This is meant to be called from the audio interrupt.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GoertzelProcess(tGoertzelBank *psBank, const int32_t *pi32In,
+                uint32_t ui32Count)
+{
+    uint32_t ui32Run, ui32Idx, ui32Tone;
+    float fX, fS0, fS1, fS2, fCoeff, fScale;
+
+    while(ui32Count)
+    {
+        //
+        // Run up to the end of the current block.
+        //
+        ui32Run = psBank->ui32BlockSize - psBank->ui32Count;
+        if(ui32Run > ui32Count)
+        {
+            ui32Run = ui32Count;
+        }
+
+        for(ui32Tone = 0; ui32Tone < psBank->ui32NumTones; ui32Tone++)
+        {
+            fCoeff = psBank->pfCoeff[ui32Tone];
+            fS1 = psBank->pfS1[ui32Tone];
+            fS2 = psBank->pfS2[ui32Tone];
+            for(ui32Idx = 0; ui32Idx < ui32Run; ui32Idx++)
+            {
+                fX = (float)pi32In[ui32Idx];
+                fS0 = fX + (fCoeff * fS1) - fS2;
+                fS2 = fS1;
+                fS1 = fS0;
+            }
+            psBank->pfS1[ui32Tone] = fS1;
+            psBank->pfS2[ui32Tone] = fS2;
+        }
+
+        pi32In += ui32Run;
+        ui32Count -= ui32Run;
+        psBank->ui32Count += ui32Run;
+        if(psBank->ui32Count < psBank->ui32BlockSize)
+        {
+            break;
+        }
+
+        //
+        // The block is complete.  |X|^2 = s1^2 + s2^2 - 2 cos(w) s1 s2, and a
+        // sine of amplitude A gives |X| = A N / 2, so 2 / N^2 turns it into
+        // the mean square of the tone.  The samples were fed unscaled, so
+        // 2^-62 takes the result to full scale.
+        //
+        fScale = (2.0f / 4611686018427387904.0f) /
+                 ((float)psBank->ui32BlockSize *
+                  (float)psBank->ui32BlockSize);
+        for(ui32Tone = 0; ui32Tone < psBank->ui32NumTones; ui32Tone++)
+        {
+            fS1 = psBank->pfS1[ui32Tone];
+            fS2 = psBank->pfS2[ui32Tone];
+            psBank->sResult.pfPower[ui32Tone] =
+                ((fS1 * fS1) + (fS2 * fS2) -
+                 (psBank->pfCoeff[ui32Tone] * fS1 * fS2)) * fScale;
+            psBank->pfS1[ui32Tone] = 0.0f;
+            psBank->pfS2[ui32Tone] = 0.0f;
+        }
+        psBank->sResult.ui32Sequence++;
+        psBank->ui32Count = 0;
+    }
+}
+
+//*****************************************************************************
+//
+//! Reads the tone powers of the last completed block.
+//!
+//! \param psBank is a pointer to the bank state.
+//! \param psSnapshot is a pointer to the structure that receives the result.
+//!
+//! This may be called from the main loop while the audio interrupt feeds the
+//! bank.  The copy is retried if a block completes during it, so the powers
+//! returned always belong to a single block.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+GoertzelSnapshotGet(tGoertzelBank *psBank, tGoertzelSnapshot *psSnapshot)
+{
+    volatile tGoertzelSnapshot *psResult;
+    uint32_t ui32Tone;
+
+    psResult = &psBank->sResult;
+    do
+    {
+        psSnapshot->ui32Sequence = psResult->ui32Sequence;
+        psSnapshot->ui32NumTones = psResult->ui32NumTones;
+        for(ui32Tone = 0; ui32Tone < psSnapshot->ui32NumTones; ui32Tone++)
+        {
+            psSnapshot->pfPower[ui32Tone] = psResult->pfPower[ui32Tone];
+        }
+    }
+    while(psSnapshot->ui32Sequence != psResult->ui32Sequence);
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
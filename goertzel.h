@@ -0,0 +1,109 @@
+//*****************************************************************************
+//
+// goertzel.h - Prototypes for the Goertzel tone detector bank.
+//
+//*****************************************************************************
+
+#ifndef __GOERTZEL_H__
+#define __GOERTZEL_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The largest number of tones one bank can watch.
+//
+//*****************************************************************************
+#define GOERTZEL_MAX_TONES      8
+
+//*****************************************************************************
+//
+// The tone powers of the last completed block.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The number of blocks completed so far.  It changes whenever the powers
+    // are replaced, so a reader can tell a new result from an old one.
+    //
+    uint32_t ui32Sequence;
+
+    //
+    // The number of valid entries in pfPower.
+    //
+    uint32_t ui32NumTones;
+
+    //
+    // The mean square of each tone over the block: a sine of amplitude A at
+    // the target frequency reads A^2 / 2, relative to full scale.
+    //
+    float pfPower[GOERTZEL_MAX_TONES];
+}
+tGoertzelSnapshot;
+
+//*****************************************************************************
+//
+// The state of one detector bank.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The number of tones and the block length in samples.
+    //
+    uint32_t ui32NumTones;
+    uint32_t ui32BlockSize;
+
+    //
+    // The samples accumulated so far in the current block.
+    //
+    uint32_t ui32Count;
+
+    //
+    // 2 cos(2 pi f / fs) for each tone, and the two most recent outputs of
+    // each tone's resonator.
+    //
+    float pfCoeff[GOERTZEL_MAX_TONES];
+    float pfS1[GOERTZEL_MAX_TONES];
+    float pfS2[GOERTZEL_MAX_TONES];
+
+    //
+    // The result of the last completed block.
+    //
+    tGoertzelSnapshot sResult;
+}
+tGoertzelBank;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern bool GoertzelInit(tGoertzelBank *psBank, const float *pfFrequency,
+                         uint32_t ui32NumTones, uint32_t ui32SampleRate,
+                         uint32_t ui32BlockSize);
+extern void GoertzelProcess(tGoertzelBank *psBank, const int32_t *pi32In,
+                            uint32_t ui32Count);
+extern void GoertzelSnapshotGet(tGoertzelBank *psBank,
+                                tGoertzelSnapshot *psSnapshot);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GOERTZEL_H__
@@ -0,0 +1,207 @@
+//*****************************************************************************
+//
+// block_file.c - Host file-backed block device.
+//
+// The player and the recorder reach their card through block read and write
+// functions that the application provides (see wav_play.h and wav_rec.h).
+// This provides them for a file on the host, so that both run unchanged
+// against a disk image, or against a WAV file taken as the image of a card
+// that holds it from block 0.  A read past the end of the file returns
+// zeros, as the unused tail of a file's last cluster would.
+//
+// These use POSIX file I/O and build only for the host.
+//
+//*****************************************************************************
+
+#define _FILE_OFFSET_BITS       64
+#define _POSIX_C_SOURCE         200809L
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "wav_riff.h"
+#include "block_file.h"
+
+//*****************************************************************************
+//
+//! \addtogroup block_file_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! Opens a file as a block device.
+//!
+//! \param psDev is a pointer to the device state.
+//! \param pcPath is the path of the file.
+//!
+//! The device covers the file, its last block padded.  It may be read and
+//! written.
+//!
+//! \return Returns \b true on success or \b false if the file cannot be
+//! opened.
+//
+//*****************************************************************************
+bool
+BlockFileOpen(tBlockFile *psDev, const char *pcPath)
+{
+    struct stat sStat;
+
+    psDev->iFD = open(pcPath, O_RDWR);
+    if(psDev->iFD < 0)
+    {
+        psDev->iFD = open(pcPath, O_RDONLY);
+    }
+    if((psDev->iFD < 0) || (fstat(psDev->iFD, &sStat) != 0))
+    {
+        return(false);
+    }
+
+    psDev->ui32NumBlocks = (uint32_t)((sStat.st_size + WAV_BLOCK_SIZE - 1) /
+                                      WAV_BLOCK_SIZE);
+    psDev->ui32Calls = 0;
+    psDev->ui32Blocks = 0;
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Creates a file as a block device.
+//!
+//! \param psDev is a pointer to the device state.
+//! \param pcPath is the path of the file, which is replaced if it exists.
+//! \param ui32NumBlocks is the size of the device in blocks.
+//!
+//! The file is made the full size of the device at once, as a card's blocks
+//! are allocated to a recording before it starts.
+//!
+//! \return Returns \b true on success or \b false if the file cannot be
+//! created.
+//
+//*****************************************************************************
+bool
+BlockFileCreate(tBlockFile *psDev, const char *pcPath, uint32_t ui32NumBlocks)
+{
+    psDev->iFD = open(pcPath, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(psDev->iFD < 0)
+    {
+        return(false);
+    }
+    if(ftruncate(psDev->iFD, (off_t)ui32NumBlocks * WAV_BLOCK_SIZE) != 0)
+    {
+        close(psDev->iFD);
+        return(false);
+    }
+
+    psDev->ui32NumBlocks = ui32NumBlocks;
+    psDev->ui32Calls = 0;
+    psDev->ui32Blocks = 0;
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Reads blocks; a tWavBlockRead for the player.
+//!
+//! \param pvDevice is a pointer to the device state.
+//! \param ui32Block is the first block to read.
+//! \param pui8Data points to the buffer that receives the blocks.
+//! \param ui32Count is the number of blocks.
+//!
+//! The player reads whole bursts, so the last of a file may run past the
+//! end of the device; those blocks read as zeros.
+//!
+//! \return Returns \b true on success or \b false if the file could not be
+//! read.
+//
+//*****************************************************************************
+bool
+BlockFileRead(void *pvDevice, uint32_t ui32Block, uint8_t *pui8Data,
+              uint32_t ui32Count)
+{
+    tBlockFile *psDev;
+    size_t sSize;
+    ssize_t iCount;
+
+    psDev = pvDevice;
+    sSize = (size_t)ui32Count * WAV_BLOCK_SIZE;
+    iCount = pread(psDev->iFD, pui8Data, sSize,
+                   (off_t)ui32Block * WAV_BLOCK_SIZE);
+    if(iCount < 0)
+    {
+        return(false);
+    }
+    memset(pui8Data + iCount, 0, sSize - (size_t)iCount);
+    psDev->ui32Calls++;
+    psDev->ui32Blocks += ui32Count;
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Writes blocks; a tWavBlockWrite for the recorder.
+//!
+//! \param pvDevice is a pointer to the device state.
+//! \param ui32Block is the first block to write.
+//! \param pui8Data points to the blocks.
+//! \param ui32Count is the number of blocks.
+//!
+//! \return Returns \b true on success or \b false if the blocks are not all
+//! in the device or the file could not be written.
+//
+//*****************************************************************************
+bool
+BlockFileWrite(void *pvDevice, uint32_t ui32Block, const uint8_t *pui8Data,
+               uint32_t ui32Count)
+{
+    tBlockFile *psDev;
+    size_t sSize;
+
+    psDev = pvDevice;
+    if((ui32Block > psDev->ui32NumBlocks) ||
+       (ui32Count > (psDev->ui32NumBlocks - ui32Block)))
+    {
+        return(false);
+    }
+
+    sSize = (size_t)ui32Count * WAV_BLOCK_SIZE;
+    if(pwrite(psDev->iFD, pui8Data, sSize,
+              (off_t)ui32Block * WAV_BLOCK_SIZE) != (ssize_t)sSize)
+    {
+        return(false);
+    }
+    psDev->ui32Calls++;
+    psDev->ui32Blocks += ui32Count;
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Closes a device.
+//!
+//! \param psDev is a pointer to the device state.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+BlockFileClose(tBlockFile *psDev)
+{
+    close(psDev->iFD);
+    psDev->iFD = -1;
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
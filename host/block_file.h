@@ -0,0 +1,66 @@
+//*****************************************************************************
+//
+// block_file.h - Prototypes for the host file-backed block device.
+//
+//*****************************************************************************
+
+#ifndef __BLOCK_FILE_H__
+#define __BLOCK_FILE_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// A block device held in a file, in WAV_BLOCK_SIZE blocks.
+//
+//*****************************************************************************
+typedef struct
+{
+    int iFD;
+
+    //
+    // The number of blocks in the device.
+    //
+    uint32_t ui32NumBlocks;
+
+    //
+    // The number of device calls and of blocks moved by them.
+    //
+    uint32_t ui32Calls;
+    uint32_t ui32Blocks;
+}
+tBlockFile;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern bool BlockFileOpen(tBlockFile *psDev, const char *pcPath);
+extern bool BlockFileCreate(tBlockFile *psDev, const char *pcPath,
+                            uint32_t ui32NumBlocks);
+extern bool BlockFileRead(void *pvDevice, uint32_t ui32Block,
+                          uint8_t *pui8Data, uint32_t ui32Count);
+extern bool BlockFileWrite(void *pvDevice, uint32_t ui32Block,
+                           const uint8_t *pui8Data, uint32_t ui32Count);
+extern void BlockFileClose(tBlockFile *psDev);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __BLOCK_FILE_H__
@@ -0,0 +1,409 @@
+//*****************************************************************************
+//
+// fftcheck.c - Host check of the fixed-point FFT library against a DFT.
+//
+// Every transform in fft.c, at every supported length, is run on random
+// full-scale blocks and compared with a direct DFT computed in double
+// precision.  The DFT is scaled as the transform is, X(k) / N for the
+// forward transforms and unscaled for the inverse ones, and rounded to the
+// nearest step of the output format; the fixed-point result is compared
+// with it bin by bin.  For each transform the share of bins that match the
+// rounded DFT exactly is printed with the largest and the RMS difference,
+// in steps of the output format.  The check fails if any difference
+// exceeds the bound for the transform, which allows for the rounding of
+// each stage: the forward transforms scale at every stage, so their errors
+// grow only with the number of stages; the inverse transforms do not, so
+// theirs grow with the square root of the length.
+//
+// The real forward transforms are fed full-scale samples and the complex
+// ones samples anywhere in the unit circle, the range they are documented
+// for.  The inverse transforms are fed bins small enough that the samples
+// they return stay in range, as the bins of a forward transform are.
+//
+// The cost of each complex forward transform is also printed, from
+// FFTBenchmark(), in nanoseconds.
+//
+// Build from this directory with, on one line:
+//
+//     cc -O2 -I.. -o fftcheck fftcheck.c ../fft.c ../perf.c -lm
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "fft.h"
+
+//*****************************************************************************
+//
+// The number of random blocks per transform and length.
+//
+//*****************************************************************************
+#define FFTCHECK_BLOCKS         64
+
+//*****************************************************************************
+//
+// The transforms checked.
+//
+//*****************************************************************************
+#define FFTCHECK_FORWARD_Q15    0
+#define FFTCHECK_INVERSE_Q15    1
+#define FFTCHECK_FORWARD_Q31    2
+#define FFTCHECK_INVERSE_Q31    3
+#define FFTCHECK_REAL_Q15       4
+#define FFTCHECK_REAL_INV_Q15   5
+#define FFTCHECK_REAL_Q31       6
+#define FFTCHECK_REAL_INV_Q31   7
+#define FFTCHECK_NUM            8
+
+static const char *g_ppcFFTCheckNames[FFTCHECK_NUM] =
+{
+    "FFTForwardQ15", "FFTInverseQ15", "FFTForwardQ31", "FFTInverseQ31",
+    "FFTRealForward", "FFTRealInverse", "FFTRealForwardQ31",
+    "FFTRealInverseQ31"
+};
+
+//*****************************************************************************
+//
+// The largest difference from the rounded DFT allowed for each transform at
+// length ui32N, in steps of the output format.  Each stage of a forward
+// transform rounds, and later stages scale its error down, so the error
+// grows only with the number of stages: the Q15 ones truncate each sum
+// once, and the Q31 ones truncate each input before the sum.  The inverse
+// transforms do not scale, so the rounding of each stage is carried through
+// the rest at full size and the error grows with the square root of the
+// length.
+//
+//*****************************************************************************
+static double
+FFTCheckBound(uint32_t ui32Check, uint32_t ui32N)
+{
+    double dStages;
+
+    dStages = log2((double)ui32N);
+    switch(ui32Check)
+    {
+        case FFTCHECK_FORWARD_Q15:
+        case FFTCHECK_REAL_Q15:
+        {
+            return(2.0 + (dStages / 2.0));
+        }
+        case FFTCHECK_FORWARD_Q31:
+        case FFTCHECK_REAL_Q31:
+        {
+            return(2.0 * dStages);
+        }
+        default:
+        {
+            return(3.0 * sqrt((double)ui32N));
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// The results of one transform at one length.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t ui32Values;
+    uint32_t ui32Exact;
+    double dMax;
+    double dSumSq;
+}
+tFFTCheckStats;
+
+//*****************************************************************************
+//
+// Returns a random integer uniform over the range of a signed field of
+// ui32Bits bits, shifted down by ui32Shift.
+//
+//*****************************************************************************
+static int32_t
+FFTCheckRandom(uint32_t ui32Bits, uint32_t ui32Shift)
+{
+    uint32_t ui32Value;
+
+    ui32Value = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+    ui32Value ^= (uint32_t)rand() << 31;
+    return(((int32_t)ui32Value >> (32 - ui32Bits)) >> ui32Shift);
+}
+
+//*****************************************************************************
+//
+// Computes the DFT of ui32N complex points in pdIn, interleaved real and
+// imaginary, into pdOut: exp(-j...) if bInverse is false, exp(+j...)
+// otherwise, multiplied by dScale.
+//
+//*****************************************************************************
+static void
+FFTCheckDFT(const double *pdIn, double *pdOut, uint32_t ui32N, bool bInverse,
+            double dScale)
+{
+    static double pdCos[FFT_MAX_SIZE], pdSin[FFT_MAX_SIZE];
+    uint32_t ui32K, ui32Idx, ui32Phase;
+    double dRe, dIm, dSign;
+
+    dSign = bInverse ? 1.0 : -1.0;
+    for(ui32Idx = 0; ui32Idx < ui32N; ui32Idx++)
+    {
+        pdCos[ui32Idx] = cos((2.0 * M_PI * ui32Idx) / ui32N);
+        pdSin[ui32Idx] = dSign * sin((2.0 * M_PI * ui32Idx) / ui32N);
+    }
+
+    for(ui32K = 0; ui32K < ui32N; ui32K++)
+    {
+        dRe = 0.0;
+        dIm = 0.0;
+        for(ui32Idx = 0; ui32Idx < ui32N; ui32Idx++)
+        {
+            ui32Phase = (ui32K * ui32Idx) % ui32N;
+            dRe += ((pdIn[2 * ui32Idx] * pdCos[ui32Phase]) -
+                    (pdIn[(2 * ui32Idx) + 1] * pdSin[ui32Phase]));
+            dIm += ((pdIn[2 * ui32Idx] * pdSin[ui32Phase]) +
+                    (pdIn[(2 * ui32Idx) + 1] * pdCos[ui32Phase]));
+        }
+        pdOut[2 * ui32K] = dRe * dScale;
+        pdOut[(2 * ui32K) + 1] = dIm * dScale;
+    }
+}
+
+//*****************************************************************************
+//
+// Compares ui32Count results with the reference, rounded to whole steps.
+//
+//*****************************************************************************
+static void
+FFTCheckCompare(tFFTCheckStats *psStats, const int32_t *pi32Out,
+                const double *pdRef, uint32_t ui32Count)
+{
+    uint32_t ui32Idx;
+    double dDiff;
+
+    for(ui32Idx = 0; ui32Idx < ui32Count; ui32Idx++)
+    {
+        dDiff = fabs((double)pi32Out[ui32Idx] - floor(pdRef[ui32Idx] + 0.5));
+        psStats->ui32Values++;
+        if(dDiff == 0.0)
+        {
+            psStats->ui32Exact++;
+        }
+        if(dDiff > psStats->dMax)
+        {
+            psStats->dMax = dDiff;
+        }
+        psStats->dSumSq += dDiff * dDiff;
+    }
+}
+
+//*****************************************************************************
+//
+// Runs one block through one transform at length ui32N and compares it.
+//
+//*****************************************************************************
+static bool
+FFTCheckBlock(uint32_t ui32Check, uint32_t ui32N, tFFTCheckStats *psStats)
+{
+    static int16_t pi16Data[2 * FFT_MAX_SIZE + 2];
+    static int32_t pi32Data[2 * FFT_MAX_SIZE + 2];
+    static int32_t pi32Out[2 * FFT_MAX_SIZE + 2];
+    static double pdIn[2 * FFT_MAX_SIZE], pdRef[2 * FFT_MAX_SIZE];
+    tFFT sFFT;
+    uint32_t ui32Idx, ui32Bits, ui32Shift, ui32Half, ui32Log2;
+    bool bQ31, bReal, bInverse;
+
+    bQ31 = ((ui32Check == FFTCHECK_FORWARD_Q31) ||
+            (ui32Check == FFTCHECK_INVERSE_Q31) ||
+            (ui32Check == FFTCHECK_REAL_Q31) ||
+            (ui32Check == FFTCHECK_REAL_INV_Q31));
+    bReal = (ui32Check >= FFTCHECK_REAL_Q15);
+    bInverse = ((ui32Check == FFTCHECK_INVERSE_Q15) ||
+                (ui32Check == FFTCHECK_INVERSE_Q31) ||
+                (ui32Check == FFTCHECK_REAL_INV_Q15) ||
+                (ui32Check == FFTCHECK_REAL_INV_Q31));
+    ui32Bits = bQ31 ? 32 : 16;
+    for(ui32Log2 = 0; (1u << ui32Log2) < ui32N; ui32Log2++)
+    {
+    }
+
+    if(!(bReal ? FFTRealInit(&sFFT, ui32N) : FFTInit(&sFFT, ui32N)))
+    {
+        return(false);
+    }
+
+    //
+    // Make the input.  The real forward transforms take full-scale samples
+    // and the complex ones samples anywhere in the unit circle.  The inverse
+    // transforms take bins a factor of N down, so the samples stay in range;
+    // the real inverse takes the half spectrum of a real block, bins 0 and
+    // N / 2 real.
+    //
+    ui32Shift = bInverse ? ui32Log2 : 0;
+    for(ui32Idx = 0; ui32Idx < (2 * ui32N); ui32Idx++)
+    {
+        pdIn[ui32Idx] = 0.0;
+    }
+    ui32Half = bReal ? ((ui32N / 2) + 1) : ui32N;
+    for(ui32Idx = 0; ui32Idx < (bReal && !bInverse ? ui32N : 2 * ui32Half);
+        ui32Idx++)
+    {
+        pi32Data[ui32Idx] = FFTCheckRandom(ui32Bits, ui32Shift);
+        while(!bReal && !bInverse && (ui32Idx & 1) &&
+              ((((double)pi32Data[ui32Idx - 1] * pi32Data[ui32Idx - 1]) +
+                ((double)pi32Data[ui32Idx] * pi32Data[ui32Idx])) >
+               ldexp(1.0, 2 * (ui32Bits - 1))))
+        {
+            pi32Data[ui32Idx - 1] = FFTCheckRandom(ui32Bits, 0);
+            pi32Data[ui32Idx] = FFTCheckRandom(ui32Bits, 0);
+        }
+    }
+    if(bReal && bInverse)
+    {
+        pi32Data[1] = 0;
+        pi32Data[ui32N + 1] = 0;
+    }
+
+    //
+    // Form the reference input as N complex points.
+    //
+    if(bReal && !bInverse)
+    {
+        for(ui32Idx = 0; ui32Idx < ui32N; ui32Idx++)
+        {
+            pdIn[2 * ui32Idx] = pi32Data[ui32Idx];
+        }
+    }
+    else if(bReal)
+    {
+        for(ui32Idx = 0; ui32Idx < ui32Half; ui32Idx++)
+        {
+            pdIn[2 * ui32Idx] = pi32Data[2 * ui32Idx];
+            pdIn[(2 * ui32Idx) + 1] = pi32Data[(2 * ui32Idx) + 1];
+            pdIn[2 * ((ui32N - ui32Idx) % ui32N)] = pi32Data[2 * ui32Idx];
+            pdIn[(2 * ((ui32N - ui32Idx) % ui32N)) + 1] =
+                -pi32Data[(2 * ui32Idx) + 1];
+        }
+    }
+    else
+    {
+        for(ui32Idx = 0; ui32Idx < (2 * ui32N); ui32Idx++)
+        {
+            pdIn[ui32Idx] = pi32Data[ui32Idx];
+        }
+    }
+    FFTCheckDFT(pdIn, pdRef, ui32N, bInverse,
+                bInverse ? 1.0 : (1.0 / ui32N));
+
+    //
+    // Run the transform in the sample type.
+    //
+    if(!bQ31)
+    {
+        for(ui32Idx = 0; ui32Idx < (2 * ui32N) + 2; ui32Idx++)
+        {
+            pi16Data[ui32Idx] = (int16_t)pi32Data[ui32Idx];
+        }
+    }
+    switch(ui32Check)
+    {
+        case FFTCHECK_FORWARD_Q15: FFTForwardQ15(&sFFT, pi16Data); break;
+        case FFTCHECK_INVERSE_Q15: FFTInverseQ15(&sFFT, pi16Data); break;
+        case FFTCHECK_FORWARD_Q31: FFTForwardQ31(&sFFT, pi32Data); break;
+        case FFTCHECK_INVERSE_Q31: FFTInverseQ31(&sFFT, pi32Data); break;
+        case FFTCHECK_REAL_Q15: FFTRealForward(&sFFT, pi16Data); break;
+        case FFTCHECK_REAL_INV_Q15: FFTRealInverse(&sFFT, pi16Data); break;
+        case FFTCHECK_REAL_Q31: FFTRealForwardQ31(&sFFT, pi32Data); break;
+        default: FFTRealInverseQ31(&sFFT, pi32Data); break;
+    }
+    for(ui32Idx = 0; ui32Idx < (2 * ui32N) + 2; ui32Idx++)
+    {
+        pi32Out[ui32Idx] = bQ31 ? pi32Data[ui32Idx] : pi16Data[ui32Idx];
+    }
+
+    //
+    // The real forward transform returns bins 0 to N / 2 and the real
+    // inverse returns N real samples; the reference holds the real samples
+    // in its real parts.
+    //
+    if(bReal && bInverse)
+    {
+        for(ui32Idx = 0; ui32Idx < ui32N; ui32Idx++)
+        {
+            pdRef[ui32Idx] = pdRef[2 * ui32Idx];
+        }
+        FFTCheckCompare(psStats, pi32Out, pdRef, ui32N);
+    }
+    else
+    {
+        FFTCheckCompare(psStats, pi32Out, pdRef,
+                        bReal ? (ui32N + 2) : (2 * ui32N));
+    }
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Checks every transform at every length and prints the results.
+//
+//*****************************************************************************
+int
+main(void)
+{
+    static int32_t pi32Scratch[2 * FFT_MAX_SIZE];
+    tFFTCheckStats sStats;
+    uint32_t ui32Check, ui32N, ui32Block, ui32Bad;
+    double dBound;
+
+    srand(1);
+    ui32Bad = 0;
+    for(ui32Check = 0; ui32Check < FFTCHECK_NUM; ui32Check++)
+    {
+        for(ui32N = FFT_MIN_SIZE; ui32N <= FFT_MAX_SIZE; ui32N *= 2)
+        {
+            sStats.ui32Values = 0;
+            sStats.ui32Exact = 0;
+            sStats.dMax = 0.0;
+            sStats.dSumSq = 0.0;
+            for(ui32Block = 0; ui32Block < FFTCHECK_BLOCKS; ui32Block++)
+            {
+                if(!FFTCheckBlock(ui32Check, ui32N, &sStats))
+                {
+                    printf("%-18s %5u: not supported\n",
+                           g_ppcFFTCheckNames[ui32Check], ui32N);
+                    ui32Bad++;
+                    break;
+                }
+            }
+
+            dBound = FFTCheckBound(ui32Check, ui32N);
+            printf("%-18s %5u: %5.1f%% exact, max %6.0f, rms %7.2f, "
+                   "bound %4.0f%s\n", g_ppcFFTCheckNames[ui32Check], ui32N,
+                   (100.0 * sStats.ui32Exact) / sStats.ui32Values,
+                   sStats.dMax, sqrt(sStats.dSumSq / sStats.ui32Values),
+                   dBound, (sStats.dMax > dBound) ? "  FAIL" : "");
+            if(sStats.dMax > dBound)
+            {
+                ui32Bad++;
+            }
+        }
+    }
+
+    for(ui32N = FFT_MIN_SIZE; ui32N <= FFT_MAX_SIZE; ui32N *= 4)
+    {
+        printf("complex %5u: Q15 %6u ns, Q31 %6u ns\n", ui32N,
+               FFTBenchmark(ui32N, false, pi32Scratch),
+               FFTBenchmark(ui32N, true, pi32Scratch));
+    }
+
+    if(ui32Bad != 0)
+    {
+        printf("FAIL\n");
+        return(1);
+    }
+    printf("PASS\n");
+    return(0);
+}
@@ -0,0 +1,843 @@
+//*****************************************************************************
+//
+// i2cmodel.c - Host run of the codec control driver against an I2C and timer
+// model.
+//
+// wm8731.c is built unchanged against software versions of the driverlib
+// functions it calls.  The I2C master model takes 2.5 us a bit, as at
+// 400 kHz: a burst start sends the start condition, the address and the
+// first byte, a burst finish sends the second byte and the stop, and each
+// raises the master interrupt when it is done.  An error stop sends a stop
+// alone and is taken to raise no interrupt.  I2CMasterBusy() lets model time
+// pass while it is polled, as the bus carries on while the driver spins on
+// it.  Timer 1A counts down at the system clock and a new load takes effect
+// at once, as it does with the TnILD bit clear.  The codec at the far end
+// decodes each write into a register file that starts out unknown and takes
+// the datasheet defaults on a reset.
+//
+// The run checks that writes reach the codec in the order they were made,
+// that queued waits hold the queue for their time, across a clock change
+// too, that writes of the value a register already holds are dropped once
+// the codec has been reset and never before, that a write overtaken in the
+// queue is replaced, that reads never touch the bus, that a full queue
+// refuses writes without losing the ones it holds, and that a write the
+// codec does not acknowledge is counted and sent again on the next write to
+// its register.  At the end the codec must hold what WM8731Read() says.
+//
+// Build from this directory with, on one line:
+//
+//     cc -O2 -I. -I.. -DPART_TM4C123GH6PM -o i2cmodel i2cmodel.c
+//        ../wm8731.c
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/gpio.h"
+#include "driverlib/i2c.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#include "clock.h"
+#include "wm8731.h"
+
+//*****************************************************************************
+//
+// The driver's interrupt handlers, which the vector table names on the board.
+//
+//*****************************************************************************
+extern void I2C0_Handler(void);
+extern void TIMER1A_Handler(void);
+
+//*****************************************************************************
+//
+// The model's time step and I2C bit time in nanoseconds, the most writes it
+// logs, the longest it runs a queue for before giving up, and the slack
+// allowed on a wait, a step either side.
+//
+//*****************************************************************************
+#define MODEL_STEP_NS           500
+#define MODEL_BIT_NS            2500
+#define MODEL_MAX_WRITES        256
+#define MODEL_TIMEOUT_NS        2000000000ULL
+#define MODEL_WAIT_SLACK_NS     (2 * MODEL_STEP_NS)
+
+//*****************************************************************************
+//
+// The number of codec registers with a value, and the value a register holds
+// until the codec has been reset.
+//
+//*****************************************************************************
+#define MODEL_NUM_REGS          10
+#define MODEL_UNKNOWN           0xffff
+
+//*****************************************************************************
+//
+// A write as the codec received it: the register, the value, and when the
+// transaction started and ended.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t ui32Reg;
+    uint32_t ui32Value;
+    uint64_t ui64Start;
+    uint64_t ui64End;
+}
+tModelWrite;
+
+//*****************************************************************************
+//
+// The time, the system clock, and the interrupt controller: whether
+// interrupts are masked, and whether each source is enabled and pending.
+//
+//*****************************************************************************
+static uint64_t g_ui64ModelNow;
+static uint32_t g_ui32ModelClock;
+static bool g_bModelIntsOff;
+static bool g_bModelI2CIntOn;
+static bool g_bModelI2CPending;
+static bool g_bModelTimerIntOn;
+static bool g_bModelTimerPending;
+static tClockHook g_pfnModelClockHook;
+
+
+//*****************************************************************************
+//
+// The I2C master: whether its interrupt is enabled, its address and data
+// registers, the command on the bus and the time it has left, whether the
+// bus is held between the two halves of a write, the first byte of the
+// write, when it started, the command's error, and the error to inject in
+// the next command that can fail.
+//
+//*****************************************************************************
+static bool g_bModelI2CMasterInt;
+static uint8_t g_ui8ModelAddr;
+static uint8_t g_ui8ModelData;
+static uint32_t g_ui32ModelCmd;
+static uint32_t g_ui32ModelBusyNs;
+static bool g_bModelHeld;
+static uint8_t g_ui8ModelFirst;
+static uint64_t g_ui64ModelStart;
+static uint32_t g_ui32ModelErr;
+static uint32_t g_ui32ModelNack;
+
+//*****************************************************************************
+//
+// Timer 1A: its count and whether it is running.
+//
+//*****************************************************************************
+static uint32_t g_ui32ModelTimer;
+static bool g_bModelTimerOn;
+
+//*****************************************************************************
+//
+// The codec: its registers, and the writes it received.
+//
+//*****************************************************************************
+static uint32_t g_pui32ModelCodec[MODEL_NUM_REGS];
+static tModelWrite g_psModelWrites[MODEL_MAX_WRITES];
+static uint32_t g_ui32ModelWrites;
+
+//*****************************************************************************
+//
+// The checks: the driver's misuse of the model, its bus reads, and the
+// number of checks that failed.
+//
+//*****************************************************************************
+static uint32_t g_ui32ModelMisuse;
+static uint32_t g_ui32ModelReads;
+static uint32_t g_ui32ModelFailures;
+
+//*****************************************************************************
+//
+// The codec's register contents after a reset, from the datasheet.
+//
+//*****************************************************************************
+static const uint32_t g_pui32ModelDefaults[MODEL_NUM_REGS] =
+{
+    0x097, 0x097, 0x079, 0x079, 0x00a, 0x008, 0x09f, 0x00a, 0x000, 0x000
+};
+
+//*****************************************************************************
+//
+// The system control, GPIO, interrupt controller and clock functions.
+//
+//*****************************************************************************
+void
+SysCtlPeripheralEnable(uint32_t ui32Peripheral)
+{
+}
+
+bool
+SysCtlPeripheralReady(uint32_t ui32Peripheral)
+{
+    return(true);
+}
+
+uint32_t
+SysCtlClockGet(void)
+{
+    return(g_ui32ModelClock);
+}
+
+void
+GPIOPinConfigure(uint32_t ui32PinConfig)
+{
+}
+
+void
+GPIOPinTypeI2C(uint32_t ui32Port, uint8_t ui8Pins)
+{
+}
+
+void
+GPIOPinTypeI2CSCL(uint32_t ui32Port, uint8_t ui8Pins)
+{
+}
+
+void
+IntEnable(uint32_t ui32Interrupt)
+{
+    if(ui32Interrupt == INT_I2C0)
+    {
+        g_bModelI2CIntOn = true;
+    }
+    else if(ui32Interrupt == INT_TIMER1A)
+    {
+        g_bModelTimerIntOn = true;
+    }
+}
+
+bool
+IntMasterDisable(void)
+{
+    bool bWasOff;
+
+    bWasOff = g_bModelIntsOff;
+    g_bModelIntsOff = true;
+    return(bWasOff);
+}
+
+bool
+IntMasterEnable(void)
+{
+    bool bWasOff;
+
+    bWasOff = g_bModelIntsOff;
+    g_bModelIntsOff = false;
+    return(bWasOff);
+}
+
+bool
+ClockHookRegister(tClockHook pfnHook)
+{
+    g_pfnModelClockHook = pfnHook;
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Timer 1A's functions.  Only the one-shot timeout is used.
+//
+//*****************************************************************************
+void
+TimerConfigure(uint32_t ui32Base, uint32_t ui32Config)
+{
+    if(ui32Config != TIMER_CFG_ONE_SHOT)
+    {
+        g_ui32ModelMisuse++;
+    }
+}
+
+void
+TimerIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+}
+
+void
+TimerIntClear(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    g_bModelTimerPending = false;
+}
+
+void
+TimerLoadSet(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value)
+{
+    g_ui32ModelTimer = ui32Value;
+}
+
+void
+TimerEnable(uint32_t ui32Base, uint32_t ui32Timer)
+{
+    g_bModelTimerOn = true;
+}
+
+uint32_t
+TimerValueGet(uint32_t ui32Base, uint32_t ui32Timer)
+{
+    return(g_ui32ModelTimer);
+}
+
+//*****************************************************************************
+//
+// Completes the command on the bus.  At the end of a write the codec takes
+// the register number and ninth data bit from the first byte and the rest
+// from the second; a reset returns it to its defaults.
+//
+//*****************************************************************************
+static void
+ModelI2CDone(void)
+{
+    uint32_t ui32Cmd, ui32Reg, ui32Idx;
+    tModelWrite *psWrite;
+
+    ui32Cmd = g_ui32ModelCmd;
+    g_ui32ModelCmd = 0;
+
+    if(ui32Cmd == I2C_MASTER_CMD_BURST_SEND_START)
+    {
+        g_bModelHeld = true;
+    }
+    else if(ui32Cmd == I2C_MASTER_CMD_BURST_SEND_FINISH)
+    {
+        g_bModelHeld = false;
+        if(!g_ui32ModelErr)
+        {
+            ui32Reg = g_ui8ModelFirst >> 1;
+            if(ui32Reg == WM8731_REG_RESET)
+            {
+                for(ui32Idx = 0; ui32Idx < MODEL_NUM_REGS; ui32Idx++)
+                {
+                    g_pui32ModelCodec[ui32Idx] = g_pui32ModelDefaults[ui32Idx];
+                }
+            }
+            else if(ui32Reg < MODEL_NUM_REGS)
+            {
+                g_pui32ModelCodec[ui32Reg] = (((g_ui8ModelFirst & 1) << 8) |
+                                              g_ui8ModelData);
+            }
+            else
+            {
+                g_ui32ModelMisuse++;
+            }
+
+            if(g_ui32ModelWrites < MODEL_MAX_WRITES)
+            {
+                psWrite = &g_psModelWrites[g_ui32ModelWrites++];
+                psWrite->ui32Reg = ui32Reg;
+                psWrite->ui32Value = (((g_ui8ModelFirst & 1) << 8) |
+                                      g_ui8ModelData);
+                psWrite->ui64Start = g_ui64ModelStart;
+                psWrite->ui64End = g_ui64ModelNow;
+            }
+        }
+    }
+    else
+    {
+        //
+        // A stop on its own.
+        //
+        g_bModelHeld = false;
+        return;
+    }
+
+    if(g_bModelI2CMasterInt)
+    {
+        g_bModelI2CPending = true;
+    }
+}
+
+//*****************************************************************************
+//
+// Moves the model on by one time step: the bus, then the timer at the
+// system clock.  Interrupts are not taken here.
+//
+//*****************************************************************************
+static void
+ModelStep(void)
+{
+    uint32_t ui32Count;
+
+    g_ui64ModelNow += MODEL_STEP_NS;
+
+    if(g_ui32ModelCmd)
+    {
+        g_ui32ModelBusyNs -= MODEL_STEP_NS;
+        if(g_ui32ModelBusyNs == 0)
+        {
+            ModelI2CDone();
+        }
+    }
+
+    if(g_bModelTimerOn)
+    {
+        ui32Count = g_ui32ModelClock / (1000000000 / MODEL_STEP_NS);
+        if(g_ui32ModelTimer <= ui32Count)
+        {
+            g_ui32ModelTimer = 0;
+            g_bModelTimerOn = false;
+            g_bModelTimerPending = true;
+        }
+        else
+        {
+            g_ui32ModelTimer -= ui32Count;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// The I2C master functions.  The registers may only be changed while the
+// master is idle, and the bus clock only for the system clock in use.
+//
+//*****************************************************************************
+void
+I2CMasterInitExpClk(uint32_t ui32Base, uint32_t ui32I2CClk, bool bFast)
+{
+    if(g_ui32ModelCmd || !bFast || (ui32I2CClk != g_ui32ModelClock))
+    {
+        g_ui32ModelMisuse++;
+    }
+}
+
+void
+I2CMasterIntEnable(uint32_t ui32Base)
+{
+    g_bModelI2CMasterInt = true;
+}
+
+void
+I2CMasterIntClear(uint32_t ui32Base)
+{
+    g_bModelI2CPending = false;
+}
+
+void
+I2CMasterSlaveAddrSet(uint32_t ui32Base, uint8_t ui8SlaveAddr,
+                      bool bReceive)
+{
+    if(g_ui32ModelCmd)
+    {
+        g_ui32ModelMisuse++;
+    }
+    if(bReceive)
+    {
+        g_ui32ModelReads++;
+    }
+    g_ui8ModelAddr = ui8SlaveAddr;
+}
+
+void
+I2CMasterDataPut(uint32_t ui32Base, uint8_t ui8Data)
+{
+    if(g_ui32ModelCmd)
+    {
+        g_ui32ModelMisuse++;
+    }
+    g_ui8ModelData = ui8Data;
+}
+
+uint32_t
+I2CMasterErr(uint32_t ui32Base)
+{
+    return(g_ui32ModelErr);
+}
+
+bool
+I2CMasterBusy(uint32_t ui32Base)
+{
+    if(g_ui32ModelCmd)
+    {
+        ModelStep();
+    }
+    return(g_ui32ModelCmd != 0);
+}
+
+void
+I2CMasterControl(uint32_t ui32Base, uint32_t ui32Cmd)
+{
+    if(g_ui32ModelCmd)
+    {
+        g_ui32ModelMisuse++;
+    }
+
+    if(ui32Cmd == I2C_MASTER_CMD_BURST_SEND_START)
+    {
+        //
+        // The start, the address and the first byte.  An address that is not
+        // acknowledged ends the command there, with the bus held.
+        //
+        if(g_bModelHeld || (g_ui8ModelAddr != WM8731_I2C_ADDR))
+        {
+            g_ui32ModelMisuse++;
+        }
+        g_ui64ModelStart = g_ui64ModelNow;
+        g_ui8ModelFirst = g_ui8ModelData;
+        g_ui32ModelErr = g_ui32ModelNack & I2C_MASTER_ERR_ADDR_ACK;
+        g_ui32ModelNack &= ~I2C_MASTER_ERR_ADDR_ACK;
+        g_ui32ModelBusyNs = (g_ui32ModelErr ? 10 : 19) * MODEL_BIT_NS;
+    }
+    else if(ui32Cmd == I2C_MASTER_CMD_BURST_SEND_FINISH)
+    {
+        //
+        // The second byte and the stop.  A byte that is not acknowledged
+        // still ends with the stop.
+        //
+        if(!g_bModelHeld || g_ui32ModelErr)
+        {
+            g_ui32ModelMisuse++;
+        }
+        g_ui32ModelErr = g_ui32ModelNack & I2C_MASTER_ERR_DATA_ACK;
+        g_ui32ModelNack &= ~I2C_MASTER_ERR_DATA_ACK;
+        g_ui32ModelBusyNs = 10 * MODEL_BIT_NS;
+    }
+    else if(ui32Cmd == I2C_MASTER_CMD_BURST_SEND_ERROR_STOP)
+    {
+        if(!g_bModelHeld)
+        {
+            g_ui32ModelMisuse++;
+        }
+        g_ui32ModelBusyNs = MODEL_BIT_NS;
+    }
+    else
+    {
+        g_ui32ModelMisuse++;
+        return;
+    }
+    g_ui32ModelCmd = ui32Cmd;
+}
+
+//*****************************************************************************
+//
+// Runs the model for ui64Ns nanoseconds, taking interrupts as they come.
+//
+//*****************************************************************************
+static void
+ModelRun(uint64_t ui64Ns)
+{
+    uint64_t ui64End;
+
+    ui64End = g_ui64ModelNow + ui64Ns;
+    while(g_ui64ModelNow < ui64End)
+    {
+        ModelStep();
+        if(!g_bModelIntsOff && g_bModelI2CPending && g_bModelI2CIntOn)
+        {
+            g_bModelI2CPending = false;
+            I2C0_Handler();
+        }
+        if(!g_bModelIntsOff && g_bModelTimerPending && g_bModelTimerIntOn)
+        {
+            g_bModelTimerPending = false;
+            TIMER1A_Handler();
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Runs the model until the driver's queue and the bus are idle.
+//
+//*****************************************************************************
+static void
+ModelDrain(void)
+{
+    uint64_t ui64End;
+
+    ui64End = g_ui64ModelNow + MODEL_TIMEOUT_NS;
+    while((WM8731Busy() || g_ui32ModelCmd) && (g_ui64ModelNow < ui64End))
+    {
+        ModelRun(MODEL_STEP_NS);
+    }
+}
+
+//*****************************************************************************
+//
+// Counts and reports a failed check.
+//
+//*****************************************************************************
+static void
+ModelCheck(bool bPass, const char *pcWhat)
+{
+    if(!bPass)
+    {
+        printf("failed: %s\n", pcWhat);
+        g_ui32ModelFailures++;
+    }
+}
+
+//*****************************************************************************
+//
+// Checks that the codec received write ui32Write as given.
+//
+//*****************************************************************************
+static void
+ModelWriteCheck(uint32_t ui32Write, uint32_t ui32Reg, uint32_t ui32Value,
+                const char *pcWhat)
+{
+    ModelCheck((ui32Write < g_ui32ModelWrites) &&
+               (g_psModelWrites[ui32Write].ui32Reg == ui32Reg) &&
+               (g_psModelWrites[ui32Write].ui32Value == ui32Value), pcWhat);
+}
+
+//*****************************************************************************
+//
+// Checks that a gap between two points in model time was a wait of
+// ui32Ms milliseconds.
+//
+//*****************************************************************************
+static void
+ModelWaitCheck(uint64_t ui64From, uint64_t ui64To, uint32_t ui32Ms,
+               const char *pcWhat)
+{
+    uint64_t ui64Want;
+
+    ui64Want = (uint64_t)ui32Ms * 1000000;
+    ModelCheck((ui64To >= ui64Want + ui64From - MODEL_WAIT_SLACK_NS) &&
+               (ui64To <= ui64Want + ui64From + MODEL_WAIT_SLACK_NS), pcWhat);
+    printf("%3u ms wait took %.3f ms\n", ui32Ms,
+           (double)(ui64To - ui64From) / 1000000);
+}
+
+//*****************************************************************************
+//
+// Runs the checks, returning the exit status.
+//
+//*****************************************************************************
+int
+main(void)
+{
+    static const tWM8731Setting psBringUp[] =
+    {
+        { WM8731_REG_POWER_DOWN, WM8731_POWER_OUTPUTS },
+        { WM8731_REG_DIGITAL_IF, (WM8731_IF_MASTER | WM8731_IF_IWL_16 |
+                                  WM8731_IF_FORMAT_DSP) },
+        { WM8731_REG_SAMPLING, WM8731_SAMPLING_44K1_USB },
+        { WM8731_REG_ANALOG_PATH, WM8731_ANALOG_DACSEL },
+        { WM8731_REG_DIGITAL_PATH, 0 },
+        { WM8731_WAIT, 5 },
+        { WM8731_REG_ACTIVE, WM8731_ACTIVE },
+        { WM8731_WAIT, 2 },
+        { WM8731_REG_POWER_DOWN, 0 }
+    };
+    uint32_t ui32Reg, ui32First, ui32Idx, ui32Write, ui32Errors;
+    uint64_t ui64Queued;
+    bool bSkipped;
+
+    g_ui32ModelClock = 80000000;
+    for(ui32Reg = 0; ui32Reg < MODEL_NUM_REGS; ui32Reg++)
+    {
+        g_pui32ModelCodec[ui32Reg] = MODEL_UNKNOWN;
+    }
+
+    WM8731Init();
+    ModelCheck(!WM8731Busy() && (g_ui32ModelWrites == 0),
+               "nothing is written at start-up");
+
+    //
+    // Before the reset the codec's contents are unknown, so even a write
+    // of the default is sent.
+    //
+    WM8731Write(WM8731_REG_LLINE_IN, g_pui32ModelDefaults[0]);
+    ModelDrain();
+    ModelWriteCheck(0, WM8731_REG_LLINE_IN, g_pui32ModelDefaults[0],
+                    "a write before the reset is sent");
+
+    //
+    // After the reset the shadow holds the defaults, and writing them again
+    // sends nothing.
+    //
+    WM8731Write(WM8731_REG_RESET, 0);
+    ModelDrain();
+    ModelWriteCheck(1, WM8731_REG_RESET, 0, "the reset is sent");
+    bSkipped = true;
+    for(ui32Reg = 0; ui32Reg < MODEL_NUM_REGS; ui32Reg++)
+    {
+        bSkipped = (bSkipped &&
+                    (WM8731Read(ui32Reg) == g_pui32ModelDefaults[ui32Reg]) &&
+                    WM8731Write(ui32Reg, g_pui32ModelDefaults[ui32Reg]) &&
+                    !WM8731Busy());
+    }
+    ModelCheck(bSkipped && (g_ui32ModelWrites == 2),
+               "rewriting the defaults after a reset sends nothing");
+
+    //
+    // A bring-up table arrives in order, with its waits between the writes
+    // either side of them and no gap elsewhere.
+    //
+    ui32First = g_ui32ModelWrites;
+    ModelCheck(WM8731TableWrite(psBringUp, sizeof(psBringUp) /
+                                           sizeof(psBringUp[0])) ==
+               (sizeof(psBringUp) / sizeof(psBringUp[0])),
+               "the bring-up table is queued");
+    ModelCheck(WM8731Busy(), "the queue is busy while the table is sent");
+    ModelDrain();
+    ui32Write = ui32First;
+    for(ui32Idx = 0; ui32Idx < (sizeof(psBringUp) / sizeof(psBringUp[0]));
+        ui32Idx++)
+    {
+        if(psBringUp[ui32Idx].ui8Reg == WM8731_WAIT)
+        {
+            ModelWaitCheck(g_psModelWrites[ui32Write - 1].ui64End,
+                           g_psModelWrites[ui32Write].ui64Start,
+                           psBringUp[ui32Idx].ui16Value,
+                           "a queued wait holds the queue for its time");
+            continue;
+        }
+        ModelWriteCheck(ui32Write, psBringUp[ui32Idx].ui8Reg,
+                        psBringUp[ui32Idx].ui16Value,
+                        "the table arrives in order");
+        if((ui32Write > ui32First) &&
+           (psBringUp[ui32Idx - 1].ui8Reg != WM8731_WAIT))
+        {
+            ModelCheck(g_psModelWrites[ui32Write].ui64Start ==
+                       g_psModelWrites[ui32Write - 1].ui64End,
+                       "each write follows the last at once");
+        }
+        ui32Write++;
+    }
+    ModelCheck(g_ui32ModelWrites == ui32Write,
+               "the table sends nothing else");
+
+    //
+    // A write overtaken in the queue by another to the same register is
+    // replaced by it; the one already on the bus is not.
+    //
+    ui32First = g_ui32ModelWrites;
+    WM8731Write(WM8731_REG_LHPHONE_OUT, 0x060);
+    WM8731Write(WM8731_REG_RHPHONE_OUT, 0x060);
+    WM8731Write(WM8731_REG_RHPHONE_OUT, 0x061);
+    WM8731Write(WM8731_REG_RHPHONE_OUT, 0x062);
+    ModelCheck(WM8731Read(WM8731_REG_RHPHONE_OUT) == 0x062,
+               "a read returns the last value queued");
+    ModelDrain();
+    ModelWriteCheck(ui32First, WM8731_REG_LHPHONE_OUT, 0x060,
+                    "the write on the bus is sent");
+    ModelWriteCheck(ui32First + 1, WM8731_REG_RHPHONE_OUT, 0x062,
+                    "an overtaken write is replaced");
+    ModelCheck(g_ui32ModelWrites == (ui32First + 2),
+               "overtaken writes are not sent");
+
+    //
+    // Unchanged volumes and updates that change nothing send nothing; an
+    // update keeps the bits outside its mask.
+    //
+    ui32First = g_ui32ModelWrites;
+    WM8731VolumeSet(50, 50);
+    ModelDrain();
+    WM8731VolumeSet(50, 50);
+    WM8731VolumeSet(50, 60);
+    WM8731Update(WM8731_REG_ANALOG_PATH, WM8731_ANALOG_DACSEL,
+                 WM8731_ANALOG_DACSEL);
+    WM8731Update(WM8731_REG_ANALOG_PATH, WM8731_ANALOG_BYPASS,
+                 WM8731_ANALOG_BYPASS);
+    ModelDrain();
+    ModelWriteCheck(ui32First + 2, WM8731_REG_RHPHONE_OUT,
+                    (WM8731_HPHONE_ZERO_CROSS + WM8731_HPHONE_MUTE + 60),
+                    "only the changed volume is sent");
+    ModelWriteCheck(ui32First + 3, WM8731_REG_ANALOG_PATH,
+                    (WM8731_ANALOG_DACSEL | WM8731_ANALOG_BYPASS),
+                    "an update keeps the other bits");
+    ModelCheck(g_ui32ModelWrites == (ui32First + 4),
+               "writes of the value held are dropped");
+
+    //
+    // With a wait at the head, the queue takes writes until it is full,
+    // refuses the next, and sends all it took once the wait is over.
+    //
+    ui32First = g_ui32ModelWrites;
+    ui64Queued = g_ui64ModelNow;
+    WM8731Wait(50);
+    for(ui32Idx = 0; ui32Idx < (2 * WM8731_QUEUE_SIZE); ui32Idx++)
+    {
+        if(!WM8731Write((ui32Idx & 1) ? WM8731_REG_RLINE_IN :
+                        WM8731_REG_LLINE_IN, ui32Idx))
+        {
+            break;
+        }
+    }
+    ModelCheck(ui32Idx == (WM8731_QUEUE_SIZE - 1),
+               "a full queue refuses writes");
+    ModelDrain();
+    for(ui32Write = 0; ui32Write < ui32Idx; ui32Write++)
+    {
+        ModelWriteCheck(ui32First + ui32Write,
+                        (ui32Write & 1) ? WM8731_REG_RLINE_IN :
+                        WM8731_REG_LLINE_IN, ui32Write,
+                        "a full queue sends all it took, in order");
+    }
+    ModelCheck(g_ui32ModelWrites == (ui32First + ui32Idx),
+               "a refused write is not sent");
+    ModelWaitCheck(ui64Queued, g_psModelWrites[ui32First].ui64Start, 50,
+                   "a wait on an idle queue starts at once");
+
+    //
+    // A write the codec does not acknowledge, at the address or at the data,
+    // is counted and does not hold up the queue, and its register is sent
+    // again on the next write even with the same value.
+    //
+    ui32Errors = WM8731ErrorCountGet();
+    ui32First = g_ui32ModelWrites;
+    g_ui32ModelNack = I2C_MASTER_ERR_ADDR_ACK;
+    WM8731Write(WM8731_REG_LLINE_IN, 0x011);
+    WM8731Write(WM8731_REG_RLINE_IN, 0x012);
+    ModelDrain();
+    g_ui32ModelNack = I2C_MASTER_ERR_DATA_ACK;
+    WM8731Write(WM8731_REG_RLINE_IN, 0x013);
+    WM8731Write(WM8731_REG_LLINE_IN, 0x014);
+    ModelDrain();
+    ModelCheck(WM8731ErrorCountGet() == (ui32Errors + 2),
+               "unacknowledged writes are counted");
+    ModelWriteCheck(ui32First, WM8731_REG_RLINE_IN, 0x012,
+                    "the queue carries on after an address error");
+    ModelWriteCheck(ui32First + 1, WM8731_REG_LLINE_IN, 0x014,
+                    "the queue carries on after a data error");
+    WM8731Write(WM8731_REG_RLINE_IN, 0x013);
+    ModelDrain();
+    ModelWriteCheck(ui32First + 2, WM8731_REG_RLINE_IN, 0x013,
+                    "a failed register is written again");
+    ModelCheck(g_ui32ModelWrites == (ui32First + 3),
+               "failed writes reach nothing");
+
+    //
+    // A clock change part way through a wait leaves its length unchanged,
+    // and one with a byte on the bus lets the byte finish first.
+    //
+    ui32First = g_ui32ModelWrites;
+    ui64Queued = g_ui64ModelNow;
+    WM8731Wait(10);
+    WM8731Write(WM8731_REG_ACTIVE, 0);
+    ModelRun(4000000);
+    g_ui32ModelClock = 50000000;
+    g_pfnModelClockHook(g_ui32ModelClock);
+    ModelDrain();
+    ModelWaitCheck(ui64Queued, g_psModelWrites[ui32First].ui64Start, 10,
+                   "a wait lasts its time across a clock change");
+    WM8731Write(WM8731_REG_ACTIVE, WM8731_ACTIVE);
+    ModelRun(10000);
+    g_ui32ModelClock = 80000000;
+    g_pfnModelClockHook(g_ui32ModelClock);
+    ModelDrain();
+    ModelWriteCheck(ui32First + 1, WM8731_REG_ACTIVE, WM8731_ACTIVE,
+                    "a write survives a clock change on the bus");
+
+    //
+    // The codec holds what the shadow says, and nothing was read from it.
+    //
+    for(ui32Reg = 0; ui32Reg < MODEL_NUM_REGS; ui32Reg++)
+    {
+        ModelCheck(g_pui32ModelCodec[ui32Reg] == WM8731Read(ui32Reg),
+                   "the shadow matches the codec");
+    }
+    ModelCheck(g_ui32ModelReads == 0, "nothing is read over the bus");
+    ModelCheck(g_ui32ModelMisuse == 0, "the I2C master is used correctly");
+
+    printf("%u writes sent, %u not acknowledged, %u checks failed\n",
+           g_ui32ModelWrites, WM8731ErrorCountGet(), g_ui32ModelFailures);
+    printf("%s\n", g_ui32ModelFailures ? "FAIL" : "PASS");
+    return(g_ui32ModelFailures ? 1 : 0);
+}
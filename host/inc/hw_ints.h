@@ -0,0 +1,23 @@
+//*****************************************************************************
+//
+// hw_ints.h - Host stand-in for the TivaWare header of the same name.
+//
+// The Keil project takes inc/ from the TivaWare pack.  The host models build
+// the drivers against this copy, which holds only the definitions they use,
+// with the TM4C123GH6PM values.
+//
+//*****************************************************************************
+
+#ifndef __HW_INTS_H__
+#define __HW_INTS_H__
+
+//*****************************************************************************
+//
+// The interrupt assignments.
+//
+//*****************************************************************************
+#define INT_SSI0                23          // SSI0 Rx and Tx
+#define INT_I2C0                24          // I2C0 Master and Slave
+#define INT_TIMER1A             37          // 16/32-Bit Timer 1A
+
+#endif // __HW_INTS_H__
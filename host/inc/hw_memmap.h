@@ -0,0 +1,26 @@
+//*****************************************************************************
+//
+// hw_memmap.h - Host stand-in for the TivaWare header of the same name.
+//
+// The Keil project takes inc/ from the TivaWare pack.  The host models build
+// the drivers against this copy, which holds only the definitions they use,
+// with the TM4C123GH6PM values.  The models never dereference these; they
+// only tell the peripherals apart.
+//
+//*****************************************************************************
+
+#ifndef __HW_MEMMAP_H__
+#define __HW_MEMMAP_H__
+
+//*****************************************************************************
+//
+// The base addresses of the peripherals.
+//
+//*****************************************************************************
+#define GPIO_PORTA_BASE         0x40004000  // GPIO Port A
+#define GPIO_PORTB_BASE         0x40005000  // GPIO Port B
+#define SSI0_BASE               0x40008000  // SSI0
+#define I2C0_BASE               0x40020000  // I2C0
+#define TIMER1_BASE             0x40031000  // 16/32-bit Timer 1
+
+#endif // __HW_MEMMAP_H__
@@ -0,0 +1,21 @@
+//*****************************************************************************
+//
+// hw_ssi.h - Host stand-in for the TivaWare header of the same name.
+//
+// The Keil project takes inc/ from the TivaWare pack.  The host models build
+// the drivers against this copy, which holds only the definitions they use,
+// with the TM4C123GH6PM values.
+//
+//*****************************************************************************
+
+#ifndef __HW_SSI_H__
+#define __HW_SSI_H__
+
+//*****************************************************************************
+//
+// The SSI register offsets.
+//
+//*****************************************************************************
+#define SSI_O_DR                0x00000008  // SSI Data
+
+#endif // __HW_SSI_H__
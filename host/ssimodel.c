@@ -0,0 +1,1008 @@
+//*****************************************************************************
+//
+// ssimodel.c - Host run of the codec streaming driver against an SSI and uDMA
+// model.
+//
+// audio_ssi.c is built unchanged against software versions of the driverlib
+// functions it calls.  The uDMA model keeps the channel control table,
+// encodes it as driverlib does, and runs basic, ping-pong and peripheral
+// scatter-gather transfers from it item by item, with the task lists copied
+// into the alternate structure as the controller copies them.  The SSI model
+// has eight-word receive and transmit FIFOs; the uDMA receive request is up
+// while the receive FIFO holds a word, and the transmit request while the
+// transmit FIFO has room.  Every task waits for its channel's request,
+// memory-to-memory tasks included, as audio_ssi.c expects.  Arbitration and
+// priorities are not modelled; nothing else runs on the controller.
+//
+// The codec side sends a count, one SSI word per tick, and takes a word from
+// the transmit FIFO at the same time.  Like the WM8731 in DSP mode it pulses
+// the frame before each left word only.  The SSI model follows the frame
+// format the driver sets: in Freescale SPI mode 1 it takes the right word
+// under the same frame, and in the TI format it takes no word that arrives
+// without a pulse, so the right words are lost and the codec hears silence
+// for them.  Built with -DAUDIO_SSI_FRAME_FORMAT=SSI_FRF_TI every case
+// fails.  The frame handler inverts every word, so each received word must
+// come back inverted a fixed number of words later.  A completed transfer
+// sets the SSI interrupt pending, and the handler runs at the end of the
+// tick unless interrupts are held off.  The main loop calls
+// AudioSSIService() every few words.
+//
+// Each case checks the counts, that the handler sees every frame in order in
+// the buffer the uDMA wrote it to, that its output buffer is the one the
+// uDMA sends, and that the output is the input after the documented
+// latency.  The cases that stall the main loop or the interrupt past what
+// the driver can absorb check that every lost frame is counted instead.
+// The cases that change the system clock also check that the driver
+// refuses a clock too slow for the codec's bit clock.
+//
+// Build from this directory with, on one line:
+//
+//     cc -O2 -I. -I.. -DPART_TM4C123GH6PM -o ssimodel ssimodel.c
+//        ../audio_ssi.c
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_ssi.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/ssi.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/udma.h"
+#include "anc.h"
+#include "audio_in.h"
+#include "audio_ssi.h"
+#include "clock.h"
+#include "dma.h"
+
+//*****************************************************************************
+//
+// The driver's interrupt handler, which the vector table names on the board.
+//
+//*****************************************************************************
+extern void SSI0_Handler(void);
+
+//*****************************************************************************
+//
+// The depth of the SSI FIFOs, the most frames a case runs, and the words
+// in a frame.
+//
+//*****************************************************************************
+#define MODEL_FIFO_SIZE         8
+#define MODEL_MAX_FRAMES        512
+#define MODEL_FRAME             AUDIO_SSI_FRAME_WORDS
+
+//*****************************************************************************
+//
+// The address of the SSI data register, as the driver hands it to the uDMA.
+//
+//*****************************************************************************
+#define MODEL_SSI_DR            ((uintptr_t)(SSI0_BASE + SSI_O_DR))
+
+//*****************************************************************************
+//
+// The fields of a channel control word.
+//
+//*****************************************************************************
+#define MODEL_CTL_SIZE(ui32Ctl) (1 << (((ui32Ctl) >> 24) & 3))
+#define MODEL_CTL_SRCINC(ui32Ctl)                                             \
+                                (((ui32Ctl) >> 26) & 3)
+#define MODEL_CTL_DSTINC(ui32Ctl)                                             \
+                                (((ui32Ctl) >> 30) & 3)
+#define MODEL_CTL_COUNT(ui32Ctl)                                              \
+                                ((((ui32Ctl) >> 4) & 0x3ff) + 1)
+#define MODEL_CTL_MODE(ui32Ctl) ((ui32Ctl) & 7)
+#define MODEL_CTL_COUNT_M       0x00003ff0
+#define MODEL_CTL_MODE_M        0x00000007
+#define MODEL_CTL_SETUP_M       0xff03c008
+
+//*****************************************************************************
+//
+// An eight-word SSI FIFO, with the codec's count of each word it holds.
+//
+//*****************************************************************************
+typedef struct
+{
+    int16_t pi16Data[MODEL_FIFO_SIZE];
+    uint32_t pui32Word[MODEL_FIFO_SIZE];
+    uint32_t ui32Read;
+    uint32_t ui32Count;
+}
+tModelFIFO;
+
+//*****************************************************************************
+//
+// A test case.  The stall holds off the main loop in ring mode and the
+// interrupt in ping-pong mode, for ui32StallLen words from word
+// ui32StallAt.
+//
+//*****************************************************************************
+typedef struct
+{
+    const char *pcName;
+    uint32_t ui32Mode;
+    uint32_t ui32Frames;
+    uint32_t ui32Period;
+    uint32_t ui32StallAt;
+    uint32_t ui32StallLen;
+    bool bLossy;
+    bool bClockChange;
+    bool bRateChange;
+}
+tModelCase;
+
+//*****************************************************************************
+//
+// The uDMA model: the control table, primary structures first, and whether
+// each channel is enabled and on its alternate structure.
+//
+//*****************************************************************************
+static tDMAControlTable g_psModelTable[64];
+static bool g_pbModelEnabled[32];
+static bool g_pbModelAlt[32];
+
+//*****************************************************************************
+//
+// The SSI model: its configuration, the FIFOs, the raw interrupt status, and
+// the interrupt controller's view of the SSI interrupt.
+//
+//*****************************************************************************
+static bool g_bModelSSIEnabled;
+static uint32_t g_ui32ModelSSIDMA;
+static uint32_t g_ui32ModelBitRate;
+static uint32_t g_ui32ModelProtocol;
+static uint32_t g_ui32ModelConfigErrors;
+static tModelFIFO g_sModelRx;
+static tModelFIFO g_sModelTx;
+static uint32_t g_ui32ModelIntStatus;
+static bool g_bModelIntEnabled;
+static bool g_bModelIntPending;
+static tClockHook g_pfnModelClockHook;
+static tClockCheck g_pfnModelClockCheck;
+
+//*****************************************************************************
+//
+// The codec side: the next word it sends, the words it has taken back, the
+// words the uDMA has written to the transmit FIFO, the words lost to a full
+// receive FIFO or sent from an empty transmit FIFO, and the words the SSI
+// let pass for want of a frame pulse.
+//
+//*****************************************************************************
+static uint32_t g_ui32ModelSent;
+static uint32_t g_ui32ModelTaken;
+static uint32_t g_ui32ModelQueued;
+static uint32_t g_ui32ModelDropped;
+static uint32_t g_ui32ModelStarved;
+static uint32_t g_ui32ModelUnframed;
+
+//*****************************************************************************
+//
+// The checks: the output latency in words, where the uDMA put the first word
+// of each received frame, the output buffer the handler was given for each
+// frame, the next word the handler expects and the frames it skipped, the
+// output frames that came back wrong, and the buffers that did not match.
+//
+//*****************************************************************************
+static uint32_t g_ui32ModelLatency;
+static int16_t *g_ppi16ModelRxAt[MODEL_MAX_FRAMES];
+static int16_t *g_ppi16ModelOut[MODEL_MAX_FRAMES];
+static uint32_t g_ui32ModelNext;
+static uint32_t g_ui32ModelSkipped;
+static uint32_t g_ui32ModelOutOfOrder;
+static uint32_t g_ui32ModelBadFrames;
+static uint32_t g_ui32ModelLastBad;
+static uint32_t g_ui32ModelBufErrors;
+static bool g_bModelCheckOutput;
+
+//*****************************************************************************
+//
+// The uDMA control table functions, as driverlib encodes them.
+//
+//*****************************************************************************
+void
+DMAInit(void)
+{
+    memset(g_psModelTable, 0, sizeof(g_psModelTable));
+    memset(g_pbModelEnabled, 0, sizeof(g_pbModelEnabled));
+    memset(g_pbModelAlt, 0, sizeof(g_pbModelAlt));
+}
+
+uint32_t
+DMAErrorCountGet(void)
+{
+    return(0);
+}
+
+void
+uDMAChannelAssign(uint32_t ui32Mapping)
+{
+}
+
+void
+uDMAChannelAttributeDisable(uint32_t ui32ChannelNum, uint32_t ui32Attr)
+{
+    if(ui32Attr & UDMA_ATTR_ALTSELECT)
+    {
+        g_pbModelAlt[ui32ChannelNum & 0x1f] = false;
+    }
+}
+
+void
+uDMAChannelControlSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Control)
+{
+    tDMAControlTable *psCtl;
+
+    psCtl = &g_psModelTable[ui32ChannelStructIndex & 0x3f];
+    psCtl->ui32Control = ((psCtl->ui32Control & ~MODEL_CTL_SETUP_M) |
+                          ui32Control);
+}
+
+void
+uDMAChannelTransferSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Mode,
+                       void *pvSrcAddr, void *pvDstAddr,
+                       uint32_t ui32TransferSize)
+{
+    tDMAControlTable *psCtl;
+    uint32_t ui32Control;
+
+    psCtl = &g_psModelTable[ui32ChannelStructIndex & 0x3f];
+    ui32Control = ((psCtl->ui32Control &
+                    ~(MODEL_CTL_COUNT_M | MODEL_CTL_MODE_M)) |
+                   ui32Mode | ((ui32TransferSize - 1) << 4));
+    if(MODEL_CTL_SRCINC(ui32Control) != 3)
+    {
+        pvSrcAddr = ((uint8_t *)pvSrcAddr +
+                     (ui32TransferSize << MODEL_CTL_SRCINC(ui32Control)) - 1);
+    }
+    if(MODEL_CTL_DSTINC(ui32Control) != 3)
+    {
+        pvDstAddr = ((uint8_t *)pvDstAddr +
+                     (ui32TransferSize << MODEL_CTL_DSTINC(ui32Control)) - 1);
+    }
+    psCtl->pvSrcEndAddr = pvSrcAddr;
+    psCtl->pvDstEndAddr = pvDstAddr;
+    psCtl->ui32Control = ui32Control;
+}
+
+void
+uDMAChannelScatterGatherSet(uint32_t ui32ChannelNum, uint32_t ui32TaskCount,
+                            void *pvTaskList, uint32_t ui32IsPeriphSG)
+{
+    tDMAControlTable *psCtl;
+
+    ui32ChannelNum &= 0x1f;
+    psCtl = &g_psModelTable[ui32ChannelNum];
+    psCtl->pvSrcEndAddr =
+        (void *)&((tDMAControlTable *)pvTaskList)[ui32TaskCount - 1].ui32Spare;
+    psCtl->pvDstEndAddr =
+        (void *)&g_psModelTable[ui32ChannelNum | UDMA_ALT_SELECT].ui32Spare;
+    psCtl->ui32Control = (UDMA_SIZE_32 | UDMA_SRC_INC_32 | UDMA_DST_INC_32 |
+                          UDMA_ARB_4 | (((ui32TaskCount * 4) - 1) << 4) |
+                          (ui32IsPeriphSG ? UDMA_MODE_PER_SCATTER_GATHER :
+                           UDMA_MODE_MEM_SCATTER_GATHER));
+    g_pbModelAlt[ui32ChannelNum] = false;
+}
+
+uint32_t
+uDMAChannelModeGet(uint32_t ui32ChannelStructIndex)
+{
+    uint32_t ui32Mode;
+
+    ui32Mode = MODEL_CTL_MODE(g_psModelTable[ui32ChannelStructIndex &
+                                             0x3f].ui32Control);
+    if(((ui32Mode & ~UDMA_MODE_ALT_SELECT) ==
+        UDMA_MODE_MEM_SCATTER_GATHER) ||
+       ((ui32Mode & ~UDMA_MODE_ALT_SELECT) == UDMA_MODE_PER_SCATTER_GATHER))
+    {
+        ui32Mode &= ~UDMA_MODE_ALT_SELECT;
+    }
+    return(ui32Mode);
+}
+
+void
+uDMAChannelEnable(uint32_t ui32ChannelNum)
+{
+    g_pbModelEnabled[ui32ChannelNum & 0x1f] = true;
+}
+
+void
+uDMAChannelDisable(uint32_t ui32ChannelNum)
+{
+    g_pbModelEnabled[ui32ChannelNum & 0x1f] = false;
+}
+
+bool
+uDMAChannelIsEnabled(uint32_t ui32ChannelNum)
+{
+    return(g_pbModelEnabled[ui32ChannelNum & 0x1f]);
+}
+
+//*****************************************************************************
+//
+// The SSI functions.  The SSI can only be set up while it is disabled, and
+// as a slave for a bit clock of at most a twelfth of the system clock.
+//
+//*****************************************************************************
+void
+SSIConfigSetExpClk(uint32_t ui32Base, uint32_t ui32SSIClk,
+                   uint32_t ui32Protocol, uint32_t ui32Mode,
+                   uint32_t ui32BitRate, uint32_t ui32DataWidth)
+{
+    if(g_bModelSSIEnabled || (ui32Mode != SSI_MODE_SLAVE) ||
+       (ui32BitRate > (ui32SSIClk / 12)) || (ui32DataWidth != 16))
+    {
+        g_ui32ModelConfigErrors++;
+    }
+    g_ui32ModelProtocol = ui32Protocol;
+    g_ui32ModelBitRate = ui32BitRate;
+}
+
+void
+SSIEnable(uint32_t ui32Base)
+{
+    g_bModelSSIEnabled = true;
+}
+
+void
+SSIDisable(uint32_t ui32Base)
+{
+    g_bModelSSIEnabled = false;
+}
+
+void
+SSIDMAEnable(uint32_t ui32Base, uint32_t ui32DMAFlags)
+{
+    g_ui32ModelSSIDMA |= ui32DMAFlags;
+}
+
+uint32_t
+SSIIntStatus(uint32_t ui32Base, bool bMasked)
+{
+    return(g_ui32ModelIntStatus);
+}
+
+void
+SSIIntClear(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    g_ui32ModelIntStatus &= ~ui32IntFlags;
+}
+
+//*****************************************************************************
+//
+// The system control, GPIO, interrupt controller and clock functions.  A
+// reset of the SSI empties its FIFOs and clears its registers.
+//
+//*****************************************************************************
+void
+SysCtlPeripheralEnable(uint32_t ui32Peripheral)
+{
+}
+
+bool
+SysCtlPeripheralReady(uint32_t ui32Peripheral)
+{
+    return(true);
+}
+
+void
+SysCtlPeripheralReset(uint32_t ui32Peripheral)
+{
+    if(ui32Peripheral == SYSCTL_PERIPH_SSI0)
+    {
+        g_bModelSSIEnabled = false;
+        g_ui32ModelSSIDMA = 0;
+        g_ui32ModelIntStatus = 0;
+        memset(&g_sModelRx, 0, sizeof(g_sModelRx));
+        memset(&g_sModelTx, 0, sizeof(g_sModelTx));
+    }
+}
+
+uint32_t
+SysCtlClockGet(void)
+{
+    return(80000000);
+}
+
+void
+GPIOPinConfigure(uint32_t ui32PinConfig)
+{
+}
+
+void
+GPIOPinTypeSSI(uint32_t ui32Port, uint8_t ui8Pins)
+{
+}
+
+void
+IntEnable(uint32_t ui32Interrupt)
+{
+    if(ui32Interrupt == INT_SSI0)
+    {
+        g_bModelIntEnabled = true;
+    }
+}
+
+void
+IntDisable(uint32_t ui32Interrupt)
+{
+    if(ui32Interrupt == INT_SSI0)
+    {
+        g_bModelIntEnabled = false;
+    }
+}
+
+void
+IntPendClear(uint32_t ui32Interrupt)
+{
+    if(ui32Interrupt == INT_SSI0)
+    {
+        g_bModelIntPending = false;
+    }
+}
+
+bool
+ClockHookRegister(tClockHook pfnHook)
+{
+    g_pfnModelClockHook = pfnHook;
+    return(true);
+}
+
+bool
+ClockCheckRegister(tClockCheck pfnCheck)
+{
+    g_pfnModelClockCheck = pfnCheck;
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Moves one item of a transfer between memory and the SSI FIFOs.  Words the
+// uDMA writes to the data register go to the transmit FIFO and words it
+// reads come from the receive FIFO.  The first word of each frame is noted
+// on the way, for the buffer checks.
+//
+//*****************************************************************************
+static void
+ModelItemMove(uint8_t *pui8Src, uint8_t *pui8Dst, uint32_t ui32Size)
+{
+    tModelFIFO *psFIFO;
+    uint32_t ui32Word;
+
+    if((uintptr_t)pui8Src == MODEL_SSI_DR)
+    {
+        psFIFO = &g_sModelRx;
+        ui32Word = psFIFO->pui32Word[psFIFO->ui32Read];
+        if(((ui32Word % MODEL_FRAME) == 0) &&
+           ((ui32Word / MODEL_FRAME) < MODEL_MAX_FRAMES))
+        {
+            g_ppi16ModelRxAt[ui32Word / MODEL_FRAME] = (int16_t *)pui8Dst;
+        }
+        memcpy(pui8Dst, &psFIFO->pi16Data[psFIFO->ui32Read], 2);
+        psFIFO->ui32Read = (psFIFO->ui32Read + 1) % MODEL_FIFO_SIZE;
+        psFIFO->ui32Count--;
+    }
+    else if((uintptr_t)pui8Dst == MODEL_SSI_DR)
+    {
+        psFIFO = &g_sModelTx;
+        ui32Word = g_ui32ModelQueued++;
+        if(g_bModelCheckOutput && ((ui32Word % MODEL_FRAME) == 0) &&
+           (ui32Word >= g_ui32ModelLatency))
+        {
+            ui32Word = (ui32Word - g_ui32ModelLatency) / MODEL_FRAME;
+            if((ui32Word < MODEL_MAX_FRAMES) && g_ppi16ModelOut[ui32Word] &&
+               (g_ppi16ModelOut[ui32Word] != (int16_t *)pui8Src))
+            {
+                g_ui32ModelBufErrors++;
+            }
+        }
+        memcpy(&psFIFO->pi16Data[(psFIFO->ui32Read + psFIFO->ui32Count) %
+                                 MODEL_FIFO_SIZE], pui8Src, 2);
+        psFIFO->ui32Count++;
+    }
+    else
+    {
+        memcpy(pui8Dst, pui8Src, ui32Size);
+    }
+}
+
+//*****************************************************************************
+//
+// Marks a transfer of channel ui32Chan complete, with its SSI interrupt.
+//
+//*****************************************************************************
+static void
+ModelTransferDone(uint32_t ui32Chan)
+{
+    g_ui32ModelIntStatus |= ((ui32Chan == UDMA_CHANNEL_SSI0RX) ? SSI_DMARX :
+                             SSI_DMATX);
+    g_bModelIntPending = true;
+}
+
+//*****************************************************************************
+//
+// Runs one step of channel ui32Chan: copies the next task of a
+// scatter-gather list into the alternate structure, or moves one item if the
+// SSI is requesting.  Returns true if the channel did anything.
+//
+//*****************************************************************************
+static bool
+ModelChannelStep(uint32_t ui32Chan)
+{
+    tDMAControlTable *psCtl, *psTask;
+    uint32_t ui32Ctl, ui32Mode, ui32Count;
+    uint8_t *pui8Src, *pui8Dst;
+    bool bRequest;
+
+    if(!g_pbModelEnabled[ui32Chan])
+    {
+        return(false);
+    }
+
+    psCtl = &g_psModelTable[ui32Chan |
+                            (g_pbModelAlt[ui32Chan] ? UDMA_ALT_SELECT : 0)];
+    ui32Ctl = psCtl->ui32Control;
+    ui32Mode = MODEL_CTL_MODE(ui32Ctl);
+    ui32Count = MODEL_CTL_COUNT(ui32Ctl);
+
+    //
+    // A channel that comes to a stopped structure is done.
+    //
+    if(ui32Mode == UDMA_MODE_STOP)
+    {
+        g_pbModelEnabled[ui32Chan] = false;
+        return(true);
+    }
+
+    //
+    // The primary structure of a scatter-gather list copies the next task,
+    // four words counted from the end of the list, into the alternate.
+    //
+    if(!g_pbModelAlt[ui32Chan] &&
+       ((ui32Mode == UDMA_MODE_MEM_SCATTER_GATHER) ||
+        (ui32Mode == UDMA_MODE_PER_SCATTER_GATHER)))
+    {
+        psTask = ((tDMAControlTable *)((uint8_t *)psCtl->pvSrcEndAddr -
+                                       offsetof(tDMAControlTable,
+                                                ui32Spare)) -
+                  ((ui32Count / 4) - 1));
+        g_psModelTable[ui32Chan | UDMA_ALT_SELECT] = *psTask;
+        psCtl->ui32Control = ((ui32Count == 4) ?
+                              (ui32Ctl & ~(MODEL_CTL_COUNT_M |
+                                           MODEL_CTL_MODE_M)) :
+                              (ui32Ctl - (4 << 4)));
+        g_pbModelAlt[ui32Chan] = true;
+        return(true);
+    }
+
+    //
+    // Everything else waits for the SSI: the receive request is up while
+    // its FIFO holds a word, the transmit request while its FIFO has room.
+    //
+    if(ui32Chan == UDMA_CHANNEL_SSI0RX)
+    {
+        bRequest = ((g_ui32ModelSSIDMA & SSI_DMA_RX) &&
+                    (g_sModelRx.ui32Count != 0));
+    }
+    else
+    {
+        bRequest = ((g_ui32ModelSSIDMA & SSI_DMA_TX) &&
+                    (g_sModelTx.ui32Count != MODEL_FIFO_SIZE));
+    }
+    if(!bRequest)
+    {
+        return(false);
+    }
+
+    //
+    // The addresses of the next item count back from the end addresses.
+    //
+    pui8Src = (uint8_t *)psCtl->pvSrcEndAddr;
+    if(MODEL_CTL_SRCINC(ui32Ctl) != 3)
+    {
+        pui8Src -= (ui32Count << MODEL_CTL_SRCINC(ui32Ctl)) - 1;
+    }
+    pui8Dst = (uint8_t *)psCtl->pvDstEndAddr;
+    if(MODEL_CTL_DSTINC(ui32Ctl) != 3)
+    {
+        pui8Dst -= (ui32Count << MODEL_CTL_DSTINC(ui32Ctl)) - 1;
+    }
+    ModelItemMove(pui8Src, pui8Dst, MODEL_CTL_SIZE(ui32Ctl));
+
+    if(ui32Count != 1)
+    {
+        psCtl->ui32Control = ui32Ctl - (1 << 4);
+        return(true);
+    }
+
+    //
+    // The transfer is done and its structure reads stopped.
+    //
+    psCtl->ui32Control = ui32Ctl & ~(MODEL_CTL_COUNT_M | MODEL_CTL_MODE_M);
+    if(ui32Mode == UDMA_MODE_PINGPONG)
+    {
+        ModelTransferDone(ui32Chan);
+        g_pbModelAlt[ui32Chan] = !g_pbModelAlt[ui32Chan];
+    }
+    else if((ui32Mode == (UDMA_MODE_MEM_SCATTER_GATHER |
+                          UDMA_MODE_ALT_SELECT)) ||
+            (ui32Mode == (UDMA_MODE_PER_SCATTER_GATHER |
+                          UDMA_MODE_ALT_SELECT)))
+    {
+        g_pbModelAlt[ui32Chan] = false;
+    }
+    else
+    {
+        ModelTransferDone(ui32Chan);
+        g_pbModelEnabled[ui32Chan] = false;
+    }
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Runs both channels until neither can go further.
+//
+//*****************************************************************************
+static void
+ModelDMARun(void)
+{
+    bool bRx, bTx;
+
+    do
+    {
+        bRx = ModelChannelStep(UDMA_CHANNEL_SSI0RX);
+        bTx = ModelChannelStep(UDMA_CHANNEL_SSI0TX);
+    }
+    while(bRx || bTx);
+}
+
+//*****************************************************************************
+//
+// Runs one word time of the codec: the uDMA catches up with whatever was
+// set up since the last word, then a word goes in and a word comes out, the
+// uDMA runs again, and then the SSI interrupt unless it is held off.  The
+// codec's words are lost while the SSI is disabled, and in the TI format
+// every right word is lost, since the codec pulses the frame before the left
+// word only.
+//
+//*****************************************************************************
+static void
+ModelTick(bool bIntHeld)
+{
+    uint32_t ui32Idx;
+    int16_t i16Word, i16Expect;
+
+    ModelDMARun();
+    if(g_bModelSSIEnabled && (g_ui32ModelProtocol == SSI_FRF_TI) &&
+       ((g_ui32ModelSent % 2) != 0))
+    {
+        g_ui32ModelUnframed++;
+        g_ui32ModelTaken++;
+    }
+    else if(g_bModelSSIEnabled)
+    {
+        if(g_sModelRx.ui32Count == MODEL_FIFO_SIZE)
+        {
+            g_ui32ModelDropped++;
+        }
+        else
+        {
+            ui32Idx = ((g_sModelRx.ui32Read + g_sModelRx.ui32Count) %
+                       MODEL_FIFO_SIZE);
+            g_sModelRx.pi16Data[ui32Idx] = (int16_t)g_ui32ModelSent;
+            g_sModelRx.pui32Word[ui32Idx] = g_ui32ModelSent;
+            g_sModelRx.ui32Count++;
+        }
+
+        if(g_sModelTx.ui32Count == 0)
+        {
+            g_ui32ModelStarved++;
+            i16Word = 0;
+        }
+        else
+        {
+            i16Word = g_sModelTx.pi16Data[g_sModelTx.ui32Read];
+            g_sModelTx.ui32Read = (g_sModelTx.ui32Read + 1) % MODEL_FIFO_SIZE;
+            g_sModelTx.ui32Count--;
+        }
+
+        //
+        // The output is silent until the first frame comes back.
+        //
+        i16Expect = ((g_ui32ModelTaken < g_ui32ModelLatency) ? 0 :
+                     (int16_t)~(g_ui32ModelTaken - g_ui32ModelLatency));
+        if(g_bModelCheckOutput && (i16Word != i16Expect) &&
+           ((g_ui32ModelBadFrames == 0) ||
+            (g_ui32ModelLastBad != (g_ui32ModelTaken / MODEL_FRAME))))
+        {
+            g_ui32ModelBadFrames++;
+            g_ui32ModelLastBad = g_ui32ModelTaken / MODEL_FRAME;
+        }
+        g_ui32ModelTaken++;
+    }
+    g_ui32ModelSent++;
+
+    ModelDMARun();
+    while(g_bModelIntPending && g_bModelIntEnabled && !bIntHeld)
+    {
+        g_bModelIntPending = false;
+        SSI0_Handler();
+        ModelDMARun();
+    }
+}
+
+//*****************************************************************************
+//
+// The frame handler: checks that the frame is the next one, or a later one,
+// and that it sits where the uDMA put it, then inverts it into the output.
+// Each frame should start on a frame boundary of the codec's count; one
+// that does not is out of order and not checked further.
+//
+//*****************************************************************************
+static void
+ModelFrameHandler(int16_t *pi16In, int16_t *pi16Out)
+{
+    uint32_t ui32Word, ui32Idx;
+
+    ui32Word = g_ui32ModelNext + (int16_t)(pi16In[0] -
+                                           (int16_t)g_ui32ModelNext);
+    if((ui32Word < g_ui32ModelNext) || ((ui32Word % MODEL_FRAME) != 0))
+    {
+        g_ui32ModelOutOfOrder++;
+        g_ui32ModelNext += MODEL_FRAME;
+    }
+    else
+    {
+        g_ui32ModelSkipped += (ui32Word - g_ui32ModelNext) / MODEL_FRAME;
+        g_ui32ModelNext = ui32Word + MODEL_FRAME;
+
+        for(ui32Idx = 0; ui32Idx < MODEL_FRAME; ui32Idx++)
+        {
+            if(pi16In[ui32Idx] != (int16_t)(ui32Word + ui32Idx))
+            {
+                g_ui32ModelOutOfOrder++;
+                break;
+            }
+        }
+    }
+
+    if(((ui32Word % MODEL_FRAME) == 0) &&
+       ((ui32Word / MODEL_FRAME) < MODEL_MAX_FRAMES))
+    {
+        if((pi16In != g_ppi16ModelRxAt[ui32Word / MODEL_FRAME]) ||
+           (pi16Out == pi16In))
+        {
+            g_ui32ModelBufErrors++;
+        }
+        g_ppi16ModelOut[ui32Word / MODEL_FRAME] = pi16Out;
+    }
+
+    for(ui32Idx = 0; ui32Idx < MODEL_FRAME; ui32Idx++)
+    {
+        pi16Out[ui32Idx] = (int16_t)~pi16In[ui32Idx];
+    }
+}
+
+//*****************************************************************************
+//
+// Runs one case, returning true if it passes.
+//
+//*****************************************************************************
+static bool
+ModelCaseRun(const tModelCase *psCase)
+{
+    uint32_t ui32Word, ui32Words, ui32Frames, ui32Restart;
+    bool bStall, bPass;
+
+    //
+    // Start from a fresh SSI and codec.
+    //
+    memset(&g_sModelRx, 0, sizeof(g_sModelRx));
+    memset(&g_sModelTx, 0, sizeof(g_sModelTx));
+    memset(g_ppi16ModelRxAt, 0, sizeof(g_ppi16ModelRxAt));
+    memset(g_ppi16ModelOut, 0, sizeof(g_ppi16ModelOut));
+    g_bModelSSIEnabled = false;
+    g_ui32ModelSSIDMA = 0;
+    g_ui32ModelIntStatus = 0;
+    g_bModelIntEnabled = false;
+    g_bModelIntPending = false;
+    g_ui32ModelConfigErrors = 0;
+    g_ui32ModelSent = 0;
+    g_ui32ModelTaken = 0;
+    g_ui32ModelQueued = 0;
+    g_ui32ModelDropped = 0;
+    g_ui32ModelStarved = 0;
+    g_ui32ModelUnframed = 0;
+    g_ui32ModelNext = 0;
+    g_ui32ModelSkipped = 0;
+    g_ui32ModelOutOfOrder = 0;
+    g_ui32ModelBadFrames = 0;
+    g_ui32ModelBufErrors = 0;
+    g_bModelCheckOutput = (!psCase->bRateChange &&
+                           ((psCase->ui32Mode == AUDIO_SSI_MODE_RING) ||
+                            !psCase->bLossy));
+    g_ui32ModelLatency = (((psCase->ui32Mode == AUDIO_SSI_MODE_RING) ?
+                           AUDIO_SSI_NUM_BUFFERS : 2) * MODEL_FRAME);
+
+    AudioSSIInit(ModelFrameHandler, psCase->ui32Mode);
+    AudioSSIStart();
+
+    //
+    // Run whole frames and half of one more, so that the last whole frame
+    // is handed over.  A rate change stops the codec half way through, on a
+    // frame boundary.
+    //
+    ui32Words = (psCase->ui32Frames * MODEL_FRAME) + (MODEL_FRAME / 2);
+    ui32Restart = (psCase->ui32Frames / 2) * MODEL_FRAME;
+    for(ui32Word = 0; ui32Word < ui32Words; ui32Word++)
+    {
+        bStall = ((ui32Word >= psCase->ui32StallAt) &&
+                  (ui32Word < (psCase->ui32StallAt + psCase->ui32StallLen)));
+
+        if(psCase->bRateChange && (ui32Word == ui32Restart))
+        {
+            AudioSSIService();
+            AudioSSIRateSet(48000);
+            if(g_ui32ModelBitRate != (48000 * 32))
+            {
+                g_ui32ModelConfigErrors++;
+            }
+        }
+        if(psCase->bClockChange && (ui32Word == (ui32Words / 2)))
+        {
+            //
+            // The idle profile's 16 MHz is refused at rates above 32 kHz.
+            //
+            if(!g_pfnModelClockCheck(50000000) ||
+               (g_pfnModelClockCheck(16000000) !=
+                ((CODEC_RATE * 32) <= (16000000 / 12))))
+            {
+                g_ui32ModelConfigErrors++;
+            }
+            g_pfnModelClockHook(50000000);
+        }
+
+        ModelTick(bStall && (psCase->ui32Mode != AUDIO_SSI_MODE_RING));
+        if(!bStall && ((ui32Word % psCase->ui32Period) == 0))
+        {
+            AudioSSIService();
+        }
+    }
+    AudioSSIService();
+    AudioSSIStop();
+
+    //
+    // The frames the codec sent in full, all of which were handed over.
+    //
+    ui32Frames = psCase->ui32Frames;
+    printf("%-24s %3u frames, %3u skipped, %2u overruns, %2u underruns, "
+           "%2u bad out, %u dropped, %u unframed\n", psCase->pcName,
+           AudioSSIFrameCountGet(), g_ui32ModelSkipped,
+           AudioSSIOverrunCountGet(), AudioSSIUnderrunCountGet(),
+           g_ui32ModelBadFrames, g_ui32ModelDropped, g_ui32ModelUnframed);
+
+    bPass = ((g_ui32ModelConfigErrors == 0) &&
+             (g_ui32ModelProtocol == AUDIO_SSI_FRAME_FORMAT) &&
+             (g_ui32ModelUnframed == 0) && (g_ui32ModelBufErrors == 0));
+    if(!psCase->bLossy)
+    {
+        bPass = (bPass && (g_ui32ModelOutOfOrder == 0) &&
+                 (g_ui32ModelDropped == 0) && (g_ui32ModelStarved == 0) &&
+                 (AudioSSIOverrunCountGet() == 0) &&
+                 (AudioSSIUnderrunCountGet() == 0) &&
+                 (g_ui32ModelBadFrames == 0) &&
+                 (AudioSSIFrameCountGet() + g_ui32ModelSkipped ==
+                  ui32Frames));
+        //
+        // The codec stops on a frame boundary for a rate change, so the last
+        // frame is still waiting for the request that releases it, and the
+        // SSI reset drops it.
+        //
+        bPass = bPass && (g_ui32ModelSkipped == (psCase->bRateChange ? 1 : 0));
+    }
+    else if(psCase->ui32Mode == AUDIO_SSI_MODE_RING)
+    {
+        //
+        // Every lost frame is counted, and streaming comes back in step.
+        //
+        bPass = (bPass && (g_ui32ModelOutOfOrder == 0) &&
+                 (g_ui32ModelDropped == 0) && (g_ui32ModelStarved == 0) &&
+                 (AudioSSIOverrunCountGet() != 0) &&
+                 (AudioSSIOverrunCountGet() == g_ui32ModelSkipped) &&
+                 (AudioSSIUnderrunCountGet() == g_ui32ModelBadFrames) &&
+                 (AudioSSIFrameCountGet() + g_ui32ModelSkipped ==
+                  ui32Frames));
+    }
+    else
+    {
+        //
+        // In ping-pong mode the FIFOs drop and repeat words while both
+        // buffers wait, and the frames that follow no longer start on a
+        // frame boundary, so the output is not checked.  Every word sent was
+        // either handed over, dropped, or is in the part frame still being
+        // received.
+        //
+        ui32Words -= (AudioSSIFrameCountGet() * MODEL_FRAME) +
+                     g_ui32ModelDropped;
+        bPass = (bPass && (AudioSSIOverrunCountGet() != 0) &&
+                 (AudioSSIUnderrunCountGet() != 0) &&
+                 (g_ui32ModelDropped != 0) && (g_ui32ModelStarved != 0) &&
+                 (ui32Words < MODEL_FRAME));
+    }
+
+    return(bPass);
+}
+
+//*****************************************************************************
+//
+// Runs the cases, returning the exit status.
+//
+//*****************************************************************************
+int
+main(void)
+{
+    static const tModelCase psCases[] =
+    {
+        {
+            "ping-pong", AUDIO_SSI_MODE_PINGPONG, 200, MODEL_FRAME, 0, 0,
+            false, true, false
+        },
+        {
+            "ping-pong late isr", AUDIO_SSI_MODE_PINGPONG, 200, MODEL_FRAME,
+            50 * MODEL_FRAME, MODEL_FRAME / 2, false, false, false
+        },
+        {
+            "ping-pong isr stall", AUDIO_SSI_MODE_PINGPONG, 200, MODEL_FRAME,
+            50 * MODEL_FRAME, 3 * MODEL_FRAME, true, false, false
+        },
+        {
+            "ring", AUDIO_SSI_MODE_RING, 200, MODEL_FRAME / 4, 0, 0, false,
+            true, false
+        },
+        {
+            "ring once a frame", AUDIO_SSI_MODE_RING, 200, MODEL_FRAME, 0, 0,
+            false, false, false
+        },
+        {
+            "ring stall", AUDIO_SSI_MODE_RING, 200, MODEL_FRAME / 4,
+            50 * MODEL_FRAME,
+            ((AUDIO_SSI_NUM_BUFFERS - 1) * MODEL_FRAME) - (MODEL_FRAME / 2),
+            false, false, false
+        },
+        {
+            "ring overrun", AUDIO_SSI_MODE_RING, 200, MODEL_FRAME / 4,
+            50 * MODEL_FRAME, (AUDIO_SSI_NUM_BUFFERS + 2) * MODEL_FRAME,
+            true, false, false
+        },
+        {
+            "ring rate change", AUDIO_SSI_MODE_RING, 200, MODEL_FRAME / 4, 0,
+            0, false, false, true
+        }
+    };
+    uint32_t ui32Case;
+    bool bPass;
+
+    printf("%u words a frame, %u ring buffers, %s frame format\n",
+           MODEL_FRAME, AUDIO_SSI_NUM_BUFFERS,
+           (AUDIO_SSI_FRAME_FORMAT == SSI_FRF_TI) ? "TI" : "Freescale SPI");
+
+    bPass = true;
+    for(ui32Case = 0; ui32Case < (sizeof(psCases) / sizeof(psCases[0]));
+        ui32Case++)
+    {
+        if(!ModelCaseRun(&psCases[ui32Case]))
+        {
+            printf("%s failed\n", psCases[ui32Case].pcName);
+            bPass = false;
+        }
+    }
+
+    printf("%s\n", bPass ? "PASS" : "FAIL");
+    return(bPass ? 0 : 1);
+}
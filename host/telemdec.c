@@ -0,0 +1,453 @@
+//*****************************************************************************
+//
+// telemdec.c - Host decoder for the telemetry stream.
+//
+// Reads the telemetry stream from the board's serial port, or from a file
+// it was captured to, and prints each frame as a line of text: the signal
+// triples, the weights and the metrics.  The decoder is the one in
+// telemetry.c, built for the host.  A serial port is put into raw mode at
+// the given line rate first.
+//
+// With -l the tool is its own loopback: it queues frames with the sending
+// side of telemetry.c, takes them out of the queue in spans of random
+// length as the uDMA would, corrupts some of the bytes on the way, and
+// feeds them to the decoder.  It checks that every frame not corrupted
+// arrives intact and that the corrupted ones are caught, which exercises
+// the framing end to end without a board.
+//
+// With -b it checks that the word-at-a-time CRC routines match the bytewise
+// ones over random lengths and alignments, then measures each with
+// TelemetryCRCBenchmark() and prints its throughput in bytes per ns.  It
+// also measures the ring the stream is queued in with RingBenchmark(),
+// moving a byte per call and in spans of TELEMDEC_RING_SPAN bytes, as the
+// firmware does at start-up.
+//
+// Build from this directory with, on one line:
+//
+//     cc -O2 -I.. -o telemdec telemdec.c ../telemetry.c ../ring.c
+//        ../driverlib/sw_crc.c ../perf.c
+//
+//*****************************************************************************
+
+#define _DEFAULT_SOURCE
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include "driverlib/sw_crc.h"
+#include "ring.h"
+#include "telemetry.h"
+
+//*****************************************************************************
+//
+// The size of the loopback queue and the number of frames it sends.
+//
+//*****************************************************************************
+#define TELEMDEC_RING_SIZE      1024
+#define TELEMDEC_LOOP_FRAMES    100000
+
+//*****************************************************************************
+//
+// The size of the CRC check and benchmark buffer and the number of checks.
+//
+//*****************************************************************************
+#define TELEMDEC_CRC_SIZE       4096
+#define TELEMDEC_CRC_CHECKS     100000
+
+//*****************************************************************************
+//
+// The span the ring benchmark moves per call, besides a byte at a time.
+//
+//*****************************************************************************
+#define TELEMDEC_RING_SPAN      256
+
+//*****************************************************************************
+//
+// The names of the metrics, in TELEMETRY_METRIC_* order.
+//
+//*****************************************************************************
+static const char *g_ppcTelemDecMetrics[TELEMETRY_NUM_METRICS] =
+{
+    "frames", "primary", "error", "mode", "rate", "anc_cycles",
+    "dma_errors", "dropped"
+};
+
+//*****************************************************************************
+//
+// The names of the CRC routines, in TELEMETRY_CRC_* order.
+//
+//*****************************************************************************
+static const char *g_ppcTelemDecCRCs[TELEMETRY_NUM_CRCS] =
+{
+    "Crc16", "Crc16Slice4", "Crc32", "Crc32Slice8"
+};
+
+//*****************************************************************************
+//
+// Reads little-endian fields from a payload.
+//
+//*****************************************************************************
+static int32_t
+TelemDecRead16(const uint8_t *pui8Data)
+{
+    return((int16_t)((uint32_t)pui8Data[0] | ((uint32_t)pui8Data[1] << 8)));
+}
+
+static uint32_t
+TelemDecRead32(const uint8_t *pui8Data)
+{
+    return((uint32_t)pui8Data[0] | ((uint32_t)pui8Data[1] << 8) |
+           ((uint32_t)pui8Data[2] << 16) | ((uint32_t)pui8Data[3] << 24));
+}
+
+//*****************************************************************************
+//
+// Prints a frame.
+//
+//*****************************************************************************
+static void
+TelemDecPrint(void *pvArg, uint32_t ui32Type, uint32_t ui32Sequence,
+              const uint8_t *pui8Payload, uint32_t ui32Size)
+{
+    uint32_t ui32Idx;
+
+    (void)pvArg;
+    printf("%3u ", ui32Sequence);
+    switch(ui32Type)
+    {
+        case TELEMETRY_TYPE_SIGNALS:
+        {
+            printf("signals");
+            for(ui32Idx = 0; (ui32Idx + 6) <= ui32Size; ui32Idx += 6)
+            {
+                printf(" %d,%d,%d", TelemDecRead16(&pui8Payload[ui32Idx]),
+                       TelemDecRead16(&pui8Payload[ui32Idx + 2]),
+                       TelemDecRead16(&pui8Payload[ui32Idx + 4]));
+            }
+            break;
+        }
+
+        case TELEMETRY_TYPE_WEIGHTS:
+        {
+            printf("weights");
+            for(ui32Idx = 0; (ui32Idx + 4) <= ui32Size; ui32Idx += 4)
+            {
+                printf(" %.6f",
+                       (int32_t)TelemDecRead32(&pui8Payload[ui32Idx]) /
+                       2147483648.0);
+            }
+            break;
+        }
+
+        case TELEMETRY_TYPE_METRICS:
+        {
+            printf("metrics");
+            for(ui32Idx = 0; ((ui32Idx + 1) * 4) <= ui32Size; ui32Idx++)
+            {
+                printf(" %s=%u",
+                       ((ui32Idx < TELEMETRY_NUM_METRICS) ?
+                        g_ppcTelemDecMetrics[ui32Idx] : "?"),
+                       TelemDecRead32(&pui8Payload[ui32Idx * 4]));
+            }
+            break;
+        }
+
+        default:
+        {
+            printf("type %u, %u bytes", ui32Type, ui32Size);
+            break;
+        }
+    }
+    printf("\n");
+}
+
+//*****************************************************************************
+//
+// The loopback's check.  Every payload is filled from its sequence number,
+// so the handler can tell what it should hold.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t ui32Frames;
+    uint32_t ui32Bad;
+}
+tTelemDecLoop;
+
+static void
+TelemDecPayloadFill(uint8_t *pui8Payload, uint32_t ui32Size,
+                    uint32_t ui32Sequence)
+{
+    uint32_t ui32Idx;
+
+    for(ui32Idx = 0; ui32Idx < ui32Size; ui32Idx++)
+    {
+        pui8Payload[ui32Idx] = (uint8_t)((ui32Sequence * 31) + ui32Idx);
+    }
+}
+
+static void
+TelemDecLoopCheck(void *pvArg, uint32_t ui32Type, uint32_t ui32Sequence,
+                  const uint8_t *pui8Payload, uint32_t ui32Size)
+{
+    tTelemDecLoop *psLoop;
+    uint8_t pui8Expect[TELEMETRY_MAX_PAYLOAD];
+
+    psLoop = pvArg;
+    TelemDecPayloadFill(pui8Expect, ui32Size, ui32Sequence);
+    if((ui32Type != TELEMETRY_TYPE_SIGNALS) ||
+       memcmp(pui8Payload, pui8Expect, ui32Size))
+    {
+        psLoop->ui32Bad++;
+    }
+    psLoop->ui32Frames++;
+}
+
+//*****************************************************************************
+//
+// Runs the loopback, returning the exit status.
+//
+//*****************************************************************************
+static int
+TelemDecLoopback(void)
+{
+    static uint8_t pui8Ring[TELEMDEC_RING_SIZE];
+    uint8_t pui8Payload[TELEMETRY_MAX_PAYLOAD], pui8Line[TELEMDEC_RING_SIZE];
+    tTelemetry sTelemetry;
+    tTelemetryDecoder sDecoder;
+    tTelemDecLoop sLoop;
+    const uint8_t *pui8Span;
+    uint32_t ui32Sent, ui32Size, ui32Span, ui32Corrupted;
+
+    srand(1);
+    TelemetryInit(&sTelemetry, pui8Ring, sizeof(pui8Ring));
+    memset(&sLoop, 0, sizeof(sLoop));
+    TelemetryDecoderInit(&sDecoder, TelemDecLoopCheck, &sLoop);
+    ui32Sent = 0;
+    ui32Corrupted = 0;
+
+    while(ui32Sent < TELEMDEC_LOOP_FRAMES)
+    {
+        //
+        // Queue frames of random size until one does not fit.
+        //
+        do
+        {
+            ui32Size = rand() % (TELEMETRY_MAX_PAYLOAD + 1);
+            TelemDecPayloadFill(pui8Payload, ui32Size,
+                                sTelemetry.ui8Sequence);
+            ui32Sent++;
+        }
+        while(TelemetrySend(&sTelemetry, TELEMETRY_TYPE_SIGNALS, pui8Payload,
+                            ui32Size) &&
+              (ui32Sent < TELEMDEC_LOOP_FRAMES));
+
+        //
+        // Send a random part of the contiguous span, as one transfer.  One
+        // transfer in fifty has a bit flipped on the line.
+        //
+        ui32Span = RingReadSpanGet(&sTelemetry.sRing, &pui8Span);
+        if(ui32Span == 0)
+        {
+            continue;
+        }
+        ui32Span = 1 + (rand() % ui32Span);
+        memcpy(pui8Line, pui8Span, ui32Span);
+        RingReadCommit(&sTelemetry.sRing, ui32Span);
+        if((rand() % 50) == 0)
+        {
+            pui8Line[rand() % ui32Span] ^= 1 << (rand() % 8);
+            ui32Corrupted++;
+        }
+        TelemetryDecode(&sDecoder, pui8Line, ui32Span);
+    }
+
+    //
+    // Drain the queue.
+    //
+    while((ui32Span = RingReadSpanGet(&sTelemetry.sRing, &pui8Span)) != 0)
+    {
+        TelemetryDecode(&sDecoder, pui8Span, ui32Span);
+        RingReadCommit(&sTelemetry.sRing, ui32Span);
+    }
+
+    printf("offered %u, queued %u, dropped %u\n", ui32Sent,
+           sTelemetry.ui32Frames, sTelemetry.ui32Dropped);
+    printf("decoded %u, bad %u, crc errors %u, lost %u, skipped %u bytes, "
+           "%u bit errors injected\n", sDecoder.ui32Frames, sLoop.ui32Bad,
+           sDecoder.ui32CRCErrors, sDecoder.ui32Lost, sDecoder.ui32Skipped,
+           ui32Corrupted);
+
+    //
+    // Every frame offered is either decoded or counted as lost, and only
+    // the corrupted transfers may lose queued frames.
+    //
+    if((sLoop.ui32Bad != 0) ||
+       ((sDecoder.ui32Frames + sDecoder.ui32Lost) > ui32Sent) ||
+       ((sTelemetry.ui32Frames - sDecoder.ui32Frames) >
+        (2 * ui32Corrupted)))
+    {
+        printf("FAIL\n");
+        return(1);
+    }
+    printf("PASS\n");
+    return(0);
+}
+
+//*****************************************************************************
+//
+// Checks and measures the CRC routines, and measures the ring, returning the
+// exit status.
+//
+//*****************************************************************************
+static int
+TelemDecCRCBenchmark(void)
+{
+    static uint8_t pui8Data[TELEMDEC_CRC_SIZE + 8];
+    static uint8_t pui8Ring[TELEMDEC_RING_SIZE];
+    uint32_t pui32Span[2] = { 1, TELEMDEC_RING_SPAN };
+    uint32_t ui32Check, ui32Offset, ui32Size, ui32Seed, ui32Bad, ui32CRC;
+    uint32_t ui32Cost;
+
+    //
+    // The bytewise routines read a byte past the end of an empty buffer at
+    // an odd address, so every check covers at least one byte.
+    //
+    srand(1);
+    for(ui32Check = 0; ui32Check < sizeof(pui8Data); ui32Check++)
+    {
+        pui8Data[ui32Check] = (uint8_t)rand();
+    }
+    ui32Bad = 0;
+    for(ui32Check = 0; ui32Check < TELEMDEC_CRC_CHECKS; ui32Check++)
+    {
+        ui32Offset = rand() % 8;
+        ui32Size = 1 + (rand() % TELEMDEC_CRC_SIZE);
+        ui32Seed = (uint32_t)rand() ^ ((uint32_t)rand() << 16);
+        if((Crc16((uint16_t)ui32Seed, &pui8Data[ui32Offset], ui32Size) !=
+            Crc16Slice4((uint16_t)ui32Seed, &pui8Data[ui32Offset],
+                        ui32Size)) ||
+           (Crc32(ui32Seed, &pui8Data[ui32Offset], ui32Size) !=
+            Crc32Slice8(ui32Seed, &pui8Data[ui32Offset], ui32Size)))
+        {
+            ui32Bad++;
+        }
+    }
+    printf("%u checks, %u mismatches\n", TELEMDEC_CRC_CHECKS, ui32Bad);
+
+    for(ui32CRC = 0; ui32CRC < TELEMETRY_NUM_CRCS; ui32CRC++)
+    {
+        ui32Cost = TelemetryCRCBenchmark(ui32CRC, pui8Data,
+                                         TELEMDEC_CRC_SIZE);
+        printf("%-12s %6u ns/KB, %.3f bytes/ns\n",
+               g_ppcTelemDecCRCs[ui32CRC], ui32Cost,
+               ui32Cost ? (1024.0 / ui32Cost) : 0.0);
+    }
+    for(ui32Check = 0; ui32Check < 2; ui32Check++)
+    {
+        ui32Cost = RingBenchmark(pui8Ring, sizeof(pui8Ring), pui8Data,
+                                 pui32Span[ui32Check]);
+        printf("ring %-7u %6u ns/KB, %.3f bytes/ns\n", pui32Span[ui32Check],
+               ui32Cost, ui32Cost ? (1024.0 / ui32Cost) : 0.0);
+    }
+
+    if(ui32Bad != 0)
+    {
+        printf("FAIL\n");
+        return(1);
+    }
+    printf("PASS\n");
+    return(0);
+}
+
+//*****************************************************************************
+//
+// Puts a serial port into raw mode at a line rate.
+//
+//*****************************************************************************
+static bool
+TelemDecPortSet(int iFD, uint32_t ui32Baud)
+{
+    struct termios sTerm;
+    speed_t sSpeed;
+
+    switch(ui32Baud)
+    {
+        case 115200: sSpeed = B115200; break;
+        case 230400: sSpeed = B230400; break;
+        case 460800: sSpeed = B460800; break;
+        case 921600: sSpeed = B921600; break;
+        default: return(false);
+    }
+
+    if(tcgetattr(iFD, &sTerm) != 0)
+    {
+        return(false);
+    }
+    cfmakeraw(&sTerm);
+    cfsetispeed(&sTerm, sSpeed);
+    cfsetospeed(&sTerm, sSpeed);
+    return(tcsetattr(iFD, TCSANOW, &sTerm) == 0);
+}
+
+//*****************************************************************************
+//
+// Decodes a capture or a serial port.
+//
+//*****************************************************************************
+int
+main(int argc, char *argv[])
+{
+    static tTelemetryDecoder sDecoder;
+    uint8_t pui8Data[4096];
+    uint32_t ui32Baud;
+    ssize_t iCount;
+    int iFD;
+
+    if((argc == 2) && !strcmp(argv[1], "-l"))
+    {
+        return(TelemDecLoopback());
+    }
+    if((argc == 2) && !strcmp(argv[1], "-b"))
+    {
+        return(TelemDecCRCBenchmark());
+    }
+    if((argc != 2) && (argc != 3))
+    {
+        fprintf(stderr, "usage: %s -l | -b | port-or-capture [baud]\n",
+                argv[0]);
+        return(2);
+    }
+
+    iFD = open(argv[1], O_RDONLY | O_NOCTTY);
+    if(iFD < 0)
+    {
+        perror(argv[1]);
+        return(1);
+    }
+    ui32Baud = (argc == 3) ? (uint32_t)strtoul(argv[2], 0, 0) : 921600;
+    if(isatty(iFD) && !TelemDecPortSet(iFD, ui32Baud))
+    {
+        fprintf(stderr, "%s: cannot set %u baud\n", argv[1], ui32Baud);
+        return(1);
+    }
+
+    TelemetryDecoderInit(&sDecoder, TelemDecPrint, 0);
+    while((iCount = read(iFD, pui8Data, sizeof(pui8Data))) > 0)
+    {
+        TelemetryDecode(&sDecoder, pui8Data, (uint32_t)iCount);
+        fflush(stdout);
+    }
+    close(iFD);
+
+    fprintf(stderr, "%u frames, %u crc errors, %u lost, %u bytes skipped\n",
+            sDecoder.ui32Frames, sDecoder.ui32CRCErrors, sDecoder.ui32Lost,
+            sDecoder.ui32Skipped);
+
+    return(0);
+}
@@ -0,0 +1,312 @@
+//*****************************************************************************
+//
+// wav_file.c - Host memory-mapped WAV reader and writer.
+//
+// The offline tools feed field recordings through the same engine that runs
+// on the target.  Reading them with stdio copies every byte from the page
+// cache into the stdio buffer and again into the caller's; mapping the file
+// instead lets the engine read the samples where the kernel already holds
+// them.  The header is parsed in the mapping with the target's parser.
+//
+// The writer preallocates the output file at its largest possible size and
+// maps it with its pages faulted in, so the engine writes its output in
+// place without a fault per fresh page, and the kernel writes the pages back
+// in large runs.  Closing the writer fills in the header and
+// cuts the file to the frames written.
+//
+// These use POSIX file mapping and build only for the host.
+//
+//*****************************************************************************
+
+#define _FILE_OFFSET_BITS       64
+#define _POSIX_C_SOURCE         200809L
+#define _DEFAULT_SOURCE
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "wav_riff.h"
+#include "wav_file.h"
+
+//*****************************************************************************
+//
+//! \addtogroup wav_file_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The size of the canonical header written by the writer.
+//
+//*****************************************************************************
+#define WAV_FILE_HEADER_SIZE    44
+
+//*****************************************************************************
+//
+// The flag that has mmap() fault in the whole writer mapping up front, where
+// the system has one.
+//
+//*****************************************************************************
+#ifdef MAP_POPULATE
+#define WAV_FILE_MAP_POPULATE   MAP_POPULATE
+#else
+#define WAV_FILE_MAP_POPULATE   0
+#endif
+
+//*****************************************************************************
+//
+// Writes little-endian fields to a byte buffer.
+//
+//*****************************************************************************
+static void
+WavFileWrite16(uint8_t *pui8Data, uint32_t ui32Value)
+{
+    pui8Data[0] = (uint8_t)ui32Value;
+    pui8Data[1] = (uint8_t)(ui32Value >> 8);
+}
+
+static void
+WavFileWrite32(uint8_t *pui8Data, uint32_t ui32Value)
+{
+    WavFileWrite16(pui8Data, ui32Value);
+    WavFileWrite16(pui8Data + 2, ui32Value >> 16);
+}
+
+//*****************************************************************************
+//
+//! Maps a WAV file for reading.
+//!
+//! \param psFile is a pointer to the file state.
+//! \param pcPath is the path of the file.
+//!
+//! The whole file is mapped read-only, with the kernel told to read ahead,
+//! and its header is parsed in place.
+//!
+//! \return Returns \b true on success or \b false if the file could not be
+//! mapped or is not a WAV file that WavRiffParse() accepts.
+//
+//*****************************************************************************
+bool
+WavFileOpen(tWavFile *psFile, const char *pcPath)
+{
+    struct stat sStat;
+    void *pvMap;
+    int iFD;
+
+    iFD = open(pcPath, O_RDONLY);
+    if(iFD < 0)
+    {
+        return(false);
+    }
+    if((fstat(iFD, &sStat) != 0) || (sStat.st_size == 0) ||
+       ((uint64_t)sStat.st_size > 0xffffffff))
+    {
+        close(iFD);
+        return(false);
+    }
+
+    pvMap = mmap(0, (size_t)sStat.st_size, PROT_READ, MAP_SHARED, iFD, 0);
+    close(iFD);
+    if(pvMap == MAP_FAILED)
+    {
+        return(false);
+    }
+    madvise(pvMap, (size_t)sStat.st_size, MADV_SEQUENTIAL);
+
+    psFile->pui8Map = pvMap;
+    psFile->sMapSize = (size_t)sStat.st_size;
+    if(WavRiffParse(psFile->pui8Map, (uint32_t)psFile->sMapSize,
+                    &psFile->sInfo) != WAV_RIFF_OK)
+    {
+        WavFileClose(psFile);
+        return(false);
+    }
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Returns one channel of a mapped file.
+//!
+//! \param psFile is a pointer to the file state.
+//! \param ui32Channel is the channel, counted from 0 in the file's order.
+//! \param psSpan is a pointer to the structure that receives the samples.
+//!
+//! The span covers the whole frames of the data chunk that are in the file,
+//! which may be fewer than the header claims if the recording was cut short.
+//! The caller chooses the channels it needs by their position; in a
+//! recording made by wav_rec.c, for example, they are the primary input,
+//! the noise reference and the canceller's output.
+//!
+//! \return Returns \b true on success or \b false if the file does not have
+//! the channel.
+//
+//*****************************************************************************
+bool
+WavFileSpanGet(tWavFile *psFile, uint32_t ui32Channel, tWavSpan *psSpan)
+{
+    if(ui32Channel >= psFile->sInfo.ui32Channels)
+    {
+        return(false);
+    }
+
+    psSpan->pvData = psFile->sInfo.pui8Data;
+    psSpan->ui32Frames = (psFile->sInfo.ui32DataInBuffer /
+                          psFile->sInfo.ui32FrameBytes);
+    psSpan->ui32Channels = psFile->sInfo.ui32Channels;
+    psSpan->pi16Data = (((psFile->sInfo.ui32Format == WAV_FORMAT_PCM) &&
+                         (psFile->sInfo.ui32Bits == 16)) ?
+                        ((const int16_t *)psFile->sInfo.pui8Data +
+                         ui32Channel) : 0);
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Unmaps a file opened with WavFileOpen().
+//!
+//! \param psFile is a pointer to the file state.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+WavFileClose(tWavFile *psFile)
+{
+    munmap((void *)psFile->pui8Map, psFile->sMapSize);
+    psFile->pui8Map = 0;
+}
+
+//*****************************************************************************
+//
+//! Creates a 16-bit PCM WAV file mapped for writing.
+//!
+//! \param psWriter is a pointer to the writer state.
+//! \param pcPath is the path of the file, which is replaced if it exists.
+//! \param ui32Rate is the sample rate in Hz.
+//! \param ui32Channels is the number of channels.
+//! \param ui32MaxFrames is the most frames that will be written.
+//!
+//! The file's blocks are allocated up front, so the writes through the
+//! mapping cannot fail for lack of space later, and the mapping is faulted
+//! in where mmap() can do so.
+//!
+//! \return Returns \b true on success or \b false if the file could not be
+//! created, allocated or mapped.
+//
+//*****************************************************************************
+bool
+WavWriterOpen(tWavWriter *psWriter, const char *pcPath, uint32_t ui32Rate,
+              uint32_t ui32Channels, uint32_t ui32MaxFrames)
+{
+    void *pvMap;
+
+    psWriter->ui32Rate = ui32Rate;
+    psWriter->ui32Channels = ui32Channels;
+    psWriter->ui32MaxFrames = ui32MaxFrames;
+    psWriter->sMapSize = (WAV_FILE_HEADER_SIZE +
+                          ((size_t)ui32MaxFrames * 2 * ui32Channels));
+
+    psWriter->iFD = open(pcPath, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(psWriter->iFD < 0)
+    {
+        return(false);
+    }
+    if(posix_fallocate(psWriter->iFD, 0, (off_t)psWriter->sMapSize) != 0)
+    {
+        close(psWriter->iFD);
+        return(false);
+    }
+
+    pvMap = mmap(0, psWriter->sMapSize, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | WAV_FILE_MAP_POPULATE, psWriter->iFD, 0);
+    if(pvMap == MAP_FAILED)
+    {
+        close(psWriter->iFD);
+        return(false);
+    }
+    psWriter->pui8Map = pvMap;
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Returns where the samples of a writer go.
+//!
+//! \param psWriter is a pointer to the writer state.
+//!
+//! \return Returns a pointer to room for \e ui32MaxFrames interleaved frames
+//! of 16-bit samples.
+//
+//*****************************************************************************
+int16_t *
+WavWriterDataGet(tWavWriter *psWriter)
+{
+    return((int16_t *)(psWriter->pui8Map + WAV_FILE_HEADER_SIZE));
+}
+
+//*****************************************************************************
+//
+//! Finishes a file created with WavWriterOpen().
+//!
+//! \param psWriter is a pointer to the writer state.
+//! \param ui32Frames is the number of frames written.
+//!
+//! The header is written, the mapping released and the file cut to its
+//! final size.
+//!
+//! \return Returns \b true on success or \b false if the file could not be
+//! cut to size.
+//
+//*****************************************************************************
+bool
+WavWriterClose(tWavWriter *psWriter, uint32_t ui32Frames)
+{
+    uint8_t *pui8Header;
+    uint32_t ui32DataSize;
+    bool bOK;
+
+    if(ui32Frames > psWriter->ui32MaxFrames)
+    {
+        ui32Frames = psWriter->ui32MaxFrames;
+    }
+    ui32DataSize = ui32Frames * 2 * psWriter->ui32Channels;
+
+    pui8Header = psWriter->pui8Map;
+    memcpy(&pui8Header[0], "RIFF", 4);
+    WavFileWrite32(&pui8Header[4], WAV_FILE_HEADER_SIZE - 8 + ui32DataSize);
+    memcpy(&pui8Header[8], "WAVEfmt ", 8);
+    WavFileWrite32(&pui8Header[16], 16);
+    WavFileWrite16(&pui8Header[20], WAV_FORMAT_PCM);
+    WavFileWrite16(&pui8Header[22], psWriter->ui32Channels);
+    WavFileWrite32(&pui8Header[24], psWriter->ui32Rate);
+    WavFileWrite32(&pui8Header[28],
+                   psWriter->ui32Rate * 2 * psWriter->ui32Channels);
+    WavFileWrite16(&pui8Header[32], 2 * psWriter->ui32Channels);
+    WavFileWrite16(&pui8Header[34], 16);
+    memcpy(&pui8Header[36], "data", 4);
+    WavFileWrite32(&pui8Header[40], ui32DataSize);
+
+    munmap(psWriter->pui8Map, psWriter->sMapSize);
+    bOK = (ftruncate(psWriter->iFD,
+                     (off_t)(WAV_FILE_HEADER_SIZE + ui32DataSize)) == 0);
+    close(psWriter->iFD);
+
+    return(bOK);
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
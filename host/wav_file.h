@@ -0,0 +1,94 @@
+//*****************************************************************************
+//
+// wav_file.h - Prototypes for the host memory-mapped WAV reader and writer.
+//
+//*****************************************************************************
+
+#ifndef __WAV_FILE_H__
+#define __WAV_FILE_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// A WAV file mapped for reading.  The layout is found in the mapping itself,
+// so sInfo.pui8Data points straight at the samples in the page cache.
+//
+//*****************************************************************************
+typedef struct
+{
+    const uint8_t *pui8Map;
+    size_t sMapSize;
+    tWavInfo sInfo;
+}
+tWavFile;
+
+//*****************************************************************************
+//
+// One channel of a file as the engine consumes it.  pi16Data points to the
+// channel's first sample, and the next is ui32Channels samples on; it is set
+// only for 16-bit integer PCM, the format the canceller takes directly, and
+// is 0 otherwise.  pvData, the start of the frames, is always set.
+//
+//*****************************************************************************
+typedef struct
+{
+    const void *pvData;
+    const int16_t *pi16Data;
+    uint32_t ui32Frames;
+    uint32_t ui32Channels;
+}
+tWavSpan;
+
+//*****************************************************************************
+//
+// A 16-bit PCM WAV file mapped for writing.  The file is preallocated for
+// ui32MaxFrames frames, filled through the mapping and cut to the frames
+// actually written when it is closed.
+//
+//*****************************************************************************
+typedef struct
+{
+    int iFD;
+    uint8_t *pui8Map;
+    size_t sMapSize;
+    uint32_t ui32Rate;
+    uint32_t ui32Channels;
+    uint32_t ui32MaxFrames;
+}
+tWavWriter;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern bool WavFileOpen(tWavFile *psFile, const char *pcPath);
+extern bool WavFileSpanGet(tWavFile *psFile, uint32_t ui32Channel,
+                           tWavSpan *psSpan);
+extern void WavFileClose(tWavFile *psFile);
+extern bool WavWriterOpen(tWavWriter *psWriter, const char *pcPath,
+                          uint32_t ui32Rate, uint32_t ui32Channels,
+                          uint32_t ui32MaxFrames);
+extern int16_t *WavWriterDataGet(tWavWriter *psWriter);
+extern bool WavWriterClose(tWavWriter *psWriter, uint32_t ui32Frames);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __WAV_FILE_H__
@@ -0,0 +1,312 @@
+//*****************************************************************************
+//
+// wavbench.c - Offline canceller run comparing stdio and mapped WAV I/O.
+//
+// Runs a 16-bit recording through the canceller, the first channel as the
+// primary input and the second as the noise reference, and writes the mono
+// output.  A stereo line capture qualifies, as does a field recording made
+// by wav_rec.c, whose third channel, the board's output, is ignored.  The
+// run is made twice per pass: once reading and writing with buffered stdio,
+// and once through the mapped reader and writer in wav_file.c, which hand
+// the canceller the samples in the page cache and take its output in the
+// output file's pages.  The best of several passes of each is reported.
+//
+// With -n the canceller is skipped and the primary channel copied to the
+// output, which leaves only the I/O cost to compare.
+//
+// Both runs read a file the first pass has already brought into the page
+// cache, so the figures compare the copies the two paths make rather than
+// the disk.  In both the canceller reads its inputs where they lie and
+// writes its output straight into the stdio buffer or the mapped file, and
+// the mapped output is faulted in before the run.  Even so the two come out
+// within a few percent of each other, either way round, so the tools keep
+// stdio for their output and the mapped writer serves this comparison.
+//
+// Build from this directory with, on one line:
+//
+//     cc -O2 -I.. -o wavbench wavbench.c wav_file.c ../wav_riff.c ../anc.c
+//        ../perf.c
+//
+//*****************************************************************************
+
+#define _FILE_OFFSET_BITS       64
+#define _POSIX_C_SOURCE         200809L
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "anc.h"
+#include "wav_riff.h"
+#include "wav_file.h"
+
+//*****************************************************************************
+//
+// The number of passes of each run, and the number of frames stdio reads and
+// writes per call.
+//
+//*****************************************************************************
+#define WAVBENCH_PASSES         5
+#define WAVBENCH_STDIO_FRAMES   4096
+
+//*****************************************************************************
+//
+// The canceller shared by both runs, and whether it is skipped.
+//
+//*****************************************************************************
+static tANCState g_sANC;
+static bool g_bBypass;
+
+//*****************************************************************************
+//
+// Returns a monotonic time in nanoseconds.
+//
+//*****************************************************************************
+static uint64_t
+WavBenchTimeGet(void)
+{
+    struct timespec sTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &sTime);
+    return(((uint64_t)sTime.tv_sec * 1000000000) + sTime.tv_nsec);
+}
+
+//*****************************************************************************
+//
+// Runs ui32Blocks blocks of interleaved frames through the canceller,
+// writing one mono sample per frame to pi16Out.  The primary and reference
+// samples of consecutive frames are ui32Stride samples apart.  The canceller
+// reads them where they are and writes straight to pi16Out.
+//
+//*****************************************************************************
+static void
+WavBenchProcess(const int16_t *pi16Primary, const int16_t *pi16Ref,
+                uint32_t ui32Stride, int16_t *pi16Out, uint32_t ui32Blocks)
+{
+    uint32_t ui32Idx;
+
+    while(ui32Blocks--)
+    {
+        if(g_bBypass)
+        {
+            for(ui32Idx = 0; ui32Idx < ANC_FRAME_SIZE; ui32Idx++)
+            {
+                pi16Out[ui32Idx] = pi16Primary[ui32Idx * ui32Stride];
+            }
+        }
+        else
+        {
+            ANCProcessFrameQ15Strided(&g_sANC, pi16Primary, pi16Ref,
+                                      ui32Stride, pi16Out);
+        }
+
+        pi16Primary += ANC_FRAME_SIZE * ui32Stride;
+        pi16Ref += ANC_FRAME_SIZE * ui32Stride;
+        pi16Out += ANC_FRAME_SIZE;
+    }
+}
+
+//*****************************************************************************
+//
+// Runs a file through the canceller with buffered stdio, returning the
+// elapsed time in nanoseconds or 0 on error.
+//
+//*****************************************************************************
+static uint64_t
+WavBenchStdio(const char *pcIn, const char *pcOut, const tWavInfo *psInfo,
+              uint32_t ui32Frames)
+{
+    static int16_t pi16In[WAV_MAX_CHANNELS * WAVBENCH_STDIO_FRAMES];
+    static int16_t pi16Out[WAVBENCH_STDIO_FRAMES];
+    uint8_t pui8Header[44];
+    uint32_t ui32Count;
+    uint64_t ui64Start;
+    FILE *psIn, *psOut;
+
+    ui64Start = WavBenchTimeGet();
+
+    psIn = fopen(pcIn, "rb");
+    psOut = fopen(pcOut, "wb");
+    if(!psIn || !psOut || fseek(psIn, psInfo->ui32DataOffset, SEEK_SET))
+    {
+        if(psIn)
+        {
+            fclose(psIn);
+        }
+        if(psOut)
+        {
+            fclose(psOut);
+        }
+        return(0);
+    }
+
+    //
+    // The header is only a placeholder; the output is compared by its
+    // samples.
+    //
+    memset(pui8Header, 0, sizeof(pui8Header));
+    fwrite(pui8Header, 1, sizeof(pui8Header), psOut);
+
+    ANCInit(&g_sANC, ANC_MODE_Q15);
+    while(ui32Frames)
+    {
+        ui32Count = ((ui32Frames < WAVBENCH_STDIO_FRAMES) ? ui32Frames :
+                     WAVBENCH_STDIO_FRAMES);
+        if(fread(pi16In, psInfo->ui32FrameBytes, ui32Count, psIn) !=
+           ui32Count)
+        {
+            break;
+        }
+        WavBenchProcess(&pi16In[0], &pi16In[1], psInfo->ui32Channels,
+                        pi16Out, ui32Count / ANC_FRAME_SIZE);
+        fwrite(pi16Out, 2, ui32Count, psOut);
+        ui32Frames -= ui32Count;
+    }
+
+    fclose(psIn);
+    fclose(psOut);
+
+    return(WavBenchTimeGet() - ui64Start);
+}
+
+//*****************************************************************************
+//
+// Runs a file through the canceller with the mapped reader and writer,
+// returning the elapsed time in nanoseconds or 0 on error.
+//
+//*****************************************************************************
+static uint64_t
+WavBenchMapped(const char *pcIn, const char *pcOut, uint32_t ui32Frames)
+{
+    tWavFile sFile;
+    tWavWriter sWriter;
+    tWavSpan sPrimary, sRef;
+    uint64_t ui64Start;
+
+    ui64Start = WavBenchTimeGet();
+
+    if(!WavFileOpen(&sFile, pcIn))
+    {
+        return(0);
+    }
+    if(!WavFileSpanGet(&sFile, 0, &sPrimary) ||
+       !WavFileSpanGet(&sFile, 1, &sRef) ||
+       !WavWriterOpen(&sWriter, pcOut, sFile.sInfo.ui32Rate, 1, ui32Frames))
+    {
+        WavFileClose(&sFile);
+        return(0);
+    }
+
+    ANCInit(&g_sANC, ANC_MODE_Q15);
+    WavBenchProcess(sPrimary.pi16Data, sRef.pi16Data, sPrimary.ui32Channels,
+                    WavWriterDataGet(&sWriter), ui32Frames / ANC_FRAME_SIZE);
+
+    WavWriterClose(&sWriter, ui32Frames);
+    WavFileClose(&sFile);
+
+    return(WavBenchTimeGet() - ui64Start);
+}
+
+//*****************************************************************************
+//
+// Prints the best time of a run.
+//
+//*****************************************************************************
+static void
+WavBenchReport(const char *pcName, uint64_t ui64Best, uint32_t ui32Frames,
+               uint32_t ui32FrameBytes)
+{
+    printf("%-6s %10.3f ms %8.2f ns/frame %9.1f MB/s\n", pcName,
+           (double)ui64Best / 1e6, (double)ui64Best / ui32Frames,
+           ((double)ui32Frames * ui32FrameBytes * 1e3) / (double)ui64Best);
+}
+
+//*****************************************************************************
+//
+// Compares the stdio and the mapped runs over a recording.
+//
+//*****************************************************************************
+int
+main(int argc, char *argv[])
+{
+    tWavFile sFile;
+    tWavInfo sInfo;
+    uint64_t ui64Time, ui64Stdio, ui64Mapped;
+    uint32_t ui32Frames, ui32Pass;
+    char pcOut[2][512];
+    int iArg;
+
+    iArg = 1;
+    if((argc > 1) && !strcmp(argv[1], "-n"))
+    {
+        g_bBypass = true;
+        iArg++;
+    }
+    if(argc - iArg != 2)
+    {
+        fprintf(stderr, "usage: %s [-n] in.wav out-prefix\n", argv[0]);
+        return(2);
+    }
+
+    //
+    // Check the recording is one the canceller takes directly.
+    //
+    if(!WavFileOpen(&sFile, argv[iArg]))
+    {
+        fprintf(stderr, "%s: not a readable WAV file\n", argv[iArg]);
+        return(1);
+    }
+    sInfo = sFile.sInfo;
+    ui32Frames = sInfo.ui32DataInBuffer / sInfo.ui32FrameBytes;
+    ui32Frames -= ui32Frames % WAVBENCH_STDIO_FRAMES;
+    WavFileClose(&sFile);
+    if((sInfo.ui32Format != WAV_FORMAT_PCM) || (sInfo.ui32Bits != 16) ||
+       (sInfo.ui32Channels < 2) || (ui32Frames == 0))
+    {
+        fprintf(stderr, "%s: need 16-bit PCM of two or more channels and at "
+                "least %u frames\n", argv[iArg], WAVBENCH_STDIO_FRAMES);
+        return(1);
+    }
+
+    snprintf(pcOut[0], sizeof(pcOut[0]), "%s-stdio.wav", argv[iArg + 1]);
+    snprintf(pcOut[1], sizeof(pcOut[1]), "%s-mmap.wav", argv[iArg + 1]);
+
+    //
+    // Alternate the runs so that both see the same state of the page cache.
+    //
+    ui64Stdio = ui64Mapped = ~(uint64_t)0;
+    for(ui32Pass = 0; ui32Pass < WAVBENCH_PASSES; ui32Pass++)
+    {
+        ui64Time = WavBenchStdio(argv[iArg], pcOut[0], &sInfo, ui32Frames);
+        if(ui64Time == 0)
+        {
+            fprintf(stderr, "%s: stdio run failed\n", pcOut[0]);
+            return(1);
+        }
+        if(ui64Time < ui64Stdio)
+        {
+            ui64Stdio = ui64Time;
+        }
+
+        ui64Time = WavBenchMapped(argv[iArg], pcOut[1], ui32Frames);
+        if(ui64Time == 0)
+        {
+            fprintf(stderr, "%s: mapped run failed\n", pcOut[1]);
+            return(1);
+        }
+        if(ui64Time < ui64Mapped)
+        {
+            ui64Mapped = ui64Time;
+        }
+    }
+
+    printf("%u frames at %u Hz, canceller %s\n", ui32Frames, sInfo.ui32Rate,
+           g_bBypass ? "bypassed" : "running");
+    WavBenchReport("stdio", ui64Stdio, ui32Frames, sInfo.ui32FrameBytes);
+    WavBenchReport("mmap", ui64Mapped, ui32Frames, sInfo.ui32FrameBytes);
+
+    return(0);
+}
@@ -0,0 +1,210 @@
+//*****************************************************************************
+//
+// wavplay.c - Host run of the WAV player against a file-backed device.
+//
+// Plays a WAV file through wav_play.c as the board would, with the file as
+// the image of a card that holds it from block 0 (see block_file.c).  The
+// device is first measured with WavPlayBenchmark(), and WavPlayRateMax()
+// gives the highest sample rate it could feed, for the file's frames and
+// for 16-bit stereo.  The file is then played to the end a codec frame at
+// a time, the player refilled from the main loop between frames, and each
+// frame handed out is checked against the file read through wav_file.c.
+//
+// The figures are in nanoseconds of the host.  The first benchmark run
+// starts with the file dropped from the page cache, so on a disk it reads
+// the disk; the rest read the cache and show the cost of the player's
+// device calls alone.  A card's figures come from running the benchmark on
+// the board with its driver.
+//
+// With -c the given file channels play on the left and the right, e.g. -c 0
+// 2 for the primary input and the output of a recording made by wav_rec.c.
+//
+// Build from this directory with, on one line:
+//
+//     cc -O2 -I.. -o wavplay wavplay.c block_file.c wav_file.c ../wav_play.c
+//        ../wav_riff.c ../ring.c ../perf.c
+//
+//*****************************************************************************
+
+#define _POSIX_C_SOURCE         200809L
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "ring.h"
+#include "wav_riff.h"
+#include "wav_play.h"
+#include "anc.h"
+#include "audio_in.h"
+#include "block_file.h"
+#include "wav_file.h"
+
+//*****************************************************************************
+//
+// The number of benchmark runs.  The best worst-case burst of the runs
+// from the page cache is reported, as the other figures in the tree report
+// the best of several runs.
+//
+//*****************************************************************************
+#define WAVPLAY_RUNS            8
+
+//*****************************************************************************
+//
+// Returns a monotonic time in nanoseconds.
+//
+//*****************************************************************************
+static uint64_t
+WavPlayTimeGet(void)
+{
+    struct timespec sTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &sTime);
+    return(((uint64_t)sTime.tv_sec * 1000000000) + sTime.tv_nsec);
+}
+
+//*****************************************************************************
+//
+// Plays a file and checks it, returning the exit status.
+//
+//*****************************************************************************
+int
+main(int argc, char *argv[])
+{
+    static tWavPlayer sPlayer;
+    static uint8_t pui8Scratch[WAV_PLAY_BURST * WAV_BLOCK_SIZE];
+    int16_t pi16Out[2 * AUDIO_FRAME_SIZE];
+    tBlockFile sDev;
+    tWavFile sFile;
+    tWavSpan sLeft, sRight;
+    uint32_t ui32Left, ui32Right, ui32Run, ui32Cost, ui32Cold, ui32Best;
+    uint32_t ui32Frames;
+    uint32_t ui32Got, ui32Idx, ui32Bad;
+    uint64_t ui64Start, ui64Time;
+    int iArg;
+
+    ui32Left = 0;
+    ui32Right = 1;
+    iArg = 1;
+    if((argc == 5) && !strcmp(argv[1], "-c"))
+    {
+        ui32Left = (uint32_t)strtoul(argv[2], 0, 0);
+        ui32Right = (uint32_t)strtoul(argv[3], 0, 0);
+        iArg = 4;
+    }
+    else if(argc != 2)
+    {
+        fprintf(stderr, "usage: %s [-c left right] file.wav\n", argv[0]);
+        return(2);
+    }
+
+    if(!BlockFileOpen(&sDev, argv[iArg]) ||
+       !WavPlayOpen(&sPlayer, BlockFileRead, &sDev, 0) ||
+       !WavFileOpen(&sFile, argv[iArg]))
+    {
+        fprintf(stderr, "%s: cannot open\n", argv[iArg]);
+        return(1);
+    }
+    if(sPlayer.sInfo.ui32Channels == 1)
+    {
+        ui32Right = 0;
+    }
+    if(!WavPlayChannelsSet(&sPlayer, ui32Left, ui32Right) ||
+       !WavFileSpanGet(&sFile, ui32Left, &sLeft) ||
+       !WavFileSpanGet(&sFile, ui32Right, &sRight))
+    {
+        fprintf(stderr, "%s: has no channels %u and %u\n", argv[iArg],
+                ui32Left, ui32Right);
+        return(1);
+    }
+
+    //
+    // Measure the device from the start of the file, first uncached.
+    //
+    fsync(sDev.iFD);
+    posix_fadvise(sDev.iFD, 0, 0, POSIX_FADV_DONTNEED);
+    ui32Cold = WavPlayBenchmark(BlockFileRead, &sDev, 0, pui8Scratch);
+    ui32Best = 0;
+    for(ui32Run = 1; ui32Run < WAVPLAY_RUNS; ui32Run++)
+    {
+        ui32Cost = WavPlayBenchmark(BlockFileRead, &sDev, 0, pui8Scratch);
+        if((ui32Run == 1) || (ui32Cost < ui32Best))
+        {
+            ui32Best = ui32Cost;
+        }
+    }
+    printf("%u channels of %u bits at %u Hz, %u frames\n",
+           sPlayer.sInfo.ui32Channels, sPlayer.sInfo.ui32Bits,
+           sPlayer.sInfo.ui32Rate,
+           sPlayer.sInfo.ui32DataSize / sPlayer.sInfo.ui32FrameBytes);
+    printf("burst of %u blocks, worst case: %u ns first, %u ns cached\n",
+           WAV_PLAY_BURST, ui32Cold, ui32Best);
+    printf("highest rate on the first: %u Hz for these frames, %u Hz for "
+           "16-bit stereo\n",
+           WavPlayRateMax(ui32Cold, sPlayer.sInfo.ui32FrameBytes,
+                          1000000000),
+           WavPlayRateMax(ui32Cold, 4, 1000000000));
+
+    //
+    // Play the file a codec frame at a time.  The main loop runs several
+    // times a frame, so the player is refilled twice between frames.
+    //
+    ui32Frames = 0;
+    ui32Bad = 0;
+    ui64Time = 0;
+    while(!WavPlayDone(&sPlayer))
+    {
+        if(!WavPlayService(&sPlayer) || !WavPlayService(&sPlayer))
+        {
+            fprintf(stderr, "%s: read failed\n", argv[iArg]);
+            return(1);
+        }
+
+        ui64Start = WavPlayTimeGet();
+        ui32Got = WavPlayFrameGet(&sPlayer, pi16Out, AUDIO_FRAME_SIZE);
+        ui64Time += WavPlayTimeGet() - ui64Start;
+
+        //
+        // Only 16-bit files can be checked sample for sample; the others
+        // are truncated on the way.
+        //
+        for(ui32Idx = 0; sLeft.pi16Data && (ui32Idx < ui32Got); ui32Idx++)
+        {
+            if((ui32Frames + ui32Idx >= sLeft.ui32Frames) ||
+               (pi16Out[2 * ui32Idx] !=
+                sLeft.pi16Data[(ui32Frames + ui32Idx) *
+                               sLeft.ui32Channels]) ||
+               (pi16Out[(2 * ui32Idx) + 1] !=
+                sRight.pi16Data[(ui32Frames + ui32Idx) *
+                                sRight.ui32Channels]))
+            {
+                ui32Bad++;
+            }
+        }
+        ui32Frames += ui32Got;
+    }
+
+    printf("played %u frames in %u device calls, %u underruns, "
+           "%.2f ns/frame converting\n", ui32Frames, sDev.ui32Calls,
+           sPlayer.ui32Underruns,
+           ui32Frames ? ((double)ui64Time / ui32Frames) : 0.0);
+    printf("%u mismatches%s\n", ui32Bad,
+           sLeft.pi16Data ? "" : " (not checked: not 16-bit PCM)");
+
+    WavFileClose(&sFile);
+    BlockFileClose(&sDev);
+
+    if((ui32Bad != 0) || (sPlayer.ui32Underruns != 0) ||
+       (ui32Frames != (sPlayer.sInfo.ui32DataSize /
+                       sPlayer.sInfo.ui32FrameBytes)))
+    {
+        printf("FAIL\n");
+        return(1);
+    }
+    printf("PASS\n");
+    return(0);
+}
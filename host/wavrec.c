@@ -0,0 +1,204 @@
+//*****************************************************************************
+//
+// wavrec.c - Host round trip through the WAV recorder.
+//
+// Records a session through wav_rec.c to a file-backed block device, as the
+// frame processor and the main loop would on the board, then reads the
+// file back with the parser and checks every sample of every channel.
+// Synthetic primary, reference and error signals stand in for the codec;
+// the frames arrive AUDIO_FRAME_SIZE at a time from a codec-style frame,
+// and the recorder is serviced after each.  The file is also parsed before
+// the recording is stopped, as a card pulled mid-session would be found.
+//
+// The file is left behind; it is the device image, a WAV file holding the
+// recording from its first block, and can be fed to wavbench.
+//
+// Build from this directory with, on one line:
+//
+//     cc -O2 -I.. -o wavrec wavrec.c block_file.c wav_file.c ../wav_rec.c
+//        ../wav_riff.c ../ring.c ../perf.c
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "ring.h"
+#include "wav_riff.h"
+#include "wav_rec.h"
+#include "anc.h"
+#include "audio_in.h"
+#include "block_file.h"
+#include "wav_file.h"
+
+//*****************************************************************************
+//
+// The sample rate and default length of the recording.
+//
+//*****************************************************************************
+#define WAVREC_RATE             44100
+#define WAVREC_SECONDS          10
+
+//*****************************************************************************
+//
+// Returns sample ui32N of channel ui32Channel of the synthetic recording:
+// ramps of different slopes, so a swapped or shifted channel shows.
+//
+//*****************************************************************************
+static int16_t
+WavRecSample(uint32_t ui32Channel, uint32_t ui32N)
+{
+    return((int16_t)((ui32N * (2 * ui32Channel + 1)) + (ui32Channel << 12)));
+}
+
+//*****************************************************************************
+//
+// Parses the header block of the device as the player would, returning the
+// data size found, or 0 if the file did not parse as a recording.
+//
+//*****************************************************************************
+static uint32_t
+WavRecParse(tBlockFile *psDev)
+{
+    uint8_t pui8Block[WAV_BLOCK_SIZE];
+    tWavInfo sInfo;
+
+    if(!BlockFileRead(psDev, 0, pui8Block, 1) ||
+       (WavRiffParse(pui8Block, WAV_BLOCK_SIZE, &sInfo) != WAV_RIFF_OK) ||
+       (sInfo.ui32Format != WAV_FORMAT_PCM) ||
+       (sInfo.ui32Channels != WAV_REC_CHANNELS) ||
+       (sInfo.ui32Rate != WAVREC_RATE) || (sInfo.ui32Bits != 16))
+    {
+        return(0);
+    }
+
+    return(sInfo.ui32DataSize);
+}
+
+//*****************************************************************************
+//
+// Records, reads back and checks.
+//
+//*****************************************************************************
+int
+main(int argc, char *argv[])
+{
+    static tWavRecorder sRec;
+    int16_t pi16In[2 * AUDIO_FRAME_SIZE], pi16Out[2 * AUDIO_FRAME_SIZE];
+    tBlockFile sDev;
+    tWavFile sFile;
+    tWavSpan sSpan;
+    uint32_t ui32Frames, ui32Blocks, ui32N, ui32Idx, ui32Channel, ui32Bad;
+    uint32_t ui32Partial;
+
+    if((argc != 2) && (argc != 3))
+    {
+        fprintf(stderr, "usage: %s file [seconds]\n", argv[0]);
+        return(2);
+    }
+    ui32Frames = ((argc == 3) ? (uint32_t)strtoul(argv[2], 0, 0) :
+                  WAVREC_SECONDS) * WAVREC_RATE;
+    ui32Frames -= ui32Frames % AUDIO_FRAME_SIZE;
+
+    //
+    // Allocate the header block and a block more than the samples need, so
+    // the recording ends short of the file's capacity as a stopped one does.
+    //
+    ui32Blocks = 2 + ((ui32Frames * WAV_REC_CHANNELS * 2) / WAV_BLOCK_SIZE);
+    if(!BlockFileCreate(&sDev, argv[1], ui32Blocks) ||
+       !WavRecStart(&sRec, BlockFileWrite, &sDev, 0, ui32Blocks,
+                    WAVREC_RATE))
+    {
+        fprintf(stderr, "%s: cannot start the recording\n", argv[1]);
+        return(1);
+    }
+
+    //
+    // Feed the recorder as the frame processor does, the primary input and
+    // the reference from the left and right of the codec frame and the
+    // error from the left of the output, and service it from the main loop.
+    //
+    ui32Partial = 0;
+    for(ui32N = 0; ui32N < ui32Frames; ui32N += AUDIO_FRAME_SIZE)
+    {
+        for(ui32Idx = 0; ui32Idx < AUDIO_FRAME_SIZE; ui32Idx++)
+        {
+            pi16In[2 * ui32Idx] = WavRecSample(0, ui32N + ui32Idx);
+            pi16In[(2 * ui32Idx) + 1] = WavRecSample(1, ui32N + ui32Idx);
+            pi16Out[2 * ui32Idx] = WavRecSample(2, ui32N + ui32Idx);
+            pi16Out[(2 * ui32Idx) + 1] = pi16Out[2 * ui32Idx];
+        }
+        WavRecFrameWrite(&sRec, &pi16In[0], &pi16In[1], &pi16Out[0], 2,
+                         AUDIO_FRAME_SIZE);
+        WavRecService(&sRec);
+
+        //
+        // Midway, the header still claims the whole file.
+        //
+        if((ui32N <= (ui32Frames / 2)) &&
+           ((ui32N + AUDIO_FRAME_SIZE) > (ui32Frames / 2)))
+        {
+            ui32Partial = WavRecParse(&sDev);
+        }
+    }
+    if(!WavRecStop(&sRec))
+    {
+        fprintf(stderr, "%s: cannot stop the recording\n", argv[1]);
+        return(1);
+    }
+    printf("recorded %u frames in %u device calls, %u dropped, "
+           "%u truncated, %u write errors, most buffered %u bytes\n",
+           ui32Frames, sDev.ui32Calls, sRec.ui32Dropped, sRec.ui32Truncated,
+           sRec.ui32WriteErrors, sRec.ui32MaxUsed);
+    printf("parsed mid-recording: %u bytes of %u, after: %u bytes\n",
+           ui32Partial, sRec.ui32Capacity, WavRecParse(&sDev));
+
+    //
+    // Read the file back through the host reader, which parses the whole
+    // file, and check each channel.
+    //
+    ui32Bad = 0;
+    if((ui32Partial != sRec.ui32Capacity) ||
+       (WavRecParse(&sDev) != (ui32Frames * WAV_REC_CHANNELS * 2)) ||
+       !WavFileOpen(&sFile, argv[1]))
+    {
+        ui32Bad++;
+    }
+    else
+    {
+        for(ui32Channel = 0; ui32Channel < WAV_REC_CHANNELS; ui32Channel++)
+        {
+            if(!WavFileSpanGet(&sFile, ui32Channel, &sSpan) ||
+               (sSpan.ui32Frames != ui32Frames))
+            {
+                ui32Bad++;
+                continue;
+            }
+            for(ui32N = 0; ui32N < ui32Frames; ui32N++)
+            {
+                if(sSpan.pi16Data[ui32N * sSpan.ui32Channels] !=
+                   WavRecSample(ui32Channel, ui32N))
+                {
+                    ui32Bad++;
+                }
+            }
+        }
+        if(WavFileSpanGet(&sFile, WAV_REC_CHANNELS, &sSpan))
+        {
+            ui32Bad++;
+        }
+        WavFileClose(&sFile);
+    }
+    BlockFileClose(&sDev);
+
+    printf("%u mismatches\n", ui32Bad);
+    if((ui32Bad != 0) || (sRec.ui32Dropped != 0) ||
+       (sRec.ui32Truncated != 0))
+    {
+        printf("FAIL\n");
+        return(1);
+    }
+    printf("PASS\n");
+    return(0);
+}
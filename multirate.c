@@ -0,0 +1,418 @@
+//*****************************************************************************
+//
+// multirate.c - Decimate-process-interpolate stage for the canceller.
+//
+// Hum and low-frequency noise only need a few kHz of bandwidth, so the
+// canceller can run at the codec rate divided by an integer factor.  Both
+// canceller inputs pass through a polyphase decimator and its output through
+// a polyphase interpolator, which divides the LMS cost by the factor.  The
+// anti-alias and anti-image filters cost MR_TAPS_PER_PHASE MACs per codec
+// sample and channel regardless of the factor.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "anc.h"
+#include "multirate.h"
+
+//*****************************************************************************
+//
+//! \addtogroup multirate_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The prototype low-pass filters, one per factor M.  Each has 8 * M taps,
+// designed as a Kaiser-windowed sinc (beta = 5.0) with its cutoff at 0.4 of
+// the low-rate Nyquist frequency and scaled to exactly unity DC gain in Q15.
+//
+//*****************************************************************************
+static const int16_t g_pi16MRFilter2[16] =
+{
+         0,    184,    278,   -565,  -1699,      0,   6044,  12142,
+     12142,   6044,      0,  -1699,   -565,    278,    184,      0
+};
+
+static const int16_t g_pi16MRFilter3[24] =
+{
+        -7,     50,    169,    221,      0,   -551,  -1099,   -956,
+       501,   3246,   6363,   8447,   8447,   6363,   3246,    501,
+      -956,  -1099,   -551,      0,    221,    169,     50,     -7
+};
+
+static const int16_t g_pi16MRFilter4[32] =
+{
+        -8,     16,     73,    144,    176,     97,   -135,   -482,
+      -800,   -862,   -438,    591,   2147,   3933,   5505,   6427,
+      6427,   5505,   3933,   2147,    591,   -438,   -862,   -800,
+      -482,   -135,     97,    176,    144,     73,     16,     -8
+};
+
+static const int16_t g_pi16MRFilter5[40] =
+{
+        -7,      4,     34,     78,    124,    144,    110,      0,
+      -187,   -418,   -625,   -712,   -580,   -156,    582,   1582,
+      2720,   3821,   4693,   5177,   5177,   4693,   3821,   2720,
+      1582,    582,   -156,   -580,   -712,   -625,   -418,   -187,
+         0,    110,    144,    124,     78,     34,      4,     -7
+};
+
+static const int16_t g_pi16MRFilter6[48] =
+{
+        -7,      0,     17,     44,     77,    107,    122,    106,
+        47,    -59,   -204,   -367,   -512,   -592,   -558,   -369,
+         0,    548,   1244,   2028,   2817,   3519,   4046,   4330,
+      4330,   4046,   3519,   2817,   2028,   1244,    548,      0,
+      -369,   -558,   -592,   -512,   -367,   -204,    -59,     47,
+       106,    122,    107,     77,     44,     17,      0,     -7
+};
+
+static const int16_t g_pi16MRFilter7[56] =
+{
+        -6,     -2,      8,     25,     48,     73,     95,    105,
+        97,     63,      0,    -92,   -205,   -326,   -433,   -501,
+      -503,   -417,   -222,     88,    509,   1021,   1592,   2178,
+      2730,   3199,   3539,   3721,   3721,   3539,   3199,   2730,
+      2178,   1592,   1021,    509,     88,   -222,   -417,   -503,
+      -501,   -433,   -326,   -205,    -92,      0,     63,     97,
+       105,     95,     73,     48,     25,      8,     -2,     -6
+};
+
+static const int16_t g_pi16MRFilter8[64] =
+{
+        -6,     -3,      4,     15,     31,     50,     69,     85,
+        93,     89,     68,     28,    -33,   -110,   -200,   -292,
+      -374,   -432,   -448,   -409,   -303,   -120,    139,    472,
+       864,   1297,   1747,   2184,   2580,   2906,   3137,   3256,
+      3256,   3137,   2906,   2580,   2184,   1747,   1297,    864,
+       472,    139,   -120,   -303,   -409,   -448,   -432,   -374,
+      -292,   -200,   -110,    -33,     28,     68,     89,     93,
+        85,     69,     50,     31,     15,      4,     -3,     -6
+};
+
+//*****************************************************************************
+//
+// The prototype filter for each factor, indexed by factor.
+//
+//*****************************************************************************
+static const int16_t * const g_ppi16MRFilters[MR_MAX_FACTOR + 1] =
+{
+    0,
+    0,
+    g_pi16MRFilter2,
+    g_pi16MRFilter3,
+    g_pi16MRFilter4,
+    g_pi16MRFilter5,
+    g_pi16MRFilter6,
+    g_pi16MRFilter7,
+    g_pi16MRFilter8
+};
+
+//*****************************************************************************
+//
+// Converts a Q15-scaled 64-bit accumulator back to a saturated 32-bit
+// sample.
+//
+//*****************************************************************************
+static int32_t
+MRSat32(int64_t i64Acc)
+{
+    i64Acc >>= 15;
+    if(i64Acc > 0x7fffffff)
+    {
+        return(0x7fffffff);
+    }
+    if(i64Acc < -0x7fffffff - 1)
+    {
+        return(-0x7fffffff - 1);
+    }
+    return((int32_t)i64Acc);
+}
+
+//*****************************************************************************
+//
+//! Initializes a decimator.
+//!
+//! \param psDec is a pointer to the decimator state.
+//! \param ui32Factor is the decimation factor, from 2 to \b MR_MAX_FACTOR.
+//!
+//! \return Returns \b true on success or \b false if the factor is not
+//! supported.
+//
+//*****************************************************************************
+bool
+MRDecimatorInit(tMRDecimator *psDec, uint32_t ui32Factor)
+{
+    if((ui32Factor < 2) || (ui32Factor > MR_MAX_FACTOR))
+    {
+        return(false);
+    }
+
+    memset(psDec, 0, sizeof(tMRDecimator));
+    psDec->pi16Coeff = g_ppi16MRFilters[ui32Factor];
+    psDec->ui32Factor = ui32Factor;
+    psDec->ui32NumTaps = ui32Factor * MR_TAPS_PER_PHASE;
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Clears the history of a decimator.
+//!
+//! \param psDec is a pointer to the decimator state.
+//!
+//! The delay line is cleared but the output phase is kept, so a decimator
+//! that resumes after a gap stays in step with one that ran on through it.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+MRDecimatorReset(tMRDecimator *psDec)
+{
+    memset(psDec->pi32Delay, 0, sizeof(psDec->pi32Delay));
+}
+
+//*****************************************************************************
+//
+//! Decimates a block of samples.
+//!
+//! \param psDec is a pointer to the decimator state.
+//! \param pi32In points to the input samples.
+//! \param ui32Count is the number of input samples.
+//! \param pi32Out points to the buffer that receives the output samples.
+//!
+//! Only the outputs that survive decimation are computed, one full-length
+//! dot product every \e ui32Factor inputs.  The block length need not be a
+//! multiple of the factor; the output phase carries over between calls.
+//!
+//! \return Returns the number of output samples written.
+//
+//*****************************************************************************
+uint32_t
+MRDecimate(tMRDecimator *psDec, const int32_t *pi32In, uint32_t ui32Count,
+           int32_t *pi32Out)
+{
+    uint32_t ui32Idx, ui32K, ui32NumOut, ui32Taps;
+    const int32_t *pi32X;
+    int64_t i64Acc;
+
+    ui32Taps = psDec->ui32NumTaps;
+    ui32NumOut = 0;
+    for(ui32Idx = 0; ui32Idx < ui32Count; ui32Idx++)
+    {
+        //
+        // Push the sample into both copies of the delay line.
+        //
+        psDec->ui32Pos = (psDec->ui32Pos ? psDec->ui32Pos : ui32Taps) - 1;
+        psDec->pi32Delay[psDec->ui32Pos] = pi32In[ui32Idx];
+        psDec->pi32Delay[psDec->ui32Pos + ui32Taps] = pi32In[ui32Idx];
+
+        if(psDec->ui32Phase != 0)
+        {
+            psDec->ui32Phase--;
+            continue;
+        }
+        psDec->ui32Phase = psDec->ui32Factor - 1;
+
+        //
+        // pi32X[k] is x(n - k).
+        //
+        pi32X = &psDec->pi32Delay[psDec->ui32Pos];
+        i64Acc = 0;
+        for(ui32K = 0; ui32K < ui32Taps; ui32K++)
+        {
+            i64Acc += (int64_t)psDec->pi16Coeff[ui32K] * pi32X[ui32K];
+        }
+        pi32Out[ui32NumOut++] = MRSat32(i64Acc);
+    }
+
+    return(ui32NumOut);
+}
+
+//*****************************************************************************
+//
+//! Initializes an interpolator.
+//!
+//! \param psInt is a pointer to the interpolator state.
+//! \param ui32Factor is the interpolation factor, from 2 to
+//! \b MR_MAX_FACTOR.
+//!
+//! \return Returns \b true on success or \b false if the factor is not
+//! supported.
+//
+//*****************************************************************************
+bool
+MRInterpolatorInit(tMRInterpolator *psInt, uint32_t ui32Factor)
+{
+    if((ui32Factor < 2) || (ui32Factor > MR_MAX_FACTOR))
+    {
+        return(false);
+    }
+
+    memset(psInt, 0, sizeof(tMRInterpolator));
+    psInt->pi16Coeff = g_ppi16MRFilters[ui32Factor];
+    psInt->ui32Factor = ui32Factor;
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Interpolates a block of samples.
+//!
+//! \param psInt is a pointer to the interpolator state.
+//! \param pi32In points to the input samples.
+//! \param ui32Count is the number of input samples.
+//! \param pi32Out points to the buffer that receives \e ui32Count times the
+//! factor output samples.
+//!
+//! Each output phase p uses only the prototype taps p, p + L, p + 2L, ...
+//! against the low-rate delay line, so the zero-stuffed samples are never
+//! multiplied.  The phase outputs are scaled by the factor to restore unity
+//! passband gain.
+//!
+//! \return Returns the number of output samples written.
+//
+//*****************************************************************************
+uint32_t
+MRInterpolate(tMRInterpolator *psInt, const int32_t *pi32In,
+              uint32_t ui32Count, int32_t *pi32Out)
+{
+    uint32_t ui32Idx, ui32Phase, ui32J, ui32Factor;
+    const int32_t *pi32X;
+    const int16_t *pi16H;
+    int64_t i64Acc;
+
+    ui32Factor = psInt->ui32Factor;
+    for(ui32Idx = 0; ui32Idx < ui32Count; ui32Idx++)
+    {
+        psInt->ui32Pos = (psInt->ui32Pos ? psInt->ui32Pos :
+                          MR_TAPS_PER_PHASE) - 1;
+        psInt->pi32Delay[psInt->ui32Pos] = pi32In[ui32Idx];
+        psInt->pi32Delay[psInt->ui32Pos + MR_TAPS_PER_PHASE] = pi32In[ui32Idx];
+        pi32X = &psInt->pi32Delay[psInt->ui32Pos];
+
+        for(ui32Phase = 0; ui32Phase < ui32Factor; ui32Phase++)
+        {
+            pi16H = &psInt->pi16Coeff[ui32Phase];
+            i64Acc = 0;
+            for(ui32J = 0; ui32J < MR_TAPS_PER_PHASE; ui32J++)
+            {
+                i64Acc += (int64_t)pi16H[ui32J * ui32Factor] * pi32X[ui32J];
+            }
+            *pi32Out++ = MRSat32(i64Acc * ui32Factor);
+        }
+    }
+
+    return(ui32Count * ui32Factor);
+}
+
+//*****************************************************************************
+//
+//! Initializes the decimate-process-interpolate stage.
+//!
+//! \param psStage is a pointer to the stage state.
+//! \param ui32Factor is the ratio of the codec rate to the canceller rate,
+//! from 1 to \b MR_MAX_FACTOR.  A factor of 1 bypasses the filters.
+//!
+//! \return Returns \b true on success or \b false if the factor is not
+//! supported.
+//
+//*****************************************************************************
+bool
+MRStageInit(tMRStage *psStage, uint32_t ui32Factor)
+{
+    psStage->ui32Factor = ui32Factor;
+    if(ui32Factor == 1)
+    {
+        return(true);
+    }
+    return(MRDecimatorInit(&psStage->sPrimary, ui32Factor) &&
+           MRDecimatorInit(&psStage->sRef, ui32Factor) &&
+           MRInterpolatorInit(&psStage->sOut, ui32Factor));
+}
+
+//*****************************************************************************
+//
+//! Brings one codec-rate frame down to the canceller rate.
+//!
+//! \param psStage is a pointer to the stage state.
+//! \param pi32Primary points to \b ANC_FRAME_SIZE times the factor primary
+//! samples at the codec rate.
+//! \param pi32Ref points to the same number of reference samples, or is
+//! \b NULL if the reference is not used.
+//! \param pi32LowPrimary points to the buffer that receives
+//! \b ANC_FRAME_SIZE primary samples at the canceller rate.
+//! \param pi32LowRef points to the buffer that receives \b ANC_FRAME_SIZE
+//! reference samples.  It is not written if \e pi32Ref is \b NULL.
+//!
+//! This and MRStageInterpolate() let other processing run at the canceller
+//! rate, in place of or after the canceller.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+MRStageDecimate(tMRStage *psStage, const int32_t *pi32Primary,
+                const int32_t *pi32Ref, int32_t *pi32LowPrimary,
+                int32_t *pi32LowRef)
+{
+    uint32_t ui32Count;
+
+    if(psStage->ui32Factor == 1)
+    {
+        memcpy(pi32LowPrimary, pi32Primary, ANC_FRAME_SIZE * sizeof(int32_t));
+        if(pi32Ref)
+        {
+            memcpy(pi32LowRef, pi32Ref, ANC_FRAME_SIZE * sizeof(int32_t));
+        }
+        return;
+    }
+
+    //
+    // Every decimator call consumes a whole number of low-rate periods, so
+    // each codec frame yields exactly one canceller frame.
+    //
+    ui32Count = ANC_FRAME_SIZE * psStage->ui32Factor;
+    MRDecimate(&psStage->sPrimary, pi32Primary, ui32Count, pi32LowPrimary);
+    if(pi32Ref)
+    {
+        MRDecimate(&psStage->sRef, pi32Ref, ui32Count, pi32LowRef);
+    }
+}
+
+//*****************************************************************************
+//
+//! Brings one canceller-rate frame back up to the codec rate.
+//!
+//! \param psStage is a pointer to the stage state.
+//! \param pi32Low points to \b ANC_FRAME_SIZE samples at the canceller rate.
+//! \param pi32Out points to the buffer that receives \b ANC_FRAME_SIZE times
+//! the factor samples at the codec rate.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+MRStageInterpolate(tMRStage *psStage, const int32_t *pi32Low,
+                   int32_t *pi32Out)
+{
+    if(psStage->ui32Factor == 1)
+    {
+        memcpy(pi32Out, pi32Low, ANC_FRAME_SIZE * sizeof(int32_t));
+        return;
+    }
+
+    MRInterpolate(&psStage->sOut, pi32Low, ANC_FRAME_SIZE, pi32Out);
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -0,0 +1,133 @@
+//*****************************************************************************
+//
+// multirate.h - Prototypes for the decimate-process-interpolate stage.
+//
+//*****************************************************************************
+
+#ifndef __MULTIRATE_H__
+#define __MULTIRATE_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The largest supported rate change factor, and the number of prototype
+// filter taps per polyphase branch.  The prototype for factor M has
+// M * MR_TAPS_PER_PHASE taps.
+//
+//*****************************************************************************
+#define MR_MAX_FACTOR           8
+#define MR_TAPS_PER_PHASE       8
+#define MR_MAX_TAPS             (MR_MAX_FACTOR * MR_TAPS_PER_PHASE)
+
+//*****************************************************************************
+//
+// A polyphase decimator by an integer factor.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The prototype low-pass filter in Q15, unity DC gain.
+    //
+    const int16_t *pi16Coeff;
+
+    //
+    // The decimation factor and the prototype length.
+    //
+    uint32_t ui32Factor;
+    uint32_t ui32NumTaps;
+
+    //
+    // The input delay line, stored twice so that the newest ui32NumTaps
+    // samples are always contiguous from pi32Delay[ui32Pos].
+    //
+    int32_t pi32Delay[2 * MR_MAX_TAPS];
+    uint32_t ui32Pos;
+
+    //
+    // The number of inputs until the next output is due.
+    //
+    uint32_t ui32Phase;
+}
+tMRDecimator;
+
+//*****************************************************************************
+//
+// A polyphase interpolator by an integer factor.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The prototype low-pass filter in Q15, unity DC gain.
+    //
+    const int16_t *pi16Coeff;
+
+    //
+    // The interpolation factor.
+    //
+    uint32_t ui32Factor;
+
+    //
+    // The low-rate delay line, stored twice like the decimator's.
+    //
+    int32_t pi32Delay[2 * MR_TAPS_PER_PHASE];
+    uint32_t ui32Pos;
+}
+tMRInterpolator;
+
+//*****************************************************************************
+//
+// The decimate-process-interpolate stage wrapped around the canceller: both
+// canceller inputs are decimated and its output is interpolated back to the
+// codec rate.
+//
+//*****************************************************************************
+typedef struct
+{
+    tMRDecimator sPrimary;
+    tMRDecimator sRef;
+    tMRInterpolator sOut;
+    uint32_t ui32Factor;
+}
+tMRStage;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern bool MRDecimatorInit(tMRDecimator *psDec, uint32_t ui32Factor);
+extern void MRDecimatorReset(tMRDecimator *psDec);
+extern uint32_t MRDecimate(tMRDecimator *psDec, const int32_t *pi32In,
+                           uint32_t ui32Count, int32_t *pi32Out);
+extern bool MRInterpolatorInit(tMRInterpolator *psInt, uint32_t ui32Factor);
+extern uint32_t MRInterpolate(tMRInterpolator *psInt, const int32_t *pi32In,
+                              uint32_t ui32Count, int32_t *pi32Out);
+extern bool MRStageInit(tMRStage *psStage, uint32_t ui32Factor);
+extern void MRStageDecimate(tMRStage *psStage, const int32_t *pi32Primary,
+                            const int32_t *pi32Ref, int32_t *pi32LowPrimary,
+                            int32_t *pi32LowRef);
+extern void MRStageInterpolate(tMRStage *psStage, const int32_t *pi32Low,
+                               int32_t *pi32Out);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __MULTIRATE_H__
@@ -0,0 +1,289 @@
+//*****************************************************************************
+//
+// nco.c - Numerically controlled oscillator.
+//
+// Synthesizes sines on the device without a libm call per sample, for tonal
+// references and for self-test signals such as the 200 Hz and 60 Hz sources
+// of the Simulink model.  A 32-bit phase accumulator advances by a fixed
+// increment per sample; its top bits select a quadrant and an entry of a
+// quarter-wave table in flash, and the bits below can linearly interpolate
+// between entries.  Harmonics are read at integer multiples of the one
+// accumulator, so they stay phase-locked to the fundamental.
+//
+// The frequency resolution is fs / 2^32.  With the 256-entry quarter table
+// the nearest entry gives about 50 dB SNR and interpolation about 85 dB.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "nco.h"
+
+//*****************************************************************************
+//
+//! \addtogroup nco_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The table geometry.  The top two bits of the phase are the quadrant, the
+// next NCO_TABLE_BITS the table entry, and the following 16 bits the
+// interpolation fraction.
+//
+//*****************************************************************************
+#define NCO_TABLE_BITS          8
+#define NCO_TABLE_SIZE          (1 << NCO_TABLE_BITS)
+#define NCO_INDEX_SHIFT         (32 - 2 - NCO_TABLE_BITS)
+#define NCO_FRAC_SHIFT          (NCO_INDEX_SHIFT - 16)
+
+//*****************************************************************************
+//
+// sin(pi i / (2 NCO_TABLE_SIZE)) in Q15 for i = 0 .. NCO_TABLE_SIZE.  The
+// extra entry closes the quarter so that every interpolation has a right
+// neighbour.
+//
+//*****************************************************************************
+static const int16_t g_pi16NCOQuarterSine[NCO_TABLE_SIZE + 1] =
+{
+         0,    201,    402,    603,    804,   1005,   1206,   1407,
+      1608,   1809,   2009,   2210,   2410,   2611,   2811,   3012,
+      3212,   3412,   3612,   3811,   4011,   4210,   4410,   4609,
+      4808,   5007,   5205,   5404,   5602,   5800,   5998,   6195,
+      6393,   6590,   6786,   6983,   7179,   7375,   7571,   7767,
+      7962,   8157,   8351,   8545,   8739,   8933,   9126,   9319,
+      9512,   9704,   9896,  10087,  10278,  10469,  10659,  10849,
+     11039,  11228,  11417,  11605,  11793,  11980,  12167,  12353,
+     12539,  12725,  12910,  13094,  13279,  13462,  13645,  13828,
+     14010,  14191,  14372,  14553,  14732,  14912,  15090,  15269,
+     15446,  15623,  15800,  15976,  16151,  16325,  16499,  16673,
+     16846,  17018,  17189,  17360,  17530,  17700,  17869,  18037,
+     18204,  18371,  18537,  18703,  18868,  19032,  19195,  19357,
+     19519,  19680,  19841,  20000,  20159,  20317,  20475,  20631,
+     20787,  20942,  21096,  21250,  21403,  21554,  21705,  21856,
+     22005,  22154,  22301,  22448,  22594,  22739,  22884,  23027,
+     23170,  23311,  23452,  23592,  23731,  23870,  24007,  24143,
+     24279,  24413,  24547,  24680,  24811,  24942,  25072,  25201,
+     25329,  25456,  25582,  25708,  25832,  25955,  26077,  26198,
+     26319,  26438,  26556,  26674,  26790,  26905,  27019,  27133,
+     27245,  27356,  27466,  27575,  27683,  27790,  27896,  28001,
+     28105,  28208,  28310,  28411,  28510,  28609,  28706,  28803,
+     28898,  28992,  29085,  29177,  29268,  29358,  29447,  29534,
+     29621,  29706,  29791,  29874,  29956,  30037,  30117,  30195,
+     30273,  30349,  30424,  30498,  30571,  30643,  30714,  30783,
+     30852,  30919,  30985,  31050,  31113,  31176,  31237,  31297,
+     31356,  31414,  31470,  31526,  31580,  31633,  31685,  31736,
+     31785,  31833,  31880,  31926,  31971,  32014,  32057,  32098,
+     32137,  32176,  32213,  32250,  32285,  32318,  32351,  32382,
+     32412,  32441,  32469,  32495,  32521,  32545,  32567,  32589,
+     32609,  32628,  32646,  32663,  32678,  32692,  32705,  32717,
+     32728,  32737,  32745,  32752,  32757,  32761,  32765,  32766,
+     32767
+};
+
+//*****************************************************************************
+//
+// Returns the sine of a phase in Q15.  Inlined into the generator loop.
+//
+//*****************************************************************************
+static __inline int32_t
+NCOLookup(uint32_t ui32Phase, uint32_t ui32Flags)
+{
+    uint32_t ui32Index;
+    int32_t i32Value, i32Next;
+
+    //
+    // Mirror the second and fourth quadrants onto the first.
+    //
+    ui32Index = (ui32Phase >> NCO_INDEX_SHIFT) & (NCO_TABLE_SIZE - 1);
+    if(ui32Phase & 0x40000000)
+    {
+        ui32Index = NCO_TABLE_SIZE - ui32Index;
+        i32Value = g_pi16NCOQuarterSine[ui32Index];
+        i32Next = g_pi16NCOQuarterSine[ui32Index - 1];
+    }
+    else
+    {
+        i32Value = g_pi16NCOQuarterSine[ui32Index];
+        i32Next = g_pi16NCOQuarterSine[ui32Index + 1];
+    }
+
+    if(ui32Flags & NCO_INTERPOLATE)
+    {
+        i32Value += ((i32Next - i32Value) *
+                     (int32_t)((ui32Phase >> NCO_FRAC_SHIFT) & 0xffff)) >> 16;
+    }
+
+    //
+    // The lower half of the turn is negative.
+    //
+    return((ui32Phase & 0x80000000) ? -i32Value : i32Value);
+}
+
+//*****************************************************************************
+//
+//! Initializes an oscillator.
+//!
+//! \param psNCO is a pointer to the oscillator state.
+//! \param ui32SampleRate is the rate of the generated samples.
+//! \param ui32Flags is \b NCO_NEAREST or \b NCO_INTERPOLATE.
+//!
+//! The oscillator starts at zero phase and zero frequency, with no
+//! harmonics.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+NCOInit(tNCO *psNCO, uint32_t ui32SampleRate, uint32_t ui32Flags)
+{
+    psNCO->ui32Phase = 0;
+    psNCO->ui32Increment = 0;
+    psNCO->ui32SampleRate = ui32SampleRate;
+    psNCO->ui32Flags = ui32Flags;
+    psNCO->ui32NumHarmonics = 0;
+}
+
+//*****************************************************************************
+//
+//! Sets the frequency of the fundamental.
+//!
+//! \param psNCO is a pointer to the oscillator state.
+//! \param fFrequency is the frequency in Hz, below half the sample rate.
+//!
+//! The phase is kept, so the output stays continuous across the change.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+NCOFrequencySet(tNCO *psNCO, float fFrequency)
+{
+    psNCO->ui32Increment = (uint32_t)(((double)fFrequency * 4294967296.0) /
+                                      psNCO->ui32SampleRate);
+}
+
+//*****************************************************************************
+//
+//! Changes the rate of the generated samples.
+//!
+//! \param psNCO is a pointer to the oscillator state.
+//! \param ui32SampleRate is the new sample rate.
+//!
+//! The phase increment is rescaled so that the frequency in Hz stays the
+//! same, and the phase is kept, so the output stays continuous across the
+//! change.  The frequency must be below half the new rate.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+NCOSampleRateSet(tNCO *psNCO, uint32_t ui32SampleRate)
+{
+    psNCO->ui32Increment =
+        (uint32_t)(((uint64_t)psNCO->ui32Increment * psNCO->ui32SampleRate) /
+                   ui32SampleRate);
+    psNCO->ui32SampleRate = ui32SampleRate;
+}
+
+//*****************************************************************************
+//
+//! Configures one harmonic.
+//!
+//! \param psNCO is a pointer to the oscillator state.
+//! \param ui32Index is the harmonic slot, less than \b NCO_MAX_HARMONICS.
+//! Slots are used in order; configuring slot n enables slots 0 to n.
+//! \param ui32Multiple is the multiple of the fundamental, 1 for the
+//! fundamental itself.
+//! \param i16Amplitude is the amplitude in Q15.
+//!
+//! The amplitudes of all harmonics should sum to no more than full scale.
+//!
+//! \return Returns \b true on success or \b false if the slot does not
+//! exist.
+//
+//*****************************************************************************
+bool
+NCOHarmonicSet(tNCO *psNCO, uint32_t ui32Index, uint32_t ui32Multiple,
+               int16_t i16Amplitude)
+{
+    if(ui32Index >= NCO_MAX_HARMONICS)
+    {
+        return(false);
+    }
+
+    while(psNCO->ui32NumHarmonics <= ui32Index)
+    {
+        psNCO->pui32Multiple[psNCO->ui32NumHarmonics] = 1;
+        psNCO->pi16Amplitude[psNCO->ui32NumHarmonics] = 0;
+        psNCO->ui32NumHarmonics++;
+    }
+    psNCO->pui32Multiple[ui32Index] = ui32Multiple;
+    psNCO->pi16Amplitude[ui32Index] = i16Amplitude;
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Looks up the sine of a phase.
+//!
+//! \param ui32Phase is the phase, a full turn being 2^32.
+//! \param ui32Flags is \b NCO_NEAREST or \b NCO_INTERPOLATE.
+//!
+//! \return Returns the sine in Q15.
+//
+//*****************************************************************************
+int16_t
+NCOSine(uint32_t ui32Phase, uint32_t ui32Flags)
+{
+    return((int16_t)NCOLookup(ui32Phase, ui32Flags));
+}
+
+//*****************************************************************************
+//
+//! Generates a block of samples.
+//!
+//! \param psNCO is a pointer to the oscillator state.
+//! \param pi32Out points to the buffer that receives the samples, full scale
+//! at 32 bits.
+//! \param ui32Count is the number of samples.
+//!
+//! Each sample is the sum of all configured harmonics.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+NCOGenerate(tNCO *psNCO, int32_t *pi32Out, uint32_t ui32Count)
+{
+    uint32_t ui32Idx, ui32Harmonic, ui32Phase;
+    int32_t i32Sum;
+
+    ui32Phase = psNCO->ui32Phase;
+    for(ui32Idx = 0; ui32Idx < ui32Count; ui32Idx++)
+    {
+        i32Sum = 0;
+        for(ui32Harmonic = 0; ui32Harmonic < psNCO->ui32NumHarmonics;
+            ui32Harmonic++)
+        {
+            if(psNCO->pi16Amplitude[ui32Harmonic] != 0)
+            {
+                i32Sum += (int32_t)psNCO->pi16Amplitude[ui32Harmonic] *
+                          NCOLookup(ui32Phase *
+                                    psNCO->pui32Multiple[ui32Harmonic],
+                                    psNCO->ui32Flags);
+            }
+        }
+        pi32Out[ui32Idx] = i32Sum << 1;
+        ui32Phase += psNCO->ui32Increment;
+    }
+    psNCO->ui32Phase = ui32Phase;
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
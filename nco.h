@@ -0,0 +1,92 @@
+//*****************************************************************************
+//
+// nco.h - Prototypes for the numerically controlled oscillator.
+//
+//*****************************************************************************
+
+#ifndef __NCO_H__
+#define __NCO_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The largest number of harmonics one oscillator can produce.
+//
+//*****************************************************************************
+#define NCO_MAX_HARMONICS       4
+
+//*****************************************************************************
+//
+// Values that can be passed to NCOInit() as the ui32Flags parameter.
+//
+//*****************************************************************************
+#define NCO_NEAREST             0x00000000  // Nearest table entry
+#define NCO_INTERPOLATE         0x00000001  // Linear interpolation
+
+//*****************************************************************************
+//
+// The state of one oscillator.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The phase of the fundamental, a full turn being 2^32, and the phase
+    // advance per sample.
+    //
+    uint32_t ui32Phase;
+    uint32_t ui32Increment;
+
+    //
+    // The sample rate, used to convert frequencies to phase increments.
+    //
+    uint32_t ui32SampleRate;
+
+    //
+    // NCO_NEAREST or NCO_INTERPOLATE.
+    //
+    uint32_t ui32Flags;
+
+    //
+    // The harmonics: the multiple of the fundamental and the amplitude in
+    // Q15 of each.  A harmonic with zero amplitude costs nothing.
+    //
+    uint32_t ui32NumHarmonics;
+    uint32_t pui32Multiple[NCO_MAX_HARMONICS];
+    int16_t pi16Amplitude[NCO_MAX_HARMONICS];
+}
+tNCO;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern void NCOInit(tNCO *psNCO, uint32_t ui32SampleRate, uint32_t ui32Flags);
+extern void NCOFrequencySet(tNCO *psNCO, float fFrequency);
+extern void NCOSampleRateSet(tNCO *psNCO, uint32_t ui32SampleRate);
+extern bool NCOHarmonicSet(tNCO *psNCO, uint32_t ui32Index,
+                           uint32_t ui32Multiple, int16_t i16Amplitude);
+extern int16_t NCOSine(uint32_t ui32Phase, uint32_t ui32Flags);
+extern void NCOGenerate(tNCO *psNCO, int32_t *pi32Out, uint32_t ui32Count);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __NCO_H__
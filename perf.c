@@ -0,0 +1,281 @@
+//*****************************************************************************
+//
+// perf.c - Cycle-count instrumentation for the DSP stages.
+//
+// On the target the probes read the Cortex-M4 DWT cycle counter, which runs
+// at the core clock and costs a single load to sample.  On a host build they
+// fall back to the monotonic clock in nanoseconds so the same code paths can
+// be timed off target.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <string.h>
+#if defined(__ARMCC_VERSION) || defined(__arm__)
+#include "CU_TM4C123.h"
+#define PERF_TARGET
+#else
+#include <time.h>
+#endif
+#include "perf.h"
+
+//*****************************************************************************
+//
+//! \addtogroup perf_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The statistics and the pending start time of each probe.
+//
+//*****************************************************************************
+static tPerfStats g_psPerfStats[PERF_NUM_PROBES];
+static uint32_t g_pui32PerfStart[PERF_NUM_PROBES];
+
+//*****************************************************************************
+//
+//! Enables the cycle counter and clears all probes.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+PerfInit(void)
+{
+    uint32_t ui32Probe;
+
+#ifdef PERF_TARGET
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    for(ui32Probe = 0; ui32Probe < PERF_NUM_PROBES; ui32Probe++)
+    {
+        PerfReset(ui32Probe);
+    }
+}
+
+//*****************************************************************************
+//
+//! Returns the free-running cycle count.
+//!
+//! The count wraps every 2^32 cycles (53 s at 80 MHz); differences of two
+//! readings are correct across a single wrap.
+//!
+//! \return Returns the current cycle count.
+//
+//*****************************************************************************
+uint32_t
+PerfCyclesGet(void)
+{
+#ifdef PERF_TARGET
+    return(DWT->CYCCNT);
+#else
+    struct timespec sNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &sNow);
+    return((uint32_t)((uint64_t)sNow.tv_sec * 1000000000 + sNow.tv_nsec));
+#endif
+}
+
+//*****************************************************************************
+//
+//! Starts a measurement.
+//!
+//! \param ui32Probe is the probe, one of the \b PERF_PROBE_ values.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+PerfStart(uint32_t ui32Probe)
+{
+    g_pui32PerfStart[ui32Probe] = PerfCyclesGet();
+}
+
+//*****************************************************************************
+//
+//! Ends a measurement and folds it into the probe's statistics.
+//!
+//! \param ui32Probe is the probe, one of the \b PERF_PROBE_ values.
+//! \param ui32Units is the number of units processed during the measurement.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+PerfStop(uint32_t ui32Probe, uint32_t ui32Units)
+{
+    tPerfStats *psStats;
+    uint32_t ui32Cycles;
+
+    ui32Cycles = PerfCyclesGet() - g_pui32PerfStart[ui32Probe];
+    psStats = &g_psPerfStats[ui32Probe];
+
+    psStats->ui32Calls++;
+    psStats->ui32Units += ui32Units;
+    psStats->ui64Cycles += ui32Cycles;
+    if(ui32Cycles < psStats->ui32MinCycles)
+    {
+        psStats->ui32MinCycles = ui32Cycles;
+    }
+    if(ui32Cycles > psStats->ui32MaxCycles)
+    {
+        psStats->ui32MaxCycles = ui32Cycles;
+    }
+    if(ui32Units && ((ui32Cycles / ui32Units) > psStats->ui32MaxPerUnit))
+    {
+        psStats->ui32MaxPerUnit = ui32Cycles / ui32Units;
+    }
+}
+
+//*****************************************************************************
+//
+//! Returns a copy of a probe's statistics.
+//!
+//! \param ui32Probe is the probe, one of the \b PERF_PROBE_ values.
+//! \param psStats points to the structure that receives the statistics.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+PerfStatsGet(uint32_t ui32Probe, tPerfStats *psStats)
+{
+    *psStats = g_psPerfStats[ui32Probe];
+}
+
+//*****************************************************************************
+//
+//! Clears a probe's statistics.
+//!
+//! \param ui32Probe is the probe, one of the \b PERF_PROBE_ values.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+PerfReset(uint32_t ui32Probe)
+{
+    memset(&g_psPerfStats[ui32Probe], 0, sizeof(tPerfStats));
+    g_psPerfStats[ui32Probe].ui32MinCycles = 0xffffffff;
+}
+
+//*****************************************************************************
+//
+//! Returns one sample of the benchmark test signal.
+//!
+//! \param ui32Idx is the position of the sample in the signal.
+//!
+//! The signal steps through the 16-bit range in large, irregular strides, so
+//! it is full scale and exercises the saturation and rounding paths without
+//! any sample depending on the last.
+//!
+//! \return Returns the sample in Q15.
+//
+//*****************************************************************************
+int16_t
+PerfPatternGet(uint32_t ui32Idx)
+{
+    return((int16_t)((int32_t)((ui32Idx * 40503) & 0xffff) - 0x8000));
+}
+
+//*****************************************************************************
+//
+//! Fills a buffer of 16-bit samples with the benchmark test signal.
+//!
+//! \param pi16Buf points to the buffer.
+//! \param ui32Count is the number of samples.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+PerfPatternFill16(int16_t *pi16Buf, uint32_t ui32Count)
+{
+    uint32_t ui32Idx;
+
+    for(ui32Idx = 0; ui32Idx < ui32Count; ui32Idx++)
+    {
+        pi16Buf[ui32Idx] = PerfPatternGet(ui32Idx);
+    }
+}
+
+//*****************************************************************************
+//
+//! Fills a byte buffer with the benchmark test signal.
+//!
+//! \param pui8Buf points to the buffer.
+//! \param ui32Count is the number of bytes.
+//!
+//! Each byte is the upper byte of a sample, which varies more than the
+//! lower one.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+PerfPatternFill8(uint8_t *pui8Buf, uint32_t ui32Count)
+{
+    uint32_t ui32Idx;
+
+    for(ui32Idx = 0; ui32Idx < ui32Count; ui32Idx++)
+    {
+        pui8Buf[ui32Idx] = (uint8_t)((uint16_t)PerfPatternGet(ui32Idx) >> 8);
+    }
+}
+
+//*****************************************************************************
+//
+//! Times a piece of code, keeping the fastest of several runs.
+//!
+//! \param pfnSetup is called before each run and is not timed, or is
+//! \b NULL if the runs need no setup.
+//! \param pfnRun is the code to time.
+//! \param pvArg is passed to both.
+//!
+//! \e pfnRun is timed \b PERF_BENCHMARK_RUNS times and the fastest run is
+//! kept, so that a run lengthened by an interrupt does not count.  The
+//! measurement includes the call of \e pfnRun itself, a few cycles.  On the
+//! target the result is in processor cycles; on a host build it is in
+//! nanoseconds.
+//!
+//! \return Returns the cost of the fastest run.
+//
+//*****************************************************************************
+uint32_t
+PerfBenchmarkRun(tPerfBenchmarkStep pfnSetup, tPerfBenchmarkStep pfnRun,
+                 void *pvArg)
+{
+    uint32_t ui32Run, ui32Start, ui32Cycles, ui32Best;
+
+    ui32Best = 0xffffffff;
+    for(ui32Run = 0; ui32Run < PERF_BENCHMARK_RUNS; ui32Run++)
+    {
+        if(pfnSetup)
+        {
+            pfnSetup(pvArg);
+        }
+
+        ui32Start = PerfCyclesGet();
+        pfnRun(pvArg);
+        ui32Cycles = PerfCyclesGet() - ui32Start;
+
+        if(ui32Cycles < ui32Best)
+        {
+            ui32Best = ui32Cycles;
+        }
+    }
+
+    return(ui32Best);
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
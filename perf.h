@@ -0,0 +1,109 @@
+//*****************************************************************************
+//
+// perf.h - Prototypes for the cycle-count instrumentation.
+//
+//*****************************************************************************
+
+#ifndef __PERF_H__
+#define __PERF_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The probes.  Each instrumented stage owns one; add new stages before
+// PERF_NUM_PROBES.
+//
+//*****************************************************************************
+#define PERF_PROBE_RESAMPLE     0   // Cycles per output sample
+#define PERF_PROBE_SPECSUB      1   // Cycles per frame
+#define PERF_PROBE_WIENER       2   // Cycles per frame
+#define PERF_PROBE_CODEC_INIT   3   // Cycles per codec setting
+#define PERF_PROBE_FIRST_FRAME  4   // Cycles from main() to the first frame
+#define PERF_PROBE_RATE_SWITCH  5   // Cycles the codec is stopped per switch
+#define PERF_NUM_PROBES         6
+
+//*****************************************************************************
+//
+// The statistics gathered by one probe.  A measurement covers one call of
+// the instrumented code and processes some number of units (samples or
+// frames, as documented for each probe).
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The number of measurements and the total units processed.
+    //
+    uint32_t ui32Calls;
+    uint32_t ui32Units;
+
+    //
+    // The total cycles of all measurements.
+    //
+    uint64_t ui64Cycles;
+
+    //
+    // The fewest and most cycles taken by a single measurement.
+    //
+    uint32_t ui32MinCycles;
+    uint32_t ui32MaxCycles;
+
+    //
+    // The largest cycles-per-unit seen in a single measurement, i.e. the
+    // bound the stage has actually met.
+    //
+    uint32_t ui32MaxPerUnit;
+}
+tPerfStats;
+
+//*****************************************************************************
+//
+// The number of times PerfBenchmarkRun() times the code under test.
+//
+//*****************************************************************************
+#define PERF_BENCHMARK_RUNS     4
+
+//*****************************************************************************
+//
+// A step of a benchmark, passed the benchmark's own state.
+//
+//*****************************************************************************
+typedef void (*tPerfBenchmarkStep)(void *pvArg);
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern void PerfInit(void);
+extern uint32_t PerfCyclesGet(void);
+extern void PerfStart(uint32_t ui32Probe);
+extern void PerfStop(uint32_t ui32Probe, uint32_t ui32Units);
+extern void PerfStatsGet(uint32_t ui32Probe, tPerfStats *psStats);
+extern void PerfReset(uint32_t ui32Probe);
+extern int16_t PerfPatternGet(uint32_t ui32Idx);
+extern void PerfPatternFill16(int16_t *pi16Buf, uint32_t ui32Count);
+extern void PerfPatternFill8(uint8_t *pui8Buf, uint32_t ui32Count);
+extern uint32_t PerfBenchmarkRun(tPerfBenchmarkStep pfnSetup,
+                                 tPerfBenchmarkStep pfnRun, void *pvArg);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __PERF_H__
@@ -0,0 +1,39 @@
+//*****************************************************************************
+//
+// ramfunc.h - Placement of the DSP kernels in SRAM.
+//
+// At 80 MHz the flash needs wait states.  The prefetch buffer hides them for
+// straight-line code, but every taken branch in an inner loop refills it, so
+// the tight loops of the canceller, FFT and biquad kernels stall on each
+// iteration.  A function marked RAMFUNC is linked into the .ramfunc section,
+// which the scatter file (Lab5.sct) loads from flash and places at the start
+// of SRAM; the reset handler copies it there before anything runs.  SRAM
+// reads take no wait states.
+//
+// Each kernel has its own option in its module header, so the placements can
+// be benchmarked separately:
+//
+//     ANC_KERNEL_IN_RAM       anc.h
+//     FFT_KERNEL_IN_RAM       fft.h
+//     BIQUAD_KERNEL_IN_RAM    biquad.h
+//
+// Defining one to 0 leaves that kernel in flash.
+//
+//*****************************************************************************
+
+#ifndef __RAMFUNC_H__
+#define __RAMFUNC_H__
+
+//*****************************************************************************
+//
+// Only the ARM toolchain's scatter file places the section, so host builds
+// leave the kernels where the compiler puts them.
+//
+//*****************************************************************************
+#if defined(__ARMCC_VERSION)
+#define RAMFUNC                 __attribute__((section(".ramfunc")))
+#else
+#define RAMFUNC
+#endif
+
+#endif // __RAMFUNC_H__
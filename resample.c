@@ -0,0 +1,871 @@
+//*****************************************************************************
+//
+// resample.c - Polyphase rational sample-rate converter.
+//
+// Converts between the codec rate and the single internal rate the DSP is
+// tuned for, so the rest of the pipeline does not depend on which codec rate
+// a unit is deployed at.  Conversion by L / M is done with a bank of L
+// polyphase branches taken from one low-pass prototype; the branch for each
+// output is selected by an integer phase accumulator, so there is no
+// floating point and no per-output coefficient computation.  The banks are
+// precomputed const tables and live in flash.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "perf.h"
+#include "resample.h"
+
+//*****************************************************************************
+//
+//! \addtogroup resample_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The polyphase banks.  Each prototype has L * RESAMPLE_TAPS taps, designed
+// as a Kaiser-windowed sinc (beta = 6.0) with its cutoff at 0.9 of the lower
+// of the two Nyquist frequencies.  The interpolation gain L is folded in and
+// every branch is trimmed to exactly unity DC gain in Q15.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+// The L = 160, M = 147 polyphase bank: 160 branches of 16 taps, branch-major.
+//
+//*****************************************************************************
+static const int16_t g_pi16ResampleL160M147[160 * RESAMPLE_TAPS] =
+{
+       -11,     81,   -270,    638,  -1202,   1904,  -2612,   3181,
+     29478,   2992,  -2539,   1872,  -1191,    636,   -270,     81,
+       -11,     80,   -270,    641,  -1214,   1935,  -2686,   3371,
+     29477,   2805,  -2465,   1841,  -1179,    632,   -270,     81,
+       -11,     80,   -270,    644,  -1225,   1965,  -2759,   3563,
+     29470,   2619,  -2391,   1808,  -1166,    629,   -270,     82,
+       -11,     79,   -269,    646,  -1235,   1996,  -2832,   3757,
+     29458,   2435,  -2317,   1776,  -1154,    626,   -269,     82,
+       -11,     79,   -269,    648,  -1246,   2025,  -2904,   3952,
+     29447,   2253,  -2243,   1743,  -1141,    622,   -269,     82,
+       -11,     78,   -268,    650,  -1256,   2055,  -2976,   4148,
+     29432,   2072,  -2169,   1710,  -1128,    618,   -269,     82,
+       -10,     77,   -268,    652,  -1266,   2084,  -3048,   4346,
+     29412,   1893,  -2094,   1676,  -1115,    614,   -268,     83,
+       -10,     77,   -267,    653,  -1275,   2112,  -3119,   4545,
+     29389,   1716,  -2020,   1643,  -1101,    610,   -268,     83,
+       -10,     76,   -266,    655,  -1284,   2140,  -3190,   4745,
+     29362,   1541,  -1945,   1609,  -1087,    606,   -267,     83,
+       -10,     75,   -265,    656,  -1293,   2168,  -3261,   4947,
+     29336,   1367,  -1871,   1574,  -1073,    601,   -266,     83,
+       -10,     74,   -264,    657,  -1301,   2195,  -3331,   5150,
+     29304,   1195,  -1797,   1540,  -1059,    597,   -265,     83,
+        -9,     73,   -263,    657,  -1309,   2221,  -3401,   5354,
+     29270,   1025,  -1722,   1505,  -1044,    592,   -264,     83,
+        -9,     73,   -262,    658,  -1316,   2247,  -3470,   5560,
+     29230,    857,  -1648,   1470,  -1029,    587,   -263,     83,
+        -9,     72,   -260,    658,  -1324,   2272,  -3539,   5767,
+     29190,    690,  -1573,   1435,  -1014,    582,   -262,     83,
+        -9,     71,   -259,    658,  -1331,   2297,  -3607,   5975,
+     29148,    526,  -1499,   1399,   -999,    576,   -261,     83,
+        -8,     70,   -257,    658,  -1337,   2322,  -3674,   6184,
+     29098,    363,  -1425,   1364,   -984,    571,   -260,     83,
+        -8,     69,   -256,    658,  -1343,   2345,  -3741,   6394,
+     29048,    203,  -1351,   1328,   -968,    565,   -258,     83,
+        -8,     67,   -254,    657,  -1349,   2369,  -3807,   6606,
+     28995,     44,  -1278,   1292,   -952,    560,   -257,     83,
+        -7,     66,   -252,    656,  -1354,   2391,  -3873,   6818,
+     28939,   -113,  -1204,   1256,   -936,    554,   -255,     82,
+        -7,     65,   -250,    655,  -1359,   2413,  -3938,   7031,
+     28881,   -268,  -1131,   1220,   -920,    548,   -254,     82,
+        -7,     64,   -248,    654,  -1363,   2434,  -4002,   7246,
+     28817,   -421,  -1058,   1183,   -903,    542,   -252,     82,
+        -6,     63,   -246,    652,  -1367,   2455,  -4065,   7461,
+     28750,   -572,   -985,   1147,   -887,    536,   -250,     82,
+        -6,     61,   -243,    650,  -1371,   2475,  -4128,   7677,
+     28684,   -720,   -912,   1110,   -870,    529,   -249,     81,
+        -6,     60,   -241,    648,  -1374,   2494,  -4190,   7894,
+     28612,   -867,   -840,   1074,   -853,    523,   -247,     81,
+        -5,     58,   -238,    646,  -1377,   2513,  -4251,   8112,
+     28537,  -1012,   -768,   1037,   -836,    516,   -245,     81,
+        -5,     57,   -236,    643,  -1379,   2531,  -4311,   8331,
+     28462,  -1155,   -697,   1000,   -819,    509,   -243,     80,
+        -4,     56,   -233,    641,  -1381,   2548,  -4371,   8551,
+     28377,  -1295,   -625,    964,   -802,    503,   -241,     80,
+        -4,     54,   -230,    638,  -1382,   2565,  -4429,   8771,
+     28295,  -1434,   -555,    927,   -784,    496,   -239,     79,
+        -4,     52,   -227,    634,  -1383,   2581,  -4487,   8992,
+     28210,  -1570,   -484,    890,   -767,    489,   -237,     79,
+        -3,     51,   -224,    631,  -1384,   2596,  -4543,   9213,
+     28120,  -1705,   -414,    853,   -749,    482,   -234,     78,
+        -3,     49,   -221,    627,  -1384,   2611,  -4599,   9436,
+     28030,  -1837,   -345,    816,   -732,    474,   -232,     78,
+        -2,     47,   -217,    623,  -1383,   2624,  -4654,   9658,
+     27935,  -1967,   -275,    779,   -714,    467,   -230,     77,
+        -2,     46,   -214,    619,  -1383,   2637,  -4707,   9882,
+     27836,  -2095,   -207,    742,   -696,    460,   -227,     77,
+        -1,     44,   -210,    615,  -1381,   2650,  -4760,  10106,
+     27733,  -2220,   -139,    706,   -678,    452,   -225,     76,
+        -1,     42,   -207,    610,  -1379,   2661,  -4811,  10330,
+     27630,  -2344,    -71,    669,   -660,    445,   -222,     76,
+         0,     40,   -203,    605,  -1377,   2672,  -4862,  10555,
+     27525,  -2465,     -4,    632,   -642,    437,   -220,     75,
+         1,     38,   -199,    600,  -1374,   2682,  -4911,  10780,
+     27414,  -2584,     63,    595,   -623,    429,   -217,     74,
+         1,     36,   -195,    594,  -1371,   2691,  -4959,  11005,
+     27304,  -2701,    129,    559,   -605,    421,   -215,     74,
+         2,     34,   -191,    589,  -1368,   2699,  -5006,  11231,
+     27190,  -2816,    194,    522,   -587,    414,   -212,     73,
+         2,     32,   -187,    583,  -1363,   2706,  -5052,  11457,
+     27073,  -2929,    259,    486,   -568,    406,   -209,     72,
+         3,     30,   -182,    576,  -1359,   2713,  -5096,  11684,
+     26950,  -3039,    324,    450,   -550,    398,   -206,     72,
+         3,     28,   -178,    570,  -1354,   2719,  -5140,  11910,
+     26830,  -3147,    387,    414,   -531,    390,   -204,     71,
+         4,     26,   -173,    563,  -1348,   2724,  -5182,  12137,
+     26704,  -3253,    450,    378,   -513,    382,   -201,     70,
+         5,     24,   -169,    556,  -1342,   2728,  -5222,  12364,
+     26576,  -3357,    513,    342,   -494,    373,   -198,     69,
+         5,     21,   -164,    549,  -1335,   2731,  -5262,  12591,
+     26449,  -3459,    574,    306,   -476,    365,   -195,     68,
+         6,     19,   -159,    542,  -1328,   2733,  -5300,  12818,
+     26312,  -3558,    636,    271,   -457,    357,   -192,     68,
+         7,     17,   -154,    534,  -1321,   2735,  -5336,  13045,
+     26176,  -3655,    696,    236,   -439,    349,   -189,     67,
+         7,     15,   -149,    526,  -1313,   2735,  -5371,  13272,
+     26040,  -3750,    756,    200,   -420,    340,   -186,     66,
+         8,     12,   -144,    518,  -1304,   2735,  -5405,  13499,
+     25899,  -3842,    814,    166,   -402,    332,   -183,     65,
+         9,     10,   -138,    509,  -1295,   2734,  -5438,  13726,
+     25754,  -3932,    873,    131,   -383,    324,   -180,     64,
+        10,      7,   -133,    501,  -1285,   2732,  -5469,  13952,
+     25610,  -4020,    930,     96,   -365,    315,   -177,     64,
+        10,      5,   -127,    492,  -1275,   2729,  -5498,  14179,
+     25461,  -4106,    987,     62,   -347,    307,   -174,     63,
+        11,      2,   -122,    483,  -1265,   2725,  -5526,  14405,
+     25312,  -4190,   1043,     28,   -328,    298,   -170,     62,
+        12,      0,   -116,    473,  -1254,   2720,  -5552,  14631,
+     25159,  -4271,   1098,     -6,   -310,    290,   -167,     61,
+        13,     -3,   -110,    464,  -1242,   2714,  -5577,  14856,
+     25005,  -4350,   1152,    -39,   -292,    281,   -164,     60,
+        13,     -6,   -104,    454,  -1230,   2707,  -5600,  15082,
+     24847,  -4427,   1206,    -72,   -273,    273,   -161,     59,
+        14,     -8,    -98,    444,  -1217,   2700,  -5622,  15306,
+     24688,  -4501,   1258,   -105,   -255,    264,   -158,     58,
+        15,    -11,    -92,    433,  -1204,   2691,  -5642,  15531,
+     24526,  -4573,   1310,   -138,   -237,    256,   -154,     57,
+        16,    -14,    -86,    423,  -1191,   2682,  -5660,  15755,
+     24363,  -4644,   1361,   -170,   -219,    247,   -151,     56,
+        17,    -17,    -80,    412,  -1177,   2671,  -5677,  15978,
+     24197,  -4711,   1412,   -202,   -201,    239,   -148,     55,
+        17,    -19,    -73,    401,  -1162,   2660,  -5692,  16201,
+     24028,  -4777,   1461,   -234,   -183,    230,   -144,     54,
+        18,    -22,    -67,    389,  -1147,   2647,  -5705,  16423,
+     23860,  -4840,   1510,   -266,   -165,    221,   -141,     53,
+        19,    -25,    -60,    378,  -1131,   2634,  -5717,  16645,
+     23687,  -4901,   1557,   -297,   -148,    213,   -138,     52,
+        20,    -28,    -54,    366,  -1115,   2620,  -5727,  16866,
+     23513,  -4960,   1604,   -327,   -130,    204,   -135,     51,
+        21,    -31,    -47,    354,  -1099,   2605,  -5735,  17086,
+     23336,  -5017,   1650,   -358,   -113,    196,   -131,     51,
+        22,    -34,    -40,    342,  -1082,   2588,  -5741,  17305,
+     23159,  -5072,   1695,   -388,    -95,    187,   -128,     50,
+        23,    -37,    -33,    330,  -1064,   2571,  -5745,  17524,
+     22977,  -5124,   1739,   -418,    -78,    179,   -125,     49,
+        24,    -40,    -26,    317,  -1046,   2553,  -5748,  17742,
+     22794,  -5174,   1782,   -447,    -61,    171,   -121,     48,
+        24,    -43,    -19,    304,  -1028,   2534,  -5749,  17959,
+     22613,  -5222,   1824,   -476,    -44,    162,   -118,     47,
+        25,    -46,    -12,    291,  -1009,   2514,  -5748,  18175,
+     22426,  -5268,   1866,   -505,    -27,    154,   -114,     46,
+        26,    -49,     -4,    278,   -989,   2492,  -5745,  18390,
+     22239,  -5312,   1906,   -533,    -10,    145,   -111,     45,
+        27,    -52,      3,    264,   -969,   2470,  -5740,  18604,
+     22050,  -5353,   1946,   -561,      6,    137,   -108,     44,
+        28,    -55,     10,    251,   -949,   2447,  -5733,  18817,
+     21857,  -5392,   1984,   -588,     23,    129,   -104,     43,
+        29,    -59,     18,    237,   -928,   2423,  -5725,  19028,
+     21668,  -5430,   2022,   -615,     39,    120,   -101,     42,
+        30,    -62,     25,    223,   -907,   2398,  -5714,  19239,
+     21474,  -5465,   2059,   -642,     55,    112,    -98,     41,
+        31,    -65,     33,    208,   -885,   2372,  -5702,  19449,
+     21277,  -5498,   2094,   -668,     72,    104,    -94,     40,
+        32,    -68,     41,    194,   -863,   2345,  -5687,  19657,
+     21080,  -5529,   2129,   -694,     87,     96,    -91,     39,
+        33,    -71,     48,    179,   -840,   2317,  -5670,  19864,
+     20880,  -5557,   2163,   -719,    103,     88,    -88,     38,
+        34,    -75,     56,    164,   -817,   2288,  -5652,  20070,
+     20681,  -5584,   2196,   -744,    119,     80,    -85,     37,
+        35,    -78,     64,    149,   -793,   2258,  -5631,  20274,
+     20480,  -5609,   2227,   -769,    134,     72,    -81,     36,
+        36,    -81,     72,    134,   -769,   2227,  -5609,  20480,
+     20274,  -5631,   2258,   -793,    149,     64,    -78,     35,
+        37,    -85,     80,    119,   -744,   2196,  -5584,  20681,
+     20070,  -5652,   2288,   -817,    164,     56,    -75,     34,
+        38,    -88,     88,    103,   -719,   2163,  -5557,  20880,
+     19864,  -5670,   2317,   -840,    179,     48,    -71,     33,
+        39,    -91,     96,     87,   -694,   2129,  -5529,  21080,
+     19657,  -5687,   2345,   -863,    194,     41,    -68,     32,
+        40,    -94,    104,     72,   -668,   2094,  -5498,  21277,
+     19449,  -5702,   2372,   -885,    208,     33,    -65,     31,
+        41,    -98,    112,     55,   -642,   2059,  -5465,  21474,
+     19239,  -5714,   2398,   -907,    223,     25,    -62,     30,
+        42,   -101,    120,     39,   -615,   2022,  -5430,  21668,
+     19028,  -5725,   2423,   -928,    237,     18,    -59,     29,
+        43,   -104,    129,     23,   -588,   1984,  -5392,  21857,
+     18817,  -5733,   2447,   -949,    251,     10,    -55,     28,
+        44,   -108,    137,      6,   -561,   1946,  -5353,  22050,
+     18604,  -5740,   2470,   -969,    264,      3,    -52,     27,
+        45,   -111,    145,    -10,   -533,   1906,  -5312,  22239,
+     18390,  -5745,   2492,   -989,    278,     -4,    -49,     26,
+        46,   -114,    154,    -27,   -505,   1866,  -5268,  22426,
+     18175,  -5748,   2514,  -1009,    291,    -12,    -46,     25,
+        47,   -118,    162,    -44,   -476,   1824,  -5222,  22613,
+     17959,  -5749,   2534,  -1028,    304,    -19,    -43,     24,
+        48,   -121,    171,    -61,   -447,   1782,  -5174,  22794,
+     17742,  -5748,   2553,  -1046,    317,    -26,    -40,     24,
+        49,   -125,    179,    -78,   -418,   1739,  -5124,  22977,
+     17524,  -5745,   2571,  -1064,    330,    -33,    -37,     23,
+        50,   -128,    187,    -95,   -388,   1695,  -5072,  23159,
+     17305,  -5741,   2588,  -1082,    342,    -40,    -34,     22,
+        51,   -131,    196,   -113,   -358,   1650,  -5017,  23336,
+     17086,  -5735,   2605,  -1099,    354,    -47,    -31,     21,
+        51,   -135,    204,   -130,   -327,   1604,  -4960,  23513,
+     16866,  -5727,   2620,  -1115,    366,    -54,    -28,     20,
+        52,   -138,    213,   -148,   -297,   1557,  -4901,  23687,
+     16645,  -5717,   2634,  -1131,    378,    -60,    -25,     19,
+        53,   -141,    221,   -165,   -266,   1510,  -4840,  23860,
+     16423,  -5705,   2647,  -1147,    389,    -67,    -22,     18,
+        54,   -144,    230,   -183,   -234,   1461,  -4777,  24028,
+     16201,  -5692,   2660,  -1162,    401,    -73,    -19,     17,
+        55,   -148,    239,   -201,   -202,   1412,  -4711,  24197,
+     15978,  -5677,   2671,  -1177,    412,    -80,    -17,     17,
+        56,   -151,    247,   -219,   -170,   1361,  -4644,  24363,
+     15755,  -5660,   2682,  -1191,    423,    -86,    -14,     16,
+        57,   -154,    256,   -237,   -138,   1310,  -4573,  24526,
+     15531,  -5642,   2691,  -1204,    433,    -92,    -11,     15,
+        58,   -158,    264,   -255,   -105,   1258,  -4501,  24688,
+     15306,  -5622,   2700,  -1217,    444,    -98,     -8,     14,
+        59,   -161,    273,   -273,    -72,   1206,  -4427,  24847,
+     15082,  -5600,   2707,  -1230,    454,   -104,     -6,     13,
+        60,   -164,    281,   -292,    -39,   1152,  -4350,  25005,
+     14856,  -5577,   2714,  -1242,    464,   -110,     -3,     13,
+        61,   -167,    290,   -310,     -6,   1098,  -4271,  25159,
+     14631,  -5552,   2720,  -1254,    473,   -116,      0,     12,
+        62,   -170,    298,   -328,     28,   1043,  -4190,  25312,
+     14405,  -5526,   2725,  -1265,    483,   -122,      2,     11,
+        63,   -174,    307,   -347,     62,    987,  -4106,  25461,
+     14179,  -5498,   2729,  -1275,    492,   -127,      5,     10,
+        64,   -177,    315,   -365,     96,    930,  -4020,  25610,
+     13952,  -5469,   2732,  -1285,    501,   -133,      7,     10,
+        64,   -180,    324,   -383,    131,    873,  -3932,  25754,
+     13726,  -5438,   2734,  -1295,    509,   -138,     10,      9,
+        65,   -183,    332,   -402,    166,    814,  -3842,  25899,
+     13499,  -5405,   2735,  -1304,    518,   -144,     12,      8,
+        66,   -186,    340,   -420,    200,    756,  -3750,  26040,
+     13272,  -5371,   2735,  -1313,    526,   -149,     15,      7,
+        67,   -189,    349,   -439,    236,    696,  -3655,  26176,
+     13045,  -5336,   2735,  -1321,    534,   -154,     17,      7,
+        68,   -192,    357,   -457,    271,    636,  -3558,  26312,
+     12818,  -5300,   2733,  -1328,    542,   -159,     19,      6,
+        68,   -195,    365,   -476,    306,    574,  -3459,  26449,
+     12591,  -5262,   2731,  -1335,    549,   -164,     21,      5,
+        69,   -198,    373,   -494,    342,    513,  -3357,  26576,
+     12364,  -5222,   2728,  -1342,    556,   -169,     24,      5,
+        70,   -201,    382,   -513,    378,    450,  -3253,  26704,
+     12137,  -5182,   2724,  -1348,    563,   -173,     26,      4,
+        71,   -204,    390,   -531,    414,    387,  -3147,  26830,
+     11910,  -5140,   2719,  -1354,    570,   -178,     28,      3,
+        72,   -206,    398,   -550,    450,    324,  -3039,  26950,
+     11684,  -5096,   2713,  -1359,    576,   -182,     30,      3,
+        72,   -209,    406,   -568,    486,    259,  -2929,  27073,
+     11457,  -5052,   2706,  -1363,    583,   -187,     32,      2,
+        73,   -212,    414,   -587,    522,    194,  -2816,  27190,
+     11231,  -5006,   2699,  -1368,    589,   -191,     34,      2,
+        74,   -215,    421,   -605,    559,    129,  -2701,  27304,
+     11005,  -4959,   2691,  -1371,    594,   -195,     36,      1,
+        74,   -217,    429,   -623,    595,     63,  -2584,  27414,
+     10780,  -4911,   2682,  -1374,    600,   -199,     38,      1,
+        75,   -220,    437,   -642,    632,     -4,  -2465,  27525,
+     10555,  -4862,   2672,  -1377,    605,   -203,     40,      0,
+        76,   -222,    445,   -660,    669,    -71,  -2344,  27630,
+     10330,  -4811,   2661,  -1379,    610,   -207,     42,     -1,
+        76,   -225,    452,   -678,    706,   -139,  -2220,  27733,
+     10106,  -4760,   2650,  -1381,    615,   -210,     44,     -1,
+        77,   -227,    460,   -696,    742,   -207,  -2095,  27836,
+      9882,  -4707,   2637,  -1383,    619,   -214,     46,     -2,
+        77,   -230,    467,   -714,    779,   -275,  -1967,  27935,
+      9658,  -4654,   2624,  -1383,    623,   -217,     47,     -2,
+        78,   -232,    474,   -732,    816,   -345,  -1837,  28030,
+      9436,  -4599,   2611,  -1384,    627,   -221,     49,     -3,
+        78,   -234,    482,   -749,    853,   -414,  -1705,  28120,
+      9213,  -4543,   2596,  -1384,    631,   -224,     51,     -3,
+        79,   -237,    489,   -767,    890,   -484,  -1570,  28210,
+      8992,  -4487,   2581,  -1383,    634,   -227,     52,     -4,
+        79,   -239,    496,   -784,    927,   -555,  -1434,  28295,
+      8771,  -4429,   2565,  -1382,    638,   -230,     54,     -4,
+        80,   -241,    503,   -802,    964,   -625,  -1295,  28377,
+      8551,  -4371,   2548,  -1381,    641,   -233,     56,     -4,
+        80,   -243,    509,   -819,   1000,   -697,  -1155,  28462,
+      8331,  -4311,   2531,  -1379,    643,   -236,     57,     -5,
+        81,   -245,    516,   -836,   1037,   -768,  -1012,  28537,
+      8112,  -4251,   2513,  -1377,    646,   -238,     58,     -5,
+        81,   -247,    523,   -853,   1074,   -840,   -867,  28612,
+      7894,  -4190,   2494,  -1374,    648,   -241,     60,     -6,
+        81,   -249,    529,   -870,   1110,   -912,   -720,  28684,
+      7677,  -4128,   2475,  -1371,    650,   -243,     61,     -6,
+        82,   -250,    536,   -887,   1147,   -985,   -572,  28750,
+      7461,  -4065,   2455,  -1367,    652,   -246,     63,     -6,
+        82,   -252,    542,   -903,   1183,  -1058,   -421,  28817,
+      7246,  -4002,   2434,  -1363,    654,   -248,     64,     -7,
+        82,   -254,    548,   -920,   1220,  -1131,   -268,  28881,
+      7031,  -3938,   2413,  -1359,    655,   -250,     65,     -7,
+        82,   -255,    554,   -936,   1256,  -1204,   -113,  28939,
+      6818,  -3873,   2391,  -1354,    656,   -252,     66,     -7,
+        83,   -257,    560,   -952,   1292,  -1278,     44,  28995,
+      6606,  -3807,   2369,  -1349,    657,   -254,     67,     -8,
+        83,   -258,    565,   -968,   1328,  -1351,    203,  29048,
+      6394,  -3741,   2345,  -1343,    658,   -256,     69,     -8,
+        83,   -260,    571,   -984,   1364,  -1425,    363,  29098,
+      6184,  -3674,   2322,  -1337,    658,   -257,     70,     -8,
+        83,   -261,    576,   -999,   1399,  -1499,    526,  29148,
+      5975,  -3607,   2297,  -1331,    658,   -259,     71,     -9,
+        83,   -262,    582,  -1014,   1435,  -1573,    690,  29190,
+      5767,  -3539,   2272,  -1324,    658,   -260,     72,     -9,
+        83,   -263,    587,  -1029,   1470,  -1648,    857,  29230,
+      5560,  -3470,   2247,  -1316,    658,   -262,     73,     -9,
+        83,   -264,    592,  -1044,   1505,  -1722,   1025,  29270,
+      5354,  -3401,   2221,  -1309,    657,   -263,     73,     -9,
+        83,   -265,    597,  -1059,   1540,  -1797,   1195,  29304,
+      5150,  -3331,   2195,  -1301,    657,   -264,     74,    -10,
+        83,   -266,    601,  -1073,   1574,  -1871,   1367,  29336,
+      4947,  -3261,   2168,  -1293,    656,   -265,     75,    -10,
+        83,   -267,    606,  -1087,   1609,  -1945,   1541,  29362,
+      4745,  -3190,   2140,  -1284,    655,   -266,     76,    -10,
+        83,   -268,    610,  -1101,   1643,  -2020,   1716,  29389,
+      4545,  -3119,   2112,  -1275,    653,   -267,     77,    -10,
+        83,   -268,    614,  -1115,   1676,  -2094,   1893,  29412,
+      4346,  -3048,   2084,  -1266,    652,   -268,     77,    -10,
+        82,   -269,    618,  -1128,   1710,  -2169,   2072,  29432,
+      4148,  -2976,   2055,  -1256,    650,   -268,     78,    -11,
+        82,   -269,    622,  -1141,   1743,  -2243,   2253,  29447,
+      3952,  -2904,   2025,  -1246,    648,   -269,     79,    -11,
+        82,   -269,    626,  -1154,   1776,  -2317,   2435,  29458,
+      3757,  -2832,   1996,  -1235,    646,   -269,     79,    -11,
+        82,   -270,    629,  -1166,   1808,  -2391,   2619,  29470,
+      3563,  -2759,   1965,  -1225,    644,   -270,     80,    -11,
+        81,   -270,    632,  -1179,   1841,  -2465,   2805,  29477,
+      3371,  -2686,   1935,  -1214,    641,   -270,     80,    -11,
+        81,   -270,    636,  -1191,   1872,  -2539,   2992,  29478,
+      3181,  -2612,   1904,  -1202,    638,   -270,     81,    -11
+};
+
+//*****************************************************************************
+//
+// The L = 147, M = 160 polyphase bank: 147 branches of 16 taps, branch-major.
+//
+//*****************************************************************************
+static const int16_t g_pi16ResampleL147M160[147 * RESAMPLE_TAPS] =
+{
+        18,    -63,     37,    257,  -1031,   2334,  -3910,   5267,
+     27114,   5077,  -3856,   2327,  -1040,    266,     32,    -61,
+        19,    -65,     42,    247,  -1023,   2341,  -3963,   5457,
+     27111,   4889,  -3801,   2319,  -1047,    274,     27,    -59,
+        19,    -66,     48,    238,  -1014,   2346,  -4015,   5648,
+     27104,   4702,  -3746,   2311,  -1055,    283,     22,    -57,
+        19,    -68,     53,    229,  -1004,   2351,  -4067,   5841,
+     27095,   4516,  -3690,   2302,  -1062,    291,     17,    -55,
+        20,    -70,     58,    219,   -995,   2356,  -4117,   6035,
+     27081,   4331,  -3633,   2292,  -1068,    300,     12,    -53,
+        20,    -72,     64,    209,   -984,   2359,  -4167,   6229,
+     27067,   4148,  -3576,   2281,  -1074,    308,      7,    -51,
+        21,    -74,     69,    199,   -974,   2362,  -4216,   6425,
+     27049,   3966,  -3518,   2270,  -1080,    316,      2,    -49,
+        21,    -76,     75,    189,   -963,   2364,  -4264,   6621,
+     27030,   3785,  -3459,   2258,  -1085,    323,     -3,    -48,
+        22,    -78,     80,    179,   -951,   2365,  -4311,   6819,
+     27004,   3606,  -3400,   2246,  -1090,    331,     -8,    -46,
+        22,    -80,     86,    168,   -939,   2366,  -4357,   7017,
+     26978,   3427,  -3340,   2232,  -1094,    338,    -12,    -44,
+        22,    -82,     92,    157,   -927,   2365,  -4401,   7216,
+     26948,   3251,  -3280,   2219,  -1098,    345,    -17,    -42,
+        23,    -84,     97,    147,   -914,   2364,  -4445,   7416,
+     26916,   3075,  -3219,   2204,  -1102,    352,    -22,    -40,
+        23,    -86,    103,    136,   -901,   2362,  -4488,   7616,
+     26881,   2901,  -3157,   2189,  -1105,    359,    -26,    -39,
+        24,    -88,    109,    124,   -887,   2360,  -4530,   7818,
+     26840,   2729,  -3096,   2174,  -1108,    366,    -30,    -37,
+        24,    -90,    114,    113,   -873,   2356,  -4571,   8020,
+     26802,   2558,  -3033,   2157,  -1111,    372,    -35,    -35,
+        24,    -92,    120,    102,   -859,   2352,  -4610,   8222,
+     26758,   2388,  -2971,   2141,  -1113,    378,    -39,    -33,
+        25,    -93,    126,     90,   -844,   2347,  -4649,   8426,
+     26709,   2220,  -2907,   2123,  -1114,    384,    -43,    -32,
+        25,    -95,    132,     78,   -829,   2341,  -4686,   8629,
+     26661,   2054,  -2844,   2105,  -1116,    390,    -47,    -30,
+        25,    -97,    138,     66,   -813,   2334,  -4722,   8834,
+     26608,   1889,  -2780,   2087,  -1116,    395,    -52,    -28,
+        26,    -99,    144,     54,   -797,   2326,  -4757,   9039,
+     26553,   1726,  -2716,   2068,  -1117,    401,    -56,    -27,
+        26,   -101,    150,     42,   -781,   2318,  -4791,   9244,
+     26495,   1564,  -2651,   2049,  -1117,    406,    -60,    -25,
+        27,   -103,    155,     30,   -764,   2309,  -4824,   9450,
+     26433,   1404,  -2586,   2029,  -1117,    411,    -63,    -23,
+        27,   -105,    161,     17,   -747,   2299,  -4855,   9657,
+     26370,   1246,  -2521,   2008,  -1116,    416,    -67,    -22,
+        27,   -107,    167,      5,   -729,   2288,  -4885,   9864,
+     26303,   1089,  -2456,   1987,  -1115,    421,    -71,    -20,
+        28,   -109,    173,     -8,   -711,   2276,  -4913,  10071,
+     26235,    934,  -2391,   1966,  -1114,    425,    -75,    -19,
+        28,   -110,    179,    -21,   -693,   2263,  -4941,  10278,
+     26164,    780,  -2325,   1944,  -1112,    429,    -78,    -17,
+        28,   -112,    185,    -33,   -674,   2250,  -4967,  10486,
+     26089,    629,  -2259,   1921,  -1110,    433,    -82,    -16,
+        29,   -114,    191,    -47,   -655,   2235,  -4991,  10694,
+     26011,    479,  -2193,   1899,  -1108,    437,    -85,    -14,
+        29,   -116,    197,    -60,   -635,   2220,  -5014,  10902,
+     25931,    331,  -2127,   1875,  -1105,    441,    -88,    -13,
+        29,   -117,    203,    -73,   -615,   2204,  -5036,  11110,
+     25848,    184,  -2060,   1852,  -1102,    444,    -92,    -11,
+        30,   -119,    209,    -86,   -595,   2187,  -5056,  11319,
+     25761,     40,  -1994,   1828,  -1099,    448,    -95,    -10,
+        30,   -121,    215,   -100,   -574,   2170,  -5075,  11528,
+     25672,   -103,  -1927,   1803,  -1095,    451,    -98,     -8,
+        30,   -123,    221,   -113,   -553,   2151,  -5093,  11736,
+     25584,   -244,  -1861,   1778,  -1091,    454,   -101,     -7,
+        30,   -124,    227,   -127,   -531,   2131,  -5109,  11945,
+     25489,   -383,  -1794,   1753,  -1086,    456,   -104,     -5,
+        31,   -126,    233,   -141,   -509,   2111,  -5123,  12154,
+     25392,   -520,  -1728,   1727,  -1081,    459,   -107,     -4,
+        31,   -128,    239,   -154,   -487,   2090,  -5136,  12362,
+     25294,   -655,  -1661,   1701,  -1076,    461,   -110,     -3,
+        31,   -129,    245,   -168,   -465,   2068,  -5147,  12571,
+     25192,   -789,  -1595,   1675,  -1071,    464,   -113,     -1,
+        31,   -131,    251,   -182,   -442,   2045,  -5157,  12779,
+     25090,   -921,  -1529,   1648,  -1065,    466,   -115,      0,
+        32,   -132,    257,   -196,   -419,   2021,  -5165,  12988,
+     24982,  -1050,  -1462,   1621,  -1059,    467,   -118,      1,
+        32,   -134,    262,   -210,   -395,   1996,  -5171,  13196,
+     24874,  -1178,  -1396,   1594,  -1053,    469,   -120,      2,
+        32,   -135,    268,   -225,   -371,   1971,  -5176,  13404,
+     24764,  -1304,  -1330,   1566,  -1046,    470,   -123,      3,
+        32,   -137,    274,   -239,   -347,   1944,  -5179,  13611,
+     24650,  -1428,  -1264,   1538,  -1039,    472,   -125,      5,
+        32,   -138,    280,   -253,   -322,   1917,  -5181,  13818,
+     24534,  -1550,  -1198,   1510,  -1032,    473,   -128,      6,
+        33,   -140,    286,   -267,   -297,   1889,  -5181,  14025,
+     24415,  -1670,  -1133,   1482,  -1025,    474,   -130,      7,
+        33,   -141,    291,   -282,   -272,   1860,  -5179,  14232,
+     24294,  -1788,  -1067,   1453,  -1017,    475,   -132,      8,
+        33,   -142,    297,   -296,   -247,   1830,  -5176,  14438,
+     24172,  -1904,  -1002,   1424,  -1009,    475,   -134,      9,
+        33,   -144,    302,   -311,   -221,   1799,  -5170,  14644,
+     24047,  -2018,   -937,   1395,  -1001,    476,   -136,     10,
+        33,   -145,    308,   -325,   -195,   1768,  -5163,  14849,
+     23917,  -2130,   -872,   1366,   -992,    476,   -138,     11,
+        33,   -146,    314,   -340,   -169,   1735,  -5155,  15053,
+     23790,  -2240,   -808,   1336,   -983,    476,   -140,     12,
+        33,   -147,    319,   -354,   -142,   1702,  -5144,  15257,
+     23656,  -2348,   -744,   1306,   -974,    476,   -141,     13,
+        33,   -149,    325,   -369,   -115,   1668,  -5132,  15461,
+     23522,  -2454,   -680,   1276,   -965,    476,   -143,     14,
+        33,   -150,    330,   -383,    -88,   1633,  -5118,  15664,
+     23385,  -2557,   -616,   1246,   -956,    475,   -145,     15,
+        33,   -151,    335,   -398,    -60,   1597,  -5102,  15866,
+     23245,  -2659,   -553,   1216,   -946,    475,   -146,     16,
+        33,   -152,    340,   -413,    -33,   1561,  -5084,  16067,
+     23106,  -2759,   -491,   1186,   -936,    474,   -148,     17,
+        33,   -153,    346,   -427,     -5,   1523,  -5064,  16268,
+     22961,  -2857,   -428,   1155,   -926,    473,   -149,     18,
+        33,   -154,    351,   -442,     24,   1485,  -5043,  16468,
+     22815,  -2953,   -366,   1124,   -915,    472,   -150,     19,
+        33,   -155,    356,   -456,     52,   1446,  -5019,  16666,
+     22671,  -3047,   -305,   1093,   -905,    471,   -152,     19,
+        33,   -155,    361,   -471,     81,   1406,  -4994,  16865,
+     22517,  -3138,   -243,   1063,   -894,    470,   -153,     20,
+        33,   -156,    366,   -485,    109,   1365,  -4967,  17062,
+     22368,  -3228,   -183,   1032,   -883,    468,   -154,     21,
+        33,   -157,    371,   -500,    138,   1324,  -4938,  17258,
+     22214,  -3315,   -122,   1000,   -871,    466,   -155,     22,
+        33,   -158,    375,   -514,    168,   1282,  -4907,  17453,
+     22060,  -3401,    -63,    969,   -860,    465,   -156,     22,
+        33,   -158,    380,   -529,    197,   1239,  -4874,  17647,
+     21901,  -3484,     -3,    938,   -848,    463,   -157,     23,
+        33,   -159,    385,   -543,    227,   1195,  -4839,  17841,
+     21741,  -3566,     56,    907,   -837,    461,   -158,     24,
+        32,   -160,    389,   -557,    257,   1151,  -4802,  18033,
+     21581,  -3645,    114,    875,   -825,    459,   -158,     24,
+        32,   -160,    394,   -572,    287,   1105,  -4764,  18224,
+     21418,  -3722,    172,    844,   -812,    456,   -159,     25,
+        32,   -160,    398,   -586,    317,   1059,  -4723,  18413,
+     21254,  -3798,    229,    813,   -800,    454,   -160,     26,
+        32,   -161,    402,   -600,    347,   1012,  -4680,  18602,
+     21090,  -3871,    285,    781,   -788,    451,   -160,     26,
+        32,   -161,    407,   -614,    377,    965,  -4636,  18789,
+     20921,  -3942,    341,    750,   -775,    448,   -161,     27,
+        31,   -161,    411,   -628,    408,    917,  -4589,  18975,
+     20749,  -4011,    397,    719,   -762,    446,   -161,     27,
+        31,   -162,    415,   -642,    439,    868,  -4540,  19160,
+     20577,  -4078,    452,    687,   -749,    443,   -161,     28,
+        31,   -162,    419,   -656,    469,    818,  -4489,  19343,
+     20407,  -4143,    506,    656,   -736,    439,   -162,     28,
+        30,   -162,    422,   -669,    500,    768,  -4437,  19525,
+     20232,  -4206,    560,    625,   -723,    436,   -162,     29,
+        30,   -162,    426,   -683,    531,    717,  -4382,  19706,
+     20055,  -4266,    613,    593,   -710,    433,   -162,     29,
+        30,   -162,    430,   -697,    562,    665,  -4325,  19877,
+     19885,  -4325,    665,    562,   -697,    430,   -162,     30,
+        29,   -162,    433,   -710,    593,    613,  -4266,  20055,
+     19706,  -4382,    717,    531,   -683,    426,   -162,     30,
+        29,   -162,    436,   -723,    625,    560,  -4206,  20232,
+     19525,  -4437,    768,    500,   -669,    422,   -162,     30,
+        28,   -162,    439,   -736,    656,    506,  -4143,  20407,
+     19343,  -4489,    818,    469,   -656,    419,   -162,     31,
+        28,   -161,    443,   -749,    687,    452,  -4078,  20577,
+     19160,  -4540,    868,    439,   -642,    415,   -162,     31,
+        27,   -161,    446,   -762,    719,    397,  -4011,  20749,
+     18975,  -4589,    917,    408,   -628,    411,   -161,     31,
+        27,   -161,    448,   -775,    750,    341,  -3942,  20921,
+     18789,  -4636,    965,    377,   -614,    407,   -161,     32,
+        26,   -160,    451,   -788,    781,    285,  -3871,  21090,
+     18602,  -4680,   1012,    347,   -600,    402,   -161,     32,
+        26,   -160,    454,   -800,    813,    229,  -3798,  21254,
+     18413,  -4723,   1059,    317,   -586,    398,   -160,     32,
+        25,   -159,    456,   -812,    844,    172,  -3722,  21418,
+     18224,  -4764,   1105,    287,   -572,    394,   -160,     32,
+        24,   -158,    459,   -825,    875,    114,  -3645,  21581,
+     18033,  -4802,   1151,    257,   -557,    389,   -160,     32,
+        24,   -158,    461,   -837,    907,     56,  -3566,  21741,
+     17841,  -4839,   1195,    227,   -543,    385,   -159,     33,
+        23,   -157,    463,   -848,    938,     -3,  -3484,  21901,
+     17647,  -4874,   1239,    197,   -529,    380,   -158,     33,
+        22,   -156,    465,   -860,    969,    -63,  -3401,  22060,
+     17453,  -4907,   1282,    168,   -514,    375,   -158,     33,
+        22,   -155,    466,   -871,   1000,   -122,  -3315,  22214,
+     17258,  -4938,   1324,    138,   -500,    371,   -157,     33,
+        21,   -154,    468,   -883,   1032,   -183,  -3228,  22368,
+     17062,  -4967,   1365,    109,   -485,    366,   -156,     33,
+        20,   -153,    470,   -894,   1063,   -243,  -3138,  22517,
+     16865,  -4994,   1406,     81,   -471,    361,   -155,     33,
+        19,   -152,    471,   -905,   1093,   -305,  -3047,  22671,
+     16666,  -5019,   1446,     52,   -456,    356,   -155,     33,
+        19,   -150,    472,   -915,   1124,   -366,  -2953,  22815,
+     16468,  -5043,   1485,     24,   -442,    351,   -154,     33,
+        18,   -149,    473,   -926,   1155,   -428,  -2857,  22961,
+     16268,  -5064,   1523,     -5,   -427,    346,   -153,     33,
+        17,   -148,    474,   -936,   1186,   -491,  -2759,  23106,
+     16067,  -5084,   1561,    -33,   -413,    340,   -152,     33,
+        16,   -146,    475,   -946,   1216,   -553,  -2659,  23245,
+     15866,  -5102,   1597,    -60,   -398,    335,   -151,     33,
+        15,   -145,    475,   -956,   1246,   -616,  -2557,  23385,
+     15664,  -5118,   1633,    -88,   -383,    330,   -150,     33,
+        14,   -143,    476,   -965,   1276,   -680,  -2454,  23522,
+     15461,  -5132,   1668,   -115,   -369,    325,   -149,     33,
+        13,   -141,    476,   -974,   1306,   -744,  -2348,  23656,
+     15257,  -5144,   1702,   -142,   -354,    319,   -147,     33,
+        12,   -140,    476,   -983,   1336,   -808,  -2240,  23790,
+     15053,  -5155,   1735,   -169,   -340,    314,   -146,     33,
+        11,   -138,    476,   -992,   1366,   -872,  -2130,  23917,
+     14849,  -5163,   1768,   -195,   -325,    308,   -145,     33,
+        10,   -136,    476,  -1001,   1395,   -937,  -2018,  24047,
+     14644,  -5170,   1799,   -221,   -311,    302,   -144,     33,
+         9,   -134,    475,  -1009,   1424,  -1002,  -1904,  24172,
+     14438,  -5176,   1830,   -247,   -296,    297,   -142,     33,
+         8,   -132,    475,  -1017,   1453,  -1067,  -1788,  24294,
+     14232,  -5179,   1860,   -272,   -282,    291,   -141,     33,
+         7,   -130,    474,  -1025,   1482,  -1133,  -1670,  24415,
+     14025,  -5181,   1889,   -297,   -267,    286,   -140,     33,
+         6,   -128,    473,  -1032,   1510,  -1198,  -1550,  24534,
+     13818,  -5181,   1917,   -322,   -253,    280,   -138,     32,
+         5,   -125,    472,  -1039,   1538,  -1264,  -1428,  24650,
+     13611,  -5179,   1944,   -347,   -239,    274,   -137,     32,
+         3,   -123,    470,  -1046,   1566,  -1330,  -1304,  24764,
+     13404,  -5176,   1971,   -371,   -225,    268,   -135,     32,
+         2,   -120,    469,  -1053,   1594,  -1396,  -1178,  24874,
+     13196,  -5171,   1996,   -395,   -210,    262,   -134,     32,
+         1,   -118,    467,  -1059,   1621,  -1462,  -1050,  24982,
+     12988,  -5165,   2021,   -419,   -196,    257,   -132,     32,
+         0,   -115,    466,  -1065,   1648,  -1529,   -921,  25090,
+     12779,  -5157,   2045,   -442,   -182,    251,   -131,     31,
+        -1,   -113,    464,  -1071,   1675,  -1595,   -789,  25192,
+     12571,  -5147,   2068,   -465,   -168,    245,   -129,     31,
+        -3,   -110,    461,  -1076,   1701,  -1661,   -655,  25294,
+     12362,  -5136,   2090,   -487,   -154,    239,   -128,     31,
+        -4,   -107,    459,  -1081,   1727,  -1728,   -520,  25392,
+     12154,  -5123,   2111,   -509,   -141,    233,   -126,     31,
+        -5,   -104,    456,  -1086,   1753,  -1794,   -383,  25489,
+     11945,  -5109,   2131,   -531,   -127,    227,   -124,     30,
+        -7,   -101,    454,  -1091,   1778,  -1861,   -244,  25584,
+     11736,  -5093,   2151,   -553,   -113,    221,   -123,     30,
+        -8,    -98,    451,  -1095,   1803,  -1927,   -103,  25672,
+     11528,  -5075,   2170,   -574,   -100,    215,   -121,     30,
+       -10,    -95,    448,  -1099,   1828,  -1994,     40,  25761,
+     11319,  -5056,   2187,   -595,    -86,    209,   -119,     30,
+       -11,    -92,    444,  -1102,   1852,  -2060,    184,  25848,
+     11110,  -5036,   2204,   -615,    -73,    203,   -117,     29,
+       -13,    -88,    441,  -1105,   1875,  -2127,    331,  25931,
+     10902,  -5014,   2220,   -635,    -60,    197,   -116,     29,
+       -14,    -85,    437,  -1108,   1899,  -2193,    479,  26011,
+     10694,  -4991,   2235,   -655,    -47,    191,   -114,     29,
+       -16,    -82,    433,  -1110,   1921,  -2259,    629,  26089,
+     10486,  -4967,   2250,   -674,    -33,    185,   -112,     28,
+       -17,    -78,    429,  -1112,   1944,  -2325,    780,  26164,
+     10278,  -4941,   2263,   -693,    -21,    179,   -110,     28,
+       -19,    -75,    425,  -1114,   1966,  -2391,    934,  26235,
+     10071,  -4913,   2276,   -711,     -8,    173,   -109,     28,
+       -20,    -71,    421,  -1115,   1987,  -2456,   1089,  26303,
+      9864,  -4885,   2288,   -729,      5,    167,   -107,     27,
+       -22,    -67,    416,  -1116,   2008,  -2521,   1246,  26370,
+      9657,  -4855,   2299,   -747,     17,    161,   -105,     27,
+       -23,    -63,    411,  -1117,   2029,  -2586,   1404,  26433,
+      9450,  -4824,   2309,   -764,     30,    155,   -103,     27,
+       -25,    -60,    406,  -1117,   2049,  -2651,   1564,  26495,
+      9244,  -4791,   2318,   -781,     42,    150,   -101,     26,
+       -27,    -56,    401,  -1117,   2068,  -2716,   1726,  26553,
+      9039,  -4757,   2326,   -797,     54,    144,    -99,     26,
+       -28,    -52,    395,  -1116,   2087,  -2780,   1889,  26608,
+      8834,  -4722,   2334,   -813,     66,    138,    -97,     25,
+       -30,    -47,    390,  -1116,   2105,  -2844,   2054,  26661,
+      8629,  -4686,   2341,   -829,     78,    132,    -95,     25,
+       -32,    -43,    384,  -1114,   2123,  -2907,   2220,  26709,
+      8426,  -4649,   2347,   -844,     90,    126,    -93,     25,
+       -33,    -39,    378,  -1113,   2141,  -2971,   2388,  26758,
+      8222,  -4610,   2352,   -859,    102,    120,    -92,     24,
+       -35,    -35,    372,  -1111,   2157,  -3033,   2558,  26802,
+      8020,  -4571,   2356,   -873,    113,    114,    -90,     24,
+       -37,    -30,    366,  -1108,   2174,  -3096,   2729,  26840,
+      7818,  -4530,   2360,   -887,    124,    109,    -88,     24,
+       -39,    -26,    359,  -1105,   2189,  -3157,   2901,  26881,
+      7616,  -4488,   2362,   -901,    136,    103,    -86,     23,
+       -40,    -22,    352,  -1102,   2204,  -3219,   3075,  26916,
+      7416,  -4445,   2364,   -914,    147,     97,    -84,     23,
+       -42,    -17,    345,  -1098,   2219,  -3280,   3251,  26948,
+      7216,  -4401,   2365,   -927,    157,     92,    -82,     22,
+       -44,    -12,    338,  -1094,   2232,  -3340,   3427,  26978,
+      7017,  -4357,   2366,   -939,    168,     86,    -80,     22,
+       -46,     -8,    331,  -1090,   2246,  -3400,   3606,  27004,
+      6819,  -4311,   2365,   -951,    179,     80,    -78,     22,
+       -48,     -3,    323,  -1085,   2258,  -3459,   3785,  27030,
+      6621,  -4264,   2364,   -963,    189,     75,    -76,     21,
+       -49,      2,    316,  -1080,   2270,  -3518,   3966,  27049,
+      6425,  -4216,   2362,   -974,    199,     69,    -74,     21,
+       -51,      7,    308,  -1074,   2281,  -3576,   4148,  27067,
+      6229,  -4167,   2359,   -984,    209,     64,    -72,     20,
+       -53,     12,    300,  -1068,   2292,  -3633,   4331,  27081,
+      6035,  -4117,   2356,   -995,    219,     58,    -70,     20,
+       -55,     17,    291,  -1062,   2302,  -3690,   4516,  27095,
+      5841,  -4067,   2351,  -1004,    229,     53,    -68,     19,
+       -57,     22,    283,  -1055,   2311,  -3746,   4702,  27104,
+      5648,  -4015,   2346,  -1014,    238,     48,    -66,     19,
+       -59,     27,    274,  -1047,   2319,  -3801,   4889,  27111,
+      5457,  -3963,   2341,  -1023,    247,     42,    -65,     19,
+       -61,     32,    266,  -1040,   2327,  -3856,   5077,  27114,
+      5267,  -3910,   2334,  -1031,    257,     37,    -63,     18
+};
+
+//*****************************************************************************
+//
+// The L = 3, M = 2 polyphase bank: 3 branches of 16 taps, branch-major.
+//
+//*****************************************************************************
+static const int16_t g_pi16ResampleL3M2[3 * RESAMPLE_TAPS] =
+{
+        -3,     48,   -213,    608,  -1341,   2513,  -4354,   8578,
+     28366,  -1315,   -608,    939,   -771,    472,   -217,     66,
+        28,    -70,     63,    136,   -762,   2217,  -5598,  20370,
+     20370,  -5598,   2217,   -762,    136,     63,    -70,     28,
+        66,   -217,    472,   -771,    939,   -608,  -1315,  28366,
+      8578,  -4354,   2513,  -1341,    608,   -213,     48,     -3
+};
+
+//*****************************************************************************
+//
+// The L = 2, M = 3 polyphase bank: 2 branches of 16 taps, branch-major.
+//
+//*****************************************************************************
+static const int16_t g_pi16ResampleL2M3[2 * RESAMPLE_TAPS] =
+{
+        18,     17,   -307,    321,    998,  -2370,   -810,  13392,
+     18892,   5494,  -3266,   -304,    998,   -217,   -135,     47,
+        47,   -135,   -217,    998,   -304,  -3266,   5494,  18892,
+     13392,   -810,  -2370,    998,    321,   -307,     17,     18
+};
+
+//*****************************************************************************
+//
+// The supported conversions.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t ui32L;
+    uint32_t ui32M;
+    const int16_t *pi16Bank;
+}
+tResampleRatio;
+
+static const tResampleRatio g_psResampleRatios[] =
+{
+    { 160, 147, g_pi16ResampleL160M147 },   // 44.1 kHz -> 48 kHz
+    { 147, 160, g_pi16ResampleL147M160 },   // 48 kHz -> 44.1 kHz
+    { 3, 2, g_pi16ResampleL3M2 },           // 32 kHz -> 48 kHz
+    { 2, 3, g_pi16ResampleL2M3 }            // 48 kHz -> 32 kHz
+};
+
+#define NUM_RESAMPLE_RATIOS     (sizeof(g_psResampleRatios) /                 \
+                                 sizeof(g_psResampleRatios[0]))
+
+//*****************************************************************************
+//
+// Returns the greatest common divisor of two rates.
+//
+//*****************************************************************************
+static uint32_t
+ResampleGCD(uint32_t ui32A, uint32_t ui32B)
+{
+    uint32_t ui32T;
+
+    while(ui32B)
+    {
+        ui32T = ui32A % ui32B;
+        ui32A = ui32B;
+        ui32B = ui32T;
+    }
+    return(ui32A);
+}
+
+//*****************************************************************************
+//
+//! Initializes a converter.
+//!
+//! \param psRS is a pointer to the converter state.
+//! \param ui32InRate is the input sample rate in Hz.
+//! \param ui32OutRate is the output sample rate in Hz.
+//!
+//! The ratio of the rates is reduced to lowest terms and looked up among the
+//! precomputed banks: 44.1 kHz <-> 48 kHz and 32 kHz <-> 48 kHz (or any pair
+//! of rates in the same ratios).  Equal rates give a pass-through converter.
+//!
+//! \return Returns \b true on success or \b false if the ratio is not
+//! supported.
+//
+//*****************************************************************************
+bool
+ResampleInit(tResampler *psRS, uint32_t ui32InRate, uint32_t ui32OutRate)
+{
+    uint32_t ui32GCD, ui32L, ui32M, ui32Idx;
+
+    memset(psRS, 0, sizeof(tResampler));
+    if(!ui32InRate || !ui32OutRate)
+    {
+        return(false);
+    }
+
+    ui32GCD = ResampleGCD(ui32InRate, ui32OutRate);
+    ui32L = ui32OutRate / ui32GCD;
+    ui32M = ui32InRate / ui32GCD;
+
+    if(ui32L == ui32M)
+    {
+        psRS->ui32L = 1;
+        psRS->ui32M = 1;
+        return(true);
+    }
+
+    for(ui32Idx = 0; ui32Idx < NUM_RESAMPLE_RATIOS; ui32Idx++)
+    {
+        if((g_psResampleRatios[ui32Idx].ui32L == ui32L) &&
+           (g_psResampleRatios[ui32Idx].ui32M == ui32M))
+        {
+            psRS->pi16Bank = g_psResampleRatios[ui32Idx].pi16Bank;
+            psRS->ui32L = ui32L;
+            psRS->ui32M = ui32M;
+            return(true);
+        }
+    }
+
+    return(false);
+}
+
+//*****************************************************************************
+//
+//! Converts a block of samples.
+//!
+//! \param psRS is a pointer to the converter state.
+//! \param pi32In points to the input samples.
+//! \param ui32Count is the number of input samples.
+//! \param pi32Out points to the buffer that receives the output samples; it
+//! must hold ResampleOutputMax() samples.
+//!
+//! The converter is fully streaming: any block length may be passed and the
+//! output phase carries over between calls, so the long-run output count is
+//! exactly \e ui32Count * L / M.  Each output costs \b RESAMPLE_TAPS MACs.
+//! The cost per output sample is recorded under \b PERF_PROBE_RESAMPLE.
+//!
+//! \return Returns the number of output samples written.
+//
+//*****************************************************************************
+uint32_t
+ResampleProcess(tResampler *psRS, const int32_t *pi32In, uint32_t ui32Count,
+                int32_t *pi32Out)
+{
+    uint32_t ui32Idx, ui32K, ui32NumOut;
+    const int32_t *pi32X;
+    const int16_t *pi16H;
+    int64_t i64Acc;
+
+    if(psRS->ui32L == psRS->ui32M)
+    {
+        memcpy(pi32Out, pi32In, ui32Count * sizeof(int32_t));
+        return(ui32Count);
+    }
+
+    PerfStart(PERF_PROBE_RESAMPLE);
+
+    ui32NumOut = 0;
+    for(ui32Idx = 0; ui32Idx < ui32Count; ui32Idx++)
+    {
+        psRS->ui32Pos = (psRS->ui32Pos ? psRS->ui32Pos : RESAMPLE_TAPS) - 1;
+        psRS->pi32Delay[psRS->ui32Pos] = pi32In[ui32Idx];
+        psRS->pi32Delay[psRS->ui32Pos + RESAMPLE_TAPS] = pi32In[ui32Idx];
+        pi32X = &psRS->pi32Delay[psRS->ui32Pos];
+
+        //
+        // Emit every output that falls between this input and the next.
+        //
+        while(psRS->ui32Phase < psRS->ui32L)
+        {
+            pi16H = &psRS->pi16Bank[psRS->ui32Phase * RESAMPLE_TAPS];
+            i64Acc = 0;
+            for(ui32K = 0; ui32K < RESAMPLE_TAPS; ui32K++)
+            {
+                i64Acc += (int64_t)pi16H[ui32K] * pi32X[ui32K];
+            }
+            i64Acc >>= 15;
+            if(i64Acc > 0x7fffffff)
+            {
+                i64Acc = 0x7fffffff;
+            }
+            else if(i64Acc < -0x7fffffff - 1)
+            {
+                i64Acc = -0x7fffffff - 1;
+            }
+            pi32Out[ui32NumOut++] = (int32_t)i64Acc;
+            psRS->ui32Phase += psRS->ui32M;
+        }
+        psRS->ui32Phase -= psRS->ui32L;
+    }
+
+    PerfStop(PERF_PROBE_RESAMPLE, ui32NumOut);
+
+    return(ui32NumOut);
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -0,0 +1,91 @@
+//*****************************************************************************
+//
+// resample.h - Prototypes for the rational sample-rate converter.
+//
+//*****************************************************************************
+
+#ifndef __RESAMPLE_H__
+#define __RESAMPLE_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The number of taps in every polyphase branch.  Each output sample costs
+// exactly this many MACs whatever the ratio.
+//
+//*****************************************************************************
+#define RESAMPLE_TAPS           16
+
+//*****************************************************************************
+//
+// The state of one converter.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The polyphase bank, RESAMPLE_TAPS taps per branch, branch-major.
+    //
+    const int16_t *pi16Bank;
+
+    //
+    // The interpolation and decimation factors; the output rate is the input
+    // rate times L / M.
+    //
+    uint32_t ui32L;
+    uint32_t ui32M;
+
+    //
+    // The branch that produces the next output.  Outputs are due while it is
+    // below L; each output advances it by M and each input takes L off it.
+    //
+    uint32_t ui32Phase;
+
+    //
+    // The input delay line, stored twice so that the newest RESAMPLE_TAPS
+    // samples are always contiguous from pi32Delay[ui32Pos].
+    //
+    int32_t pi32Delay[2 * RESAMPLE_TAPS];
+    uint32_t ui32Pos;
+}
+tResampler;
+
+//*****************************************************************************
+//
+// Returns the largest number of outputs ResampleProcess() can produce from
+// ui32Count inputs.
+//
+//*****************************************************************************
+#define ResampleOutputMax(psRS, ui32Count)                                    \
+        ((((ui32Count) * (psRS)->ui32L) / (psRS)->ui32M) + 1)
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern bool ResampleInit(tResampler *psRS, uint32_t ui32InRate,
+                         uint32_t ui32OutRate);
+extern uint32_t ResampleProcess(tResampler *psRS, const int32_t *pi32In,
+                                uint32_t ui32Count, int32_t *pi32Out);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __RESAMPLE_H__
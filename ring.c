@@ -0,0 +1,389 @@
+//*****************************************************************************
+//
+// ring.c - Single-producer, single-consumer byte ring.
+//
+// One side fills the ring and the other drains it, typically one from an
+// interrupt handler and the other from the main loop, with no lock between
+// them.  The capacity is a power of two so that the free-running indices are
+// reduced to buffer offsets with a mask.
+//
+// The producer copies its data in before it publishes the new input index,
+// and the consumer copies its data out before it publishes the new output
+// index; a barrier between the two keeps both the compiler and the core from
+// reordering them.  Data can be moved with a copy (RingWrite(), RingRead())
+// or in place, by asking for the largest contiguous span and committing what
+// was used of it, which suits DMA and block device transfers.
+//
+// The module uses no target peripherals and builds for the host as well.
+// The mikroC examples under WM8731 build it too, without the benchmark,
+// which needs the perf module.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#if defined(__ARMCC_VERSION) || defined(__arm__)
+#include "CU_TM4C123.h"
+#endif
+#ifndef __MIKROC_PRO_FOR_PIC32__
+#include "perf.h"
+#endif
+#include "ring.h"
+
+//*****************************************************************************
+//
+//! \addtogroup ring_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The memory barrier between the data and the index that publishes it.  On
+// the Cortex-M4 the DMB is also a compiler barrier.  Hosts with GCC get a
+// full barrier.  Elsewhere the volatile indices only order the accesses in
+// the compiler, which is enough on a single in-order core.
+//
+//*****************************************************************************
+#if defined(__ARMCC_VERSION) || defined(__arm__)
+#define RING_BARRIER()          __DMB()
+#elif defined(__GNUC__)
+#define RING_BARRIER()          __sync_synchronize()
+#else
+#define RING_BARRIER()
+#endif
+
+//*****************************************************************************
+//
+// The number of bytes passed through the ring per benchmark run.
+//
+//*****************************************************************************
+#define RING_BENCHMARK_BYTES    16384
+
+//*****************************************************************************
+//
+//! Initializes a ring.
+//!
+//! \param psRing is a pointer to the ring state.
+//! \param pui8Buf points to the storage.
+//! \param ui32Size is the size of the storage in bytes, a power of two.
+//!
+//! The ring starts empty.  Neither side may be using it while it is
+//! initialized.
+//!
+//! \return Returns \b true on success or \b false if the size is not a
+//! power of two.
+//
+//*****************************************************************************
+bool
+RingInit(tRing *psRing, uint8_t *pui8Buf, uint32_t ui32Size)
+{
+    if((ui32Size == 0) || (ui32Size & (ui32Size - 1)))
+    {
+        return(false);
+    }
+
+    psRing->pui8Buf = pui8Buf;
+    psRing->ui32Mask = ui32Size - 1;
+    psRing->ui32In = 0;
+    psRing->ui32Out = 0;
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Returns the number of bytes waiting in a ring.
+//!
+//! \param psRing is a pointer to the ring state.
+//!
+//! Called by the consumer the result is a lower bound, and called by the
+//! producer an upper bound, since the other side may move on meanwhile.
+//!
+//! \return Returns the number of bytes that can be read.
+//
+//*****************************************************************************
+uint32_t
+RingUsed(tRing *psRing)
+{
+    return(psRing->ui32In - psRing->ui32Out);
+}
+
+//*****************************************************************************
+//
+//! Returns the free space in a ring.
+//!
+//! \param psRing is a pointer to the ring state.
+//!
+//! Called by the producer the result is a lower bound.
+//!
+//! \return Returns the number of bytes that can be written.
+//
+//*****************************************************************************
+uint32_t
+RingFree(tRing *psRing)
+{
+    return(psRing->ui32Mask + 1 - (psRing->ui32In - psRing->ui32Out));
+}
+
+//*****************************************************************************
+//
+//! Returns the largest contiguous free span of a ring.
+//!
+//! \param psRing is a pointer to the ring state.
+//! \param ppui8Span is a pointer to the location that receives the start of
+//! the span.
+//!
+//! The producer fills some or all of the span and then publishes it with
+//! RingWriteCommit().  When the free space wraps around the end of the
+//! storage only the part up to the end is returned; the rest follows as the
+//! next span.
+//!
+//! \return Returns the size of the span in bytes, 0 if the ring is full.
+//
+//*****************************************************************************
+uint32_t
+RingWriteSpanGet(tRing *psRing, uint8_t **ppui8Span)
+{
+    uint32_t ui32In, ui32Offset, ui32Free;
+
+    ui32In = psRing->ui32In;
+    ui32Free = psRing->ui32Mask + 1 - (ui32In - psRing->ui32Out);
+    ui32Offset = ui32In & psRing->ui32Mask;
+    if(ui32Free > (psRing->ui32Mask + 1 - ui32Offset))
+    {
+        ui32Free = psRing->ui32Mask + 1 - ui32Offset;
+    }
+
+    *ppui8Span = &psRing->pui8Buf[ui32Offset];
+    return(ui32Free);
+}
+
+//*****************************************************************************
+//
+//! Publishes bytes written into a span.
+//!
+//! \param psRing is a pointer to the ring state.
+//! \param ui32Count is the number of bytes written, no more than the span
+//! returned by RingWriteSpanGet().
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+RingWriteCommit(tRing *psRing, uint32_t ui32Count)
+{
+    RING_BARRIER();
+    psRing->ui32In += ui32Count;
+}
+
+//*****************************************************************************
+//
+//! Returns the largest contiguous span of waiting bytes in a ring.
+//!
+//! \param psRing is a pointer to the ring state.
+//! \param ppui8Span is a pointer to the location that receives the start of
+//! the span.
+//!
+//! The consumer uses some or all of the span and then releases it with
+//! RingReadCommit().  When the data wraps around the end of the storage only
+//! the part up to the end is returned; the rest follows as the next span.
+//!
+//! \return Returns the size of the span in bytes, 0 if the ring is empty.
+//
+//*****************************************************************************
+uint32_t
+RingReadSpanGet(tRing *psRing, const uint8_t **ppui8Span)
+{
+    uint32_t ui32Out, ui32Offset, ui32Used;
+
+    ui32Out = psRing->ui32Out;
+    ui32Used = psRing->ui32In - ui32Out;
+    RING_BARRIER();
+    ui32Offset = ui32Out & psRing->ui32Mask;
+    if(ui32Used > (psRing->ui32Mask + 1 - ui32Offset))
+    {
+        ui32Used = psRing->ui32Mask + 1 - ui32Offset;
+    }
+
+    *ppui8Span = &psRing->pui8Buf[ui32Offset];
+    return(ui32Used);
+}
+
+//*****************************************************************************
+//
+//! Releases bytes read from a span.
+//!
+//! \param psRing is a pointer to the ring state.
+//! \param ui32Count is the number of bytes used, no more than the span
+//! returned by RingReadSpanGet().
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+RingReadCommit(tRing *psRing, uint32_t ui32Count)
+{
+    RING_BARRIER();
+    psRing->ui32Out += ui32Count;
+}
+
+//*****************************************************************************
+//
+//! Copies bytes into a ring.
+//!
+//! \param psRing is a pointer to the ring state.
+//! \param pui8Data points to the bytes.
+//! \param ui32Count is the number of bytes.
+//!
+//! As many bytes are written as there is space for.
+//!
+//! \return Returns the number of bytes written.
+//
+//*****************************************************************************
+uint32_t
+RingWrite(tRing *psRing, const uint8_t *pui8Data, uint32_t ui32Count)
+{
+    uint8_t *pui8Span;
+    uint32_t ui32Span, ui32Done;
+
+    ui32Done = 0;
+    while(ui32Done < ui32Count)
+    {
+        ui32Span = RingWriteSpanGet(psRing, &pui8Span);
+        if(ui32Span == 0)
+        {
+            break;
+        }
+        if(ui32Span > (ui32Count - ui32Done))
+        {
+            ui32Span = ui32Count - ui32Done;
+        }
+
+        memcpy(pui8Span, &pui8Data[ui32Done], ui32Span);
+        RingWriteCommit(psRing, ui32Span);
+        ui32Done += ui32Span;
+    }
+
+    return(ui32Done);
+}
+
+//*****************************************************************************
+//
+//! Copies bytes out of a ring.
+//!
+//! \param psRing is a pointer to the ring state.
+//! \param pui8Data points to the buffer that receives the bytes.
+//! \param ui32Count is the number of bytes wanted.
+//!
+//! As many bytes are read as are waiting.
+//!
+//! \return Returns the number of bytes read.
+//
+//*****************************************************************************
+uint32_t
+RingRead(tRing *psRing, uint8_t *pui8Data, uint32_t ui32Count)
+{
+    const uint8_t *pui8Span;
+    uint32_t ui32Span, ui32Done;
+
+    ui32Done = 0;
+    while(ui32Done < ui32Count)
+    {
+        ui32Span = RingReadSpanGet(psRing, &pui8Span);
+        if(ui32Span == 0)
+        {
+            break;
+        }
+        if(ui32Span > (ui32Count - ui32Done))
+        {
+            ui32Span = ui32Count - ui32Done;
+        }
+
+        memcpy(&pui8Data[ui32Done], pui8Span, ui32Span);
+        RingReadCommit(psRing, ui32Span);
+        ui32Done += ui32Span;
+    }
+
+    return(ui32Done);
+}
+
+#ifndef __MIKROC_PRO_FOR_PIC32__
+//*****************************************************************************
+//
+// The state of RingBenchmark() between its steps.
+//
+//*****************************************************************************
+typedef struct
+{
+    tRing sRing;
+    uint8_t *pui8Scratch;
+    uint32_t ui32Chunk;
+}
+tRingBenchmark;
+
+//*****************************************************************************
+//
+// Passes RING_BENCHMARK_BYTES through the ring for RingBenchmark().
+//
+//*****************************************************************************
+static void
+RingBenchmarkPass(void *pvArg)
+{
+    tRingBenchmark *psBench;
+    uint32_t ui32Moved;
+
+    psBench = (tRingBenchmark *)pvArg;
+    for(ui32Moved = 0; ui32Moved < RING_BENCHMARK_BYTES;
+        ui32Moved += psBench->ui32Chunk)
+    {
+        RingWrite(&psBench->sRing, psBench->pui8Scratch, psBench->ui32Chunk);
+        RingRead(&psBench->sRing, psBench->pui8Scratch, psBench->ui32Chunk);
+    }
+}
+
+//*****************************************************************************
+//
+//! Measures the throughput of a ring.
+//!
+//! \param pui8Buf points to the ring storage.
+//! \param ui32Size is the size of the storage in bytes, a power of two.
+//! \param pui8Scratch points to a buffer of \e ui32Chunk bytes.
+//! \param ui32Chunk is the number of bytes moved per call, no more than
+//! \e ui32Size.
+//!
+//! Blocks of \e ui32Chunk bytes are written to the ring and read back in
+//! turn, so that the transfers straddle the end of the storage as they would
+//! in use.  The passes are timed with PerfBenchmarkRun().
+//!
+//! \return Returns the cost of passing 1 KB through the ring, or 0 if the
+//! dimensions are not supported.
+//
+//*****************************************************************************
+uint32_t
+RingBenchmark(uint8_t *pui8Buf, uint32_t ui32Size, uint8_t *pui8Scratch,
+              uint32_t ui32Chunk)
+{
+    tRingBenchmark sBench;
+
+    if(!RingInit(&sBench.sRing, pui8Buf, ui32Size) || (ui32Chunk == 0) ||
+       (ui32Chunk > ui32Size))
+    {
+        return(0);
+    }
+    sBench.pui8Scratch = pui8Scratch;
+    sBench.ui32Chunk = ui32Chunk;
+    PerfPatternFill8(pui8Scratch, ui32Chunk);
+
+    return(PerfBenchmarkRun(0, RingBenchmarkPass, &sBench) /
+           (RING_BENCHMARK_BYTES / 1024));
+}
+#endif
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -0,0 +1,66 @@
+//*****************************************************************************
+//
+// ring.h - Prototypes for the single-producer, single-consumer byte ring.
+//
+//*****************************************************************************
+
+#ifndef __RING_H__
+#define __RING_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// A ring instance.  The capacity is a power of two and the indices run
+// freely, wrapping at 2^32, so that the fill level is always their
+// difference and a full ring needs no spare byte to tell it from an empty
+// one.  Only the producer writes ui32In and only the consumer writes ui32Out.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint8_t *pui8Buf;
+    uint32_t ui32Mask;
+    volatile uint32_t ui32In;
+    volatile uint32_t ui32Out;
+}
+tRing;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern bool RingInit(tRing *psRing, uint8_t *pui8Buf, uint32_t ui32Size);
+extern uint32_t RingUsed(tRing *psRing);
+extern uint32_t RingFree(tRing *psRing);
+extern uint32_t RingWrite(tRing *psRing, const uint8_t *pui8Data,
+                          uint32_t ui32Count);
+extern uint32_t RingRead(tRing *psRing, uint8_t *pui8Data,
+                         uint32_t ui32Count);
+extern uint32_t RingWriteSpanGet(tRing *psRing, uint8_t **ppui8Span);
+extern void RingWriteCommit(tRing *psRing, uint32_t ui32Count);
+extern uint32_t RingReadSpanGet(tRing *psRing, const uint8_t **ppui8Span);
+extern void RingReadCommit(tRing *psRing, uint32_t ui32Count);
+extern uint32_t RingBenchmark(uint8_t *pui8Buf, uint32_t ui32Size,
+                              uint8_t *pui8Scratch, uint32_t ui32Chunk);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __RING_H__
@@ -0,0 +1,341 @@
+//*****************************************************************************
+//
+// specsub.c - Single-channel spectral noise suppression.
+//
+// The input is analysed with a short-time fixed-point real FFT; the noise
+// floor of every bin is tracked from the minima of its smoothed power, each
+// bin is scaled by a gain computed from its power and the floor, and the
+// frames are resynthesized by overlap-add.
+//
+// Two gain rules are provided.  Power spectral subtraction serves installs
+// without a separate noise reference, where the two-input canceller cannot
+// run.  The Wiener rule, with the a priori SNR of each bin smoothed by the
+// decision-directed estimator, serves as a post-filter on the canceller
+// output: it removes the residual that the canceller leaves when the
+// reference is only partly coherent with the noise at the primary input,
+// with much less musical noise than subtraction.
+//
+// Square-root Hann windows are used for both analysis and synthesis, so the
+// overlapped window products sum to exactly one.  Each analysis frame is
+// normalized with one CLZ pass before the transform so that quiet passages
+// keep their resolution through the 1/N scaling of the FFT.
+//
+//*****************************************************************************
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "dsp_q15.h"
+#include "anc.h"
+#include "fft.h"
+#include "perf.h"
+#include "specsub.h"
+
+//*****************************************************************************
+//
+//! \addtogroup specsub_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The square-root periodic Hann window, sin(pi n / N) in Q15.
+//
+//*****************************************************************************
+static const int16_t g_pi16SpecSubWindow[SPECSUB_FFT_SIZE] =
+{
+         0,    804,   1608,   2411,   3212,   4011,   4808,   5602,
+      6393,   7180,   7962,   8740,   9512,  10279,  11039,  11793,
+     12540,  13279,  14010,  14733,  15447,  16151,  16846,  17531,
+     18205,  18868,  19520,  20160,  20788,  21403,  22006,  22595,
+     23170,  23732,  24279,  24812,  25330,  25833,  26320,  26791,
+     27246,  27684,  28106,  28511,  28899,  29269,  29622,  29957,
+     30274,  30572,  30853,  31114,  31357,  31581,  31786,  31972,
+     32138,  32286,  32413,  32522,  32610,  32679,  32729,  32758,
+     32767,  32758,  32729,  32679,  32610,  32522,  32413,  32286,
+     32138,  31972,  31786,  31581,  31357,  31114,  30853,  30572,
+     30274,  29957,  29622,  29269,  28899,  28511,  28106,  27684,
+     27246,  26791,  26320,  25833,  25330,  24812,  24279,  23732,
+     23170,  22595,  22006,  21403,  20788,  20160,  19520,  18868,
+     18205,  17531,  16846,  16151,  15447,  14733,  14010,  13279,
+     12540,  11793,  11039,  10279,   9512,   8740,   7962,   7180,
+      6393,   5602,   4808,   4011,   3212,   2411,   1608,    804
+};
+
+//*****************************************************************************
+//
+// Resamples one per-bin spectrum in place from bins spaced at ui32OldRate /
+// SPECSUB_FFT_SIZE to bins spaced at ui32NewRate / SPECSUB_FFT_SIZE, by
+// linear interpolation.  Bins above the old Nyquist frequency take the value
+// of the last old bin.
+//
+//*****************************************************************************
+static void
+SpecSubBinsResample(float *pfBins, uint32_t ui32OldRate, uint32_t ui32NewRate)
+{
+    float pfOld[SPECSUB_BINS];
+    float fRatio, fPos, fFrac;
+    uint32_t ui32Idx, ui32Bin;
+
+    memcpy(pfOld, pfBins, sizeof(pfOld));
+    fRatio = (float)ui32NewRate / (float)ui32OldRate;
+    for(ui32Idx = 0; ui32Idx < SPECSUB_BINS; ui32Idx++)
+    {
+        fPos = (float)ui32Idx * fRatio;
+        ui32Bin = (uint32_t)fPos;
+        if(ui32Bin >= (SPECSUB_BINS - 1))
+        {
+            pfBins[ui32Idx] = pfOld[SPECSUB_BINS - 1];
+        }
+        else
+        {
+            fFrac = fPos - (float)ui32Bin;
+            pfBins[ui32Idx] = ((1.0f - fFrac) * pfOld[ui32Bin]) +
+                              (fFrac * pfOld[ui32Bin + 1]);
+        }
+    }
+}
+
+//*****************************************************************************
+//
+//! Initializes a suppressor.
+//!
+//! \param psSS is a pointer to the suppressor state.
+//! \param ui32Rule is the gain rule, \b SPECSUB_RULE_SUBTRACT or
+//! \b SPECSUB_RULE_WIENER.
+//! \param ui32Probe is the instrumentation probe that receives the cycles
+//! per frame.
+//!
+//! The noise floor starts at zero and settles over the first frames.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SpecSubInit(tSpecSub *psSS, uint32_t ui32Rule, uint32_t ui32Probe)
+{
+    memset(psSS, 0, sizeof(tSpecSub));
+    FFTRealInit(&psSS->sFFT, SPECSUB_FFT_SIZE);
+    psSS->ui32Rule = ui32Rule;
+    psSS->ui32Probe = ui32Probe;
+}
+
+//*****************************************************************************
+//
+//! Clears a suppressor's history.
+//!
+//! \param psSS is a pointer to the suppressor state.
+//!
+//! The input window, the overlap and the spectra are cleared as by
+//! SpecSubInit(), while the rule and the probe are kept.  This is for a
+//! suppressor that is about to run again after frames it did not see, so
+//! that it neither adds a stale overlap to its first output nor suppresses
+//! with a stale noise floor.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SpecSubReset(tSpecSub *psSS)
+{
+    memset(psSS->pi16Input, 0, sizeof(psSS->pi16Input));
+    memset(psSS->pi16Overlap, 0, sizeof(psSS->pi16Overlap));
+    memset(psSS->pfPower, 0, sizeof(psSS->pfPower));
+    memset(psSS->pfNoise, 0, sizeof(psSS->pfNoise));
+    memset(psSS->pfClean, 0, sizeof(psSS->pfClean));
+}
+
+//*****************************************************************************
+//
+//! Suppresses the stationary noise in one frame.
+//!
+//! \param psSS is a pointer to the suppressor state.
+//! \param pi32In points to \b SPECSUB_HOP input samples, full scale at 32
+//! bits.
+//! \param pi32Out points to the buffer that receives \b SPECSUB_HOP output
+//! samples.  It may alias \e pi32In.
+//!
+//! The frames are those of the canceller, so no buffering is added beyond the
+//! overlap; the output lags the input by one hop.  The cycles per frame are
+//! recorded under the probe given to SpecSubInit().
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SpecSubProcess(tSpecSub *psSS, const int32_t *pi32In, int32_t *pi32Out)
+{
+    int16_t pi16Buf[SPECSUB_FFT_SIZE + 2];
+    uint32_t ui32Idx, ui32Mag, ui32Shift;
+    float fScale, fPower, fNoise, fSNR, fGain;
+    int32_t i32Re, i32Im, i32Gain;
+
+    PerfStart(psSS->ui32Probe);
+
+    //
+    // Slide the new hop into the analysis history.
+    //
+    memmove(psSS->pi16Input, &psSS->pi16Input[SPECSUB_HOP],
+            SPECSUB_HOP * sizeof(int16_t));
+    for(ui32Idx = 0; ui32Idx < SPECSUB_HOP; ui32Idx++)
+    {
+        psSS->pi16Input[SPECSUB_HOP + ui32Idx] =
+            (int16_t)(pi32In[ui32Idx] >> 16);
+    }
+
+    //
+    // Window, then scale the frame up to just below full scale.
+    //
+    ui32Mag = 0;
+    for(ui32Idx = 0; ui32Idx < SPECSUB_FFT_SIZE; ui32Idx++)
+    {
+        pi16Buf[ui32Idx] = (int16_t)(((int32_t)psSS->pi16Input[ui32Idx] *
+                                      g_pi16SpecSubWindow[ui32Idx]) >> 15);
+        ui32Mag |= (uint32_t)(pi16Buf[ui32Idx] ^ (pi16Buf[ui32Idx] >> 15));
+    }
+    ui32Shift = ui32Mag ? (DSPCountLeadingZeros(ui32Mag) - 17) : 0;
+    for(ui32Idx = 0; ui32Idx < SPECSUB_FFT_SIZE; ui32Idx++)
+    {
+        pi16Buf[ui32Idx] = (int16_t)((uint32_t)pi16Buf[ui32Idx] << ui32Shift);
+    }
+
+    FFTRealForward(&psSS->sFFT, pi16Buf);
+
+    //
+    // Per-bin noise tracking and gain.  Powers are brought back to a common
+    // scale by undoing the frame normalization.
+    //
+    fScale = 1.0f / (float)(1UL << (2 * ui32Shift));
+    for(ui32Idx = 0; ui32Idx < SPECSUB_BINS; ui32Idx++)
+    {
+        i32Re = pi16Buf[2 * ui32Idx];
+        i32Im = pi16Buf[(2 * ui32Idx) + 1];
+        fPower = (float)((i32Re * i32Re) + (i32Im * i32Im)) * fScale;
+
+        psSS->pfPower[ui32Idx] = (SPECSUB_POWER_SMOOTH *
+                                  psSS->pfPower[ui32Idx]) +
+                                 ((1.0f - SPECSUB_POWER_SMOOTH) * fPower);
+
+        //
+        // The floor follows the smoothed power straight down and creeps up
+        // at a bounded rate, approximating a running minimum without a
+        // search window.
+        //
+        if(psSS->pfPower[ui32Idx] < psSS->pfNoise[ui32Idx])
+        {
+            psSS->pfNoise[ui32Idx] = psSS->pfPower[ui32Idx];
+        }
+        else
+        {
+            psSS->pfNoise[ui32Idx] *= SPECSUB_NOISE_RISE;
+            if(psSS->pfNoise[ui32Idx] == 0.0f)
+            {
+                psSS->pfNoise[ui32Idx] = psSS->pfPower[ui32Idx];
+            }
+        }
+
+        if(psSS->ui32Rule == SPECSUB_RULE_WIENER)
+        {
+            //
+            // Decision-directed a priori SNR: the clean power of the last
+            // frame blended with the instantaneous excess over the noise,
+            // then G = SNR / (1 + SNR).
+            //
+            fNoise = SPECSUB_WIENER_BIAS * psSS->pfNoise[ui32Idx];
+            if(fNoise > 0.0f)
+            {
+                fSNR = (fPower > fNoise) ? ((fPower - fNoise) / fNoise) :
+                       0.0f;
+                fSNR = (SPECSUB_DD_SMOOTH * psSS->pfClean[ui32Idx] / fNoise) +
+                       ((1.0f - SPECSUB_DD_SMOOTH) * fSNR);
+                fGain = fSNR / (1.0f + fSNR);
+            }
+            else
+            {
+                fGain = 1.0f;
+            }
+            if(fGain < SPECSUB_GAIN_FLOOR)
+            {
+                fGain = SPECSUB_GAIN_FLOOR;
+            }
+            psSS->pfClean[ui32Idx] = fGain * fGain * fPower;
+        }
+        else
+        {
+            //
+            // Power subtraction: |G|^2 = 1 - noise / power.
+            //
+            fNoise = SPECSUB_OVERSUB * psSS->pfNoise[ui32Idx];
+            fGain = (fPower > 0.0f) ? (1.0f - (fNoise / fPower)) : 0.0f;
+            if(fGain < (SPECSUB_GAIN_FLOOR * SPECSUB_GAIN_FLOOR))
+            {
+                fGain = SPECSUB_GAIN_FLOOR * SPECSUB_GAIN_FLOOR;
+            }
+            fGain = sqrtf(fGain);
+        }
+        i32Gain = (int32_t)(fGain * 32767.0f);
+
+        pi16Buf[2 * ui32Idx] = (int16_t)((i32Re * i32Gain) >> 15);
+        pi16Buf[(2 * ui32Idx) + 1] = (int16_t)((i32Im * i32Gain) >> 15);
+    }
+
+    FFTRealInverse(&psSS->sFFT, pi16Buf);
+
+    //
+    // Undo the normalization, apply the synthesis window and overlap-add.
+    //
+    for(ui32Idx = 0; ui32Idx < SPECSUB_FFT_SIZE; ui32Idx++)
+    {
+        pi16Buf[ui32Idx] = (int16_t)((((int32_t)pi16Buf[ui32Idx] >>
+                                       ui32Shift) *
+                                      g_pi16SpecSubWindow[ui32Idx]) >> 15);
+    }
+    for(ui32Idx = 0; ui32Idx < SPECSUB_HOP; ui32Idx++)
+    {
+        pi32Out[ui32Idx] = (int32_t)DSPSat16((int32_t)pi16Buf[ui32Idx] +
+                                             psSS->pi16Overlap[ui32Idx]) << 16;
+        psSS->pi16Overlap[ui32Idx] = pi16Buf[SPECSUB_HOP + ui32Idx];
+    }
+
+    PerfStop(psSS->ui32Probe, 1);
+}
+
+//*****************************************************************************
+//
+//! Carries a suppressor's spectra over to a new sample rate.
+//!
+//! \param psSS is a pointer to the suppressor state.
+//! \param ui32OldRate is the rate the suppressor has been running at.
+//! \param ui32NewRate is the rate of the frames that follow.
+//!
+//! The bins keep their number but not their frequencies, so the smoothed
+//! power, the noise floor and the clean power are resampled onto the new bin
+//! frequencies instead of being cleared.  The suppressor then goes on
+//! suppressing at once rather than letting the noise through while the floor
+//! settles again.  The overlap is kept; it only affects the first frame.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SpecSubRateSet(tSpecSub *psSS, uint32_t ui32OldRate, uint32_t ui32NewRate)
+{
+    if((ui32OldRate == 0) || (ui32NewRate == 0) ||
+       (ui32OldRate == ui32NewRate))
+    {
+        return;
+    }
+
+    SpecSubBinsResample(psSS->pfPower, ui32OldRate, ui32NewRate);
+    SpecSubBinsResample(psSS->pfNoise, ui32OldRate, ui32NewRate);
+    SpecSubBinsResample(psSS->pfClean, ui32OldRate, ui32NewRate);
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -0,0 +1,131 @@
+//*****************************************************************************
+//
+// specsub.h - Prototypes for the single-microphone spectral subtraction.
+//
+//*****************************************************************************
+
+#ifndef __SPECSUB_H__
+#define __SPECSUB_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The STFT dimensions.  The hop is one canceller frame, so a suppressor runs
+// on the canceller's frames, either in its place or after it; the transform
+// spans two hops with 50% overlap.
+//
+//*****************************************************************************
+#define SPECSUB_HOP             ANC_FRAME_SIZE
+#define SPECSUB_FFT_SIZE        (2 * SPECSUB_HOP)
+#define SPECSUB_BINS            ((SPECSUB_FFT_SIZE / 2) + 1)
+
+//*****************************************************************************
+//
+// Values that can be passed to SpecSubInit() as the ui32Rule parameter.
+//
+//*****************************************************************************
+#define SPECSUB_RULE_SUBTRACT   0x00000000  // Power spectral subtraction
+#define SPECSUB_RULE_WIENER     0x00000001  // Decision-directed Wiener
+
+//*****************************************************************************
+//
+// The suppression parameters.  For power subtraction the tracked noise
+// floor is scaled up by SPECSUB_OVERSUB, which over-subtracts and also makes
+// up for a running minimum sitting below the mean noise power.  No bin is
+// attenuated by more than SPECSUB_GAIN_FLOOR, and the floor estimate rises
+// by at most SPECSUB_NOISE_RISE per frame (about 3 dB per second at 115
+// frames per second) so that it follows slowly increasing noise but not
+// speech.
+//
+//*****************************************************************************
+#define SPECSUB_OVERSUB         3.0f
+#define SPECSUB_GAIN_FLOOR      0.1f
+#define SPECSUB_POWER_SMOOTH    0.9f
+#define SPECSUB_NOISE_RISE      1.006f
+
+//*****************************************************************************
+//
+// The Wiener rule.  SPECSUB_DD_SMOOTH is the weight of the previous frame's
+// clean power in the decision-directed a priori SNR; values near one trade a
+// slower response to onsets for far less musical noise.  The rule needs an
+// unbiased noise estimate rather than an over-subtracted one, so the floor
+// is only scaled up by SPECSUB_WIENER_BIAS to make up for the minimum.
+//
+//*****************************************************************************
+#define SPECSUB_DD_SMOOTH       0.98f
+#define SPECSUB_WIENER_BIAS     1.5f
+
+//*****************************************************************************
+//
+// The state of one suppressor.
+//
+//*****************************************************************************
+typedef struct
+{
+    tFFT sFFT;
+
+    //
+    // The last SPECSUB_FFT_SIZE input samples in Q15.
+    //
+    int16_t pi16Input[SPECSUB_FFT_SIZE];
+
+    //
+    // The second half of the previous synthesis frame, waiting to be added
+    // to the first half of the next one.
+    //
+    int16_t pi16Overlap[SPECSUB_HOP];
+
+    //
+    // The smoothed power and the tracked noise floor of each bin, in units of
+    // Q15 squared.
+    //
+    float pfPower[SPECSUB_BINS];
+    float pfNoise[SPECSUB_BINS];
+
+    //
+    // The clean power of each bin in the previous frame, for the Wiener
+    // rule.
+    //
+    float pfClean[SPECSUB_BINS];
+
+    //
+    // The gain rule and the instrumentation probe of this instance.
+    //
+    uint32_t ui32Rule;
+    uint32_t ui32Probe;
+}
+tSpecSub;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern void SpecSubInit(tSpecSub *psSS, uint32_t ui32Rule,
+                        uint32_t ui32Probe);
+extern void SpecSubReset(tSpecSub *psSS);
+extern void SpecSubRateSet(tSpecSub *psSS, uint32_t ui32OldRate,
+                           uint32_t ui32NewRate);
+extern void SpecSubProcess(tSpecSub *psSS, const int32_t *pi32In,
+                           int32_t *pi32Out);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SPECSUB_H__
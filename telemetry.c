@@ -0,0 +1,392 @@
+//*****************************************************************************
+//
+// telemetry.c - Binary telemetry framing.
+//
+// Telemetry frames are short, checksummed binary records of the running
+// filter: decimated signals, weight snapshots and metrics.  The sender
+// queues whole frames in a ring (see ring.h), from which a transport such
+// as telemetry_uart.c hands them to the hardware; a frame that does not fit
+// is dropped whole and counted, so the sender never waits on the link.
+//
+// The decoder is the other end.  It takes the byte stream in pieces of any
+// size, finds the frames by their sync bytes, checks their CRC and tracks
+// their sequence numbers.  After a bad frame it looks for the next sync
+// from the byte after the bad frame's start, so a corrupted byte costs only
+// the frames it lands in.
+//
+// The module uses no target peripherals and builds for the host as well,
+// where the decoder serves the host tool.
+//
+// The CRC over each frame is the largest per-byte cost of the framing, so
+// it uses the word-at-a-time Crc16Slice4(); TelemetryCRCBenchmark() gives
+// the cost of it and of the other CRC routines per kilobyte.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "driverlib/sw_crc.h"
+#include "perf.h"
+#include "ring.h"
+#include "telemetry.h"
+
+//*****************************************************************************
+//
+// The number of bytes checksummed per run of TelemetryCRCBenchmark(), and
+// where its results go so the runs are not optimized away.
+//
+//*****************************************************************************
+#define TELEMETRY_BENCHMARK_BYTES                                             \
+                                8192
+static volatile uint32_t g_ui32TelemetryCRCSink;
+
+//*****************************************************************************
+//
+//! \addtogroup telemetry_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! Initializes the sending side.
+//!
+//! \param psTelemetry is a pointer to the telemetry state.
+//! \param pui8Buf points to the storage for queued frames.
+//! \param ui32Size is the size of the storage in bytes, a power of two.
+//!
+//! \return Returns \b true on success or \b false if \e ui32Size is not a
+//! power of two.
+//
+//*****************************************************************************
+bool
+TelemetryInit(tTelemetry *psTelemetry, uint8_t *pui8Buf, uint32_t ui32Size)
+{
+    psTelemetry->ui8Sequence = 0;
+    psTelemetry->ui32Frames = 0;
+    psTelemetry->ui32Dropped = 0;
+
+    return(RingInit(&psTelemetry->sRing, pui8Buf, ui32Size));
+}
+
+//*****************************************************************************
+//
+//! Queues a frame.
+//!
+//! \param psTelemetry is a pointer to the telemetry state.
+//! \param ui32Type is the frame type.
+//! \param pvPayload points to the payload.
+//! \param ui32Size is the size of the payload in bytes, at most
+//! \b TELEMETRY_MAX_PAYLOAD.
+//!
+//! The frame is framed, checksummed and copied into the queue whole, or not
+//! at all.  Frames must be sent from one context only, since the queue has
+//! a single producer.
+//!
+//! \return Returns \b true if the frame was queued or \b false if it was
+//! dropped.
+//
+//*****************************************************************************
+bool
+TelemetrySend(tTelemetry *psTelemetry, uint32_t ui32Type,
+              const void *pvPayload, uint32_t ui32Size)
+{
+    uint8_t pui8Header[TELEMETRY_HEADER_SIZE], pui8CRC[TELEMETRY_CRC_SIZE];
+    uint16_t ui16CRC;
+
+    pui8Header[0] = TELEMETRY_SYNC0;
+    pui8Header[1] = TELEMETRY_SYNC1;
+    pui8Header[2] = (uint8_t)ui32Type;
+    pui8Header[3] = psTelemetry->ui8Sequence++;
+    pui8Header[4] = (uint8_t)ui32Size;
+    pui8Header[5] = (uint8_t)(ui32Size >> 8);
+
+    if((ui32Size > TELEMETRY_MAX_PAYLOAD) ||
+       (RingFree(&psTelemetry->sRing) <
+        (TELEMETRY_HEADER_SIZE + ui32Size + TELEMETRY_CRC_SIZE)))
+    {
+        psTelemetry->ui32Dropped++;
+        return(false);
+    }
+
+    ui16CRC = Crc16Slice4(0, &pui8Header[2], TELEMETRY_HEADER_SIZE - 2);
+    ui16CRC = Crc16Slice4(ui16CRC, pvPayload, ui32Size);
+    pui8CRC[0] = (uint8_t)ui16CRC;
+    pui8CRC[1] = (uint8_t)(ui16CRC >> 8);
+
+    RingWrite(&psTelemetry->sRing, pui8Header, TELEMETRY_HEADER_SIZE);
+    RingWrite(&psTelemetry->sRing, pvPayload, ui32Size);
+    RingWrite(&psTelemetry->sRing, pui8CRC, TELEMETRY_CRC_SIZE);
+    psTelemetry->ui32Frames++;
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Initializes a decoder.
+//!
+//! \param psDecoder is a pointer to the decoder state.
+//! \param pfnHandler is called for each intact frame.
+//! \param pvArg is passed to \e pfnHandler.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+TelemetryDecoderInit(tTelemetryDecoder *psDecoder,
+                     tTelemetryHandler pfnHandler, void *pvArg)
+{
+    psDecoder->pfnHandler = pfnHandler;
+    psDecoder->pvArg = pvArg;
+    psDecoder->bSequence = false;
+    psDecoder->ui32Frames = 0;
+    psDecoder->ui32CRCErrors = 0;
+    psDecoder->ui32Lost = 0;
+    psDecoder->ui32Skipped = 0;
+    psDecoder->ui32Count = 0;
+}
+
+//*****************************************************************************
+//
+// Removes bytes from the front of the frame being collected.
+//
+//*****************************************************************************
+static void
+TelemetryDecoderDrop(tTelemetryDecoder *psDecoder, uint32_t ui32Count)
+{
+    psDecoder->ui32Count -= ui32Count;
+    memmove(psDecoder->pui8Frame, &psDecoder->pui8Frame[ui32Count],
+            psDecoder->ui32Count);
+}
+
+//*****************************************************************************
+//
+// Handles every complete frame among the bytes collected, and drops the
+// bytes that cannot start one.
+//
+//*****************************************************************************
+static void
+TelemetryDecoderCheck(tTelemetryDecoder *psDecoder)
+{
+    uint8_t *pui8Frame;
+    uint32_t ui32Size, ui32Sequence;
+    uint16_t ui16CRC;
+
+    pui8Frame = psDecoder->pui8Frame;
+    while(psDecoder->ui32Count)
+    {
+        //
+        // Skip to the next sync pair.
+        //
+        if((pui8Frame[0] != TELEMETRY_SYNC0) ||
+           ((psDecoder->ui32Count > 1) && (pui8Frame[1] != TELEMETRY_SYNC1)))
+        {
+            psDecoder->ui32Skipped++;
+            TelemetryDecoderDrop(psDecoder, 1);
+            continue;
+        }
+        if(psDecoder->ui32Count < TELEMETRY_HEADER_SIZE)
+        {
+            return;
+        }
+
+        //
+        // A size out of range means the sync pair was in the data.
+        //
+        ui32Size = (uint32_t)pui8Frame[4] | ((uint32_t)pui8Frame[5] << 8);
+        if(ui32Size > TELEMETRY_MAX_PAYLOAD)
+        {
+            psDecoder->ui32Skipped++;
+            TelemetryDecoderDrop(psDecoder, 1);
+            continue;
+        }
+        if(psDecoder->ui32Count <
+           (TELEMETRY_HEADER_SIZE + ui32Size + TELEMETRY_CRC_SIZE))
+        {
+            return;
+        }
+
+        ui16CRC = Crc16Slice4(0, &pui8Frame[2],
+                              TELEMETRY_HEADER_SIZE - 2 + ui32Size);
+        if((pui8Frame[TELEMETRY_HEADER_SIZE + ui32Size] !=
+            (uint8_t)ui16CRC) ||
+           (pui8Frame[TELEMETRY_HEADER_SIZE + ui32Size + 1] !=
+            (uint8_t)(ui16CRC >> 8)))
+        {
+            psDecoder->ui32CRCErrors++;
+            TelemetryDecoderDrop(psDecoder, 1);
+            continue;
+        }
+
+        //
+        // An intact frame.  Count the frames missing before it.
+        //
+        ui32Sequence = pui8Frame[3];
+        if(psDecoder->bSequence)
+        {
+            psDecoder->ui32Lost += (ui32Sequence - psDecoder->ui32Sequence) &
+                                   0xff;
+        }
+        psDecoder->ui32Sequence = (ui32Sequence + 1) & 0xff;
+        psDecoder->bSequence = true;
+        psDecoder->ui32Frames++;
+
+        psDecoder->pfnHandler(psDecoder->pvArg, pui8Frame[2], ui32Sequence,
+                              &pui8Frame[TELEMETRY_HEADER_SIZE], ui32Size);
+        TelemetryDecoderDrop(psDecoder,
+                             TELEMETRY_HEADER_SIZE + ui32Size +
+                             TELEMETRY_CRC_SIZE);
+    }
+}
+
+//*****************************************************************************
+//
+//! Decodes received bytes.
+//!
+//! \param psDecoder is a pointer to the decoder state.
+//! \param pui8Data points to the bytes.
+//! \param ui32Count is the number of bytes.
+//!
+//! The bytes continue the stream from the previous call.  The handler is
+//! called for each frame they complete, before this returns.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+TelemetryDecode(tTelemetryDecoder *psDecoder, const uint8_t *pui8Data,
+                uint32_t ui32Count)
+{
+    uint32_t ui32Span;
+
+    while(ui32Count)
+    {
+        ui32Span = TELEMETRY_MAX_FRAME - psDecoder->ui32Count;
+        if(ui32Span > ui32Count)
+        {
+            ui32Span = ui32Count;
+        }
+        memcpy(&psDecoder->pui8Frame[psDecoder->ui32Count], pui8Data,
+               ui32Span);
+        psDecoder->ui32Count += ui32Span;
+        pui8Data += ui32Span;
+        ui32Count -= ui32Span;
+
+        TelemetryDecoderCheck(psDecoder);
+    }
+}
+
+//*****************************************************************************
+//
+// The state of TelemetryCRCBenchmark() between its steps.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t ui32CRC;
+    uint8_t *pui8Scratch;
+    uint32_t ui32Size;
+    uint32_t ui32Passes;
+}
+tTelemetryCRCBenchmark;
+
+//*****************************************************************************
+//
+// Checksums the buffer in a running fashion for TelemetryCRCBenchmark().  The
+// result is stored where the compiler cannot drop it.
+//
+//*****************************************************************************
+static void
+TelemetryCRCBenchmarkPass(void *pvArg)
+{
+    tTelemetryCRCBenchmark *psBench;
+    uint32_t ui32Idx, ui32Value;
+
+    psBench = (tTelemetryCRCBenchmark *)pvArg;
+    ui32Value = 0;
+    for(ui32Idx = 0; ui32Idx < psBench->ui32Passes; ui32Idx++)
+    {
+        switch(psBench->ui32CRC)
+        {
+            case TELEMETRY_CRC_16:
+            {
+                ui32Value = Crc16((uint16_t)ui32Value, psBench->pui8Scratch,
+                                  psBench->ui32Size);
+                break;
+            }
+
+            case TELEMETRY_CRC_16_SLICE4:
+            {
+                ui32Value = Crc16Slice4((uint16_t)ui32Value,
+                                        psBench->pui8Scratch,
+                                        psBench->ui32Size);
+                break;
+            }
+
+            case TELEMETRY_CRC_32:
+            {
+                ui32Value = Crc32(ui32Value, psBench->pui8Scratch,
+                                  psBench->ui32Size);
+                break;
+            }
+
+            default:
+            {
+                ui32Value = Crc32Slice8(ui32Value, psBench->pui8Scratch,
+                                        psBench->ui32Size);
+                break;
+            }
+        }
+    }
+    g_ui32TelemetryCRCSink = ui32Value;
+}
+
+//*****************************************************************************
+//
+//! Measures the throughput of a CRC routine.
+//!
+//! \param ui32CRC is the routine, one of the \b TELEMETRY_CRC_* values.
+//! \param pui8Scratch points to a buffer of \e ui32Size bytes.
+//! \param ui32Size is the number of bytes checksummed per call.
+//!
+//! The buffer is filled with a pattern and checksummed in a running fashion
+//! until about 8 KB have passed, starting from the buffer itself, so that
+//! the alignment is as the caller gives it.  The passes are timed with
+//! PerfBenchmarkRun().
+//!
+//! \return Returns the cost of checksumming 1 KB, or 0 if the routine is
+//! not known or \e ui32Size is 0.
+//
+//*****************************************************************************
+uint32_t
+TelemetryCRCBenchmark(uint32_t ui32CRC, uint8_t *pui8Scratch,
+                      uint32_t ui32Size)
+{
+    tTelemetryCRCBenchmark sBench;
+    uint32_t ui32Best;
+
+    if((ui32CRC >= TELEMETRY_NUM_CRCS) || (ui32Size == 0))
+    {
+        return(0);
+    }
+
+    sBench.ui32CRC = ui32CRC;
+    sBench.pui8Scratch = pui8Scratch;
+    sBench.ui32Size = ui32Size;
+    sBench.ui32Passes = ((TELEMETRY_BENCHMARK_BYTES + ui32Size - 1) /
+                         ui32Size);
+    PerfPatternFill8(pui8Scratch, ui32Size);
+
+    ui32Best = PerfBenchmarkRun(0, TelemetryCRCBenchmarkPass, &sBench);
+    return((uint32_t)(((uint64_t)ui32Best * 1024) /
+                      (sBench.ui32Passes * ui32Size)));
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
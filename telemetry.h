@@ -0,0 +1,187 @@
+//*****************************************************************************
+//
+// telemetry.h - Prototypes for the binary telemetry framing.
+//
+//*****************************************************************************
+
+#ifndef __TELEMETRY_H__
+#define __TELEMETRY_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The frame layout.  Every frame is
+//
+//     offset  size  field
+//     0       2     sync, TELEMETRY_SYNC0 then TELEMETRY_SYNC1
+//     2       1     type, one of the TELEMETRY_TYPE_* values
+//     3       1     sequence number, counting every frame offered
+//     4       2     payload size in bytes, little-endian
+//     6       n     payload
+//     6 + n   2     Crc16() of bytes 2 to 5 + n, little-endian
+//
+// Multi-byte payload fields are little-endian, the processor's byte order.
+// A gap in the sequence numbers is a frame dropped, by the sender for lack
+// of room or on the line.
+//
+//*****************************************************************************
+#define TELEMETRY_SYNC0         0xa5
+#define TELEMETRY_SYNC1         0x5a
+#define TELEMETRY_HEADER_SIZE   6
+#define TELEMETRY_CRC_SIZE      2
+#define TELEMETRY_MAX_PAYLOAD   240
+#define TELEMETRY_MAX_FRAME     (TELEMETRY_HEADER_SIZE +                      \
+                                 TELEMETRY_MAX_PAYLOAD + TELEMETRY_CRC_SIZE)
+
+//*****************************************************************************
+//
+// The frame types.
+//
+// TELEMETRY_TYPE_SIGNALS carries decimated canceller-rate samples as int16_t
+// triples: primary input, noise reference and error.
+//
+// TELEMETRY_TYPE_WEIGHTS carries the canceller's ANC_NUM_TAPS weights as
+// int32_t in Q31.
+//
+// TELEMETRY_TYPE_METRICS carries TELEMETRY_NUM_METRICS uint32_t values,
+// indexed by the TELEMETRY_METRIC_* values.
+//
+//*****************************************************************************
+#define TELEMETRY_TYPE_SIGNALS  0x01
+#define TELEMETRY_TYPE_WEIGHTS  0x02
+#define TELEMETRY_TYPE_METRICS  0x03
+
+//*****************************************************************************
+//
+// The fields of a TELEMETRY_TYPE_METRICS payload.
+//
+//*****************************************************************************
+#define TELEMETRY_METRIC_FRAMES 0           // Codec frames processed
+#define TELEMETRY_METRIC_PRIMARY                                              \
+                                1           // Smoothed primary input energy
+#define TELEMETRY_METRIC_ERROR  2           // Smoothed output energy
+#define TELEMETRY_METRIC_MODE   3           // One of the AUDIO_MODE_* values
+#define TELEMETRY_METRIC_RATE   4           // Codec rate in Hz
+#define TELEMETRY_METRIC_ANC_CYCLES                                           \
+                                5           // Cycles per canceller frame
+#define TELEMETRY_METRIC_DMA_ERRORS                                           \
+                                6           // uDMA bus errors
+#define TELEMETRY_METRIC_DROPPED                                              \
+                                7           // Telemetry frames dropped
+#define TELEMETRY_NUM_METRICS   8
+
+//*****************************************************************************
+//
+// The CRC routines measured by TelemetryCRCBenchmark().
+//
+//*****************************************************************************
+#define TELEMETRY_CRC_16        0           // Crc16(), a byte per step
+#define TELEMETRY_CRC_16_SLICE4 1           // Crc16Slice4(), a word per step
+#define TELEMETRY_CRC_32        2           // Crc32(), a byte per step
+#define TELEMETRY_CRC_32_SLICE8 3           // Crc32Slice8(), two words a step
+#define TELEMETRY_NUM_CRCS      4
+
+//*****************************************************************************
+//
+// The sending side: frames are queued in a ring, from which the transport
+// takes them.
+//
+//*****************************************************************************
+typedef struct
+{
+    tRing sRing;
+
+    //
+    // The sequence number of the next frame.
+    //
+    uint8_t ui8Sequence;
+
+    //
+    // The number of frames queued, and dropped because the ring was full or
+    // the payload too large.
+    //
+    volatile uint32_t ui32Frames;
+    volatile uint32_t ui32Dropped;
+}
+tTelemetry;
+
+//*****************************************************************************
+//
+// Called by the decoder for each intact frame.
+//
+//*****************************************************************************
+typedef void (*tTelemetryHandler)(void *pvArg, uint32_t ui32Type,
+                                  uint32_t ui32Sequence,
+                                  const uint8_t *pui8Payload,
+                                  uint32_t ui32Size);
+
+//*****************************************************************************
+//
+// The receiving side: a decoder that finds frames in a byte stream.
+//
+//*****************************************************************************
+typedef struct
+{
+    tTelemetryHandler pfnHandler;
+    void *pvArg;
+
+    //
+    // The sequence number expected next, once a frame has been seen.
+    //
+    uint32_t ui32Sequence;
+    bool bSequence;
+
+    //
+    // The number of intact frames, of frames with a bad CRC, of frames lost
+    // as counted by the sequence numbers, and of bytes skipped looking for
+    // the start of a frame.
+    //
+    uint32_t ui32Frames;
+    uint32_t ui32CRCErrors;
+    uint32_t ui32Lost;
+    uint32_t ui32Skipped;
+
+    //
+    // The bytes of the frame being collected.
+    //
+    uint32_t ui32Count;
+    uint8_t pui8Frame[TELEMETRY_MAX_FRAME];
+}
+tTelemetryDecoder;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern bool TelemetryInit(tTelemetry *psTelemetry, uint8_t *pui8Buf,
+                          uint32_t ui32Size);
+extern bool TelemetrySend(tTelemetry *psTelemetry, uint32_t ui32Type,
+                          const void *pvPayload, uint32_t ui32Size);
+extern void TelemetryDecoderInit(tTelemetryDecoder *psDecoder,
+                                 tTelemetryHandler pfnHandler, void *pvArg);
+extern void TelemetryDecode(tTelemetryDecoder *psDecoder,
+                            const uint8_t *pui8Data, uint32_t ui32Count);
+extern uint32_t TelemetryCRCBenchmark(uint32_t ui32CRC, uint8_t *pui8Scratch,
+                                      uint32_t ui32Size);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __TELEMETRY_H__
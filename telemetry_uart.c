@@ -0,0 +1,259 @@
+//*****************************************************************************
+//
+// telemetry_uart.c - UART telemetry transport.
+//
+// UART0, on PA0 and PA1, carries the telemetry frames queued by telemetry.c
+// to the host through the LaunchPad's debug USB bridge.  The uDMA moves the
+// bytes from the queue into the transmit FIFO, so the CPU does nothing per
+// byte: each transfer covers the whole contiguous span of queued bytes, up
+// to the end of the ring, and the UART interrupt, entered when it completes,
+// releases the span and starts the next.  TelemetryUARTService() starts a
+// transfer when the link has gone idle and frames have been queued since.
+//
+// For bench testing without a host the UART can loop its output back to
+// its own receiver, where the receive interrupt runs the bytes through a
+// decoder; its counters then show whether the frames survive the link.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_uart.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/uart.h"
+#include "driverlib/udma.h"
+#include "clock.h"
+#include "dma.h"
+#include "ring.h"
+#include "telemetry.h"
+#include "telemetry_uart.h"
+
+//*****************************************************************************
+//
+//! \addtogroup telemetry_uart_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The frames being sent, the loopback decoder, if any, and the line rate.
+//
+//*****************************************************************************
+static tTelemetry *g_psTelemetryUART;
+static tTelemetryDecoder *g_psTelemetryUARTLoopback;
+static uint32_t g_ui32TelemetryUARTBaud;
+
+//*****************************************************************************
+//
+// The size of the transfer in flight, 0 when the link is idle, and the bytes
+// sent since initialization.
+//
+//*****************************************************************************
+static volatile uint32_t g_ui32TelemetryUARTSpan;
+static volatile uint32_t g_ui32TelemetryUARTBytes;
+
+//*****************************************************************************
+//
+// Sets the baud rate divisor for the system clock ui32Clock.
+//
+//*****************************************************************************
+static void
+TelemetryUARTClockSet(uint32_t ui32Clock)
+{
+    UARTConfigSetExpClk(UART0_BASE, ui32Clock, g_ui32TelemetryUARTBaud,
+                        (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE |
+                         UART_CONFIG_PAR_NONE));
+}
+
+//*****************************************************************************
+//
+// Starts a transfer of the queued bytes up to the end of the ring, if there
+// are any.  This must only be called with no transfer in flight.
+//
+//*****************************************************************************
+static void
+TelemetryUARTStart(void)
+{
+    const uint8_t *pui8Span;
+    uint32_t ui32Span;
+
+    ui32Span = RingReadSpanGet(&g_psTelemetryUART->sRing, &pui8Span);
+    if(ui32Span == 0)
+    {
+        return;
+    }
+
+    //
+    // A uDMA transfer moves at most 1024 items.
+    //
+    if(ui32Span > 1024)
+    {
+        ui32Span = 1024;
+    }
+
+    g_ui32TelemetryUARTSpan = ui32Span;
+    uDMAChannelTransferSet(UDMA_CHANNEL_UART0TX | UDMA_PRI_SELECT,
+                           UDMA_MODE_BASIC, (void *)pui8Span,
+                           (void *)(UART0_BASE + UART_O_DR), ui32Span);
+    uDMAChannelEnable(UDMA_CHANNEL_UART0TX);
+}
+
+//*****************************************************************************
+//
+//! Initializes the UART transport.
+//!
+//! \param psTelemetry is a pointer to the telemetry state whose frames are
+//! sent.
+//! \param ui32Baud is the line rate.
+//! \param psLoopback is a pointer to a decoder that receives the frames
+//! looped back inside the UART, or 0 to send them to the host.
+//!
+//! UART0 is set up for 8 data bits, no parity and one stop bit, and follows
+//! changes of the system clock.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+TelemetryUARTInit(tTelemetry *psTelemetry, uint32_t ui32Baud,
+                  tTelemetryDecoder *psLoopback)
+{
+    g_psTelemetryUART = psTelemetry;
+    g_psTelemetryUARTLoopback = psLoopback;
+    g_ui32TelemetryUARTBaud = ui32Baud;
+    g_ui32TelemetryUARTSpan = 0;
+    g_ui32TelemetryUARTBytes = 0;
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UART0);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
+    while(!SysCtlPeripheralReady(SYSCTL_PERIPH_UART0) ||
+          !SysCtlPeripheralReady(SYSCTL_PERIPH_GPIOA))
+    {
+    }
+
+    GPIOPinConfigure(GPIO_PA0_U0RX);
+    GPIOPinConfigure(GPIO_PA1_U0TX);
+    GPIOPinTypeUART(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
+
+    TelemetryUARTClockSet(SysCtlClockGet());
+    UARTFIFOLevelSet(UART0_BASE, UART_FIFO_TX4_8, UART_FIFO_RX4_8);
+    UARTDMAEnable(UART0_BASE, UART_DMA_TX);
+
+    //
+    // In loopback the receiver takes the bytes from its FIFO in the
+    // interrupt, at half full or when the line goes quiet.
+    //
+    if(psLoopback)
+    {
+        HWREG(UART0_BASE + UART_O_CTL) |= UART_CTL_LBE;
+        UARTIntEnable(UART0_BASE, UART_INT_RX | UART_INT_RT);
+    }
+
+    //
+    // The channel moves bytes four at a time, as the transmit FIFO drains
+    // to half full.
+    //
+    DMAInit();
+    uDMAChannelAssign(UDMA_CH9_UART0TX);
+    uDMAChannelAttributeDisable(UDMA_CHANNEL_UART0TX, UDMA_ATTR_ALL);
+    uDMAChannelControlSet(UDMA_CHANNEL_UART0TX | UDMA_PRI_SELECT,
+                          UDMA_SIZE_8 | UDMA_SRC_INC_8 | UDMA_DST_INC_NONE |
+                          UDMA_ARB_4);
+
+    IntEnable(INT_UART0);
+    ClockHookRegister(TelemetryUARTClockSet);
+}
+
+//*****************************************************************************
+//
+//! Starts sending queued frames.
+//!
+//! This is called from the main loop after frames are queued.  It does
+//! nothing while a transfer is in flight; the interrupt chains the next one
+//! itself.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+TelemetryUARTService(void)
+{
+    bool bIntsOff;
+
+    //
+    // In loopback the interrupt also runs for received bytes, so keep it out
+    // until the transfer and its size are both set.
+    //
+    bIntsOff = IntMasterDisable();
+    if(g_ui32TelemetryUARTSpan == 0)
+    {
+        TelemetryUARTStart();
+    }
+    if(!bIntsOff)
+    {
+        IntMasterEnable();
+    }
+}
+
+//*****************************************************************************
+//
+//! Returns the number of bytes sent.
+//!
+//! \return Returns the number of bytes sent since TelemetryUARTInit().
+//
+//*****************************************************************************
+uint32_t
+TelemetryUARTBytesGet(void)
+{
+    return(g_ui32TelemetryUARTBytes);
+}
+
+//*****************************************************************************
+//
+// The UART0 interrupt handler, entered when a transmit transfer completes
+// and, in loopback, when bytes have been received.
+//
+//*****************************************************************************
+void
+UART0_Handler(void)
+{
+    uint8_t pui8Data[16];
+    uint32_t ui32Count;
+    int32_t i32Char;
+
+    UARTIntClear(UART0_BASE, UARTIntStatus(UART0_BASE, true));
+
+    if(g_ui32TelemetryUARTSpan &&
+       !uDMAChannelIsEnabled(UDMA_CHANNEL_UART0TX))
+    {
+        RingReadCommit(&g_psTelemetryUART->sRing, g_ui32TelemetryUARTSpan);
+        g_ui32TelemetryUARTBytes += g_ui32TelemetryUARTSpan;
+        g_ui32TelemetryUARTSpan = 0;
+        TelemetryUARTStart();
+    }
+
+    if(g_psTelemetryUARTLoopback)
+    {
+        ui32Count = 0;
+        while((ui32Count < sizeof(pui8Data)) &&
+              ((i32Char = UARTCharGetNonBlocking(UART0_BASE)) != -1))
+        {
+            pui8Data[ui32Count++] = (uint8_t)i32Char;
+        }
+        TelemetryDecode(g_psTelemetryUARTLoopback, pui8Data, ui32Count);
+    }
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
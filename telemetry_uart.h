@@ -0,0 +1,51 @@
+//*****************************************************************************
+//
+// telemetry_uart.h - Prototypes for the UART telemetry transport.
+//
+//*****************************************************************************
+
+#ifndef __TELEMETRY_UART_H__
+#define __TELEMETRY_UART_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The default line rate.  The UART reaches the system clock / 16, but the
+// LaunchPad's debug USB bridge, which carries UART0 to the host, tops out
+// around 1 Mbaud.
+//
+//*****************************************************************************
+#ifndef TELEMETRY_UART_BAUD
+#define TELEMETRY_UART_BAUD     921600
+#endif
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern void TelemetryUARTInit(tTelemetry *psTelemetry, uint32_t ui32Baud,
+                              tTelemetryDecoder *psLoopback);
+extern void TelemetryUARTService(void);
+extern uint32_t TelemetryUARTBytesGet(void);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __TELEMETRY_UART_H__
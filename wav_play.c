@@ -0,0 +1,428 @@
+//*****************************************************************************
+//
+// wav_play.c - Block device WAV player.
+//
+// The player reads a WAV file from a block device, typically an SD card, a
+// burst of whole sectors at a time, and hands out codec frames from it.  One
+// device call fills one half of a double buffer while the other half plays,
+// so the per-command overhead of the card is paid once per burst rather than
+// once per byte.
+//
+// The double buffer is a ring (see ring.h) of two bursts.  The main loop
+// calls WavPlayService(), which reads the next burst straight into whichever
+// half has been played out.  The codec frame handler calls WavPlayFrameGet(),
+// which consumes samples from the other half; in the SSI's ring mode both run
+// from the main loop, while the uDMA plays the frames already handed over.
+//
+// The file must be stored in consecutive blocks, and its header, up to the
+// start of the samples, must fit in the first burst.  The header is parsed
+// in place by WavRiffParse() and the samples after it play from the same
+// buffer.  Every layout the parser accepts is played, truncated to the 16
+// bits of the codec.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "perf.h"
+#include "ring.h"
+#include "wav_riff.h"
+#include "wav_play.h"
+
+//*****************************************************************************
+//
+//! \addtogroup wav_play_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The size of one half of the double buffer in bytes.
+//
+//*****************************************************************************
+#define WAV_PLAY_BURST_BYTES    (WAV_PLAY_BURST * WAV_BLOCK_SIZE)
+
+//*****************************************************************************
+//
+// The largest frame the parser accepts: WAV_MAX_CHANNELS channels of 32
+// bits.
+//
+//*****************************************************************************
+#define WAV_MAX_FRAME_BYTES     (WAV_MAX_CHANNELS * 4)
+
+//*****************************************************************************
+//
+// The number of bursts read per benchmark.
+//
+//*****************************************************************************
+#define WAV_BENCHMARK_BURSTS    16
+
+//*****************************************************************************
+//
+// Converts one little-endian file sample to Q15.  Integer samples keep their
+// upper 16 bits; float samples are scaled and saturated.
+//
+//*****************************************************************************
+static int16_t
+WavSampleConvert(const tWavInfo *psInfo, const uint8_t *pui8Sample)
+{
+    uint32_t ui32Word;
+    float fSample;
+
+    if(psInfo->ui32Format == WAV_FORMAT_FLOAT)
+    {
+        ui32Word = ((uint32_t)pui8Sample[0] | ((uint32_t)pui8Sample[1] << 8) |
+                    ((uint32_t)pui8Sample[2] << 16) |
+                    ((uint32_t)pui8Sample[3] << 24));
+        memcpy(&fSample, &ui32Word, sizeof(fSample));
+        fSample *= 32768.0f;
+        if(fSample >= 32767.0f)
+        {
+            return(32767);
+        }
+        if(fSample > -32768.0f)
+        {
+            return((int16_t)fSample);
+        }
+        return((fSample == fSample) ? -32768 : 0);
+    }
+
+    pui8Sample += (psInfo->ui32Bits / 8) - 2;
+    return((int16_t)((uint32_t)pui8Sample[0] |
+                     ((uint32_t)pui8Sample[1] << 8)));
+}
+
+//*****************************************************************************
+//
+// Converts one file frame to an interleaved stereo codec frame, from the
+// file channels chosen for each side.
+//
+//*****************************************************************************
+static void
+WavFrameConvert(tWavPlayer *psPlayer, const uint8_t *pui8Frame,
+                int16_t *pi16Out)
+{
+    uint32_t ui32SampleBytes;
+
+    ui32SampleBytes = psPlayer->sInfo.ui32Bits / 8;
+    pi16Out[0] = WavSampleConvert(&psPlayer->sInfo,
+                                  pui8Frame + (psPlayer->ui32LeftChannel *
+                                               ui32SampleBytes));
+    pi16Out[1] = WavSampleConvert(&psPlayer->sInfo,
+                                  pui8Frame + (psPlayer->ui32RightChannel *
+                                               ui32SampleBytes));
+}
+
+//*****************************************************************************
+//
+//! Opens a WAV file for playing.
+//!
+//! \param psPlayer is a pointer to the player state.
+//! \param pfnRead is the device's block read function.
+//! \param pvDevice is passed to \e pfnRead to identify the device.
+//! \param ui32FirstBlock is the first block of the file.
+//!
+//! The first burst is read and the header in it parsed; the samples that
+//! follow the header are ready to play on return, in place.  The layout is
+//! left in \e psPlayer->sInfo.
+//!
+//! The first file channel plays on the left and the second, or the first
+//! again in a mono file, on the right; WavPlayChannelsSet() chooses others.
+//!
+//! \return Returns \b true on success or \b false if the device could not
+//! be read, or the file is not supported or its header does not fit in one
+//! burst.
+//
+//*****************************************************************************
+bool
+WavPlayOpen(tWavPlayer *psPlayer, tWavBlockRead pfnRead, void *pvDevice,
+            uint32_t ui32FirstBlock)
+{
+    uint8_t *pui8Span;
+
+    psPlayer->pfnRead = pfnRead;
+    psPlayer->pvDevice = pvDevice;
+    psPlayer->ui32Underruns = 0;
+    RingInit(&psPlayer->sRing, psPlayer->pui8Buf, sizeof(psPlayer->pui8Buf));
+
+    RingWriteSpanGet(&psPlayer->sRing, &pui8Span);
+    if(!pfnRead(pvDevice, ui32FirstBlock, pui8Span, WAV_PLAY_BURST) ||
+       (WavRiffParse(pui8Span, WAV_PLAY_BURST_BYTES, &psPlayer->sInfo) !=
+        WAV_RIFF_OK))
+    {
+        return(false);
+    }
+
+    //
+    // Publish the samples in the first burst, and drop the header.
+    //
+    RingWriteCommit(&psPlayer->sRing, (psPlayer->sInfo.ui32DataOffset +
+                                       psPlayer->sInfo.ui32DataInBuffer));
+    RingReadCommit(&psPlayer->sRing, psPlayer->sInfo.ui32DataOffset);
+    psPlayer->ui32Remaining = (psPlayer->sInfo.ui32DataSize -
+                               psPlayer->sInfo.ui32DataInBuffer);
+    psPlayer->ui32Block = ui32FirstBlock + WAV_PLAY_BURST;
+    psPlayer->ui32LeftChannel = 0;
+    psPlayer->ui32RightChannel = (psPlayer->sInfo.ui32Channels > 1) ? 1 : 0;
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Chooses the file channels to play.
+//!
+//! \param psPlayer is a pointer to the player state.
+//! \param ui32Left is the file channel played on the left codec channel.
+//! \param ui32Right is the file channel played on the right codec channel.
+//!
+//! Channels are counted from 0 in the file's order.  For a recording made
+//! by wav_rec.c, for example, channel 2 is the canceller's output.  This may
+//! be called at any time after WavPlayOpen().
+//!
+//! \return Returns \b true on success or \b false if the file does not have
+//! the channels.
+//
+//*****************************************************************************
+bool
+WavPlayChannelsSet(tWavPlayer *psPlayer, uint32_t ui32Left,
+                   uint32_t ui32Right)
+{
+    if((ui32Left >= psPlayer->sInfo.ui32Channels) ||
+       (ui32Right >= psPlayer->sInfo.ui32Channels))
+    {
+        return(false);
+    }
+
+    psPlayer->ui32LeftChannel = ui32Left;
+    psPlayer->ui32RightChannel = ui32Right;
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Refills the double buffer.
+//!
+//! \param psPlayer is a pointer to the player state.
+//!
+//! If a half of the double buffer has been played out, the next burst of the
+//! file is read into it.  This is called from the main loop, at least once
+//! per half buffer of playing time.
+//!
+//! \return Returns \b false if the device failed, or \b true otherwise.
+//
+//*****************************************************************************
+bool
+WavPlayService(tWavPlayer *psPlayer)
+{
+    uint8_t *pui8Span;
+
+    if((psPlayer->ui32Remaining == 0) ||
+       (RingWriteSpanGet(&psPlayer->sRing, &pui8Span) <
+        WAV_PLAY_BURST_BYTES))
+    {
+        return(true);
+    }
+
+    if(!psPlayer->pfnRead(psPlayer->pvDevice, psPlayer->ui32Block, pui8Span,
+                          WAV_PLAY_BURST))
+    {
+        return(false);
+    }
+    psPlayer->ui32Block += WAV_PLAY_BURST;
+
+    //
+    // The last burst runs past the end of the samples; only publish the
+    // samples.
+    //
+    if(psPlayer->ui32Remaining > WAV_PLAY_BURST_BYTES)
+    {
+        RingWriteCommit(&psPlayer->sRing, WAV_PLAY_BURST_BYTES);
+        psPlayer->ui32Remaining -= WAV_PLAY_BURST_BYTES;
+    }
+    else
+    {
+        RingWriteCommit(&psPlayer->sRing, psPlayer->ui32Remaining);
+        psPlayer->ui32Remaining = 0;
+    }
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Plays frames from the double buffer.
+//!
+//! \param psPlayer is a pointer to the player state.
+//! \param pi16Out points to the buffer that receives \e ui32Frames frames of
+//! interleaved stereo codec samples.
+//! \param ui32Frames is the number of frames wanted.
+//!
+//! Frames that find no samples waiting are filled with silence.  If the file
+//! has not been read to the end yet, they are also counted as underruns.
+//!
+//! \return Returns the number of frames taken from the file.
+//
+//*****************************************************************************
+uint32_t
+WavPlayFrameGet(tWavPlayer *psPlayer, int16_t *pi16Out, uint32_t ui32Frames)
+{
+    const uint8_t *pui8Span;
+    uint8_t pui8Frame[WAV_MAX_FRAME_BYTES];
+    uint32_t ui32FrameBytes, ui32Span, ui32Done, ui32Idx;
+
+    ui32FrameBytes = psPlayer->sInfo.ui32FrameBytes;
+    ui32Done = 0;
+    while(ui32Done < ui32Frames)
+    {
+        //
+        // Convert the whole frames in the next contiguous span.
+        //
+        ui32Span = (RingReadSpanGet(&psPlayer->sRing, &pui8Span) /
+                    ui32FrameBytes);
+        if(ui32Span > (ui32Frames - ui32Done))
+        {
+            ui32Span = ui32Frames - ui32Done;
+        }
+        for(ui32Idx = 0; ui32Idx < ui32Span; ui32Idx++)
+        {
+            WavFrameConvert(psPlayer, &pui8Span[ui32Idx * ui32FrameBytes],
+                            &pi16Out[2 * (ui32Done + ui32Idx)]);
+        }
+        RingReadCommit(&psPlayer->sRing, ui32Span * ui32FrameBytes);
+        ui32Done += ui32Span;
+
+        //
+        // A frame may straddle the end of the buffer; copy it out whole.
+        //
+        if((ui32Done < ui32Frames) && (ui32Span == 0))
+        {
+            if(RingUsed(&psPlayer->sRing) < ui32FrameBytes)
+            {
+                break;
+            }
+            RingRead(&psPlayer->sRing, pui8Frame, ui32FrameBytes);
+            WavFrameConvert(psPlayer, pui8Frame, &pi16Out[2 * ui32Done]);
+            ui32Done++;
+        }
+    }
+
+    if(ui32Done < ui32Frames)
+    {
+        memset(&pi16Out[2 * ui32Done], 0,
+               (ui32Frames - ui32Done) * 2 * sizeof(int16_t));
+        if(psPlayer->ui32Remaining)
+        {
+            psPlayer->ui32Underruns++;
+        }
+    }
+
+    return(ui32Done);
+}
+
+//*****************************************************************************
+//
+//! Tells whether a file has played to the end.
+//!
+//! \param psPlayer is a pointer to the player state.
+//!
+//! \return Returns \b true once every sample has been handed out.
+//
+//*****************************************************************************
+bool
+WavPlayDone(tWavPlayer *psPlayer)
+{
+    return((psPlayer->ui32Remaining == 0) &&
+           (RingUsed(&psPlayer->sRing) < psPlayer->sInfo.ui32FrameBytes));
+}
+
+//*****************************************************************************
+//
+//! Measures the cost of one burst read from a device.
+//!
+//! \param pfnRead is the device's block read function.
+//! \param pvDevice is passed to \e pfnRead to identify the device.
+//! \param ui32Block is the first of the blocks to read.
+//! \param pui8Scratch points to a buffer of \b WAV_PLAY_BURST blocks.
+//!
+//! Consecutive bursts are read as the player would read them, and the
+//! slowest is reported, since that is the one playing has to survive.  On
+//! the target the result is in processor cycles; on a host build it is in
+//! nanoseconds.  WavPlayRateMax() turns it into the highest sample rate the
+//! device can keep up with.
+//!
+//! \return Returns the cost of one burst, or 0 if the device failed.
+//
+//*****************************************************************************
+uint32_t
+WavPlayBenchmark(tWavBlockRead pfnRead, void *pvDevice, uint32_t ui32Block,
+                 uint8_t *pui8Scratch)
+{
+    uint32_t ui32Burst, ui32Start, ui32Cycles, ui32Worst;
+
+    ui32Worst = 0;
+    for(ui32Burst = 0; ui32Burst < WAV_BENCHMARK_BURSTS; ui32Burst++)
+    {
+        ui32Start = PerfCyclesGet();
+        if(!pfnRead(pvDevice, ui32Block, pui8Scratch, WAV_PLAY_BURST))
+        {
+            return(0);
+        }
+        ui32Cycles = PerfCyclesGet() - ui32Start;
+        ui32Block += WAV_PLAY_BURST;
+
+        if(ui32Cycles > ui32Worst)
+        {
+            ui32Worst = ui32Cycles;
+        }
+    }
+
+    return(ui32Worst);
+}
+
+//*****************************************************************************
+//
+//! Returns the highest sample rate a device can sustain.
+//!
+//! \param ui32BurstCycles is the cost of one burst from WavPlayBenchmark().
+//! \param ui32FrameBytes is the size of a file frame, e.g. 4 for 16-bit
+//! stereo.
+//! \param ui32Clock is the rate of the cost's unit: the processor clock in
+//! Hz on the target, or 1000000000 on a host build.
+//!
+//! A burst must be read in the time the other half of the double buffer
+//! takes to play.  The result leaves no time for the rest of the frame
+//! processing, so a player should stay well below it.
+//!
+//! \return Returns the highest sample rate in Hz.
+//
+//*****************************************************************************
+uint32_t
+WavPlayRateMax(uint32_t ui32BurstCycles, uint32_t ui32FrameBytes,
+               uint32_t ui32Clock)
+{
+    uint64_t ui64Rate;
+
+    if(ui32BurstCycles == 0)
+    {
+        return(0);
+    }
+
+    //
+    // A fast device, such as a host's page cache, could overflow the result.
+    //
+    ui64Rate = (((uint64_t)ui32Clock * WAV_PLAY_BURST_BYTES) /
+                ((uint64_t)ui32BurstCycles * ui32FrameBytes));
+
+    return((ui64Rate > 0xffffffff) ? 0xffffffff : (uint32_t)ui64Rate);
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -0,0 +1,113 @@
+//*****************************************************************************
+//
+// wav_play.h - Prototypes for the block device WAV player.
+//
+//*****************************************************************************
+
+#ifndef __WAV_PLAY_H__
+#define __WAV_PLAY_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The number of blocks read per device call, i.e. the size of each half of
+// the double buffer.  Longer bursts amortize the per-command cost of the
+// card at the cost of RAM.
+//
+//*****************************************************************************
+#ifndef WAV_PLAY_BURST
+#define WAV_PLAY_BURST          4
+#endif
+
+//*****************************************************************************
+//
+// Reads ui32Count consecutive blocks starting at block ui32Block of a device
+// into pui8Data, returning true on success.  The application provides this
+// for its card driver.
+//
+//*****************************************************************************
+typedef bool (*tWavBlockRead)(void *pvDevice, uint32_t ui32Block,
+                              uint8_t *pui8Data, uint32_t ui32Count);
+
+//*****************************************************************************
+//
+// A player instance.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The device and the next block of the file to read from it.
+    //
+    tWavBlockRead pfnRead;
+    void *pvDevice;
+    uint32_t ui32Block;
+
+    //
+    // The sample data bytes not yet read from the device.
+    //
+    uint32_t ui32Remaining;
+
+    //
+    // The layout of the file.
+    //
+    tWavInfo sInfo;
+
+    //
+    // The file channels played on the left and the right codec channels.
+    //
+    uint32_t ui32LeftChannel;
+    uint32_t ui32RightChannel;
+
+    //
+    // The number of frames that found no data waiting while the file still
+    // had some to read.
+    //
+    volatile uint32_t ui32Underruns;
+
+    //
+    // The double buffer.  The device fills one half while the other plays.
+    //
+    tRing sRing;
+    uint8_t pui8Buf[2 * WAV_PLAY_BURST * WAV_BLOCK_SIZE];
+}
+tWavPlayer;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern bool WavPlayOpen(tWavPlayer *psPlayer, tWavBlockRead pfnRead,
+                        void *pvDevice, uint32_t ui32FirstBlock);
+extern bool WavPlayChannelsSet(tWavPlayer *psPlayer, uint32_t ui32Left,
+                               uint32_t ui32Right);
+extern bool WavPlayService(tWavPlayer *psPlayer);
+extern uint32_t WavPlayFrameGet(tWavPlayer *psPlayer, int16_t *pi16Out,
+                                uint32_t ui32Frames);
+extern bool WavPlayDone(tWavPlayer *psPlayer);
+extern uint32_t WavPlayBenchmark(tWavBlockRead pfnRead, void *pvDevice,
+                                 uint32_t ui32Block, uint8_t *pui8Scratch);
+extern uint32_t WavPlayRateMax(uint32_t ui32BurstCycles,
+                               uint32_t ui32FrameBytes, uint32_t ui32Clock);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __WAV_PLAY_H__
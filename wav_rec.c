@@ -0,0 +1,348 @@
+//*****************************************************************************
+//
+// wav_rec.c - Block device WAV recorder.
+//
+// The recorder captures the canceller's primary input, noise reference and
+// error to a WAV file on a block device, typically an SD card, for field
+// diagnostics.  It is the player in reverse: the frame processor hands over
+// frames, which are packed into one half of a double buffer (see ring.h)
+// while the other half is written out a burst of whole sectors at a time.
+//
+// Handing frames over is a bounded copy that never waits on the device, so
+// it adds no jitter to the frame processor, in the interrupt or in the main
+// loop.  If the device has fallen so far behind that the buffer is full, the
+// frames are dropped and counted instead.  The device is only written from
+// WavRecService(), which the main loop calls at its lowest priority.
+//
+// The file's blocks must be allocated, consecutively, before recording
+// starts; with FatFs, for example, by f_expand().  The recorder then only
+// writes whole blocks inside them and never waits for the file system to
+// find a free cluster.  The first block holds the header, padded with a
+// JUNK chunk so that the samples start on a block boundary.  It is written
+// at the start for the whole of the file, so that a recording cut short by
+// a reset still opens, and rewritten with the true sizes at the stop.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "ring.h"
+#include "wav_riff.h"
+#include "wav_rec.h"
+
+//*****************************************************************************
+//
+//! \addtogroup wav_rec_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The size of one half of the double buffer, and of a frame, in bytes.
+//
+//*****************************************************************************
+#define WAV_REC_BURST_BYTES     (WAV_REC_BURST * WAV_BLOCK_SIZE)
+#define WAV_REC_FRAME_BYTES     (WAV_REC_CHANNELS * 2)
+
+//*****************************************************************************
+//
+// The files must open with the tree's own parser.
+//
+//*****************************************************************************
+typedef char WavRecChannelsParse[(WAV_REC_CHANNELS <= WAV_MAX_CHANNELS) ?
+                                 1 : -1];
+
+//*****************************************************************************
+//
+// The offsets in the header block of the RIFF size, the fmt chunk, the JUNK
+// chunk that pads the header to one block, and the data chunk header.
+//
+//*****************************************************************************
+#define WAV_REC_RIFF_SIZE       4
+#define WAV_REC_FMT             12
+#define WAV_REC_JUNK            36
+#define WAV_REC_DATA            (WAV_BLOCK_SIZE - 8)
+
+//*****************************************************************************
+//
+// Writes little-endian fields to a byte buffer.
+//
+//*****************************************************************************
+static void
+WavRecWrite16(uint8_t *pui8Data, uint32_t ui32Value)
+{
+    pui8Data[0] = (uint8_t)ui32Value;
+    pui8Data[1] = (uint8_t)(ui32Value >> 8);
+}
+
+static void
+WavRecWrite32(uint8_t *pui8Data, uint32_t ui32Value)
+{
+    WavRecWrite16(pui8Data, ui32Value);
+    WavRecWrite16(pui8Data + 2, ui32Value >> 16);
+}
+
+//*****************************************************************************
+//
+// Writes the header block for ui32DataSize bytes of samples.  The block is
+// built in the double buffer, which must be empty.
+//
+//*****************************************************************************
+static bool
+WavRecHeaderWrite(tWavRecorder *psRec, uint32_t ui32DataSize)
+{
+    uint8_t *pui8Header;
+
+    pui8Header = psRec->pui8Buf;
+    memset(pui8Header, 0, WAV_BLOCK_SIZE);
+
+    memcpy(&pui8Header[0], "RIFF", 4);
+    WavRecWrite32(&pui8Header[WAV_REC_RIFF_SIZE],
+                  WAV_BLOCK_SIZE - 8 + ui32DataSize);
+    memcpy(&pui8Header[8], "WAVE", 4);
+
+    memcpy(&pui8Header[WAV_REC_FMT], "fmt ", 4);
+    WavRecWrite32(&pui8Header[WAV_REC_FMT + 4], 16);
+    WavRecWrite16(&pui8Header[WAV_REC_FMT + 8], WAV_FORMAT_PCM);
+    WavRecWrite16(&pui8Header[WAV_REC_FMT + 10], WAV_REC_CHANNELS);
+    WavRecWrite32(&pui8Header[WAV_REC_FMT + 12], psRec->ui32Rate);
+    WavRecWrite32(&pui8Header[WAV_REC_FMT + 16],
+                  psRec->ui32Rate * WAV_REC_FRAME_BYTES);
+    WavRecWrite16(&pui8Header[WAV_REC_FMT + 20], WAV_REC_FRAME_BYTES);
+    WavRecWrite16(&pui8Header[WAV_REC_FMT + 22], 16);
+
+    memcpy(&pui8Header[WAV_REC_JUNK], "JUNK", 4);
+    WavRecWrite32(&pui8Header[WAV_REC_JUNK + 4],
+                  WAV_REC_DATA - WAV_REC_JUNK - 8);
+
+    memcpy(&pui8Header[WAV_REC_DATA], "data", 4);
+    WavRecWrite32(&pui8Header[WAV_REC_DATA + 4], ui32DataSize);
+
+    return(psRec->pfnWrite(psRec->pvDevice, psRec->ui32FirstBlock,
+                           pui8Header, 1));
+}
+
+//*****************************************************************************
+//
+//! Starts a recording.
+//!
+//! \param psRec is a pointer to the recorder state.
+//! \param pfnWrite is the device's block write function.
+//! \param pvDevice is passed to \e pfnWrite to identify the device.
+//! \param ui32FirstBlock is the first block of the file.
+//! \param ui32NumBlocks is the number of consecutive blocks allocated to the
+//! file, including the header block.
+//! \param ui32Rate is the sample rate of the frames in Hz.
+//!
+//! The header is written for a file that fills every block, and frames are
+//! taken from the return on.
+//!
+//! \return Returns \b true on success or \b false if the file has no room
+//! for samples or the header could not be written.
+//
+//*****************************************************************************
+bool
+WavRecStart(tWavRecorder *psRec, tWavBlockWrite pfnWrite, void *pvDevice,
+            uint32_t ui32FirstBlock, uint32_t ui32NumBlocks,
+            uint32_t ui32Rate)
+{
+    psRec->bRecording = false;
+    if(ui32NumBlocks < 2)
+    {
+        return(false);
+    }
+
+    psRec->pfnWrite = pfnWrite;
+    psRec->pvDevice = pvDevice;
+    psRec->ui32FirstBlock = ui32FirstBlock;
+    psRec->ui32NumBlocks = ui32NumBlocks;
+    psRec->ui32Block = ui32FirstBlock + 1;
+    psRec->ui32Rate = ui32Rate;
+    psRec->ui32Taken = 0;
+    psRec->ui32Capacity = (ui32NumBlocks - 1) * WAV_BLOCK_SIZE;
+    psRec->ui32Capacity -= psRec->ui32Capacity % WAV_REC_FRAME_BYTES;
+    psRec->ui32Dropped = 0;
+    psRec->ui32Truncated = 0;
+    psRec->ui32WriteErrors = 0;
+    psRec->ui32MaxUsed = 0;
+    RingInit(&psRec->sRing, psRec->pui8Buf, sizeof(psRec->pui8Buf));
+
+    if(!WavRecHeaderWrite(psRec, psRec->ui32Capacity))
+    {
+        return(false);
+    }
+
+    psRec->bRecording = true;
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Records frames.
+//!
+//! \param psRec is a pointer to the recorder state.
+//! \param pi16Primary points to the primary input samples.
+//! \param pi16Ref points to the noise reference samples.
+//! \param pi16Error points to the error samples.
+//! \param ui32Stride is the distance between consecutive samples of each
+//! channel, e.g. 2 for the left or right channel of a codec frame.
+//! \param ui32Frames is the number of frames.
+//!
+//! This is called from the frame processor.  The frames are copied into the
+//! double buffer; the device is not touched.  If there is no room for all of
+//! them, in the buffer or in the file, none are taken, and they are counted
+//! in \e psRec->ui32Dropped or \e psRec->ui32Truncated.  Nothing is done
+//! unless a recording is running.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+WavRecFrameWrite(tWavRecorder *psRec, const int16_t *pi16Primary,
+                 const int16_t *pi16Ref, const int16_t *pi16Error,
+                 uint32_t ui32Stride, uint32_t ui32Frames)
+{
+    int16_t pi16Frame[WAV_REC_CHANNELS];
+    uint32_t ui32Bytes, ui32Idx;
+
+    if(!psRec->bRecording)
+    {
+        return;
+    }
+
+    ui32Bytes = ui32Frames * WAV_REC_FRAME_BYTES;
+    if(ui32Bytes > (psRec->ui32Capacity - psRec->ui32Taken))
+    {
+        psRec->ui32Truncated += ui32Frames;
+        return;
+    }
+    if(ui32Bytes > RingFree(&psRec->sRing))
+    {
+        psRec->ui32Dropped += ui32Frames;
+        return;
+    }
+
+    //
+    // The samples are stored in the processor's byte order, which is the
+    // little-endian order of the file.
+    //
+    for(ui32Idx = 0; ui32Idx < ui32Frames; ui32Idx++)
+    {
+        pi16Frame[0] = pi16Primary[ui32Idx * ui32Stride];
+        pi16Frame[1] = pi16Ref[ui32Idx * ui32Stride];
+        pi16Frame[2] = pi16Error[ui32Idx * ui32Stride];
+        RingWrite(&psRec->sRing, (const uint8_t *)pi16Frame,
+                  WAV_REC_FRAME_BYTES);
+    }
+    psRec->ui32Taken += ui32Bytes;
+}
+
+//*****************************************************************************
+//
+//! Writes out the double buffer.
+//!
+//! \param psRec is a pointer to the recorder state.
+//!
+//! Each half of the double buffer that has filled is written to the device.
+//! This is called from the main loop at its lowest priority, at least once
+//! per half buffer of recording time.
+//!
+//! \return Returns \b false if the device failed, or \b true otherwise.
+//
+//*****************************************************************************
+bool
+WavRecService(tWavRecorder *psRec)
+{
+    const uint8_t *pui8Span;
+    uint32_t ui32Used;
+
+    ui32Used = RingUsed(&psRec->sRing);
+    if(ui32Used > psRec->ui32MaxUsed)
+    {
+        psRec->ui32MaxUsed = ui32Used;
+    }
+
+    //
+    // Bursts are always taken whole, so a full half is always contiguous.
+    //
+    while(RingReadSpanGet(&psRec->sRing, &pui8Span) >= WAV_REC_BURST_BYTES)
+    {
+        if(!psRec->pfnWrite(psRec->pvDevice, psRec->ui32Block, pui8Span,
+                            WAV_REC_BURST))
+        {
+            psRec->ui32WriteErrors++;
+            return(false);
+        }
+        RingReadCommit(&psRec->sRing, WAV_REC_BURST_BYTES);
+        psRec->ui32Block += WAV_REC_BURST;
+    }
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Stops a recording and finishes the file.
+//!
+//! \param psRec is a pointer to the recorder state.
+//!
+//! No more frames are taken.  The frames still in the double buffer are
+//! written, the last block padded with silence, and the header rewritten
+//! for the samples recorded.  This is called from the main loop.
+//!
+//! \return Returns \b true on success or \b false if the device failed, in
+//! which case this may be called again to retry.
+//
+//*****************************************************************************
+bool
+WavRecStop(tWavRecorder *psRec)
+{
+    const uint8_t *pui8Span;
+    uint32_t ui32Used, ui32Blocks;
+
+    psRec->bRecording = false;
+
+    if(!WavRecService(psRec))
+    {
+        return(false);
+    }
+
+    //
+    // What is left is less than a burst, in the half the next burst would
+    // have been written from.  Pad it to whole blocks in place.
+    //
+    ui32Used = RingReadSpanGet(&psRec->sRing, &pui8Span);
+    if(ui32Used)
+    {
+        ui32Blocks = (ui32Used + WAV_BLOCK_SIZE - 1) / WAV_BLOCK_SIZE;
+        memset((uint8_t *)pui8Span + ui32Used, 0,
+               (ui32Blocks * WAV_BLOCK_SIZE) - ui32Used);
+        if(!psRec->pfnWrite(psRec->pvDevice, psRec->ui32Block, pui8Span,
+                            ui32Blocks))
+        {
+            psRec->ui32WriteErrors++;
+            return(false);
+        }
+        RingReadCommit(&psRec->sRing, ui32Used);
+        psRec->ui32Block += ui32Blocks;
+    }
+
+    RingInit(&psRec->sRing, psRec->pui8Buf, sizeof(psRec->pui8Buf));
+    if(!WavRecHeaderWrite(psRec, psRec->ui32Taken))
+    {
+        psRec->ui32WriteErrors++;
+        return(false);
+    }
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
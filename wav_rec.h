@@ -0,0 +1,135 @@
+//*****************************************************************************
+//
+// wav_rec.h - Prototypes for the block device WAV recorder.
+//
+//*****************************************************************************
+
+#ifndef __WAV_REC_H__
+#define __WAV_REC_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The number of blocks written per device call, i.e. the size of each half
+// of the double buffer.  It must be a power of two.  Longer bursts amortize
+// the per-command cost of the card, and ride out its longer busy periods,
+// at the cost of RAM.
+//
+//*****************************************************************************
+#ifndef WAV_REC_BURST
+#define WAV_REC_BURST           4
+#endif
+
+//*****************************************************************************
+//
+// The channels of a recording: the primary input, the noise reference and
+// the error, i.e. the processed output, as 16-bit samples.
+//
+//*****************************************************************************
+#define WAV_REC_CHANNELS        3
+
+//*****************************************************************************
+//
+// Writes ui32Count consecutive blocks starting at block ui32Block of a device
+// from pui8Data, returning true on success.  The application provides this
+// for its card driver.
+//
+//*****************************************************************************
+typedef bool (*tWavBlockWrite)(void *pvDevice, uint32_t ui32Block,
+                               const uint8_t *pui8Data, uint32_t ui32Count);
+
+//*****************************************************************************
+//
+// A recorder instance.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The device, the file's blocks on it and the next block to write.
+    //
+    tWavBlockWrite pfnWrite;
+    void *pvDevice;
+    uint32_t ui32FirstBlock;
+    uint32_t ui32NumBlocks;
+    uint32_t ui32Block;
+
+    //
+    // The sample rate written to the header.
+    //
+    uint32_t ui32Rate;
+
+    //
+    // True while frames are being taken.
+    //
+    volatile bool bRecording;
+
+    //
+    // The sample data bytes taken so far, and the most the file can hold.
+    // Only the frame writer changes ui32Taken.
+    //
+    volatile uint32_t ui32Taken;
+    uint32_t ui32Capacity;
+
+    //
+    // The number of frames dropped because the double buffer was full, i.e.
+    // the device fell behind, and because the file was full.
+    //
+    volatile uint32_t ui32Dropped;
+    volatile uint32_t ui32Truncated;
+
+    //
+    // The number of failed device writes.  A failed burst is retried at the
+    // next service.
+    //
+    volatile uint32_t ui32WriteErrors;
+
+    //
+    // The most bytes found waiting in the double buffer at a service, a
+    // measure of how close the device has come to dropping frames.
+    //
+    uint32_t ui32MaxUsed;
+
+    //
+    // The double buffer.  One half fills with frames while the other is
+    // written.
+    //
+    tRing sRing;
+    uint8_t pui8Buf[2 * WAV_REC_BURST * WAV_BLOCK_SIZE];
+}
+tWavRecorder;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern bool WavRecStart(tWavRecorder *psRec, tWavBlockWrite pfnWrite,
+                        void *pvDevice, uint32_t ui32FirstBlock,
+                        uint32_t ui32NumBlocks, uint32_t ui32Rate);
+extern void WavRecFrameWrite(tWavRecorder *psRec, const int16_t *pi16Primary,
+                             const int16_t *pi16Ref, const int16_t *pi16Error,
+                             uint32_t ui32Stride, uint32_t ui32Frames);
+extern bool WavRecService(tWavRecorder *psRec);
+extern bool WavRecStop(tWavRecorder *psRec);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __WAV_REC_H__
@@ -0,0 +1,232 @@
+//*****************************************************************************
+//
+// wav_riff.c - RIFF/WAV header parser.
+//
+// A WAV file is a RIFF container: a 12-byte RIFF header naming the WAVE
+// form, then a sequence of chunks, each an 8-byte identifier and size
+// followed by the body, padded to an even length.  Only the fmt and data
+// chunks matter for playing; LIST, fact, cue and the rest are stepped over.
+// Nothing fixes their order or the size of the fmt chunk, so the offset of
+// the samples can only be found by walking the chunks.
+//
+// The parser walks the chunks once, over the first sectors of the file as
+// they were read into a buffer, and stops at the data chunk.  It copies
+// nothing; the samples it reports point into the same buffer.
+//
+// The module uses no target peripherals and builds for the host as well.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "wav_riff.h"
+
+//*****************************************************************************
+//
+//! \addtogroup wav_riff_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The sizes of the RIFF header and of a chunk header, and the sizes of the
+// basic and the extensible fmt chunk bodies.
+//
+//*****************************************************************************
+#define WAV_RIFF_HEADER_SIZE    12
+#define WAV_CHUNK_HEADER_SIZE   8
+#define WAV_FMT_SIZE            16
+#define WAV_FMT_EXT_SIZE        40
+
+//*****************************************************************************
+//
+// The last 14 bytes of the subtype GUID of an extensible fmt chunk.  The
+// first two bytes hold the format tag of the subtype.
+//
+//*****************************************************************************
+static const uint8_t g_pui8WavSubtypeGUID[14] =
+{
+    0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00,
+    0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71
+};
+
+//*****************************************************************************
+//
+// Reads little-endian fields from a byte buffer.
+//
+//*****************************************************************************
+static uint32_t
+WavRiffRead16(const uint8_t *pui8Data)
+{
+    return((uint32_t)pui8Data[0] | ((uint32_t)pui8Data[1] << 8));
+}
+
+static uint32_t
+WavRiffRead32(const uint8_t *pui8Data)
+{
+    return(WavRiffRead16(pui8Data) | (WavRiffRead16(pui8Data + 2) << 16));
+}
+
+//*****************************************************************************
+//
+// Checks a fmt chunk body and fills in the format fields of psInfo.
+//
+//*****************************************************************************
+static bool
+WavRiffFmtParse(const uint8_t *pui8Fmt, uint32_t ui32Size, tWavInfo *psInfo)
+{
+    uint32_t ui32Format;
+
+    if(ui32Size < WAV_FMT_SIZE)
+    {
+        return(false);
+    }
+
+    ui32Format = WavRiffRead16(&pui8Fmt[0]);
+    psInfo->ui32Channels = WavRiffRead16(&pui8Fmt[2]);
+    psInfo->ui32Rate = WavRiffRead32(&pui8Fmt[4]);
+    psInfo->ui32FrameBytes = WavRiffRead16(&pui8Fmt[12]);
+    psInfo->ui32Bits = WavRiffRead16(&pui8Fmt[14]);
+    psInfo->ui32ValidBits = psInfo->ui32Bits;
+
+    //
+    // An extensible chunk carries the real format tag in its subtype, and
+    // may declare fewer significant bits than the container holds.
+    //
+    if(ui32Format == WAV_FORMAT_EXTENSIBLE)
+    {
+        if((ui32Size < WAV_FMT_EXT_SIZE) ||
+           memcmp(&pui8Fmt[26], g_pui8WavSubtypeGUID,
+                  sizeof(g_pui8WavSubtypeGUID)))
+        {
+            return(false);
+        }
+        ui32Format = WavRiffRead16(&pui8Fmt[24]);
+        if(WavRiffRead16(&pui8Fmt[18]) != 0)
+        {
+            psInfo->ui32ValidBits = WavRiffRead16(&pui8Fmt[18]);
+        }
+    }
+
+    psInfo->ui32Format = ui32Format;
+    if((psInfo->ui32Channels < 1) ||
+       (psInfo->ui32Channels > WAV_MAX_CHANNELS) ||
+       (psInfo->ui32Rate == 0) ||
+       (psInfo->ui32ValidBits > psInfo->ui32Bits) ||
+       (psInfo->ui32FrameBytes !=
+        (psInfo->ui32Channels * (psInfo->ui32Bits / 8))))
+    {
+        return(false);
+    }
+
+    if(ui32Format == WAV_FORMAT_PCM)
+    {
+        return((psInfo->ui32Bits == 16) || (psInfo->ui32Bits == 24) ||
+               (psInfo->ui32Bits == 32));
+    }
+    if(ui32Format == WAV_FORMAT_FLOAT)
+    {
+        return(psInfo->ui32Bits == 32);
+    }
+    return(false);
+}
+
+//*****************************************************************************
+//
+//! Finds the format and the samples of a WAV file.
+//!
+//! \param pui8Buf points to the start of the file, typically its first
+//! sectors.
+//! \param ui32Size is the number of bytes in the buffer.
+//! \param psInfo is a pointer to the structure that receives the layout.
+//!
+//! The chunks are walked from the RIFF header up to the data chunk, which
+//! must follow a valid fmt chunk.  Integer PCM of 16, 24 or 32 bits and
+//! 32-bit float are accepted, in one to \b WAV_MAX_CHANNELS channels, in
+//! both the basic and the extensible fmt layouts.
+//!
+//! The buffer need only reach the data chunk's header; the samples may lie
+//! beyond it.  \e psInfo->pui8Data then points to where they would start in
+//! the buffer, and \e psInfo->ui32DataInBuffer is 0.
+//!
+//! \return Returns \b WAV_RIFF_OK on success, \b WAV_RIFF_NOT_WAV if the
+//! buffer does not start with a RIFF WAVE header, \b WAV_RIFF_UNSUPPORTED if
+//! the fmt chunk is missing, malformed or not a supported format, or
+//! \b WAV_RIFF_TRUNCATED if the buffer ends before the data chunk header.
+//
+//*****************************************************************************
+uint32_t
+WavRiffParse(const uint8_t *pui8Buf, uint32_t ui32Size, tWavInfo *psInfo)
+{
+    uint32_t ui32Offset, ui32ChunkSize;
+    bool bFmt;
+
+    if((ui32Size < WAV_RIFF_HEADER_SIZE) ||
+       memcmp(&pui8Buf[0], "RIFF", 4) || memcmp(&pui8Buf[8], "WAVE", 4))
+    {
+        return(WAV_RIFF_NOT_WAV);
+    }
+
+    bFmt = false;
+    ui32Offset = WAV_RIFF_HEADER_SIZE;
+    while((ui32Size - ui32Offset) >= WAV_CHUNK_HEADER_SIZE)
+    {
+        ui32ChunkSize = WavRiffRead32(&pui8Buf[ui32Offset + 4]);
+
+        if(!memcmp(&pui8Buf[ui32Offset], "fmt ", 4))
+        {
+            if((ui32Size - ui32Offset - WAV_CHUNK_HEADER_SIZE) <
+               ui32ChunkSize)
+            {
+                return(WAV_RIFF_TRUNCATED);
+            }
+            if(!WavRiffFmtParse(&pui8Buf[ui32Offset + WAV_CHUNK_HEADER_SIZE],
+                                ui32ChunkSize, psInfo))
+            {
+                return(WAV_RIFF_UNSUPPORTED);
+            }
+            bFmt = true;
+        }
+        else if(!memcmp(&pui8Buf[ui32Offset], "data", 4))
+        {
+            if(!bFmt)
+            {
+                return(WAV_RIFF_UNSUPPORTED);
+            }
+
+            ui32Offset += WAV_CHUNK_HEADER_SIZE;
+            psInfo->ui32DataOffset = ui32Offset;
+            psInfo->ui32DataSize =
+                ui32ChunkSize - (ui32ChunkSize % psInfo->ui32FrameBytes);
+            psInfo->pui8Data = &pui8Buf[ui32Offset];
+            psInfo->ui32DataInBuffer = ui32Size - ui32Offset;
+            if(psInfo->ui32DataInBuffer > psInfo->ui32DataSize)
+            {
+                psInfo->ui32DataInBuffer = psInfo->ui32DataSize;
+            }
+            return(WAV_RIFF_OK);
+        }
+
+        //
+        // Step over the chunk and its pad byte.  A size that runs to the end
+        // of the buffer or past it leaves nothing more to walk here.
+        //
+        if(ui32ChunkSize >= (ui32Size - ui32Offset - WAV_CHUNK_HEADER_SIZE))
+        {
+            break;
+        }
+        ui32Offset += WAV_CHUNK_HEADER_SIZE + ui32ChunkSize +
+                      (ui32ChunkSize & 1);
+    }
+
+    return(WAV_RIFF_TRUNCATED);
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -0,0 +1,121 @@
+//*****************************************************************************
+//
+// wav_riff.h - Prototypes for the RIFF/WAV header parser.
+//
+//*****************************************************************************
+
+#ifndef __WAV_RIFF_H__
+#define __WAV_RIFF_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The sample formats reported in tWavInfo.ui32Format.  Extensible files are
+// reported as the format of their subtype.
+//
+//*****************************************************************************
+#define WAV_FORMAT_PCM          0x0001      // Integer PCM
+#define WAV_FORMAT_FLOAT        0x0003      // IEEE 754 single precision
+#define WAV_FORMAT_EXTENSIBLE   0xfffe
+
+//*****************************************************************************
+//
+// The most channels a file may have.  The recorder's files have three (see
+// wav_rec.h); players choose which of them to use.
+//
+//*****************************************************************************
+#define WAV_MAX_CHANNELS        8
+
+//*****************************************************************************
+//
+// The block size of the devices WAV files are played from and recorded to:
+// one SD card sector.
+//
+//*****************************************************************************
+#define WAV_BLOCK_SIZE          512
+
+//*****************************************************************************
+//
+// Values returned by WavRiffParse().
+//
+//*****************************************************************************
+#define WAV_RIFF_OK             0           // The data chunk was found
+#define WAV_RIFF_NOT_WAV        1           // Not a RIFF WAVE file
+#define WAV_RIFF_UNSUPPORTED    2           // Bad or unsupported fmt chunk
+#define WAV_RIFF_TRUNCATED      3           // The buffer ends before data
+
+//*****************************************************************************
+//
+// The layout of a WAV file as found by WavRiffParse().
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // One of WAV_FORMAT_PCM or WAV_FORMAT_FLOAT.
+    //
+    uint32_t ui32Format;
+
+    //
+    // The number of channels, 1 to WAV_MAX_CHANNELS, and the sample rate in
+    // Hz.
+    //
+    uint32_t ui32Channels;
+    uint32_t ui32Rate;
+
+    //
+    // The bits each sample occupies in the file, 16, 24 or 32, and the bits
+    // of it that are significant, counted from the most significant end.
+    //
+    uint32_t ui32Bits;
+    uint32_t ui32ValidBits;
+
+    //
+    // The bytes per frame of all channels.
+    //
+    uint32_t ui32FrameBytes;
+
+    //
+    // The file offset and size of the sample data, the size rounded down to
+    // whole frames.
+    //
+    uint32_t ui32DataOffset;
+    uint32_t ui32DataSize;
+
+    //
+    // The sample data in the parsed buffer, without a copy, and how many of
+    // its bytes the buffer holds; 0 if the data starts beyond the buffer.
+    //
+    const uint8_t *pui8Data;
+    uint32_t ui32DataInBuffer;
+}
+tWavInfo;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern uint32_t WavRiffParse(const uint8_t *pui8Buf, uint32_t ui32Size,
+                             tWavInfo *psInfo);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __WAV_RIFF_H__
@@ -0,0 +1,598 @@
+//*****************************************************************************
+//
+// wm8731.c - Interrupt-driven control of the WM8731 codec over I2C0.
+//
+// Every control write is one three-byte I2C transaction: the address, then
+// the register number and the ninth data bit, then the lower eight data
+// bits.  Writes are queued and sent by the I2C0 interrupt one byte at a
+// time, so changing a setting never waits for the bus and can be done from
+// any context, including the audio path.  The bus runs in 400 kHz fast
+// mode, so a write takes about 70 us.
+//
+// A table of settings may also hold waits.  A wait holds the queue for a
+// time on Timer 1A instead of spinning, so bring-up sequences that need the
+// codec to settle between writes cost no CPU time either.  The TM4C123 I2C
+// master has no transmit FIFO or burst counter, so the bytes are still fed
+// one per interrupt; that is three short interrupts per write.
+//
+// The codec's registers are write-only, so a shadow copy of all of them is
+// kept here.  Reads come from the shadow and cost nothing, and a write of
+// the value a register already holds is dropped.  Until the first reset the
+// codec's contents are unknown, so nothing is dropped before then.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/gpio.h"
+#include "driverlib/i2c.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#include "clock.h"
+#include "wm8731.h"
+
+//*****************************************************************************
+//
+//! \addtogroup wm8731_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The queue must be a power of two in size so that the free-running indices
+// wrap cleanly.
+//
+//*****************************************************************************
+typedef char
+    WM8731QueueIsPow2[((WM8731_QUEUE_SIZE &
+                        (WM8731_QUEUE_SIZE - 1)) == 0) ? 1 : -1];
+
+//*****************************************************************************
+//
+// Maps a register number to its slot in the shadow copy.  The reset register
+// takes the slot after the active control register.
+//
+//*****************************************************************************
+#define WM8731_SHADOW_INDEX(ui32Reg)                                          \
+        (((ui32Reg) == WM8731_REG_RESET) ? (WM8731_NUM_REGS - 1) : (ui32Reg))
+
+//*****************************************************************************
+//
+// The control word for a register write: seven bits of register number over
+// nine bits of data.
+//
+//*****************************************************************************
+#define WM8731_WORD(ui32Reg, ui32Value)                                       \
+        ((uint16_t)(((ui32Reg) << 9) | ((ui32Value) & 0x1ff)))
+
+//*****************************************************************************
+//
+// The register contents after a reset, from the datasheet.
+//
+//*****************************************************************************
+static const uint16_t g_pui16WM8731Defaults[WM8731_NUM_REGS] =
+{
+    0x097, 0x097, 0x079, 0x079, 0x00a, 0x008, 0x09f, 0x00a, 0x000, 0x000,
+    0x000
+};
+
+//*****************************************************************************
+//
+// The shadow copy of the registers, holding the value each will have once
+// the queue has drained, and the set of registers whose contents in the
+// codec are not known.
+//
+//*****************************************************************************
+static uint16_t g_pui16WM8731Shadow[WM8731_NUM_REGS];
+static uint32_t g_ui32WM8731Unknown;
+
+//*****************************************************************************
+//
+// The write queue.  Whenever the queue is not empty, the entry at its head
+// is on the bus or, for a wait, being timed.
+//
+//*****************************************************************************
+static uint16_t g_pui16WM8731Queue[WM8731_QUEUE_SIZE];
+static volatile uint32_t g_ui32WM8731Head;
+static volatile uint32_t g_ui32WM8731Tail;
+
+//*****************************************************************************
+//
+// Set while the second byte of the head entry is on the bus, and the number
+// of writes the codec did not acknowledge.
+//
+//*****************************************************************************
+static bool g_bWM8731Finishing;
+static volatile uint32_t g_ui32WM8731Errors;
+
+//*****************************************************************************
+//
+// The system clock the bus and the wait timer were set up for.
+//
+//*****************************************************************************
+static uint32_t g_ui32WM8731Clock;
+
+//*****************************************************************************
+//
+// Starts the transaction or the wait for the entry at the head of the queue.
+//
+//*****************************************************************************
+static void
+WM8731Send(void)
+{
+    uint16_t ui16Word;
+
+    ui16Word = g_pui16WM8731Queue[g_ui32WM8731Head % WM8731_QUEUE_SIZE];
+    if((ui16Word >> 9) == WM8731_WAIT)
+    {
+        TimerLoadSet(TIMER1_BASE, TIMER_A,
+                     (ui16Word & 0x1ff) * (g_ui32WM8731Clock / 1000));
+        TimerEnable(TIMER1_BASE, TIMER_A);
+        return;
+    }
+
+    g_bWM8731Finishing = false;
+    I2CMasterSlaveAddrSet(I2C0_BASE, WM8731_I2C_ADDR, false);
+    I2CMasterDataPut(I2C0_BASE, (uint8_t)(ui16Word >> 8));
+    I2CMasterControl(I2C0_BASE, I2C_MASTER_CMD_BURST_SEND_START);
+}
+
+//*****************************************************************************
+//
+// Queues one control word, starting the bus if it was idle.  Interrupts must
+// be disabled.
+//
+//*****************************************************************************
+static bool
+WM8731Queue(uint32_t ui32Reg, uint32_t ui32Value)
+{
+    uint32_t ui32Count;
+
+    ui32Count = g_ui32WM8731Tail - g_ui32WM8731Head;
+
+    //
+    // A write to the same register as the last queued one, not yet on the
+    // bus, replaces it.  Nothing was queued after it, so the order of the
+    // writes the codec sees is unchanged.  Waits are never merged.
+    //
+    if((ui32Count > 1) && (ui32Reg != WM8731_WAIT) &&
+       ((g_pui16WM8731Queue[(g_ui32WM8731Tail - 1) % WM8731_QUEUE_SIZE] >>
+         9) == ui32Reg))
+    {
+        g_pui16WM8731Queue[(g_ui32WM8731Tail - 1) % WM8731_QUEUE_SIZE] =
+            WM8731_WORD(ui32Reg, ui32Value);
+        return(true);
+    }
+
+    if(ui32Count == WM8731_QUEUE_SIZE)
+    {
+        return(false);
+    }
+
+    g_pui16WM8731Queue[g_ui32WM8731Tail % WM8731_QUEUE_SIZE] =
+        WM8731_WORD(ui32Reg, ui32Value);
+    g_ui32WM8731Tail++;
+    if(ui32Count == 0)
+    {
+        WM8731Send();
+    }
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Follows a change of the system clock.  The byte on the bus is let finish
+// before the bus clock divider is set again, and a wait being timed has its
+// remaining count rescaled so that it still lasts as long as it should.
+//
+//*****************************************************************************
+static void
+WM8731ClockSet(uint32_t ui32Clock)
+{
+    uint32_t ui32Remaining;
+    bool bIntsOff;
+
+    bIntsOff = IntMasterDisable();
+
+    while(I2CMasterBusy(I2C0_BASE))
+    {
+    }
+    I2CMasterInitExpClk(I2C0_BASE, ui32Clock, true);
+
+    if((g_ui32WM8731Head != g_ui32WM8731Tail) &&
+       ((g_pui16WM8731Queue[g_ui32WM8731Head % WM8731_QUEUE_SIZE] >> 9) ==
+        WM8731_WAIT))
+    {
+        ui32Remaining = TimerValueGet(TIMER1_BASE, TIMER_A);
+        TimerLoadSet(TIMER1_BASE, TIMER_A,
+                     (uint32_t)(((uint64_t)ui32Remaining * ui32Clock) /
+                                g_ui32WM8731Clock));
+    }
+    g_ui32WM8731Clock = ui32Clock;
+
+    if(!bIntsOff)
+    {
+        IntMasterEnable();
+    }
+}
+
+//*****************************************************************************
+//
+//! Initializes the codec control driver.
+//!
+//! I2C0 is set up as a 400 kHz master on PB2 (SCL) and PB3 (SDA) and Timer
+//! 1A as the one-shot wait timer, both with their interrupts enabled.  No
+//! write is made; the first one should normally be a reset, after which the
+//! shadow copy holds the codec's defaults.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+WM8731Init(void)
+{
+    uint32_t ui32Reg;
+
+    for(ui32Reg = 0; ui32Reg < WM8731_NUM_REGS; ui32Reg++)
+    {
+        g_pui16WM8731Shadow[ui32Reg] = g_pui16WM8731Defaults[ui32Reg];
+    }
+    g_ui32WM8731Unknown = (1 << WM8731_NUM_REGS) - 1;
+    g_ui32WM8731Head = 0;
+    g_ui32WM8731Tail = 0;
+    g_ui32WM8731Errors = 0;
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_I2C0);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOB);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER1);
+    while(!SysCtlPeripheralReady(SYSCTL_PERIPH_I2C0) ||
+          !SysCtlPeripheralReady(SYSCTL_PERIPH_GPIOB) ||
+          !SysCtlPeripheralReady(SYSCTL_PERIPH_TIMER1))
+    {
+    }
+
+    GPIOPinConfigure(GPIO_PB2_I2C0SCL);
+    GPIOPinConfigure(GPIO_PB3_I2C0SDA);
+    GPIOPinTypeI2CSCL(GPIO_PORTB_BASE, GPIO_PIN_2);
+    GPIOPinTypeI2C(GPIO_PORTB_BASE, GPIO_PIN_3);
+
+    g_ui32WM8731Clock = SysCtlClockGet();
+    I2CMasterInitExpClk(I2C0_BASE, g_ui32WM8731Clock, true);
+    I2CMasterIntEnable(I2C0_BASE);
+    IntEnable(INT_I2C0);
+
+    TimerConfigure(TIMER1_BASE, TIMER_CFG_ONE_SHOT);
+    TimerIntEnable(TIMER1_BASE, TIMER_TIMA_TIMEOUT);
+    IntEnable(INT_TIMER1A);
+
+    ClockHookRegister(WM8731ClockSet);
+}
+
+//*****************************************************************************
+//
+//! Writes a codec register.
+//!
+//! \param ui32Reg is the register, one of the \b WM8731_REG_* values.
+//! \param ui32Value is the nine-bit value to write.
+//!
+//! The write is queued and this function returns at once.  Writes reach the
+//! codec in the order they were made.  A write of the value the register
+//! already holds is dropped, except to the reset register, and so is a write
+//! that is overtaken by another one to the same register before it reaches
+//! the bus.
+//!
+//! This function may be called from any context.
+//!
+//! \return Returns \b false if the queue was full and the write was lost.
+//
+//*****************************************************************************
+bool
+WM8731Write(uint32_t ui32Reg, uint32_t ui32Value)
+{
+    uint32_t ui32Index;
+    bool bIntsOff, bRet;
+
+    ui32Index = WM8731_SHADOW_INDEX(ui32Reg);
+    ui32Value &= 0x1ff;
+
+    bIntsOff = IntMasterDisable();
+
+    if((ui32Reg != WM8731_REG_RESET) &&
+       !(g_ui32WM8731Unknown & (1 << ui32Index)) &&
+       (g_pui16WM8731Shadow[ui32Index] == ui32Value))
+    {
+        bRet = true;
+    }
+    else
+    {
+        bRet = WM8731Queue(ui32Reg, ui32Value);
+    }
+
+    if(bRet)
+    {
+        if(ui32Reg == WM8731_REG_RESET)
+        {
+            for(ui32Index = 0; ui32Index < WM8731_NUM_REGS; ui32Index++)
+            {
+                g_pui16WM8731Shadow[ui32Index] =
+                    g_pui16WM8731Defaults[ui32Index];
+            }
+            g_ui32WM8731Unknown = 0;
+        }
+        else
+        {
+            g_pui16WM8731Shadow[ui32Index] = (uint16_t)ui32Value;
+            g_ui32WM8731Unknown &= ~(1 << ui32Index);
+        }
+    }
+
+    if(!bIntsOff)
+    {
+        IntMasterEnable();
+    }
+
+    return(bRet);
+}
+
+//*****************************************************************************
+//
+//! Holds the following writes for a time.
+//!
+//! \param ui32Milliseconds is the time to wait, from 1 to 511 ms.
+//!
+//! The wait starts once the writes queued before it have been sent.  It is
+//! used to give the codec the settling time the datasheet asks for without
+//! blocking the caller.
+//!
+//! \return Returns \b false if the queue was full and the wait was lost.
+//
+//*****************************************************************************
+bool
+WM8731Wait(uint32_t ui32Milliseconds)
+{
+    bool bIntsOff, bRet;
+
+    if(ui32Milliseconds == 0)
+    {
+        return(true);
+    }
+
+    bIntsOff = IntMasterDisable();
+    bRet = WM8731Queue(WM8731_WAIT,
+                       (ui32Milliseconds > 0x1ff) ? 0x1ff : ui32Milliseconds);
+    if(!bIntsOff)
+    {
+        IntMasterEnable();
+    }
+
+    return(bRet);
+}
+
+//*****************************************************************************
+//
+//! Changes some of the bits of a codec register.
+//!
+//! \param ui32Reg is the register, one of the \b WM8731_REG_* values.
+//! \param ui32Mask is the set of bits to change.
+//! \param ui32Value is the new value of those bits.
+//!
+//! The current value comes from the shadow copy, so no bus read is needed.
+//!
+//! \return Returns \b false if the queue was full and the write was lost.
+//
+//*****************************************************************************
+bool
+WM8731Update(uint32_t ui32Reg, uint32_t ui32Mask, uint32_t ui32Value)
+{
+    uint32_t ui32Old;
+    bool bIntsOff, bRet;
+
+    bIntsOff = IntMasterDisable();
+    ui32Old = g_pui16WM8731Shadow[WM8731_SHADOW_INDEX(ui32Reg)];
+    bRet = WM8731Write(ui32Reg, (ui32Old & ~ui32Mask) |
+                                (ui32Value & ui32Mask));
+    if(!bIntsOff)
+    {
+        IntMasterEnable();
+    }
+
+    return(bRet);
+}
+
+//*****************************************************************************
+//
+//! Returns the value of a codec register.
+//!
+//! \param ui32Reg is the register, one of the \b WM8731_REG_* values.
+//!
+//! \return Returns the value last written to the register, including writes
+//! still in the queue, or the codec's default after a reset.
+//
+//*****************************************************************************
+uint32_t
+WM8731Read(uint32_t ui32Reg)
+{
+    return(g_pui16WM8731Shadow[WM8731_SHADOW_INDEX(ui32Reg)]);
+}
+
+//*****************************************************************************
+//
+//! Writes a table of codec register settings.
+//!
+//! \param psTable is a pointer to the settings, in the order they are to be
+//! written.
+//! \param ui32Count is the number of settings.
+//!
+//! A setting for the \b WM8731_WAIT pseudo-register is a wait of its value
+//! in milliseconds, as made by WM8731Wait().
+//!
+//! \return Returns the number of settings queued; fewer than \e ui32Count if
+//! the queue filled up.
+//
+//*****************************************************************************
+uint32_t
+WM8731TableWrite(const tWM8731Setting *psTable, uint32_t ui32Count)
+{
+    uint32_t ui32Idx;
+
+    for(ui32Idx = 0; ui32Idx < ui32Count; ui32Idx++)
+    {
+        if(!((psTable[ui32Idx].ui8Reg == WM8731_WAIT) ?
+             WM8731Wait(psTable[ui32Idx].ui16Value) :
+             WM8731Write(psTable[ui32Idx].ui8Reg,
+                         psTable[ui32Idx].ui16Value)))
+        {
+            break;
+        }
+    }
+
+    return(ui32Idx);
+}
+
+//*****************************************************************************
+//
+//! Sets the headphone volume.
+//!
+//! \param ui32Left is the left channel volume.
+//! \param ui32Right is the right channel volume.
+//!
+//! The volumes run from 0, which mutes, through 1 for -73 dB to 80 for
+//! +6 dB in 1 dB steps; larger values are limited to 80.  Changes take
+//! effect at a zero crossing.  A channel whose volume is unchanged is not
+//! written.
+//!
+//! \return Returns \b false if the queue was full and a write was lost.
+//
+//*****************************************************************************
+bool
+WM8731VolumeSet(uint32_t ui32Left, uint32_t ui32Right)
+{
+    bool bRet;
+
+    ui32Left = (ui32Left > 80) ? 80 : ui32Left;
+    ui32Right = (ui32Right > 80) ? 80 : ui32Right;
+
+    bRet = WM8731Write(WM8731_REG_LHPHONE_OUT,
+                       (WM8731_HPHONE_ZERO_CROSS + WM8731_HPHONE_MUTE +
+                        ui32Left));
+    bRet &= WM8731Write(WM8731_REG_RHPHONE_OUT,
+                        (WM8731_HPHONE_ZERO_CROSS + WM8731_HPHONE_MUTE +
+                         ui32Right));
+
+    return(bRet);
+}
+
+//*****************************************************************************
+//
+//! Determines whether any codec writes are still outstanding.
+//!
+//! \return Returns \b true if the queue, including any waits, has not yet
+//! drained.
+//
+//*****************************************************************************
+bool
+WM8731Busy(void)
+{
+    return(g_ui32WM8731Head != g_ui32WM8731Tail);
+}
+
+//*****************************************************************************
+//
+//! Returns the number of writes the codec failed to acknowledge.
+//!
+//! A failed write is dropped and its register is treated as unknown, so the
+//! next write to it is sent even if it matches the shadow copy.
+//!
+//! \return Returns the error count.
+//
+//*****************************************************************************
+uint32_t
+WM8731ErrorCountGet(void)
+{
+    return(g_ui32WM8731Errors);
+}
+
+//*****************************************************************************
+//
+// The I2C0 interrupt handler, entered when a byte of the current write has
+// been sent.
+//
+//*****************************************************************************
+void
+I2C0_Handler(void)
+{
+    uint32_t ui32Reg;
+
+    I2CMasterIntClear(I2C0_BASE);
+
+    if(g_ui32WM8731Head == g_ui32WM8731Tail)
+    {
+        return;
+    }
+
+    if(I2CMasterErr(I2C0_BASE) != I2C_MASTER_ERR_NONE)
+    {
+        //
+        // Release the bus if the failure left it held, and forget what the
+        // register holds.  The stop takes a bit time; this rare path waits
+        // for it rather than leaving the next start to the controller.
+        //
+        if(!g_bWM8731Finishing)
+        {
+            I2CMasterControl(I2C0_BASE, I2C_MASTER_CMD_BURST_SEND_ERROR_STOP);
+        }
+        while(I2CMasterBusy(I2C0_BASE))
+        {
+        }
+
+        ui32Reg = (g_pui16WM8731Queue[g_ui32WM8731Head % WM8731_QUEUE_SIZE] >>
+                   9);
+        g_ui32WM8731Unknown |= 1 << WM8731_SHADOW_INDEX(ui32Reg);
+        g_ui32WM8731Errors++;
+    }
+    else if(!g_bWM8731Finishing)
+    {
+        I2CMasterDataPut(I2C0_BASE,
+                         (uint8_t)g_pui16WM8731Queue[g_ui32WM8731Head %
+                                                     WM8731_QUEUE_SIZE]);
+        I2CMasterControl(I2C0_BASE, I2C_MASTER_CMD_BURST_SEND_FINISH);
+        g_bWM8731Finishing = true;
+        return;
+    }
+
+    g_ui32WM8731Head++;
+    if(g_ui32WM8731Head != g_ui32WM8731Tail)
+    {
+        WM8731Send();
+    }
+}
+
+//*****************************************************************************
+//
+// The Timer 1A interrupt handler, entered when a queued wait has elapsed.
+//
+//*****************************************************************************
+void
+TIMER1A_Handler(void)
+{
+    TimerIntClear(TIMER1_BASE, TIMER_TIMA_TIMEOUT);
+
+    g_ui32WM8731Head++;
+    if(g_ui32WM8731Head != g_ui32WM8731Tail)
+    {
+        WM8731Send();
+    }
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -0,0 +1,135 @@
+//*****************************************************************************
+//
+// wm8731.h - Prototypes and register definitions for the WM8731 codec control
+//            driver.
+//
+//*****************************************************************************
+
+#ifndef __WM8731_H__
+#define __WM8731_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The codec's 7-bit I2C address with CSB tied low.
+//
+//*****************************************************************************
+#define WM8731_I2C_ADDR         0x1a
+
+//*****************************************************************************
+//
+// The codec registers.  All of them are nine bits wide and write-only.
+//
+//*****************************************************************************
+#define WM8731_REG_LLINE_IN     0x00        // Left line input volume
+#define WM8731_REG_RLINE_IN     0x01        // Right line input volume
+#define WM8731_REG_LHPHONE_OUT  0x02        // Left headphone output volume
+#define WM8731_REG_RHPHONE_OUT  0x03        // Right headphone output volume
+#define WM8731_REG_ANALOG_PATH  0x04        // Analog audio path control
+#define WM8731_REG_DIGITAL_PATH 0x05        // Digital audio path control
+#define WM8731_REG_POWER_DOWN   0x06        // Power down control
+#define WM8731_REG_DIGITAL_IF   0x07        // Digital audio interface format
+#define WM8731_REG_SAMPLING     0x08        // Sampling control
+#define WM8731_REG_ACTIVE       0x09        // Active control
+#define WM8731_REG_RESET        0x0f        // Reset
+
+//*****************************************************************************
+//
+// A pseudo-register for setting tables: a setting for it is a wait of its
+// value in milliseconds.
+//
+//*****************************************************************************
+#define WM8731_WAIT             0x7f
+
+//*****************************************************************************
+//
+// The number of registers held in the shadow copy.
+//
+//*****************************************************************************
+#define WM8731_NUM_REGS         11
+
+//*****************************************************************************
+//
+// Register fields used by the application.
+//
+//*****************************************************************************
+#define WM8731_LINE_IN_MUTE     0x080       // Mute the line input
+#define WM8731_LINE_IN_0DB      0x017       // 0 dB line input gain
+#define WM8731_HPHONE_ZERO_CROSS                                              \
+                                0x080       // Change volume at zero crossings
+#define WM8731_HPHONE_0DB       0x079       // 0 dB headphone gain
+#define WM8731_HPHONE_MUTE      0x02f       // Headphone volume codes below
+                                            // this one mute
+#define WM8731_POWER_OUTPUTS    0x010       // Power down the outputs
+#define WM8731_ANALOG_DACSEL    0x010       // DAC to the outputs
+#define WM8731_ANALOG_BYPASS    0x008       // Line input to the outputs
+#define WM8731_ANALOG_INSEL_MIC 0x004       // Microphone to the ADC
+#define WM8731_ANALOG_MUTE_MIC  0x002       // Mute the microphone
+#define WM8731_DIGITAL_DACMU    0x008       // Soft-mute the DAC
+#define WM8731_DIGITAL_ADCHPD   0x001       // Disable the ADC high-pass
+#define WM8731_IF_MASTER        0x040       // Codec drives the clocks
+#define WM8731_IF_IWL_16        0x000       // 16-bit words
+#define WM8731_IF_FORMAT_DSP    0x003       // DSP mode framing
+#define WM8731_SAMPLING_8K_USB  0x00d       // 8 kHz from a 12 MHz MCLK
+#define WM8731_SAMPLING_32K_USB 0x019       // 32 kHz from a 12 MHz MCLK
+#define WM8731_SAMPLING_44K1_USB                                              \
+                                0x023       // 44.1 kHz from a 12 MHz MCLK
+#define WM8731_SAMPLING_48K_USB 0x001       // 48 kHz from a 12 MHz MCLK
+#define WM8731_ACTIVE           0x001       // Digital interface active
+
+//*****************************************************************************
+//
+// The number of register writes and waits that may be queued.
+//
+//*****************************************************************************
+#define WM8731_QUEUE_SIZE       16
+
+//*****************************************************************************
+//
+// One register setting in a table passed to WM8731TableWrite().
+//
+//*****************************************************************************
+typedef struct
+{
+    uint8_t ui8Reg;
+    uint16_t ui16Value;
+}
+tWM8731Setting;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern void WM8731Init(void);
+extern bool WM8731Write(uint32_t ui32Reg, uint32_t ui32Value);
+extern bool WM8731Update(uint32_t ui32Reg, uint32_t ui32Mask,
+                         uint32_t ui32Value);
+extern bool WM8731Wait(uint32_t ui32Milliseconds);
+extern uint32_t WM8731Read(uint32_t ui32Reg);
+extern uint32_t WM8731TableWrite(const tWM8731Setting *psTable,
+                                 uint32_t ui32Count);
+extern bool WM8731VolumeSet(uint32_t ui32Left, uint32_t ui32Right);
+extern bool WM8731Busy(void);
+extern uint32_t WM8731ErrorCountGet(void);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __WM8731_H__